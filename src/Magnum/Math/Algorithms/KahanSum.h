@@ -66,6 +66,9 @@ for(UnsignedByte pixel: pixels) {
     sum = Math::Algorithms::kahanSum(&value, &value + 1, sum, &c);
 }
 @endcode
+
+For large contiguous ranges, @ref sum() with @ref SummationMode::Kahan is
+usually faster and can be split across multiple threads.
 */
 template<class Iterator, class T = typename std::decay<decltype(*std::declval<Iterator>())>::type> T kahanSum(Iterator begin, Iterator end, T sum = T(0), T* compensation = nullptr) {
     T c = compensation ? *compensation : T(0);
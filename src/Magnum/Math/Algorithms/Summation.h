@@ -0,0 +1,285 @@
+#ifndef Magnum_Math_Algorithms_Summation_h
+#define Magnum_Math_Algorithms_Summation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::Math::Algorithms::SummationMode, function @ref Magnum::Math::Algorithms::sum(), @ref Magnum::Math::Algorithms::sumChunkCount(), @ref Magnum::Math::Algorithms::sumChunk(), @ref Magnum::Math::Algorithms::sumPartials()
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Vector.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+/**
+@brief Summation mode
+
+@see @ref sum(), @ref sumChunk()
+*/
+enum class SummationMode: UnsignedByte {
+    /**
+     * Pairwise (cascade) summation. The error grows with logarithm of the
+     * item count, which is for most uses good enough and as fast as plain
+     * accumulation.
+     */
+    Pairwise,
+
+    /**
+     * Kahan summation, see @ref kahanSum() for details. The error is
+     * independent of the item count, for the price of four operations per
+     * item.
+     */
+    Kahan,
+
+    /**
+     * Neumaier summation, a variant of Kahan summation that handles also the
+     * case where the added value is larger in magnitude than the running
+     * sum. Slightly slower than @ref SummationMode::Kahan because of the
+     * additional comparison.
+     */
+    Neumaier
+};
+
+/**
+@brief Summation chunk size
+
+Item count processed by a single @ref sumChunk() call. The range is always
+split into chunks of this size, independently of how many threads are used
+for the calculation, which is what makes the result of @ref sum() bit-exact
+with a multithreaded calculation using @ref sumChunk() and @ref sumPartials().
+*/
+constexpr std::size_t SummationChunkSize = 8192;
+
+namespace Implementation {
+
+enum: std::size_t {
+    /* Count of independent accumulators, allowing the compiler to vectorize
+       the inner loop without relaxing floating-point semantics */
+    SummationLanes = 8,
+    /* Block size at which pairwise summation falls back to plain
+       accumulation into the lanes */
+    SummationPairwiseBlock = 128
+};
+
+template<class T> inline typename std::enable_if<std::is_arithmetic<T>::value>::type neumaierStep(T& sum, T& compensation, const T value) {
+    const T t = sum + value;
+    if(std::abs(sum) >= std::abs(value))
+        compensation += (sum - t) + value;
+    else
+        compensation += (value - t) + sum;
+    sum = t;
+}
+
+template<std::size_t size, class T> inline void neumaierStep(Vector<size, T>& sum, Vector<size, T>& compensation, const Vector<size, T>& value) {
+    for(std::size_t i = 0; i != size; ++i)
+        neumaierStep(sum[i], compensation[i], value[i]);
+}
+
+template<class T> inline void kahanStep(T& sum, T& compensation, const T& value) {
+    const T y = value - compensation;
+    const T t = sum + y;
+    compensation = (t - sum) - y;
+    sum = t;
+}
+
+/* Adds the lanes together in a fixed order */
+template<class T> inline T sumLanes(const T(&lanes)[SummationLanes]) {
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+           ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+template<class T> T sumPairwise(const T* const data, const std::size_t size) {
+    if(size > SummationPairwiseBlock) {
+        const std::size_t half = size/2;
+        return sumPairwise(data, half) + sumPairwise(data + half, size - half);
+    }
+
+    T lanes[SummationLanes]{};
+    std::size_t i = 0;
+    for(; i + SummationLanes <= size; i += SummationLanes)
+        for(std::size_t j = 0; j != SummationLanes; ++j)
+            lanes[j] += data[i + j];
+    for(std::size_t j = 0; i != size; ++i, ++j)
+        lanes[j] += data[i];
+
+    return sumLanes(lanes);
+}
+
+template<class T> T sumKahan(const T* const data, const std::size_t size) {
+    T lanes[SummationLanes]{};
+    T compensations[SummationLanes]{};
+    std::size_t i = 0;
+    for(; i + SummationLanes <= size; i += SummationLanes)
+        for(std::size_t j = 0; j != SummationLanes; ++j)
+            kahanStep(lanes[j], compensations[j], data[i + j]);
+    for(std::size_t j = 0; i != size; ++i, ++j)
+        kahanStep(lanes[j], compensations[j], data[i]);
+
+    /* Combine the lanes with compensation as well, otherwise the precision
+       gained above would get lost again */
+    T sum{}, compensation{};
+    for(std::size_t j = 0; j != SummationLanes; ++j)
+        kahanStep(sum, compensation, lanes[j]);
+    return sum - (compensation + sumLanes(compensations));
+}
+
+template<class T> T sumNeumaier(const T* const data, const std::size_t size) {
+    T lanes[SummationLanes]{};
+    T compensations[SummationLanes]{};
+    std::size_t i = 0;
+    for(; i + SummationLanes <= size; i += SummationLanes)
+        for(std::size_t j = 0; j != SummationLanes; ++j)
+            neumaierStep(lanes[j], compensations[j], data[i + j]);
+    for(std::size_t j = 0; i != size; ++i, ++j)
+        neumaierStep(lanes[j], compensations[j], data[i]);
+
+    T sum{}, compensation{};
+    for(std::size_t j = 0; j != SummationLanes; ++j)
+        neumaierStep(sum, compensation, lanes[j]);
+    return sum + (compensation + sumLanes(compensations));
+}
+
+template<class T> T sumChunkRange(const Corrade::Containers::ArrayView<const T> range, const std::size_t begin, const std::size_t end, const SummationMode mode);
+
+}
+
+/**
+@brief Count of chunks for given item count
+
+Size of the partial sum array to pass to @ref sumPartials().
+@see @ref SummationChunkSize
+*/
+inline std::size_t sumChunkCount(std::size_t size) {
+    return (size + SummationChunkSize - 1)/SummationChunkSize;
+}
+
+/**
+@brief Sum of a single chunk of a range
+@param range    Range to sum
+@param chunk    Chunk index, expected to be less than
+    @ref sumChunkCount() for size of @p range
+@param mode     Summation mode
+
+Sums items from `chunk*SummationChunkSize` up to `(chunk + 1)*SummationChunkSize`
+or the end of the range, whichever comes first. Chunks are independent of each
+other, so they can be calculated on any thread and in any order. The inner
+loop uses several independent accumulators that are combined in a fixed order
+at the end, allowing the compiler to vectorize it without changing the result.
+Usable for scalar types and @ref Vector (sub)classes such as @ref Color3.
+@see @ref sumPartials(), @ref sum()
+*/
+template<class T> typename std::remove_const<T>::type sumChunk(const Corrade::Containers::ArrayView<T> range, const std::size_t chunk, const SummationMode mode = SummationMode::Pairwise) {
+    typedef typename std::remove_const<T>::type Type;
+    CORRADE_ASSERT(chunk < sumChunkCount(range.size()),
+        "Math::Algorithms::sumChunk(): chunk index" << chunk << "out of range for" << sumChunkCount(range.size()) << "chunks", {});
+
+    const Type* const data = range.data() + chunk*SummationChunkSize;
+    const std::size_t size = std::min(range.size() - chunk*SummationChunkSize, std::size_t(SummationChunkSize));
+    switch(mode) {
+        case SummationMode::Pairwise:
+            return Implementation::sumPairwise(data, size);
+        case SummationMode::Kahan:
+            return Implementation::sumKahan(data, size);
+        case SummationMode::Neumaier:
+            return Implementation::sumNeumaier(data, size);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/**
+@brief Sum of partial chunk sums
+
+Combines the values calculated by @ref sumChunk() using pairwise summation in
+a fixed order. If @p partials contains results of @ref sumChunk() for all
+chunks of a range, the result is bit-exact to @ref sum() on the whole range
+with the same @ref SummationMode, no matter how the chunks were distributed
+among threads. Returns zero for an empty view.
+*/
+template<class T> typename std::remove_const<T>::type sumPartials(const Corrade::Containers::ArrayView<T> partials) {
+    typedef typename std::remove_const<T>::type Type;
+    if(partials.empty()) return Type{};
+    if(partials.size() == 1) return partials[0];
+
+    const std::size_t half = partials.size()/2;
+    return sumPartials(partials.prefix(half)) + sumPartials(partials.suffix(half));
+}
+
+/**
+@brief Sum of a range
+@param range    Range to sum
+@param mode     Summation mode
+
+Splits the range into chunks of @ref SummationChunkSize items, calculates
+them using @ref sumChunk() and combines the results in the same order as
+@ref sumPartials(). Returns zero for an empty range. Compared to
+@ref kahanSum() the inner loop can be vectorized and for large inputs the
+calculation can be split among multiple threads without affecting the result:
+@code
+Containers::ArrayView<const Float> data;
+Containers::Array<Float> partials{Math::Algorithms::sumChunkCount(data.size())};
+
+#pragma omp parallel for
+for(std::size_t i = 0; i < partials.size(); ++i)
+    partials[i] = Math::Algorithms::sumChunk(data, i);
+
+// Bit-exact to Math::Algorithms::sum(data)
+Float total = Math::Algorithms::sumPartials(partials);
+@endcode
+
+Within a chunk, @ref SummationMode::Kahan and @ref SummationMode::Neumaier
+have a bounded error independent of item count; the chunk sums are then
+added together pairwise.
+*/
+template<class T> typename std::remove_const<T>::type sum(const Corrade::Containers::ArrayView<T> range, const SummationMode mode = SummationMode::Pairwise) {
+    typedef typename std::remove_const<T>::type Type;
+    if(range.empty()) return Type{};
+    return Implementation::sumChunkRange<Type>(range, 0, sumChunkCount(range.size()), mode);
+}
+
+namespace Implementation {
+
+/* Recursion matching the one in sumPartials(), only without the need to
+   store the partial results anywhere */
+template<class T> T sumChunkRange(const Corrade::Containers::ArrayView<const T> range, const std::size_t begin, const std::size_t end, const SummationMode mode) {
+    if(end - begin == 1) return sumChunk(range, begin, mode);
+
+    const std::size_t half = (end - begin)/2;
+    return sumChunkRange(range, begin, begin + half, mode) +
+           sumChunkRange(range, begin + half, end, mode);
+}
+
+}
+
+}}}
+
+#endif
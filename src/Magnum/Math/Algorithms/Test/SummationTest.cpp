@@ -0,0 +1,221 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <numeric>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Algorithms/KahanSum.h"
+#include "Magnum/Math/Algorithms/Summation.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct SummationTest: TestSuite::Tester {
+    explicit SummationTest();
+
+    void empty();
+    void ones();
+    void notChunkMultiple();
+    void kahanVersusNeumaier();
+    void vector();
+    void color();
+    void partials();
+    void partialsEmpty();
+    void chunkOutOfRange();
+
+    void accumulate100k();
+    void pairwise100k();
+    void kahan100k();
+    void neumaier100k();
+};
+
+SummationTest::SummationTest() {
+    addTests({&SummationTest::empty,
+              &SummationTest::ones,
+              &SummationTest::notChunkMultiple,
+              &SummationTest::kahanVersusNeumaier,
+              &SummationTest::vector,
+              &SummationTest::color,
+              &SummationTest::partials,
+              &SummationTest::partialsEmpty,
+              &SummationTest::chunkOutOfRange});
+
+    addBenchmarks({&SummationTest::accumulate100k,
+                   &SummationTest::pairwise100k,
+                   &SummationTest::kahan100k,
+                   &SummationTest::neumaier100k}, 50);
+}
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Color3<Float> Color3;
+
+void SummationTest::empty() {
+    CORRADE_COMPARE(sum(Containers::ArrayView<const Float>{}), 0.0f);
+    CORRADE_COMPARE(sum(Containers::ArrayView<const Float>{}, SummationMode::Kahan), 0.0f);
+    CORRADE_COMPARE(sumChunkCount(0), 0);
+}
+
+void SummationTest::ones() {
+    /* Plain accumulation stops at 16777216 */
+    std::vector<Float> data(20000000, 1.0f);
+    Containers::ArrayView<const Float> view{data.data(), data.size()};
+
+    CORRADE_COMPARE(sum(view), 2.0e7f);
+    CORRADE_COMPARE(sum(view, SummationMode::Kahan), 2.0e7f);
+    CORRADE_COMPARE(sum(view, SummationMode::Neumaier), 2.0e7f);
+}
+
+void SummationTest::notChunkMultiple() {
+    /* Some chunks full, the last partial and not multiple of lane count */
+    std::vector<Double> data(3*SummationChunkSize + 37);
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Double(i);
+    Containers::ArrayView<const Double> view{data.data(), data.size()};
+
+    const Double expected = Double(data.size())*Double(data.size() - 1)/2.0;
+    CORRADE_COMPARE(sumChunkCount(data.size()), 4);
+    CORRADE_COMPARE(sum(view), expected);
+    CORRADE_COMPARE(sum(view, SummationMode::Kahan), expected);
+    CORRADE_COMPARE(sum(view, SummationMode::Neumaier), expected);
+}
+
+void SummationTest::kahanVersusNeumaier() {
+    /* Classic case where Kahan fails, because the added value is larger than
+       the running sum. Repeated to span all lanes. */
+    std::vector<Double> data;
+    for(std::size_t i = 0; i != 16; ++i) {
+        data.push_back(1.0);
+        data.push_back(1.0e100);
+        data.push_back(1.0);
+        data.push_back(-1.0e100);
+    }
+    Containers::ArrayView<const Double> view{data.data(), data.size()};
+
+    CORRADE_COMPARE(sum(view, SummationMode::Neumaier), 32.0);
+    CORRADE_COMPARE(sum(view, SummationMode::Kahan), 0.0);
+}
+
+void SummationTest::vector() {
+    std::vector<Vector3> data(20000000, Vector3{1.0f, 0.5f, -0.25f});
+    Containers::ArrayView<const Vector3> view{data.data(), data.size()};
+
+    CORRADE_COMPARE(sum(view), (Vector3{2.0e7f, 1.0e7f, -5.0e6f}));
+    CORRADE_COMPARE(sum(view, SummationMode::Kahan), (Vector3{2.0e7f, 1.0e7f, -5.0e6f}));
+    CORRADE_COMPARE(sum(view, SummationMode::Neumaier), (Vector3{2.0e7f, 1.0e7f, -5.0e6f}));
+}
+
+void SummationTest::color() {
+    std::vector<Color3> data(100000, Color3{0.1f, 0.2f, 0.3f});
+    Containers::ArrayView<const Color3> view{data.data(), data.size()};
+
+    CORRADE_COMPARE(sum(view, SummationMode::Neumaier), (Color3{10000.0f, 20000.0f, 30000.0f}));
+}
+
+void SummationTest::partials() {
+    std::vector<Float> data(10*SummationChunkSize + 1234);
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = 1.0f/Float(i + 1);
+    Containers::ArrayView<const Float> view{data.data(), data.size()};
+
+    for(SummationMode mode: {SummationMode::Pairwise,
+                             SummationMode::Kahan,
+                             SummationMode::Neumaier}) {
+        /* Calculate the chunks in reverse order to simulate arbitrary
+           scheduling, the result should be bit-exact */
+        std::vector<Float> partials(sumChunkCount(data.size()));
+        for(std::size_t i = partials.size(); i != 0; --i)
+            partials[i - 1] = sumChunk(view, i - 1, mode);
+
+        const Float total = sumPartials(Containers::ArrayView<const Float>{partials.data(), partials.size()});
+        CORRADE_VERIFY(total == sum(view, mode));
+    }
+}
+
+void SummationTest::partialsEmpty() {
+    CORRADE_COMPARE(sumPartials(Containers::ArrayView<const Float>{}), 0.0f);
+}
+
+void SummationTest::chunkOutOfRange() {
+    std::vector<Float> data(SummationChunkSize + 1);
+    Containers::ArrayView<const Float> view{data.data(), data.size()};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    sumChunk(view, 2);
+    CORRADE_COMPARE(out.str(), "Math::Algorithms::sumChunk(): chunk index 2 out of range for 2 chunks\n");
+}
+
+void SummationTest::accumulate100k() {
+    std::vector<Float> data(100000, 1.0f);
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = std::accumulate(data.begin(), data.end(), 0.0f);
+    }
+
+    CORRADE_COMPARE(Float(a), 100000.0f);
+}
+
+void SummationTest::pairwise100k() {
+    std::vector<Float> data(100000, 1.0f);
+    Containers::ArrayView<const Float> view{data.data(), data.size()};
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = sum(view);
+    }
+
+    CORRADE_COMPARE(Float(a), 100000.0f);
+}
+
+void SummationTest::kahan100k() {
+    std::vector<Float> data(100000, 1.0f);
+    Containers::ArrayView<const Float> view{data.data(), data.size()};
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = sum(view, SummationMode::Kahan);
+    }
+
+    CORRADE_COMPARE(Float(a), 100000.0f);
+}
+
+void SummationTest::neumaier100k() {
+    std::vector<Float> data(100000, 1.0f);
+    Containers::ArrayView<const Float> view{data.data(), data.size()};
+
+    volatile Float a; /* to avoid optimizing the loop out */
+    CORRADE_BENCHMARK(10) {
+        a = sum(view, SummationMode::Neumaier);
+    }
+
+    CORRADE_COMPARE(Float(a), 100000.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::SummationTest)
@@ -30,7 +30,10 @@
  * @brief Class @ref Magnum::Math::Bezier, alias @ref Magnum::Math::QuadraticBezier, @ref Magnum::Math::QuadraticBezier2D, @ref Magnum::Math::QuadraticBezier3D, @ref Magnum::Math::CubicBezier, @ref Magnum::Math::CubicBezier2D, @ref Magnum::Math::CubicBezier3D
  */
 
+#include <algorithm>
 #include <array>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/Math/Vector.h"
 
@@ -48,6 +51,37 @@ namespace Implementation {
 
 Implementation of M-order N-dimensional
 [Bézier Curve](https://en.wikipedia.org/wiki/B%C3%A9zier_curve).
+
+## Flattening and constant-speed traversal
+
+Instead of sampling the curve uniformly at a high resolution, it can be
+converted to a polyline with given maximal deviation using @ref flatten().
+Flat parts of the curve are then approximated with only a few segments while
+highly curved parts are subdivided more:
+@code
+std::vector<Vector2> polyline{curve[0]};
+for(const CubicBezier2D& curve: path)
+    curve.flatten(0.25f, polyline);
+@endcode
+
+For constant-speed movement along the curve, @ref arcLengthTable() fills a
+lookup table of accumulated lengths which is then used by
+@ref parameterForArcLength() to convert travelled distance to curve
+parameter:
+@code
+Float table[64];
+curve.arcLengthTable(table);
+Vector2 position = curve.value(CubicBezier2D::parameterForArcLength(table, speed*time));
+@endcode
+
+## Batch evaluation
+
+If the curve needs to be evaluated at many positions at once, use
+@ref values(). The batch variants run De Casteljau's algorithm on blocks of
+values stored in a structure-of-arrays layout, which allows the compiler to
+vectorize the inner loops, and are thus considerably faster than calling
+@ref value() repeatedly. There is also a variant evaluating many curves at
+once, each at its own position.
 @see @ref QuadraticBezier, @ref CubicBezier, @ref QuadraticBezier2D,
     @ref QuadraticBezier3D, @ref CubicBezier2D, @ref CubicBezier3D
 */
@@ -137,6 +171,85 @@ template<UnsignedInt order, UnsignedInt dimensions, class T> class Bezier {
             return calculateIntermediatePoints(t)[0][order];
         }
 
+        /**
+         * @brief Interpolate the curve at given batch of positions
+         * @param[in] t         Interpolation factors
+         * @param[out] values   Where to put the resulting points
+         *
+         * Equivalent to calling @ref value() for each item of @p t, but
+         * done in blocks in a way that allows the compiler to vectorize the
+         * calculation. Expects that both views have the same size.
+         */
+        void values(Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Vector<dimensions, T>> values) const;
+
+        /**
+         * @brief Interpolate a batch of curves
+         * @param[in] curves    Curves to interpolate
+         * @param[in] t         Interpolation factor for each curve
+         * @param[out] values   Where to put the resulting points
+         *
+         * Equivalent to calling `curves[i].value(t[i])` for all curves, but
+         * done in blocks in a way that allows the compiler to vectorize the
+         * calculation. Expects that all views have the same size.
+         */
+        static void values(Corrade::Containers::ArrayView<const Bezier<order, dimensions, T>> curves, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Vector<dimensions, T>> values);
+
+        /**
+         * @brief Flatten the curve into a polyline
+         * @param[in] tolerance Maximal distance of the curve from the
+         *      resulting polyline
+         * @param[in,out] points Array to append the points to
+         *
+         * Adaptively subdivides the curve in the middle until all control
+         * points of each part are closer than @p tolerance to the line
+         * segment connecting its end points and appends end point of each
+         * part to @p points. As the curve lies in a convex hull of its
+         * control points, the resulting polyline is guaranteed to not
+         * deviate from the curve more than @p tolerance. The first control
+         * point is not appended, so a path consisting of more curves can be
+         * flattened into a single array without duplicating the shared
+         * points. The subdivision is limited to 16 levels, i.e. at most
+         * 65536 segments. Expects that @p tolerance is positive.
+         * @see @ref flattened()
+         */
+        void flatten(T tolerance, std::vector<Vector<dimensions, T>>& points) const;
+
+        /**
+         * @brief Flattened curve
+         *
+         * Returns the first control point followed by points appended by
+         * @ref flatten().
+         */
+        std::vector<Vector<dimensions, T>> flattened(T tolerance) const {
+            std::vector<Vector<dimensions, T>> points{_data[0]};
+            flatten(tolerance, points);
+            return points;
+        }
+
+        /**
+         * @brief Fill an arc length lookup table
+         *
+         * Samples the curve at `table.size()` equidistant interpolation
+         * factors and fills @p table with accumulated lengths of the polyline
+         * going through the samples, i.e. the first item is always `0` and
+         * the last one is approximate length of the whole curve. Expects that
+         * the table has at least two items. Use @ref parameterForArcLength()
+         * to query the table.
+         */
+        void arcLengthTable(Corrade::Containers::ArrayView<T> table) const;
+
+        /**
+         * @brief Interpolation factor for given arc length
+         * @param table     Table filled with @ref arcLengthTable()
+         * @param length    Arc length measured from the start of the curve
+         *
+         * Finds the table entries surrounding @p length using binary search
+         * and linearly interpolates between their interpolation factors. The
+         * length is clamped to range of the table, so the result is always in
+         * range @f$ [ 0, 1 ] @f$.
+         */
+        static Float parameterForArcLength(Corrade::Containers::ArrayView<const T> table, T length);
+
         /**
          * @brief Subdivide the curve at given position
          *
@@ -155,6 +268,15 @@ template<UnsignedInt order, UnsignedInt dimensions, class T> class Bezier {
         }
 
     private:
+        enum: std::size_t {
+            /* Block size for batch evaluation. The scratch memory for a cubic
+               3D curve of doubles is 1.5 kB. */
+            BatchSize = 16,
+
+            /* Maximal subdivision depth in flatten() */
+            FlattenDepth = 16
+        };
+
         /* Implementation for Bezier<order, dimensions, T>::Bezier(const Bezier<order, dimensions, U>&) */
         template<class U, std::size_t ...sequence> constexpr explicit Bezier(Implementation::Sequence<sequence...>, const Bezier<order, dimensions, U>& other) noexcept: _data{Vector<dimensions, T>(other._data[sequence])...} {}
 
@@ -162,6 +284,14 @@ template<UnsignedInt order, UnsignedInt dimensions, class T> class Bezier {
         /* MSVC 2015 can't handle {} here */
         template<class U, std::size_t ...sequence> constexpr explicit Bezier(Implementation::Sequence<sequence...>, U): _data{Vector<dimensions, T>((static_cast<void>(sequence), U{typename U::Init{}}))...} {}
 
+        /* Whether all control points are closer than given distance to the
+           line segment connecting end points */
+        bool isFlat(T toleranceSquared) const;
+
+        /* Runs De Casteljau's algorithm on given block of control points,
+           stored as [order + 1][dimensions][BatchSize] */
+        static void calculateBatch(T(&points)[order + 1][dimensions][BatchSize], const Float* t, std::size_t count);
+
         /* Calculates and returns all intermediate points generated when using De Casteljau's algorithm */
         std::array<Bezier<order, dimensions, T>, order + 1> calculateIntermediatePoints(Float t) const {
             std::array<Bezier<order, dimensions, T>, order + 1> iPoints;
@@ -179,6 +309,146 @@ template<UnsignedInt order, UnsignedInt dimensions, class T> class Bezier {
         Vector<dimensions, T> _data[order + 1];
 };
 
+template<UnsignedInt order, UnsignedInt dimensions, class T> void Bezier<order, dimensions, T>::calculateBatch(T(&points)[order + 1][dimensions][BatchSize], const Float* const t, const std::size_t count) {
+    /* The innermost loop goes over the block, operating on contiguous
+       memory with no dependencies between iterations */
+    for(std::size_t r = 1; r <= order; ++r)
+        for(std::size_t i = 0; i <= order - r; ++i)
+            for(std::size_t d = 0; d != dimensions; ++d)
+                for(std::size_t j = 0; j != count; ++j)
+                    points[i][d][j] = T(1 - t[j])*points[i][d][j] + T(t[j])*points[i + 1][d][j];
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> void Bezier<order, dimensions, T>::values(const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Vector<dimensions, T>> values) const {
+    CORRADE_ASSERT(t.size() == values.size(),
+        "Math::Bezier::values(): expected" << values.size() << "interpolation factors but got" << t.size(), );
+
+    T points[order + 1][dimensions][BatchSize];
+    for(std::size_t offset = 0; offset < t.size(); offset += BatchSize) {
+        const std::size_t count = std::min(std::size_t(BatchSize), t.size() - offset);
+
+        for(std::size_t i = 0; i <= order; ++i)
+            for(std::size_t d = 0; d != dimensions; ++d)
+                for(std::size_t j = 0; j != count; ++j)
+                    points[i][d][j] = _data[i][d];
+
+        calculateBatch(points, t + offset, count);
+
+        for(std::size_t j = 0; j != count; ++j)
+            for(std::size_t d = 0; d != dimensions; ++d)
+                values[offset + j][d] = points[0][d][j];
+    }
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> void Bezier<order, dimensions, T>::values(const Corrade::Containers::ArrayView<const Bezier<order, dimensions, T>> curves, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Vector<dimensions, T>> values) {
+    CORRADE_ASSERT(curves.size() == t.size() && curves.size() == values.size(),
+        "Math::Bezier::values(): expected" << curves.size() << "interpolation factors and output values but got" << t.size() << "and" << values.size(), );
+
+    T points[order + 1][dimensions][BatchSize];
+    for(std::size_t offset = 0; offset < curves.size(); offset += BatchSize) {
+        const std::size_t count = std::min(std::size_t(BatchSize), curves.size() - offset);
+
+        /* Transpose the control points to SoA layout */
+        for(std::size_t i = 0; i <= order; ++i)
+            for(std::size_t d = 0; d != dimensions; ++d)
+                for(std::size_t j = 0; j != count; ++j)
+                    points[i][d][j] = curves[offset + j]._data[i][d];
+
+        calculateBatch(points, t + offset, count);
+
+        for(std::size_t j = 0; j != count; ++j)
+            for(std::size_t d = 0; d != dimensions; ++d)
+                values[offset + j][d] = points[0][d][j];
+    }
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> bool Bezier<order, dimensions, T>::isFlat(const T toleranceSquared) const {
+    const Vector<dimensions, T> chord = _data[order] - _data[0];
+    const T chordLengthSquared = chord.dot();
+    for(std::size_t i = 1; i != order; ++i) {
+        const Vector<dimensions, T> point = _data[i] - _data[0];
+
+        /* Distance to the nearest point on the segment. If the end points are
+           the same, it's distance to the end point. */
+        const T s = chordLengthSquared == T(0) ? T(0) :
+            std::min(std::max(Math::dot(point, chord)/chordLengthSquared, T(0)), T(1));
+        if((point - chord*s).dot() > toleranceSquared) return false;
+    }
+
+    return true;
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> void Bezier<order, dimensions, T>::flatten(const T tolerance, std::vector<Vector<dimensions, T>>& points) const {
+    CORRADE_ASSERT(tolerance > T(0),
+        "Math::Bezier::flatten(): expected positive tolerance but got" << tolerance, );
+
+    /* Explicit stack instead of recursion. The right half is pushed first so
+       the left half gets processed (and its points appended) first. As only
+       one half gets subdivided further on each level, the stack never
+       contains more than one item per level. */
+    Bezier<order, dimensions, T> stack[FlattenDepth + 1];
+    UnsignedInt depth[FlattenDepth + 1];
+    std::size_t size = 1;
+    stack[0] = *this;
+    depth[0] = 0;
+
+    const T toleranceSquared = tolerance*tolerance;
+    while(size) {
+        --size;
+        const Bezier<order, dimensions, T> curve = stack[size];
+        const UnsignedInt level = depth[size];
+
+        if(level == FlattenDepth || curve.isFlat(toleranceSquared)) {
+            points.push_back(curve._data[order]);
+            continue;
+        }
+
+        const std::pair<Bezier<order, dimensions, T>, Bezier<order, dimensions, T>> halves = curve.subdivide(0.5f);
+        stack[size] = halves.second;
+        depth[size++] = level + 1;
+        stack[size] = halves.first;
+        depth[size++] = level + 1;
+    }
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> void Bezier<order, dimensions, T>::arcLengthTable(const Corrade::Containers::ArrayView<T> table) const {
+    CORRADE_ASSERT(table.size() >= 2,
+        "Math::Bezier::arcLengthTable(): expected at least two items but got" << table.size(), );
+
+    const Float step = 1.0f/Float(table.size() - 1);
+    Float t[BatchSize];
+    Vector<dimensions, T> samples[BatchSize];
+    Vector<dimensions, T> previous = _data[0];
+    T length(0);
+    for(std::size_t offset = 0; offset < table.size(); offset += BatchSize) {
+        const std::size_t count = std::min(std::size_t(BatchSize), table.size() - offset);
+        for(std::size_t j = 0; j != count; ++j)
+            t[j] = Float(offset + j)*step;
+        values({t, count}, {samples, count});
+
+        for(std::size_t j = 0; j != count; ++j) {
+            length += (samples[j] - previous).length();
+            table[offset + j] = length;
+            previous = samples[j];
+        }
+    }
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> Float Bezier<order, dimensions, T>::parameterForArcLength(const Corrade::Containers::ArrayView<const T> table, const T length) {
+    CORRADE_ASSERT(table.size() >= 2,
+        "Math::Bezier::parameterForArcLength(): expected at least two items but got" << table.size(), {});
+
+    if(length <= table[0]) return 0.0f;
+    if(length >= table[table.size() - 1]) return 1.0f;
+
+    /* First entry larger than the length, the previous one is less or equal
+       to it (and the first entry is zero, so it's never returned) */
+    const std::size_t i = std::upper_bound(table.begin(), table.end(), length) - table.begin();
+    const T segment = table[i] - table[i - 1];
+    const Float fraction = segment == T(0) ? 0.0f : Float((length - table[i - 1])/segment);
+    return (Float(i - 1) + fraction)/Float(table.size() - 1);
+}
+
 /**
 @brief Quadratic Bézier curve
 
@@ -0,0 +1,209 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InterpolationBatch.h"
+
+#include <algorithm>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* Number of items processed in one block. Small enough for the transposed
+   data to fit in L1 cache, large enough for the loop overhead to be
+   negligible. */
+enum: std::size_t { BatchSize = 32 };
+
+/* Quaternions transposed to a structure-of-arrays layout */
+template<class T> struct QuaternionBlock {
+    T x[BatchSize], y[BatchSize], z[BatchSize], w[BatchSize];
+
+    void load(const Quaternion<T>* const data, const std::size_t count) {
+        for(std::size_t i = 0; i != count; ++i) {
+            x[i] = data[i].vector().x();
+            y[i] = data[i].vector().y();
+            z[i] = data[i].vector().z();
+            w[i] = data[i].scalar();
+        }
+    }
+
+    void store(Quaternion<T>* const data, const std::size_t count) const {
+        for(std::size_t i = 0; i != count; ++i)
+            data[i] = {{x[i], y[i], z[i]}, w[i]};
+    }
+};
+
+template<class T> void dotBlock(const QuaternionBlock<T>& a, const QuaternionBlock<T>& b, T* const out, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = a.x[i]*b.x[i] + a.y[i]*b.y[i] + a.z[i]*b.z[i] + a.w[i]*b.w[i];
+}
+
+/* Negates second quaternion if the dot product is negative, makes the dot
+   product positive */
+template<class T> void shortestPathBlock(QuaternionBlock<T>& b, T* const dot, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i) {
+        const T sign = dot[i] < T(0) ? T(-1) : T(1);
+        b.x[i] *= sign;
+        b.y[i] *= sign;
+        b.z[i] *= sign;
+        b.w[i] *= sign;
+        dot[i] *= sign;
+    }
+}
+
+template<class T> void lerpInternal(const Corrade::Containers::ArrayView<const Quaternion<T>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<T>> normalizedB, const Corrade::Containers::ArrayView<const T> t, const Corrade::Containers::ArrayView<Quaternion<T>> out, const bool shortestPath) {
+    CORRADE_ASSERT(normalizedA.size() == out.size() && normalizedB.size() == out.size() && t.size() == out.size(),
+        "Math::lerp(): expected" << out.size() << "items in all views but got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << "and" << t.size(), );
+
+    QuaternionBlock<T> a, b;
+    T dot[BatchSize];
+    for(std::size_t offset = 0; offset < out.size(); offset += BatchSize) {
+        const std::size_t count = std::min(std::size_t(BatchSize), out.size() - offset);
+        a.load(normalizedA + offset, count);
+        b.load(normalizedB + offset, count);
+        const T* const phase = t + offset;
+
+        if(shortestPath) {
+            dotBlock(a, b, dot, count);
+            shortestPathBlock(b, dot, count);
+        }
+
+        /* Interpolate into the first block, normalize in place */
+        for(std::size_t i = 0; i != count; ++i) {
+            const T ta = T(1) - phase[i];
+            a.x[i] = ta*a.x[i] + phase[i]*b.x[i];
+            a.y[i] = ta*a.y[i] + phase[i]*b.y[i];
+            a.z[i] = ta*a.z[i] + phase[i]*b.z[i];
+            a.w[i] = ta*a.w[i] + phase[i]*b.w[i];
+        }
+        dotBlock(a, a, dot, count);
+        for(std::size_t i = 0; i != count; ++i) {
+            const T lengthInverted = T(1)/std::sqrt(dot[i]);
+            a.x[i] *= lengthInverted;
+            a.y[i] *= lengthInverted;
+            a.z[i] *= lengthInverted;
+            a.w[i] *= lengthInverted;
+        }
+
+        a.store(out + offset, count);
+    }
+}
+
+template<class T> void slerpInternal(const Corrade::Containers::ArrayView<const Quaternion<T>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<T>> normalizedB, const Corrade::Containers::ArrayView<const T> t, const Corrade::Containers::ArrayView<Quaternion<T>> out, const bool shortestPath) {
+    CORRADE_ASSERT(normalizedA.size() == out.size() && normalizedB.size() == out.size() && t.size() == out.size(),
+        "Math::slerp(): expected" << out.size() << "items in all views but got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << "and" << t.size(), );
+
+    QuaternionBlock<T> a, b;
+    T cosHalfAngle[BatchSize], weightA[BatchSize], weightB[BatchSize];
+    for(std::size_t offset = 0; offset < out.size(); offset += BatchSize) {
+        const std::size_t count = std::min(std::size_t(BatchSize), out.size() - offset);
+        a.load(normalizedA + offset, count);
+        b.load(normalizedB + offset, count);
+        const T* const phase = t + offset;
+
+        dotBlock(a, b, cosHalfAngle, count);
+        if(shortestPath) shortestPathBlock(b, cosHalfAngle, count);
+
+        /* Calculate weights of both quaternions. If the quaternions are the
+           same or one is a negation of the other, the result is the first
+           quaternion, same as in Implementation::slerp(). */
+        for(std::size_t i = 0; i != count; ++i) {
+            if(std::abs(cosHalfAngle[i]) >= T(1)) {
+                weightA[i] = T(1);
+                weightB[i] = T(0);
+                continue;
+            }
+
+            const T angle = std::acos(cosHalfAngle[i]);
+            const T sinInverted = T(1)/std::sin(angle);
+            weightA[i] = std::sin((T(1) - phase[i])*angle)*sinInverted;
+            weightB[i] = std::sin(phase[i]*angle)*sinInverted;
+        }
+
+        for(std::size_t i = 0; i != count; ++i) {
+            a.x[i] = weightA[i]*a.x[i] + weightB[i]*b.x[i];
+            a.y[i] = weightA[i]*a.y[i] + weightB[i]*b.y[i];
+            a.z[i] = weightA[i]*a.z[i] + weightB[i]*b.z[i];
+            a.w[i] = weightA[i]*a.w[i] + weightB[i]*b.w[i];
+        }
+
+        a.store(out + offset, count);
+    }
+}
+
+template<class T> void sclerpInternal(const Corrade::Containers::ArrayView<const DualQuaternion<T>> normalizedA, const Corrade::Containers::ArrayView<const DualQuaternion<T>> normalizedB, const Corrade::Containers::ArrayView<const T> t, const Corrade::Containers::ArrayView<DualQuaternion<T>> out) {
+    CORRADE_ASSERT(normalizedA.size() == out.size() && normalizedB.size() == out.size() && t.size() == out.size(),
+        "Math::sclerp(): expected" << out.size() << "items in all views but got" << normalizedA.size() << Corrade::Utility::Debug::nospace << "," << normalizedB.size() << "and" << t.size(), );
+
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = Implementation::sclerp(normalizedA[i], normalizedB[i], t[i]);
+}
+
+}
+
+void lerp(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Quaternion<Float>> out) {
+    lerpInternal(normalizedA, normalizedB, t, out, false);
+}
+
+void lerp(const Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedB, const Corrade::Containers::ArrayView<const Double> t, const Corrade::Containers::ArrayView<Quaternion<Double>> out) {
+    lerpInternal(normalizedA, normalizedB, t, out, false);
+}
+
+void lerpShortestPath(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Quaternion<Float>> out) {
+    lerpInternal(normalizedA, normalizedB, t, out, true);
+}
+
+void lerpShortestPath(const Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedB, const Corrade::Containers::ArrayView<const Double> t, const Corrade::Containers::ArrayView<Quaternion<Double>> out) {
+    lerpInternal(normalizedA, normalizedB, t, out, true);
+}
+
+void slerp(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Quaternion<Float>> out) {
+    slerpInternal(normalizedA, normalizedB, t, out, false);
+}
+
+void slerp(const Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedB, const Corrade::Containers::ArrayView<const Double> t, const Corrade::Containers::ArrayView<Quaternion<Double>> out) {
+    slerpInternal(normalizedA, normalizedB, t, out, false);
+}
+
+void slerpShortestPath(const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Quaternion<Float>> out) {
+    slerpInternal(normalizedA, normalizedB, t, out, true);
+}
+
+void slerpShortestPath(const Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedA, const Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedB, const Corrade::Containers::ArrayView<const Double> t, const Corrade::Containers::ArrayView<Quaternion<Double>> out) {
+    slerpInternal(normalizedA, normalizedB, t, out, true);
+}
+
+void sclerp(const Corrade::Containers::ArrayView<const DualQuaternion<Float>> normalizedA, const Corrade::Containers::ArrayView<const DualQuaternion<Float>> normalizedB, const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<DualQuaternion<Float>> out) {
+    sclerpInternal(normalizedA, normalizedB, t, out);
+}
+
+void sclerp(const Corrade::Containers::ArrayView<const DualQuaternion<Double>> normalizedA, const Corrade::Containers::ArrayView<const DualQuaternion<Double>> normalizedB, const Corrade::Containers::ArrayView<const Double> t, const Corrade::Containers::ArrayView<DualQuaternion<Double>> out) {
+    sclerpInternal(normalizedA, normalizedB, t, out);
+}
+
+}}
@@ -0,0 +1,129 @@
+#ifndef Magnum_Math_InterpolationBatch_h
+#define Magnum_Math_InterpolationBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Batch variants of @ref Magnum::Math::lerp(const Quaternion<T>&, const Quaternion<T>&, T) "Math::lerp()", @ref Magnum::Math::lerpShortestPath() "Math::lerpShortestPath()", @ref Magnum::Math::slerp(const Quaternion<T>&, const Quaternion<T>&, T) "Math::slerp()", @ref Magnum::Math::slerpShortestPath() "Math::slerpShortestPath()" and @ref Magnum::Math::sclerp() "Math::sclerp()"
+ *
+ * The functions take keyframe pairs and interpolation phases as separate
+ * arrays and write the results into a preallocated output array. Quaternion
+ * interpolation is done in blocks transposed to a structure-of-arrays layout,
+ * which allows the compiler to vectorize the calculation including the final
+ * normalization. Each item is processed independently of the others, so large
+ * batches can be split into slices and processed on multiple threads, with
+ * the result being the same as when processed at once. Unlike the single-value
+ * functions, the batch functions don't check that the input is normalized.
+ * All functions expect that the input and output arrays have the same size.
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Batch linear interpolation of quaternions
+@param[in] normalizedA  First quaternions
+@param[in] normalizedB  Second quaternions
+@param[in] t            Interpolation phases
+@param[out] out         Interpolated quaternions
+
+Equivalent to calling @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T)
+on each item. See @ref InterpolationBatch.h for more information.
+*/
+MAGNUM_EXPORT void lerp(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Quaternion<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void lerp(Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedB, Corrade::Containers::ArrayView<const Double> t, Corrade::Containers::ArrayView<Quaternion<Double>> out);
+
+/**
+@brief Batch linear shortest-path interpolation of quaternions
+@param[in] normalizedA  First quaternions
+@param[in] normalizedB  Second quaternions
+@param[in] t            Interpolation phases
+@param[out] out         Interpolated quaternions
+
+Equivalent to calling @ref lerpShortestPath() on each item. See
+@ref InterpolationBatch.h for more information.
+*/
+MAGNUM_EXPORT void lerpShortestPath(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Quaternion<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void lerpShortestPath(Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedB, Corrade::Containers::ArrayView<const Double> t, Corrade::Containers::ArrayView<Quaternion<Double>> out);
+
+/**
+@brief Batch spherical linear interpolation of quaternions
+@param[in] normalizedA  First quaternions
+@param[in] normalizedB  Second quaternions
+@param[in] t            Interpolation phases
+@param[out] out         Interpolated quaternions
+
+Equivalent to calling @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T)
+on each item. See @ref InterpolationBatch.h for more information.
+*/
+MAGNUM_EXPORT void slerp(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Quaternion<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void slerp(Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedB, Corrade::Containers::ArrayView<const Double> t, Corrade::Containers::ArrayView<Quaternion<Double>> out);
+
+/**
+@brief Batch spherical linear shortest-path interpolation of quaternions
+@param[in] normalizedA  First quaternions
+@param[in] normalizedB  Second quaternions
+@param[in] t            Interpolation phases
+@param[out] out         Interpolated quaternions
+
+Equivalent to calling @ref slerpShortestPath() on each item. See
+@ref InterpolationBatch.h for more information.
+*/
+MAGNUM_EXPORT void slerpShortestPath(Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Quaternion<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void slerpShortestPath(Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedA, Corrade::Containers::ArrayView<const Quaternion<Double>> normalizedB, Corrade::Containers::ArrayView<const Double> t, Corrade::Containers::ArrayView<Quaternion<Double>> out);
+
+/**
+@brief Batch screw linear interpolation of dual quaternions
+@param[in] normalizedA  First dual quaternions
+@param[in] normalizedB  Second dual quaternions
+@param[in] t            Interpolation phases
+@param[out] out         Interpolated dual quaternions
+
+Equivalent to calling @ref sclerp() on each item, including its shortest-path
+handling. The calculation involves too many branches to benefit from
+vectorization, so this function only saves the per-item overhead. See
+@ref InterpolationBatch.h for more information.
+*/
+MAGNUM_EXPORT void sclerp(Corrade::Containers::ArrayView<const DualQuaternion<Float>> normalizedA, Corrade::Containers::ArrayView<const DualQuaternion<Float>> normalizedB, Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<DualQuaternion<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void sclerp(Corrade::Containers::ArrayView<const DualQuaternion<Double>> normalizedA, Corrade::Containers::ArrayView<const DualQuaternion<Double>> normalizedB, Corrade::Containers::ArrayView<const Double> t, Corrade::Containers::ArrayView<DualQuaternion<Double>> out);
+
+}}
+
+#endif
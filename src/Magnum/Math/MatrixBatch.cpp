@@ -0,0 +1,309 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MatrixBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* Number of items processed in one block. Small enough for the transposed
+   data to fit in L1 cache, large enough for the loop overhead to be
+   negligible. */
+enum: std::size_t { BatchSize = 16 };
+
+/* Maximal count of polar decomposition iterations, to avoid infinite loops
+   on singular input */
+enum: std::size_t { PolarDecompositionIterations = 32 };
+
+/* Matrices transposed to a structure-of-arrays layout. Element at column c
+   and row r is in a[c*size + r]. */
+template<std::size_t size, class T> struct MatrixBlock {
+    T a[size*size][BatchSize];
+
+    void load(const Matrix<size, T>* const data, const std::size_t count) {
+        for(std::size_t i = 0; i != count; ++i)
+            for(std::size_t c = 0; c != size; ++c)
+                for(std::size_t r = 0; r != size; ++r)
+                    a[c*size + r][i] = data[i][c][r];
+    }
+
+    /* Upper-left 3x3 part of a 4x4 matrix */
+    void load(const Matrix4<T>* const data, const std::size_t count) {
+        static_assert(size == 3, "");
+        for(std::size_t i = 0; i != count; ++i)
+            for(std::size_t c = 0; c != 3; ++c)
+                for(std::size_t r = 0; r != 3; ++r)
+                    a[c*3 + r][i] = data[i][c][r];
+    }
+
+    void store(Matrix<size, T>* const data, const std::size_t count) const {
+        for(std::size_t i = 0; i != count; ++i)
+            for(std::size_t c = 0; c != size; ++c)
+                for(std::size_t r = 0; r != size; ++r)
+                    data[i][c][r] = a[c*size + r][i];
+    }
+
+    void storeTransposed(Matrix<size, T>* const data, const std::size_t count) const {
+        for(std::size_t i = 0; i != count; ++i)
+            for(std::size_t c = 0; c != size; ++c)
+                for(std::size_t r = 0; r != size; ++r)
+                    data[i][c][r] = a[r*size + c][i];
+    }
+};
+
+/* The formulas below are written for row-major layout, but as inverse of a
+   transposed matrix is a transposed inverse, they work for column-major
+   storage as well. */
+template<class T> void invertBlock(const MatrixBlock<3, T>& m, MatrixBlock<3, T>& out, const std::size_t count) {
+    const auto& a = m.a;
+    auto& b = out.a;
+    for(std::size_t i = 0; i != count; ++i) {
+        const T c0 = a[4][i]*a[8][i] - a[5][i]*a[7][i];
+        const T c1 = a[2][i]*a[7][i] - a[1][i]*a[8][i];
+        const T c2 = a[1][i]*a[5][i] - a[2][i]*a[4][i];
+        const T c3 = a[5][i]*a[6][i] - a[3][i]*a[8][i];
+        const T c4 = a[0][i]*a[8][i] - a[2][i]*a[6][i];
+        const T c5 = a[2][i]*a[3][i] - a[0][i]*a[5][i];
+        const T c6 = a[3][i]*a[7][i] - a[4][i]*a[6][i];
+        const T c7 = a[1][i]*a[6][i] - a[0][i]*a[7][i];
+        const T c8 = a[0][i]*a[4][i] - a[1][i]*a[3][i];
+
+        const T invDet = T(1)/(a[0][i]*c0 + a[1][i]*c3 + a[2][i]*c6);
+        b[0][i] = c0*invDet;
+        b[1][i] = c1*invDet;
+        b[2][i] = c2*invDet;
+        b[3][i] = c3*invDet;
+        b[4][i] = c4*invDet;
+        b[5][i] = c5*invDet;
+        b[6][i] = c6*invDet;
+        b[7][i] = c7*invDet;
+        b[8][i] = c8*invDet;
+    }
+}
+
+template<class T> void invertBlock(const MatrixBlock<4, T>& m, MatrixBlock<4, T>& out, const std::size_t count) {
+    const auto& a = m.a;
+    auto& b = out.a;
+    for(std::size_t i = 0; i != count; ++i) {
+        const T s0 = a[0][i]*a[5][i] - a[4][i]*a[1][i];
+        const T s1 = a[0][i]*a[6][i] - a[4][i]*a[2][i];
+        const T s2 = a[0][i]*a[7][i] - a[4][i]*a[3][i];
+        const T s3 = a[1][i]*a[6][i] - a[5][i]*a[2][i];
+        const T s4 = a[1][i]*a[7][i] - a[5][i]*a[3][i];
+        const T s5 = a[2][i]*a[7][i] - a[6][i]*a[3][i];
+
+        const T c5 = a[10][i]*a[15][i] - a[14][i]*a[11][i];
+        const T c4 = a[9][i]*a[15][i] - a[13][i]*a[11][i];
+        const T c3 = a[9][i]*a[14][i] - a[13][i]*a[10][i];
+        const T c2 = a[8][i]*a[15][i] - a[12][i]*a[11][i];
+        const T c1 = a[8][i]*a[14][i] - a[12][i]*a[10][i];
+        const T c0 = a[8][i]*a[13][i] - a[12][i]*a[9][i];
+
+        const T invDet = T(1)/(s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0);
+
+        b[0][i] = ( a[5][i]*c5 - a[6][i]*c4 + a[7][i]*c3)*invDet;
+        b[1][i] = (-a[1][i]*c5 + a[2][i]*c4 - a[3][i]*c3)*invDet;
+        b[2][i] = ( a[13][i]*s5 - a[14][i]*s4 + a[15][i]*s3)*invDet;
+        b[3][i] = (-a[9][i]*s5 + a[10][i]*s4 - a[11][i]*s3)*invDet;
+
+        b[4][i] = (-a[4][i]*c5 + a[6][i]*c2 - a[7][i]*c1)*invDet;
+        b[5][i] = ( a[0][i]*c5 - a[2][i]*c2 + a[3][i]*c1)*invDet;
+        b[6][i] = (-a[12][i]*s5 + a[14][i]*s2 - a[15][i]*s1)*invDet;
+        b[7][i] = ( a[8][i]*s5 - a[10][i]*s2 + a[11][i]*s1)*invDet;
+
+        b[8][i] = ( a[4][i]*c4 - a[5][i]*c2 + a[7][i]*c0)*invDet;
+        b[9][i] = (-a[0][i]*c4 + a[1][i]*c2 - a[3][i]*c0)*invDet;
+        b[10][i] = ( a[12][i]*s4 - a[13][i]*s2 + a[15][i]*s0)*invDet;
+        b[11][i] = (-a[8][i]*s4 + a[9][i]*s2 - a[11][i]*s0)*invDet;
+
+        b[12][i] = (-a[4][i]*c3 + a[5][i]*c1 - a[6][i]*c0)*invDet;
+        b[13][i] = ( a[0][i]*c3 - a[1][i]*c1 + a[2][i]*c0)*invDet;
+        b[14][i] = (-a[12][i]*s3 + a[13][i]*s1 - a[14][i]*s0)*invDet;
+        b[15][i] = ( a[8][i]*s3 - a[9][i]*s1 + a[10][i]*s0)*invDet;
+    }
+}
+
+template<std::size_t size, class T> void invertedInternal(const Corrade::Containers::ArrayView<const Matrix<size, T>> matrices, const Corrade::Containers::ArrayView<Matrix<size, T>> out) {
+    CORRADE_ASSERT(matrices.size() == out.size(),
+        "Math::inverted(): expected" << out.size() << "items in both views but got" << matrices.size(), );
+
+    MatrixBlock<size, T> m, inverse;
+    for(std::size_t offset = 0; offset < out.size(); offset += BatchSize) {
+        const std::size_t count = std::min(std::size_t(BatchSize), out.size() - offset);
+        m.load(matrices + offset, count);
+        invertBlock(m, inverse, count);
+        inverse.store(out + offset, count);
+    }
+}
+
+template<class T> void invertedRigidInternal(const Corrade::Containers::ArrayView<const Matrix3<T>> matrices, const Corrade::Containers::ArrayView<Matrix3<T>> out) {
+    CORRADE_ASSERT(matrices.size() == out.size(),
+        "Math::invertedRigid(): expected" << out.size() << "items in both views but got" << matrices.size(), );
+
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        const Matrix2x2<T> inverseRotation = matrices[i].rotationScaling().transposed();
+        out[i] = Matrix3<T>::from(inverseRotation, inverseRotation*-matrices[i].translation());
+    }
+}
+
+template<class T> void invertedRigidInternal(const Corrade::Containers::ArrayView<const Matrix4<T>> matrices, const Corrade::Containers::ArrayView<Matrix4<T>> out) {
+    CORRADE_ASSERT(matrices.size() == out.size(),
+        "Math::invertedRigid(): expected" << out.size() << "items in both views but got" << matrices.size(), );
+
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        const Matrix3x3<T> inverseRotation = matrices[i].rotationScaling().transposed();
+        out[i] = Matrix4<T>::from(inverseRotation, inverseRotation*-matrices[i].translation());
+    }
+}
+
+template<class T> void normalMatrixInternal(const Corrade::Containers::ArrayView<const Matrix4<T>> transformationMatrices, const Corrade::Containers::ArrayView<Matrix3x3<T>> out) {
+    CORRADE_ASSERT(transformationMatrices.size() == out.size(),
+        "Math::normalMatrix(): expected" << out.size() << "items in both views but got" << transformationMatrices.size(), );
+
+    MatrixBlock<3, T> m, inverse;
+    for(std::size_t offset = 0; offset < out.size(); offset += BatchSize) {
+        const std::size_t count = std::min(std::size_t(BatchSize), out.size() - offset);
+        m.load(transformationMatrices + offset, count);
+        invertBlock(m, inverse, count);
+        inverse.storeTransposed(out + offset, count);
+    }
+}
+
+template<class T> void polarDecompositionInternal(const Corrade::Containers::ArrayView<const Matrix3x3<T>> matrices, const Corrade::Containers::ArrayView<Matrix3x3<T>> rotations, const Corrade::Containers::ArrayView<Matrix3x3<T>> scalings) {
+    CORRADE_ASSERT(matrices.size() == rotations.size() && (scalings.empty() || scalings.size() == rotations.size()),
+        "Math::polarDecomposition(): expected" << rotations.size() << "items in all views but got" << matrices.size() << "and" << scalings.size(), );
+
+    MatrixBlock<3, T> x, inverse;
+    for(std::size_t offset = 0; offset < rotations.size(); offset += BatchSize) {
+        const std::size_t count = std::min(std::size_t(BatchSize), rotations.size() - offset);
+        x.load(matrices + offset, count);
+
+        for(std::size_t iteration = 0; iteration != PolarDecompositionIterations; ++iteration) {
+            invertBlock(x, inverse, count);
+
+            /* X = (gamma*X + (X^-T)/gamma)/2, element at (c, r) of the
+               inverse transpose is at (r, c) of the inverse. The scaling
+               factor is calculated from Frobenius norms, which needs just
+               square roots instead of a cube root of the determinant. Done
+               element by element over the whole block so the loops
+               vectorize. */
+            T halfGamma[BatchSize], halfInvGamma[BatchSize], delta[BatchSize]{};
+            T normSquared[BatchSize]{}, inverseNormSquared[BatchSize]{};
+            for(std::size_t j = 0; j != 9; ++j) {
+                for(std::size_t i = 0; i != count; ++i) {
+                    normSquared[i] += x.a[j][i]*x.a[j][i];
+                    inverseNormSquared[i] += inverse.a[j][i]*inverse.a[j][i];
+                }
+            }
+            for(std::size_t i = 0; i != count; ++i) {
+                const T gamma = std::sqrt(std::sqrt(inverseNormSquared[i]/normSquared[i]));
+                halfGamma[i] = T(0.5)*gamma;
+                halfInvGamma[i] = T(0.5)/gamma;
+            }
+            for(std::size_t c = 0; c != 3; ++c) {
+                for(std::size_t r = 0; r != 3; ++r) {
+                    T* const a = x.a[c*3 + r];
+                    const T* const b = inverse.a[r*3 + c];
+                    for(std::size_t i = 0; i != count; ++i) {
+                        const T next = halfGamma[i]*a[i] + halfInvGamma[i]*b[i];
+                        delta[i] += std::abs(next - a[i]);
+                        a[i] = next;
+                    }
+                }
+            }
+            T maxDelta{};
+            for(std::size_t i = 0; i != count; ++i)
+                maxDelta = std::max(maxDelta, delta[i]);
+
+            /* The negated comparison also stops on NaN */
+            if(!(maxDelta > TypeTraits<T>::epsilon())) break;
+        }
+
+        x.store(rotations + offset, count);
+    }
+
+    /* S = R^T M */
+    if(!scalings.empty()) for(std::size_t i = 0; i != rotations.size(); ++i)
+        scalings[i] = rotations[i].transposed()*matrices[i];
+}
+
+}
+
+void inverted(const Corrade::Containers::ArrayView<const Matrix3x3<Float>> matrices, const Corrade::Containers::ArrayView<Matrix3x3<Float>> out) {
+    invertedInternal(matrices, out);
+}
+
+void inverted(const Corrade::Containers::ArrayView<const Matrix3x3<Double>> matrices, const Corrade::Containers::ArrayView<Matrix3x3<Double>> out) {
+    invertedInternal(matrices, out);
+}
+
+void inverted(const Corrade::Containers::ArrayView<const Matrix4x4<Float>> matrices, const Corrade::Containers::ArrayView<Matrix4x4<Float>> out) {
+    invertedInternal(matrices, out);
+}
+
+void inverted(const Corrade::Containers::ArrayView<const Matrix4x4<Double>> matrices, const Corrade::Containers::ArrayView<Matrix4x4<Double>> out) {
+    invertedInternal(matrices, out);
+}
+
+void invertedRigid(const Corrade::Containers::ArrayView<const Matrix3<Float>> matrices, const Corrade::Containers::ArrayView<Matrix3<Float>> out) {
+    invertedRigidInternal(matrices, out);
+}
+
+void invertedRigid(const Corrade::Containers::ArrayView<const Matrix3<Double>> matrices, const Corrade::Containers::ArrayView<Matrix3<Double>> out) {
+    invertedRigidInternal(matrices, out);
+}
+
+void invertedRigid(const Corrade::Containers::ArrayView<const Matrix4<Float>> matrices, const Corrade::Containers::ArrayView<Matrix4<Float>> out) {
+    invertedRigidInternal(matrices, out);
+}
+
+void invertedRigid(const Corrade::Containers::ArrayView<const Matrix4<Double>> matrices, const Corrade::Containers::ArrayView<Matrix4<Double>> out) {
+    invertedRigidInternal(matrices, out);
+}
+
+void normalMatrix(const Corrade::Containers::ArrayView<const Matrix4<Float>> transformationMatrices, const Corrade::Containers::ArrayView<Matrix3x3<Float>> out) {
+    normalMatrixInternal(transformationMatrices, out);
+}
+
+void normalMatrix(const Corrade::Containers::ArrayView<const Matrix4<Double>> transformationMatrices, const Corrade::Containers::ArrayView<Matrix3x3<Double>> out) {
+    normalMatrixInternal(transformationMatrices, out);
+}
+
+void polarDecomposition(const Corrade::Containers::ArrayView<const Matrix3x3<Float>> matrices, const Corrade::Containers::ArrayView<Matrix3x3<Float>> rotations, const Corrade::Containers::ArrayView<Matrix3x3<Float>> scalings) {
+    polarDecompositionInternal(matrices, rotations, scalings);
+}
+
+void polarDecomposition(const Corrade::Containers::ArrayView<const Matrix3x3<Double>> matrices, const Corrade::Containers::ArrayView<Matrix3x3<Double>> rotations, const Corrade::Containers::ArrayView<Matrix3x3<Double>> scalings) {
+    polarDecompositionInternal(matrices, rotations, scalings);
+}
+
+}}
@@ -0,0 +1,161 @@
+#ifndef Magnum_Math_MatrixBatch_h
+#define Magnum_Math_MatrixBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Batch variants of @ref Magnum::Math::Matrix::inverted() "Math::Matrix::inverted()", @ref Magnum::Math::Matrix4::invertedRigid() "Math::Matrix4::invertedRigid()", normal matrix calculation and polar decomposition
+ *
+ * The functions take an array of matrices and write the results into a
+ * preallocated output array of the same size. General inversion, normal
+ * matrix calculation and polar decomposition are done in blocks transposed to
+ * a structure-of-arrays layout, which allows the compiler to vectorize the
+ * calculation across matrices. Each item is processed independently of the
+ * others, so large batches can be split into slices and processed on multiple
+ * threads, with the result being the same as when processed at once. Unlike
+ * the single-value functions, the batch functions don't check any
+ * preconditions on the input.
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Batch inversion of 3x3 matrices
+@param[in] matrices Matrices to invert
+@param[out] out     Inverted matrices
+
+Equivalent to calling @ref Matrix::inverted() on each item, but using a
+direct cofactor expansion instead of a recursive one. Singular matrices
+result in infinite or NaN values. See @ref MatrixBatch.h for more
+information.
+*/
+MAGNUM_EXPORT void inverted(Corrade::Containers::ArrayView<const Matrix3x3<Float>> matrices, Corrade::Containers::ArrayView<Matrix3x3<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void inverted(Corrade::Containers::ArrayView<const Matrix3x3<Double>> matrices, Corrade::Containers::ArrayView<Matrix3x3<Double>> out);
+
+/**
+@brief Batch inversion of 4x4 matrices
+@param[in] matrices Matrices to invert
+@param[out] out     Inverted matrices
+
+Equivalent to calling @ref Matrix::inverted() on each item, but using a
+direct expansion by 2x2 minors instead of a recursive one. Singular matrices
+result in infinite or NaN values. See @ref MatrixBatch.h for more
+information.
+*/
+MAGNUM_EXPORT void inverted(Corrade::Containers::ArrayView<const Matrix4x4<Float>> matrices, Corrade::Containers::ArrayView<Matrix4x4<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void inverted(Corrade::Containers::ArrayView<const Matrix4x4<Double>> matrices, Corrade::Containers::ArrayView<Matrix4x4<Double>> out);
+
+/**
+@brief Batch inversion of 2D rigid transformation matrices
+@param[in] matrices Rigid transformation matrices
+@param[out] out     Inverted matrices
+
+Equivalent to calling @ref Matrix3::invertedRigid() on each item, except that
+it's not checked that the matrices represent a rigid transformation. The
+operation is mostly a transposition, so it's done directly on the input
+without converting to a structure-of-arrays layout. See @ref MatrixBatch.h
+for more information.
+*/
+MAGNUM_EXPORT void invertedRigid(Corrade::Containers::ArrayView<const Matrix3<Float>> matrices, Corrade::Containers::ArrayView<Matrix3<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void invertedRigid(Corrade::Containers::ArrayView<const Matrix3<Double>> matrices, Corrade::Containers::ArrayView<Matrix3<Double>> out);
+
+/**
+@brief Batch inversion of 3D rigid transformation matrices
+@param[in] matrices Rigid transformation matrices
+@param[out] out     Inverted matrices
+
+Equivalent to calling @ref Matrix4::invertedRigid() on each item, except that
+it's not checked that the matrices represent a rigid transformation. The
+operation is mostly a transposition, so it's done directly on the input
+without converting to a structure-of-arrays layout. See @ref MatrixBatch.h
+for more information.
+*/
+MAGNUM_EXPORT void invertedRigid(Corrade::Containers::ArrayView<const Matrix4<Float>> matrices, Corrade::Containers::ArrayView<Matrix4<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void invertedRigid(Corrade::Containers::ArrayView<const Matrix4<Double>> matrices, Corrade::Containers::ArrayView<Matrix4<Double>> out);
+
+/**
+@brief Batch calculation of normal matrices
+@param[in] transformationMatrices   Transformation matrices
+@param[out] out                     Normal matrices
+
+Calculates inverse transpose of the upper-left 3x3 part of each matrix, the
+same as @cpp transformationMatrix.rotationScaling().inverted().transposed() @ce.
+Unlike @ref Matrix4::rotation(), the result is correct also for non-uniform
+scaling. See @ref MatrixBatch.h for more information.
+*/
+MAGNUM_EXPORT void normalMatrix(Corrade::Containers::ArrayView<const Matrix4<Float>> transformationMatrices, Corrade::Containers::ArrayView<Matrix3x3<Float>> out);
+
+/** @overload */
+MAGNUM_EXPORT void normalMatrix(Corrade::Containers::ArrayView<const Matrix4<Double>> transformationMatrices, Corrade::Containers::ArrayView<Matrix3x3<Double>> out);
+
+/**
+@brief Batch polar decomposition of 3x3 matrices
+@param[in] matrices     Matrices to decompose
+@param[out] rotations   Orthogonal factors
+@param[out] scalings    Symmetric positive semi-definite factors. Can be
+    empty if not needed.
+
+Decomposes each matrix @f$ \boldsymbol{M} @f$ into @f$ \boldsymbol{M} =
+\boldsymbol{R} \boldsymbol{S} @f$, where @f$ \boldsymbol{R} @f$ is the
+orthogonal matrix closest to @f$ \boldsymbol{M} @f$ and @f$ \boldsymbol{S} @f$
+is symmetric. Useful for extracting rotation from a matrix that contains
+scaling, shear or accumulated numerical drift. Uses the Newton iteration with
+Frobenius norm scaling: @f[
+    \boldsymbol{X}_0 = \boldsymbol{M} ~~~~~
+    \boldsymbol{X}_{k+1} = \frac{1}{2} \left( \gamma_k \boldsymbol{X}_k +
+        \frac{1}{\gamma_k} \boldsymbol{X}_k^{-T} \right) ~~~~~
+    \gamma_k = \sqrt{\frac{||\boldsymbol{X}_k^{-1}||_F}{||\boldsymbol{X}_k||_F}}
+@f]
+
+which converges quadratically, usually in less than ten iterations. That's
+considerably faster than extracting the rotation from
+@ref Algorithms::svd() as @f$ \boldsymbol{U} \boldsymbol{V}^T @f$. The
+iteration stops once all matrices in a block change by less than
+@ref TypeTraits::epsilon(). Matrices with negative determinant result in an
+orthogonal factor with determinant @f$ -1 @f$, singular matrices result in
+infinite or NaN values. See @ref MatrixBatch.h for more information.
+*/
+MAGNUM_EXPORT void polarDecomposition(Corrade::Containers::ArrayView<const Matrix3x3<Float>> matrices, Corrade::Containers::ArrayView<Matrix3x3<Float>> rotations, Corrade::Containers::ArrayView<Matrix3x3<Float>> scalings = nullptr);
+
+/** @overload */
+MAGNUM_EXPORT void polarDecomposition(Corrade::Containers::ArrayView<const Matrix3x3<Double>> matrices, Corrade::Containers::ArrayView<Matrix3x3<Double>> rotations, Corrade::Containers::ArrayView<Matrix3x3<Double>> scalings = nullptr);
+
+}}
+
+#endif
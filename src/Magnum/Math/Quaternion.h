@@ -60,6 +60,16 @@ namespace Implementation {
     template<class T> inline T angle(const Quaternion<T>& normalizedA, const Quaternion<T>& normalizedB) {
         return std::acos(dot(normalizedA, normalizedB));
     }
+
+    /* Used in slerp(), slerpShortestPath() and the batch variants (no
+       assertions, dot product already calculated) */
+    template<class T> inline Quaternion<T> slerp(const Quaternion<T>& normalizedA, const Quaternion<T>& normalizedB, const T cosHalfAngle, const T t) {
+        /* Avoid division by zero */
+        if(std::abs(cosHalfAngle) >= T(1)) return Quaternion<T>{normalizedA};
+
+        const T a = std::acos(cosHalfAngle);
+        return (std::sin((T(1) - t)*a)*normalizedA + std::sin(t*a)*normalizedB)/std::sin(a);
+    }
 }
 
 /** @relatesalso Quaternion
@@ -88,7 +98,7 @@ Expects that both quaternions are normalized. @f[
     q_{LERP} = \frac{(1 - t) q_A + t q_B}{|(1 - t) q_A + t q_B|}
 @f]
 @see @ref Quaternion::isNormalized(), @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T),
-    @ref lerp(const T&, const T&, U)
+    @ref lerpShortestPath(), @ref lerp(const T&, const T&, U)
 */
 template<class T> inline Quaternion<T> lerp(const Quaternion<T>& normalizedA, const Quaternion<T>& normalizedB, T t) {
     CORRADE_ASSERT(normalizedA.isNormalized() && normalizedB.isNormalized(),
@@ -96,6 +106,24 @@ template<class T> inline Quaternion<T> lerp(const Quaternion<T>& normalizedA, co
     return ((T(1) - t)*normalizedA + t*normalizedB).normalized();
 }
 
+/** @relatesalso Quaternion
+@brief Linear shortest-path interpolation of two quaternions
+@param normalizedA  First quaternion
+@param normalizedB  Second quaternion
+@param t            Interpolation phase (from range @f$ [0; 1] @f$)
+
+Unlike @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T), negates
+@p normalizedB if @f$ q_A \cdot q_B < 0 @f$, so the interpolation always goes
+through the shorter path. Expects that both quaternions are normalized.
+@see @ref slerpShortestPath()
+*/
+template<class T> inline Quaternion<T> lerpShortestPath(const Quaternion<T>& normalizedA, const Quaternion<T>& normalizedB, T t) {
+    CORRADE_ASSERT(normalizedA.isNormalized() && normalizedB.isNormalized(),
+        "Math::lerpShortestPath(): quaternions must be normalized", {});
+    const Quaternion<T> b = dot(normalizedA, normalizedB) < T(0) ? -normalizedB : normalizedB;
+    return ((T(1) - t)*normalizedA + t*b).normalized();
+}
+
 /** @relatesalso Quaternion
 @brief Spherical linear interpolation of two quaternions
 @param normalizedA  First quaternion
@@ -108,18 +136,35 @@ or one is a negation of the other, returns the first argument. @f[
     ~ ~ ~ ~ ~ ~ ~
     \theta = acos \left( \frac{q_A \cdot q_B}{|q_A| \cdot |q_B|} \right) = acos(q_A \cdot q_B)
 @f]
-@see @ref Quaternion::isNormalized(), @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T)
+@see @ref Quaternion::isNormalized(), @ref lerp(const Quaternion<T>&, const Quaternion<T>&, T),
+    @ref slerpShortestPath()
  */
 template<class T> inline Quaternion<T> slerp(const Quaternion<T>& normalizedA, const Quaternion<T>& normalizedB, T t) {
     CORRADE_ASSERT(normalizedA.isNormalized() && normalizedB.isNormalized(),
         "Math::slerp(): quaternions must be normalized", {});
-    const T cosHalfAngle = dot(normalizedA, normalizedB);
+    return Implementation::slerp(normalizedA, normalizedB, dot(normalizedA, normalizedB), t);
+}
 
-    /* Avoid division by zero */
-    if(std::abs(cosHalfAngle) >= T(1)) return Quaternion<T>{normalizedA};
+/** @relatesalso Quaternion
+@brief Spherical linear shortest-path interpolation of two quaternions
+@param normalizedA  First quaternion
+@param normalizedB  Second quaternion
+@param t            Interpolation phase (from range @f$ [0; 1] @f$)
 
-    const T a = std::acos(cosHalfAngle);
-    return (std::sin((T(1) - t)*a)*normalizedA + std::sin(t*a)*normalizedB)/std::sin(a);
+Unlike @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T), negates
+@p normalizedB if @f$ q_A \cdot q_B < 0 @f$, so the interpolation always goes
+through the shorter path. Expects that both quaternions are normalized. If
+the quaternions are the same or one is a negation of the other, returns the
+first argument.
+@see @ref lerpShortestPath()
+*/
+template<class T> inline Quaternion<T> slerpShortestPath(const Quaternion<T>& normalizedA, const Quaternion<T>& normalizedB, T t) {
+    CORRADE_ASSERT(normalizedA.isNormalized() && normalizedB.isNormalized(),
+        "Math::slerpShortestPath(): quaternions must be normalized", {});
+    const T cosHalfAngle = dot(normalizedA, normalizedB);
+    return cosHalfAngle < T(0) ?
+        Implementation::slerp(normalizedA, -normalizedB, -cosHalfAngle, t) :
+        Implementation::slerp(normalizedA, normalizedB, cosHalfAngle, t);
 }
 
 /**
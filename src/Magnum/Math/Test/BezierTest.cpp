@@ -29,6 +29,7 @@
 #include <Corrade/Utility/Configuration.h>
 
 #include "Magnum/Math/Bezier.h"
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Math/Vector2.h"
 #include "Magnum/Math/Functions.h"
 
@@ -82,6 +83,17 @@ struct BezierTest : Corrade::TestSuite::Tester {
     void subdivideQuadratic();
     void subdivideCubic();
 
+    void valuesBatch();
+    void valuesBatchCurves();
+    void flattenLinear();
+    void flattenCubic();
+    void flattenDegenerate();
+    void arcLengthTable();
+    void parameterForArcLength();
+
+    void valueCubic1k();
+    void valuesCubic1k();
+
     void debug();
     void configuration();
 };
@@ -105,8 +117,19 @@ BezierTest::BezierTest() {
               &BezierTest::subdivideQuadratic,
               &BezierTest::subdivideCubic,
 
+              &BezierTest::valuesBatch,
+              &BezierTest::valuesBatchCurves,
+              &BezierTest::flattenLinear,
+              &BezierTest::flattenCubic,
+              &BezierTest::flattenDegenerate,
+              &BezierTest::arcLengthTable,
+              &BezierTest::parameterForArcLength,
+
               &BezierTest::debug,
               &BezierTest::configuration});
+
+    addBenchmarks({&BezierTest::valueCubic1k,
+                   &BezierTest::valuesCubic1k}, 100);
 }
 
 void BezierTest::construct() {
@@ -274,6 +297,148 @@ void BezierTest::subdivideCubic() {
     CORRADE_COMPARE(right, (CubicBezier2D{Vector2{7.10938f, 6.57812f}, Vector2{13.4375f, 8.6875f}, Vector2{16.25f, -2.0f}, Vector2{5.0f, -20.0f}}));
 }
 
+void BezierTest::valuesBatch() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    /* More than one block to test the remainder handling */
+    Float t[37];
+    for(std::size_t i = 0; i != 37; ++i) t[i] = Float(i)/36.0f;
+
+    Vector2 values[37];
+    bezier.values(t, values);
+    for(std::size_t i = 0; i != 37; ++i)
+        CORRADE_COMPARE(values[i], bezier.value(t[i]));
+}
+
+void BezierTest::valuesBatchCurves() {
+    const CubicBezier2D curves[]{
+        {Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}},
+        {Vector2{1.0f, 2.0f}, Vector2{-1.5f, 0.3f}, Vector2{2.1f, 0.5f}, Vector2{0.0f, 2.0f}},
+        {Vector2{3.0f, 1.0f}, Vector2{4.0f, 1.0f}, Vector2{5.0f, 1.0f}, Vector2{6.0f, 1.0f}}};
+    const Float t[]{0.2f, 0.5f, 0.75f};
+
+    Vector2 values[3];
+    CubicBezier2D::values(curves, t, values);
+    CORRADE_COMPARE(values[0], (Vector2{5.8f, 5.984f}));
+    CORRADE_COMPARE(values[1], curves[1].value(0.5f));
+    CORRADE_COMPARE(values[2], (Vector2{5.25f, 1.0f}));
+}
+
+void BezierTest::flattenLinear() {
+    LinearBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{20.0f, 4.0f}};
+
+    CORRADE_COMPARE(bezier.flattened(0.01f), (std::vector<Math::Vector<2, Float>>{
+        Vector2{0.0f, 0.0f}, Vector2{20.0f, 4.0f}}));
+}
+
+void BezierTest::flattenCubic() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    const std::vector<Math::Vector<2, Float>> coarse = bezier.flattened(1.0f);
+    const std::vector<Math::Vector<2, Float>> fine = bezier.flattened(0.01f);
+    CORRADE_COMPARE(coarse.front(), bezier[0]);
+    CORRADE_COMPARE(coarse.back(), bezier[3]);
+    CORRADE_COMPARE(fine.front(), bezier[0]);
+    CORRADE_COMPARE(fine.back(), bezier[3]);
+    CORRADE_VERIFY(coarse.size() > 2);
+    CORRADE_VERIFY(fine.size() > coarse.size());
+
+    /* All points lie on the curve and no densely sampled point of the curve
+       is farther from the polyline than the tolerance */
+    for(std::size_t i = 0; i <= 100; ++i) {
+        const Vector2 point = bezier.value(Float(i)/100.0f);
+        Float minDistance = Constants<Float>::inf();
+        for(std::size_t j = 1; j != coarse.size(); ++j) {
+            const Vector2 segment{coarse[j] - coarse[j - 1]};
+            const Float s = Math::clamp(Math::dot(point - coarse[j - 1], segment)/segment.dot(), 0.0f, 1.0f);
+            minDistance = Math::min(minDistance, (point - coarse[j - 1] - segment*s).length());
+        }
+        CORRADE_VERIFY(minDistance <= 1.0f);
+    }
+
+    /* Appending to an existing array skips the first point */
+    std::vector<Math::Vector<2, Float>> points{Vector2{-1.0f}};
+    bezier.flatten(1.0f, points);
+    CORRADE_COMPARE(points.size(), coarse.size());
+    CORRADE_COMPARE(points[0], Vector2{-1.0f});
+    CORRADE_COMPARE(points[1], coarse[1]);
+}
+
+void BezierTest::flattenDegenerate() {
+    /* All control points the same, should not subdivide at all */
+    CubicBezier2D bezier{Vector2{1.0f}, Vector2{1.0f}, Vector2{1.0f}, Vector2{1.0f}};
+    CORRADE_COMPARE(bezier.flattened(0.1f), (std::vector<Math::Vector<2, Float>>{Vector2{1.0f}, Vector2{1.0f}}));
+
+    /* Loop with coinciding end points, has to be subdivided */
+    CubicBezier2D loop{Vector2{0.0f}, Vector2{10.0f, 0.0f}, Vector2{10.0f, 10.0f}, Vector2{0.0f}};
+    CORRADE_VERIFY(loop.flattened(0.1f).size() > 4);
+}
+
+void BezierTest::arcLengthTable() {
+    /* Straight line with unevenly distributed control points */
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{1.0f, 0.0f}, Vector2{2.0f, 0.0f}, Vector2{10.0f, 0.0f}};
+
+    Float table[33];
+    bezier.arcLengthTable(table);
+    CORRADE_COMPARE(table[0], 0.0f);
+    CORRADE_COMPARE(table[32], 10.0f);
+    for(std::size_t i = 1; i != 33; ++i) {
+        CORRADE_VERIFY(table[i] > table[i - 1]);
+        CORRADE_COMPARE(table[i], bezier.value(Float(i)/32.0f)[0]);
+    }
+}
+
+void BezierTest::parameterForArcLength() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{1.0f, 0.0f}, Vector2{2.0f, 0.0f}, Vector2{10.0f, 0.0f}};
+
+    Float table[257];
+    bezier.arcLengthTable(table);
+
+    /* Clamped to the range */
+    CORRADE_COMPARE(CubicBezier2D::parameterForArcLength(table, -1.0f), 0.0f);
+    CORRADE_COMPARE(CubicBezier2D::parameterForArcLength(table, 0.0f), 0.0f);
+    CORRADE_COMPARE(CubicBezier2D::parameterForArcLength(table, 10.0f), 1.0f);
+    CORRADE_COMPARE(CubicBezier2D::parameterForArcLength(table, 15.0f), 1.0f);
+
+    /* Constant-speed traversal */
+    for(Float length: {0.5f, 2.5f, 5.0f, 7.5f, 9.9f}) {
+        const Float t = CubicBezier2D::parameterForArcLength(table, length);
+        CORRADE_VERIFY(Math::abs(bezier.value(t)[0] - length) < 0.01f);
+    }
+
+    /* Entry in the table */
+    CORRADE_COMPARE(CubicBezier2D::parameterForArcLength(table, table[64]), 0.25f);
+}
+
+void BezierTest::valueCubic1k() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    Vector2 out;
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            out += bezier.value(Float(i)/1000.0f);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out != Vector2{});
+}
+
+void BezierTest::valuesCubic1k() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    Float t[1000];
+    for(std::size_t i = 0; i != 1000; ++i) t[i] = Float(i)/1000.0f;
+
+    Vector2 values[1000];
+    Vector2 out;
+    CORRADE_BENCHMARK(100) {
+        bezier.values(t, values);
+        out += values[999];
+    }
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out != Vector2{});
+}
+
 void BezierTest::debug() {
     std::ostringstream out;
     Debug(&out) << CubicBezier2D{Vector2{0.0f, 1.0f}, Vector2{1.5f, -0.3f}, Vector2{2.1f, 0.5f}, Vector2{0.0f, 2.0f}};
@@ -0,0 +1,215 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/InterpolationBatch.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct InterpolationBatchTest: Corrade::TestSuite::Tester {
+    explicit InterpolationBatchTest();
+
+    void lerp();
+    void lerpShortestPath();
+    void lerpDouble();
+    void slerp();
+    void slerpShortestPath();
+    void slerpDegenerate();
+    void sclerp();
+    void sizeMismatch();
+
+    void lerp1k();
+    void lerp1kBatch();
+    void slerp1k();
+    void slerp1kBatch();
+
+    private:
+        /* More than one block to test the remainder handling */
+        Quaternion<Float> _a[1000], _b[1000];
+        Float _t[1000];
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::Quaternion<Double> Quaterniond;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+typedef Math::Vector3<Float> Vector3;
+
+InterpolationBatchTest::InterpolationBatchTest() {
+    addTests({&InterpolationBatchTest::lerp,
+              &InterpolationBatchTest::lerpShortestPath,
+              &InterpolationBatchTest::lerpDouble,
+              &InterpolationBatchTest::slerp,
+              &InterpolationBatchTest::slerpShortestPath,
+              &InterpolationBatchTest::slerpDegenerate,
+              &InterpolationBatchTest::sclerp,
+              &InterpolationBatchTest::sizeMismatch});
+
+    addBenchmarks({&InterpolationBatchTest::lerp1k,
+                   &InterpolationBatchTest::lerp1kBatch,
+                   &InterpolationBatchTest::slerp1k,
+                   &InterpolationBatchTest::slerp1kBatch}, 100);
+
+    /* Rotations around various axes, every other pair with a negative dot
+       product */
+    for(std::size_t i = 0; i != 1000; ++i) {
+        const Vector3 axis = Vector3{Float(i%7) + 1.0f, Float(i%3) - 1.0f, Float(i%5)}.normalized();
+        _a[i] = Quaternion::rotation(Deg(Float(i%360)), axis);
+        _b[i] = Quaternion::rotation(Deg(Float(i%90) + 15.0f), axis.normalized())*(i%2 ? -1.0f : 1.0f);
+        _t[i] = Float(i%101)/100.0f;
+    }
+}
+
+using namespace Literals;
+
+void InterpolationBatchTest::lerp() {
+    Quaternion out[1000];
+    Math::lerp(_a, _b, _t, out);
+    for(std::size_t i = 0; i != 1000; ++i)
+        CORRADE_COMPARE(out[i], Math::lerp(_a[i], _b[i], _t[i]));
+}
+
+void InterpolationBatchTest::lerpShortestPath() {
+    Quaternion out[1000];
+    Math::lerpShortestPath(_a, _b, _t, out);
+    for(std::size_t i = 0; i != 1000; ++i)
+        CORRADE_COMPARE(out[i], Math::lerpShortestPath(_a[i], _b[i], _t[i]));
+}
+
+void InterpolationBatchTest::lerpDouble() {
+    const Quaterniond a[]{
+        Quaterniond::rotation(15.0_deg, Math::Vector3<Double>::xAxis()),
+        Quaterniond::rotation(-35.0_deg, Math::Vector3<Double>::yAxis())};
+    const Quaterniond b[]{
+        Quaterniond::rotation(75.0_deg, Math::Vector3<Double>::xAxis()),
+        Quaterniond::rotation(135.0_deg, Math::Vector3<Double>::zAxis())};
+    const Double t[]{0.25, 0.75};
+
+    Quaterniond out[2];
+    Math::lerp(a, b, t, out);
+    CORRADE_COMPARE(out[0], Math::lerp(a[0], b[0], 0.25));
+    CORRADE_COMPARE(out[1], Math::lerp(a[1], b[1], 0.75));
+}
+
+void InterpolationBatchTest::slerp() {
+    Quaternion out[1000];
+    Math::slerp(_a, _b, _t, out);
+    for(std::size_t i = 0; i != 1000; ++i)
+        CORRADE_COMPARE(out[i], Math::slerp(_a[i], _b[i], _t[i]));
+}
+
+void InterpolationBatchTest::slerpShortestPath() {
+    Quaternion out[1000];
+    Math::slerpShortestPath(_a, _b, _t, out);
+    for(std::size_t i = 0; i != 1000; ++i)
+        CORRADE_COMPARE(out[i], Math::slerpShortestPath(_a[i], _b[i], _t[i]));
+}
+
+void InterpolationBatchTest::slerpDegenerate() {
+    const Quaternion a = Quaternion::rotation(Deg(15.0f), Vector3::xAxis());
+    const Quaternion in[]{a, a, a};
+    const Quaternion b[]{a, -a, a};
+    const Float t[]{0.25f, 0.42f, 1.0f};
+
+    /* Avoid division by zero, same as the scalar variant */
+    Quaternion out[3];
+    Math::slerp(in, b, t, out);
+    CORRADE_COMPARE(out[0], a);
+    CORRADE_COMPARE(out[1], a);
+    CORRADE_COMPARE(out[2], a);
+}
+
+void InterpolationBatchTest::sclerp() {
+    DualQuaternion a[100], b[100], out[100];
+    Float t[100];
+    for(std::size_t i = 0; i != 100; ++i) {
+        a[i] = DualQuaternion::translation(Vector3{Float(i), 1.0f, 2.0f})*DualQuaternion::rotation(Deg(Float(i)), Vector3::xAxis());
+        b[i] = DualQuaternion::rotation(Deg(Float(i*3)), Vector3::yAxis())*DualQuaternion::translation(Vector3{3.0f, -Float(i), 0.5f});
+        if(i%2) b[i] = -b[i];
+        t[i] = Float(i)/99.0f;
+    }
+
+    Math::sclerp(a, b, t, out);
+    for(std::size_t i = 0; i != 100; ++i)
+        CORRADE_COMPARE(out[i], Math::sclerp(a[i], b[i], t[i]));
+}
+
+void InterpolationBatchTest::sizeMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Quaternion result[3];
+    Math::lerp(Corrade::Containers::arrayView(_a, 3), Corrade::Containers::arrayView(_b, 2), Corrade::Containers::arrayView(_t, 3), result);
+    Math::slerp(Corrade::Containers::arrayView(_a, 3), Corrade::Containers::arrayView(_b, 3), Corrade::Containers::arrayView(_t, 4), result);
+    CORRADE_COMPARE(out.str(),
+        "Math::lerp(): expected 3 items in all views but got 3, 2 and 3\n"
+        "Math::slerp(): expected 3 items in all views but got 3, 3 and 4\n");
+}
+
+void InterpolationBatchTest::lerp1k() {
+    Quaternion out[1000];
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            out[i] = Math::lerp(_a[i], _b[i], _t[i]);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out[999] != Quaternion{});
+}
+
+void InterpolationBatchTest::lerp1kBatch() {
+    Quaternion out[1000];
+    CORRADE_BENCHMARK(100)
+        Math::lerp(_a, _b, _t, out);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out[999] != Quaternion{});
+}
+
+void InterpolationBatchTest::slerp1k() {
+    Quaternion out[1000];
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            out[i] = Math::slerp(_a[i], _b[i], _t[i]);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out[999] != Quaternion{});
+}
+
+void InterpolationBatchTest::slerp1kBatch() {
+    Quaternion out[1000];
+    CORRADE_BENCHMARK(100)
+        Math::slerp(_a, _b, _t, out);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out[999] != Quaternion{});
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::InterpolationBatchTest)
@@ -0,0 +1,330 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <tuple>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/MatrixBatch.h"
+#include "Magnum/Math/Algorithms/GaussJordan.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct MatrixBatchTest: Corrade::TestSuite::Tester {
+    explicit MatrixBatchTest();
+
+    void inverted3();
+    void inverted4();
+    void invertedDouble();
+    void invertedRigid2D();
+    void invertedRigid3D();
+    void normalMatrix();
+    void polarDecomposition();
+    void polarDecompositionNoScalings();
+    void polarDecompositionNegativeDeterminant();
+    void polarDecompositionDouble();
+    void sizeMismatch();
+
+    void inverted4x4_1k();
+    void inverted4x4GaussJordan1k();
+    void inverted4x4_1kBatch();
+    void invertedRigid1k();
+    void invertedRigid1kBatch();
+    void rotationSvd1k();
+    void rotationPolarDecomposition1kBatch();
+
+    private:
+        /* More than one block to test the remainder handling */
+        Matrix4<Float> _rigid[1000], _general[1000];
+        Matrix3x3<Float> _rotations[1000], _stretches[1000];
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix3<Float> Matrix3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Matrix3x3<Float> Matrix3x3;
+typedef Math::Matrix4x4<Float> Matrix4x4;
+
+MatrixBatchTest::MatrixBatchTest() {
+    addTests({&MatrixBatchTest::inverted3,
+              &MatrixBatchTest::inverted4,
+              &MatrixBatchTest::invertedDouble,
+              &MatrixBatchTest::invertedRigid2D,
+              &MatrixBatchTest::invertedRigid3D,
+              &MatrixBatchTest::normalMatrix,
+              &MatrixBatchTest::polarDecomposition,
+              &MatrixBatchTest::polarDecompositionNoScalings,
+              &MatrixBatchTest::polarDecompositionNegativeDeterminant,
+              &MatrixBatchTest::polarDecompositionDouble,
+              &MatrixBatchTest::sizeMismatch});
+
+    addBenchmarks({&MatrixBatchTest::inverted4x4_1k,
+                   &MatrixBatchTest::inverted4x4GaussJordan1k,
+                   &MatrixBatchTest::inverted4x4_1kBatch,
+                   &MatrixBatchTest::invertedRigid1k,
+                   &MatrixBatchTest::invertedRigid1kBatch,
+                   &MatrixBatchTest::rotationSvd1k,
+                   &MatrixBatchTest::rotationPolarDecomposition1kBatch}, 100);
+
+    /* Rotations around various axes, combined with translation, non-uniform
+       scaling and shear for the general case */
+    for(std::size_t i = 0; i != 1000; ++i) {
+        const Vector3 axis = Vector3{Float(i%7) + 1.0f, Float(i%3) - 1.0f, Float(i%5) + 0.5f}.normalized();
+        const Matrix4 rotation = Matrix4::rotation(Deg(Float(i)*3.7f), axis);
+        const Vector3 scaling{1.0f + Float(i%4)*0.5f, 2.0f - Float(i%3)*0.5f, 0.75f + Float(i%5)*0.25f};
+
+        _rigid[i] = Matrix4::translation({Float(i)*0.01f, -1.0f, 2.0f})*rotation;
+        _general[i] = _rigid[i]*Matrix4::scaling(scaling)*Matrix4::shearingXY(0.3f, -0.2f);
+
+        /* Stretch is a symmetric positive definite matrix, i.e. a scaling
+           along some rotated axes */
+        const Matrix3x3 frame = Matrix4::rotationZ(Deg(Float(i)*11.0f)).rotationScaling();
+        _rotations[i] = rotation.rotationScaling();
+        _stretches[i] = frame*Matrix3x3::fromDiagonal(scaling)*frame.transposed();
+    }
+}
+
+void MatrixBatchTest::inverted3() {
+    Matrix3x3 matrices[1000];
+    for(std::size_t i = 0; i != 1000; ++i)
+        matrices[i] = _general[i].rotationScaling();
+
+    Matrix3x3 out[1000];
+    Math::inverted(matrices, out);
+
+    for(std::size_t i = 0; i != 1000; ++i)
+        CORRADE_COMPARE(out[i], matrices[i].inverted());
+}
+
+void MatrixBatchTest::inverted4() {
+    Matrix4x4 matrices[1000];
+    for(std::size_t i = 0; i != 1000; ++i)
+        matrices[i] = _general[i];
+
+    Matrix4x4 out[1000];
+    Math::inverted(matrices, out);
+
+    for(std::size_t i = 0; i != 1000; ++i)
+        CORRADE_COMPARE(out[i], matrices[i].inverted());
+}
+
+void MatrixBatchTest::invertedDouble() {
+    const Math::Matrix4x4<Double> matrices[]{
+        Math::Matrix4<Double>::translation({1.0, 2.0, 3.0})*
+        Math::Matrix4<Double>::rotationX(Math::Deg<Double>(35.0))*
+        Math::Matrix4<Double>::scaling({2.0, 0.5, 3.0})
+    };
+
+    Math::Matrix4x4<Double> out[1];
+    Math::inverted(matrices, out);
+    CORRADE_COMPARE(out[0], matrices[0].inverted());
+    CORRADE_COMPARE(out[0]*matrices[0], (Math::Matrix4x4<Double>{IdentityInit}));
+}
+
+void MatrixBatchTest::invertedRigid2D() {
+    Matrix3 matrices[37];
+    for(std::size_t i = 0; i != 37; ++i)
+        matrices[i] = Matrix3::translation({Float(i), -2.0f})*Matrix3::rotation(Deg(Float(i)*10.0f));
+
+    Matrix3 out[37];
+    Math::invertedRigid(matrices, out);
+
+    for(std::size_t i = 0; i != 37; ++i)
+        CORRADE_COMPARE(out[i], matrices[i].invertedRigid());
+}
+
+void MatrixBatchTest::invertedRigid3D() {
+    Matrix4 out[1000];
+    Math::invertedRigid(_rigid, out);
+
+    for(std::size_t i = 0; i != 1000; ++i)
+        CORRADE_COMPARE(out[i], _rigid[i].invertedRigid());
+}
+
+void MatrixBatchTest::normalMatrix() {
+    Matrix3x3 out[1000];
+    Math::normalMatrix(_general, out);
+
+    for(std::size_t i = 0; i != 1000; ++i)
+        CORRADE_COMPARE(out[i], _general[i].rotationScaling().inverted().transposed());
+
+    /* For a rigid transformation it's just the rotation */
+    Math::normalMatrix(_rigid, out);
+    for(std::size_t i = 0; i != 1000; ++i)
+        CORRADE_COMPARE(out[i], _rotations[i]);
+}
+
+void MatrixBatchTest::polarDecomposition() {
+    Matrix3x3 matrices[1000];
+    for(std::size_t i = 0; i != 1000; ++i)
+        matrices[i] = _rotations[i]*_stretches[i];
+
+    Matrix3x3 rotations[1000], scalings[1000];
+    Math::polarDecomposition(matrices, rotations, scalings);
+
+    for(std::size_t i = 0; i != 1000; ++i) {
+        CORRADE_COMPARE(rotations[i], _rotations[i]);
+        CORRADE_COMPARE(scalings[i], _stretches[i]);
+    }
+}
+
+void MatrixBatchTest::polarDecompositionNoScalings() {
+    const Matrix3x3 matrices[]{_rotations[5]*_stretches[7]};
+
+    Matrix3x3 rotations[1];
+    Math::polarDecomposition(matrices, rotations);
+    CORRADE_COMPARE(rotations[0], _rotations[5]);
+
+    /* Compare with the result of SVD as well */
+    Matrix3x3 u{NoInit}, v{NoInit};
+    Vector3 w{NoInit};
+    std::tie(u, w, v) = Algorithms::svd(matrices[0]);
+    CORRADE_COMPARE(rotations[0], u*v.transposed());
+}
+
+void MatrixBatchTest::polarDecompositionNegativeDeterminant() {
+    const Matrix3x3 matrices[]{_rotations[3]*Matrix3x3::fromDiagonal({-2.0f, 1.0f, 0.5f})};
+
+    Matrix3x3 rotations[1], scalings[1];
+    Math::polarDecomposition(matrices, rotations, scalings);
+    CORRADE_COMPARE(rotations[0].determinant(), -1.0f);
+    CORRADE_VERIFY(rotations[0].isOrthogonal());
+    CORRADE_COMPARE(rotations[0]*scalings[0], matrices[0]);
+}
+
+void MatrixBatchTest::polarDecompositionDouble() {
+    const Math::Matrix3x3<Double> rotation = Math::Matrix4<Double>::rotationY(Math::Deg<Double>(73.0)).rotationScaling();
+    const Math::Matrix3x3<Double> matrices[]{
+        rotation*Math::Matrix3x3<Double>::fromDiagonal({3.0, 0.1, 1.5})
+    };
+
+    Math::Matrix3x3<Double> rotations[1];
+    Math::polarDecomposition(matrices, rotations);
+    CORRADE_COMPARE(rotations[0], rotation);
+}
+
+void MatrixBatchTest::sizeMismatch() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Matrix3x3 result[3];
+    Matrix4 result4[3];
+    Math::inverted(Corrade::Containers::arrayView(_rotations, 2), result);
+    Math::invertedRigid(Corrade::Containers::arrayView(_rigid, 4), result4);
+    Math::normalMatrix(Corrade::Containers::arrayView(_rigid, 2), result);
+    Math::polarDecomposition(Corrade::Containers::arrayView(_rotations, 3), result, Corrade::Containers::arrayView(_stretches, 2));
+    CORRADE_COMPARE(out.str(),
+        "Math::inverted(): expected 3 items in both views but got 2\n"
+        "Math::invertedRigid(): expected 3 items in both views but got 4\n"
+        "Math::normalMatrix(): expected 3 items in both views but got 2\n"
+        "Math::polarDecomposition(): expected 3 items in all views but got 3 and 2\n");
+}
+
+void MatrixBatchTest::inverted4x4_1k() {
+    Matrix4 out[1000];
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            out[i] = _general[i].inverted();
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out[999] != Matrix4{});
+}
+
+void MatrixBatchTest::inverted4x4GaussJordan1k() {
+    Matrix4x4 out[1000];
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            out[i] = Algorithms::gaussJordanInverted(Matrix4x4{_general[i]});
+
+    CORRADE_VERIFY(out[999] != Matrix4x4{});
+}
+
+void MatrixBatchTest::inverted4x4_1kBatch() {
+    Matrix4x4 matrices[1000];
+    for(std::size_t i = 0; i != 1000; ++i)
+        matrices[i] = _general[i];
+
+    Matrix4x4 out[1000];
+    CORRADE_BENCHMARK(100)
+        Math::inverted(matrices, out);
+
+    CORRADE_VERIFY(out[999] != Matrix4x4{});
+}
+
+void MatrixBatchTest::invertedRigid1k() {
+    Matrix4 out[1000];
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            out[i] = _rigid[i].invertedRigid();
+
+    CORRADE_VERIFY(out[999] != Matrix4{});
+}
+
+void MatrixBatchTest::invertedRigid1kBatch() {
+    Matrix4 out[1000];
+    CORRADE_BENCHMARK(100)
+        Math::invertedRigid(_rigid, out);
+
+    CORRADE_VERIFY(out[999] != Matrix4{});
+}
+
+void MatrixBatchTest::rotationSvd1k() {
+    Matrix3x3 matrices[1000];
+    for(std::size_t i = 0; i != 1000; ++i)
+        matrices[i] = _rotations[i]*_stretches[i];
+
+    Matrix3x3 out[1000];
+    CORRADE_BENCHMARK(100) {
+        for(std::size_t i = 0; i != 1000; ++i) {
+            Matrix3x3 u{NoInit}, v{NoInit};
+            Vector3 w{NoInit};
+            std::tie(u, w, v) = Algorithms::svd(matrices[i]);
+            out[i] = u*v.transposed();
+        }
+    }
+
+    CORRADE_VERIFY(out[999] != Matrix3x3{});
+}
+
+void MatrixBatchTest::rotationPolarDecomposition1kBatch() {
+    Matrix3x3 matrices[1000];
+    for(std::size_t i = 0; i != 1000; ++i)
+        matrices[i] = _rotations[i]*_stretches[i];
+
+    Matrix3x3 out[1000];
+    CORRADE_BENCHMARK(100)
+        Math::polarDecomposition(matrices, out);
+
+    CORRADE_VERIFY(out[999] != Matrix3x3{});
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::MatrixBatchTest)
@@ -87,7 +87,9 @@ struct QuaternionTest: Corrade::TestSuite::Tester {
     void angle();
     void matrix();
     void lerp();
+    void lerpShortestPath();
     void slerp();
+    void slerpShortestPath();
     void transformVector();
     void transformVectorNormalized();
 
@@ -139,7 +141,9 @@ QuaternionTest::QuaternionTest() {
               &QuaternionTest::angle,
               &QuaternionTest::matrix,
               &QuaternionTest::lerp,
+              &QuaternionTest::lerpShortestPath,
               &QuaternionTest::slerp,
+              &QuaternionTest::slerpShortestPath,
               &QuaternionTest::transformVector,
               &QuaternionTest::transformVectorNormalized,
 
@@ -480,6 +484,23 @@ void QuaternionTest::lerp() {
 #pragma GCC pop_options
 #endif
 
+void QuaternionTest::lerpShortestPath() {
+    Quaternion a = Quaternion::rotation(Deg(15.0f), Vector3(1.0f/Constants<Float>::sqrt3()));
+    Quaternion b = Quaternion::rotation(Deg(23.0f), Vector3::xAxis());
+
+    std::ostringstream o;
+    Error redirectError{&o};
+
+    Math::lerpShortestPath(a*3.0f, b, 0.35f);
+    CORRADE_COMPARE(o.str(), "Math::lerpShortestPath(): quaternions must be normalized\n");
+
+    /* Same as lerp() if the dot product is positive, otherwise the second
+       quaternion gets negated */
+    CORRADE_COMPARE(Math::lerpShortestPath(a, b, 0.35f), Math::lerp(a, b, 0.35f));
+    CORRADE_COMPARE(Math::lerpShortestPath(a, -b, 0.35f), Math::lerp(a, b, 0.35f));
+    CORRADE_VERIFY(Math::lerp(a, -b, 0.35f) != Math::lerp(a, b, 0.35f));
+}
+
 void QuaternionTest::slerp() {
     Quaternion a = Quaternion::rotation(Deg(15.0f), Vector3(1.0f/Constants<Float>::sqrt3()));
     Quaternion b = Quaternion::rotation(Deg(23.0f), Vector3::xAxis());
@@ -502,6 +523,27 @@ void QuaternionTest::slerp() {
     CORRADE_COMPARE(Math::slerp(a, -a, 0.42f), a);
 }
 
+void QuaternionTest::slerpShortestPath() {
+    Quaternion a = Quaternion::rotation(Deg(15.0f), Vector3(1.0f/Constants<Float>::sqrt3()));
+    Quaternion b = Quaternion::rotation(Deg(23.0f), Vector3::xAxis());
+
+    std::ostringstream o;
+    Error redirectError{&o};
+
+    Math::slerpShortestPath(a, b*-3.0f, 0.35f);
+    CORRADE_COMPARE(o.str(), "Math::slerpShortestPath(): quaternions must be normalized\n");
+
+    /* Same as slerp() if the dot product is positive, otherwise the second
+       quaternion gets negated */
+    CORRADE_COMPARE(Math::slerpShortestPath(a, b, 0.35f), Math::slerp(a, b, 0.35f));
+    CORRADE_COMPARE(Math::slerpShortestPath(a, -b, 0.35f), Math::slerp(a, b, 0.35f));
+    CORRADE_VERIFY(Math::slerp(a, -b, 0.35f) != Math::slerp(a, b, 0.35f));
+
+    /* Avoid division by zero */
+    CORRADE_COMPARE(Math::slerpShortestPath(a, a, 0.25f), a);
+    CORRADE_COMPARE(Math::slerpShortestPath(a, -a, 0.42f), a);
+}
+
 void QuaternionTest::transformVector() {
     Quaternion a = Quaternion::rotation(Deg(23.0f), Vector3::xAxis());
     Matrix4 m = Matrix4::rotationX(Deg(23.0f));
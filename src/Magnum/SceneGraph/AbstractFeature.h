@@ -119,6 +119,12 @@ class CachingFeature: public SceneGraph::AbstractFeature3D {
 Before using the cached value explicitly request object cleaning by calling
 `object()->setClean()`.
 
+If @ref clean() and @ref cleanInverted() touch only state of the feature
+itself, the feature can be marked as thread-safe using
+@ref setCleanThreadSafe(). Cleaning of such features can be then distributed
+across multiple threads using @ref Scene::beginClean() and
+@ref Scene::cleanChunk().
+
 ### Accessing object transformation
 
 The feature has by default only access to @ref AbstractObject, which doesn't
@@ -153,12 +159,13 @@ errors. See also @ref compilation-speedup-hpp for more information.
 */
 template<UnsignedInt dimensions, class T> class AbstractFeature
     #ifndef DOXYGEN_GENERATING_OUTPUT
-    : private Containers::LinkedListItem<AbstractFeature<dimensions, T>, AbstractObject<dimensions, T>>
+    : private Containers::LinkedListItem<AbstractFeature<dimensions, T>, AbstractObject<dimensions, T>>, public Implementation::ObjectPoolAllocated
     #endif
 {
     friend Containers::LinkedList<AbstractFeature<dimensions, T>>;
     friend Containers::LinkedListItem<AbstractFeature<dimensions, T>, AbstractObject<dimensions, T>>;
     template<class> friend class Object;
+    template<class> friend class Scene;
 
     public:
         /**
@@ -222,6 +229,13 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
             return _cachedTransformations;
         }
 
+        /**
+         * @brief Whether the cleaning is thread-safe
+         *
+         * @see @ref setCleanThreadSafe()
+         */
+        bool isCleanThreadSafe() const { return _cleanThreadSafe; }
+
     protected:
         /**
          * @brief Set transformations to be cached
@@ -237,6 +251,20 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
             _cachedTransformations = transformations;
         }
 
+        /**
+         * @brief Mark the cleaning as thread-safe
+         *
+         * If set to `true`, @ref clean() and @ref cleanInverted() can be
+         * called from other threads than the one calling
+         * @ref Scene::beginClean(), concurrently with cleaning of other
+         * features. Set it only if the implementations don't touch any state
+         * shared with other features or objects. Default is `false`.
+         * @see @ref scenegraph-features-caching
+         */
+        void setCleanThreadSafe(bool threadSafe) {
+            _cleanThreadSafe = threadSafe;
+        }
+
         /**
          * @brief Mark feature as dirty
          *
@@ -278,6 +306,7 @@ template<UnsignedInt dimensions, class T> class AbstractFeature
 
     private:
         CachedTransformations _cachedTransformations;
+        bool _cleanThreadSafe{};
 };
 
 /**
@@ -31,9 +31,11 @@
 
 #include <functional>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/LinkedList.h>
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/ObjectPool.h"
 #include "Magnum/SceneGraph/SceneGraph.h"
 #include "Magnum/SceneGraph/visibility.h"
 
@@ -68,6 +70,9 @@ for(AbstractFeature3D* feature = object.features().first(); feature; feature = f
 }
 @endcode
 
+Objects and features can be allocated from an @ref ObjectPool instead of the
+heap to make creation, destruction and traversal of large scenes faster.
+
 @anchor SceneGraph-AbstractObject-explicit-specializations
 ## Explicit template specializations
 
@@ -86,7 +91,7 @@ class documentation or @ref compilation-speedup-hpp for more information.
 */
 template<UnsignedInt dimensions, class T> class AbstractObject
     #ifndef DOXYGEN_GENERATING_OUTPUT
-    : private Containers::LinkedList<AbstractFeature<dimensions, T>>
+    : private Containers::LinkedList<AbstractFeature<dimensions, T>>, public Implementation::ObjectPoolAllocated
     #endif
 {
     friend Containers::LinkedList<AbstractFeature<dimensions, T>>;
@@ -210,6 +215,21 @@ template<UnsignedInt dimensions, class T> class AbstractObject
             return doTransformationMatrices(objects, initialTransformationMatrix);
         }
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object
+         *
+         * Same as above, but puts the result into @p out, which is expected
+         * to have the same size as @p objects. The temporary storage is
+         * reused between calls, so in a steady state this function doesn't
+         * allocate.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::transformationMatrices()
+         *      when possible.
+         */
+        void transformationMatrices(Containers::ArrayView<const std::reference_wrapper<AbstractObject<dimensions, T>>> objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix = MatrixType()) const {
+            doTransformationMatrices(objects, out, initialTransformationMatrix);
+        }
+
         /*@}*/
 
         /**
@@ -231,6 +251,34 @@ template<UnsignedInt dimensions, class T> class AbstractObject
             objects.front().get().doSetClean(objects);
         }
 
+        /**
+         * @brief Begin cleaning given set of objects
+         * @return Count of chunks to execute with @ref cleanChunk() on the
+         *      scene
+         *
+         * Same as @ref Scene::beginClean(), usable when the concrete
+         * @ref Object type is not known. Expects that all dirty objects are
+         * part of the same scene. The returned chunks are executed by calling
+         * @ref cleanChunk() on that scene. Returns `0` if there are no dirty
+         * objects.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Scene::beginClean() when
+         *      possible.
+         */
+        static std::size_t beginClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) {
+            if(objects.empty()) return 0;
+            return objects.front().get().doBeginClean(objects);
+        }
+
+        /**
+         * @brief Clean given chunk of thread-safe features
+         *
+         * Same as @ref Scene::cleanChunk(), usable when the concrete
+         * @ref Object type is not known. Expects that the object is a scene.
+         * @see @ref beginClean(), @ref scene()
+         */
+        void cleanChunk(std::size_t chunk) { doCleanChunk(chunk); }
+
         /**
          * @brief Whether absolute transformation is dirty
          *
@@ -281,11 +329,14 @@ template<UnsignedInt dimensions, class T> class AbstractObject
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
         virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix) const = 0;
+        virtual void doTransformationMatrices(Containers::ArrayView<const std::reference_wrapper<AbstractObject<dimensions, T>>> objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix) const = 0;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
         virtual void doSetClean() = 0;
         virtual void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) = 0;
+        virtual std::size_t doBeginClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) = 0;
+        virtual void doCleanChunk(std::size_t chunk) = 0;
 };
 
 /**
@@ -131,6 +131,17 @@ just puts itself to rest and waits until some animation changes its state to
 pernamently running into separate group, they will not be traversed every time
 the @ref AnimableGroup::step() gets called, saving precious frame time.
 
+## Stepping animations in parallel
+
+If @ref animationStep() of an animation doesn't touch any state shared with
+other animations, it can be marked as thread-safe using @ref setThreadSafe().
+Steps of such animables can be then executed on multiple threads using
+@ref AnimableGroup::beginStep() and @ref AnimableGroup::stepChunk(), see
+their documentation for more information. State transitions and the
+@ref animationStarted(), @ref animationPaused(), @ref animationResumed() and
+@ref animationStopped() callbacks are always executed on the calling thread
+in a deterministic order.
+
 ## Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -207,6 +218,13 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
          */
         UnsignedShort repeatCount() const { return _repeatCount; }
 
+        /**
+         * @brief Whether the animation step is thread-safe
+         *
+         * @see @ref setThreadSafe(), @ref AnimableGroup::beginStep()
+         */
+        bool isThreadSafe() const { return _threadSafe; }
+
         /**
          * @brief Set repeat count
          * @return Reference to self (for method chaining)
@@ -242,6 +260,24 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
             return *this;
         }
 
+        /**
+         * @brief Mark the animation step as thread-safe
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, @ref animationStep() may be called from other than the
+         * calling thread of @ref AnimableGroup::beginStep(), concurrently
+         * with steps of other animables in the group. It must not modify any
+         * state shared with other animables, that includes transformation
+         * of objects shared with other animables or features such as
+         * @ref Shapes::Shape that update state of their group when object
+         * transformation changes. Default is `false`.
+         */
+        /* Protected so only animation implementer can change it */
+        Animable<dimensions, T>& setThreadSafe(bool threadSafe) {
+            _threadSafe = threadSafe;
+            return *this;
+        }
+
         /**
          * @brief Perform animation step
          * @param time      Time from start of the animation
@@ -318,7 +354,7 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
         Float startTime, pauseTime;
         AnimationState previousState;
         AnimationState currentState;
-        bool _repeated;
+        bool _repeated, _threadSafe;
         UnsignedShort _repeatCount;
         UnsignedShort repeats;
 };
@@ -31,12 +31,13 @@
 
 #include "Magnum/Timeline.h"
 #include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
 #include "Magnum/SceneGraph/Animable.h"
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object, group), _duration(0.0f), startTime(Constants::inf()), pauseTime(-Constants::inf()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _repeatCount(0), repeats(0) {}
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object, group), _duration(0.0f), startTime(Constants::inf()), pauseTime(-Constants::inf()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _threadSafe(false), _repeatCount(0), repeats(0) {}
 
 template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {}
 
@@ -62,6 +63,26 @@ template<UnsignedInt dimensions, class T> const AnimableGroup<dimensions, T>* An
 }
 
 template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
+    doStep(time, delta, false);
+}
+
+template<UnsignedInt dimensions, class T> std::size_t AnimableGroup<dimensions, T>::beginStep(const Float time, const Float delta) {
+    _deferredSteps.clear();
+    _delta = delta;
+    doStep(time, delta, true);
+    return stepChunkCount();
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::stepChunk(const std::size_t chunk) {
+    CORRADE_ASSERT(chunk < stepChunkCount(),
+        "SceneGraph::AnimableGroup::stepChunk(): chunk index" << chunk << "out of range for" << stepChunkCount() << "chunks", );
+
+    const std::size_t end = Math::min((chunk + 1)*_chunkSize, _deferredSteps.size());
+    for(std::size_t i = chunk*_chunkSize; i != end; ++i)
+        _deferredSteps[i].first->animationStep(_deferredSteps[i].second, _delta);
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::doStep(const Float time, const Float delta, const bool deferThreadSafe) {
     if(!_runningCount && !wakeUp) return;
     wakeUp = false;
 
@@ -130,7 +151,11 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
             "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", );
         CORRADE_ASSERT(delta >= 0.0f,
             "SceneGraph::AnimableGroup::step(): negative delta passed", );
-        animable.animationStep(time - animable.startTime, delta);
+
+        /* Thread-safe steps are performed later in stepChunk() */
+        if(deferThreadSafe && animable._threadSafe)
+            _deferredSteps.emplace_back(&animable, time - animable.startTime);
+        else animable.animationStep(time - animable.startTime, delta);
     }
 
     CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
@@ -29,6 +29,10 @@
  * @brief Class @ref Magnum::SceneGraph::AnimableGroup, alias @ref Magnum::SceneGraph::BasicAnimableGroup2D, @ref Magnum::SceneGraph::BasicAnimableGroup3D, typedef @ref Magnum::SceneGraph::AnimableGroup2D, @ref Magnum::SceneGraph::AnimableGroup3D
  */
 
+#include <utility>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/SceneGraph/visibility.h"
 
@@ -38,6 +42,32 @@ namespace Magnum { namespace SceneGraph {
 @brief Group of animables
 
 See @ref Animable for more information.
+
+@anchor SceneGraph-AnimableGroup-parallel
+## Stepping animations in parallel
+
+Besides the serial @ref step(), the group can step animables that are marked
+as thread-safe using @ref Animable::setThreadSafe() on multiple threads. The
+step is split into two phases. @ref beginStep() is called on the main thread
+and handles all state transitions, calls the @ref Animable::animationStarted()
+"Animable::animation*()" callbacks and steps all animables that are not
+thread-safe, in the same order as @ref step() would. Steps of the thread-safe
+animables are deferred and split into chunks of @ref chunkSize() animables,
+which are then executed using @ref stepChunk() on any thread. There's no
+built-in thread pool or work-stealing scheduler, the chunks are meant to be
+fed to the job system the application already has. See
+@ref scenegraph-parallel for details and for the `runChunks()` helper used
+below:
+@code
+std::size_t chunkCount = animables.beginStep(timeline.previousFrameTime(), timeline.previousFrameDuration());
+runChunks(threadCount, chunkCount, [&](std::size_t chunk) {
+    animables.stepChunk(chunk);
+});
+@endcode
+
+All chunks have to be executed before the next call to @ref step() or
+@ref beginStep() and before the animables or the group are modified.
+
 @see @ref scenegraph, @ref BasicAnimableGroup2D, @ref BasicAnimableGroup3D,
     @ref AnimableGroup2D, @ref AnimableGroup3D
 */
@@ -48,7 +78,7 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
         /**
          * @brief Constructor
          */
-        explicit AnimableGroup(): _runningCount(0), wakeUp(false) {}
+        explicit AnimableGroup(): _runningCount(0), wakeUp(false), _chunkSize(1024), _delta(0.0f) {}
 
         /**
          * @brief Count of running animations
@@ -67,9 +97,69 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
          */
         void step(Float time, Float delta);
 
+        /**
+         * @brief Chunk size for parallel step
+         *
+         * Default is `1024`.
+         * @see @ref beginStep()
+         */
+        std::size_t chunkSize() const { return _chunkSize; }
+
+        /**
+         * @brief Set chunk size for parallel step
+         * @return Reference to self (for method chaining)
+         *
+         * Smaller chunks allow for better load balancing at the cost of
+         * higher scheduling overhead.
+         */
+        AnimableGroup<dimensions, T>& setChunkSize(std::size_t size) {
+            CORRADE_ASSERT(size, "SceneGraph::AnimableGroup::setChunkSize(): chunk size can't be zero", *this);
+            _chunkSize = size;
+            return *this;
+        }
+
+        /**
+         * @brief Begin parallel animation step
+         * @param time      Absolute time (e.g. @ref Timeline::previousFrameTime())
+         * @param delta     Time delta for current frame (e.g. @ref Timeline::previousFrameDuration())
+         * @return Count of chunks to execute with @ref stepChunk()
+         *
+         * Does the same as @ref step(), except that @ref Animable::animationStep()
+         * of animables marked with @ref Animable::setThreadSafe() is not
+         * called. These are instead split into chunks, which are then
+         * executed using @ref stepChunk(). See
+         * @ref SceneGraph-AnimableGroup-parallel "class documentation" for
+         * an example.
+         */
+        std::size_t beginStep(Float time, Float delta);
+
+        /**
+         * @brief Count of chunks to execute
+         *
+         * Count of chunks to execute after last call to @ref beginStep().
+         */
+        std::size_t stepChunkCount() const {
+            return (_deferredSteps.size() + _chunkSize - 1)/_chunkSize;
+        }
+
+        /**
+         * @brief Execute chunk of the parallel animation step
+         *
+         * Calls @ref Animable::animationStep() for all thread-safe animables
+         * in given chunk. Can be called from any thread, but each chunk
+         * only once after each @ref beginStep(). Expects that @p chunk is
+         * less than @ref stepChunkCount().
+         */
+        void stepChunk(std::size_t chunk);
+
     private:
+        void doStep(Float time, Float delta, bool deferThreadSafe);
+
         std::size_t _runningCount;
         bool wakeUp;
+        std::size_t _chunkSize;
+        Float _delta;
+        std::vector<std::pair<Animable<dimensions, T>*, Float>> _deferredSteps;
 };
 
 /**
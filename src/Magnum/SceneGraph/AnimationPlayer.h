@@ -0,0 +1,188 @@
+#ifndef Magnum_SceneGraph_AnimationPlayer_h
+#define Magnum_SceneGraph_AnimationPlayer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::AnimationPlayer
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Animation player
+
+Samples translation, rotation, scaling and dual quaternion tracks from
+@ref AnimationTracks and applies the results to transformations of
+three-dimensional objects in a batch. Example usage:
+@code
+SceneGraph::AnimationTracks<Vector3> vectors;
+SceneGraph::AnimationTracks<Quaternion> rotations;
+SceneGraph::AnimationTracks<DualQuaternion> dualQuaternions;
+// add tracks...
+
+SceneGraph::AnimationPlayer<SceneGraph::MatrixTransformation3D> player{vectors, rotations, dualQuaternions};
+player.addTranslationRotationScaling(leg, legTranslation, legRotation)
+      .addTransformation(arm, armTransformation);
+
+void MyApplication::drawEvent() {
+    player.apply(std::fmod(timeline.previousFrameTime(), vectors.duration()));
+    // ...
+}
+@endcode
+
+On each @ref apply() all tracks in the three track sets are sampled into
+contiguous arrays using @ref AnimationTracks::sample() with
+@ref SceneGraph-AnimationTracks-hints "sampling hints" kept in the player,
+then the transformations of all bound objects are calculated and set at
+once. The track sets are thus expected to contain only tracks needed by the
+player. Translation and scaling tracks are taken from the same
+@ref AnimationTracks "AnimationTracks<Vector3>" set. Memory for the sampling
+is kept in the player and reused, so after the first call no allocations are
+done.
+
+The player doesn't own the objects nor the track sets, they are expected to
+outlive it. The player can be driven from @ref Animable::animationStep() or
+directly from the application.
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations you have to use @ref AnimationPlayer.hpp
+implementation file to avoid linker errors. See also
+@ref compilation-speedup-hpp for more information.
+
+-   @ref AnimationPlayer "AnimationPlayer<DualQuaternionTransformation>"
+-   @ref AnimationPlayer "AnimationPlayer<MatrixTransformation3D>"
+-   @ref AnimationPlayer "AnimationPlayer<RigidMatrixTransformation3D>"
+
+@see @ref scenegraph
+*/
+template<class Transformation> class AnimationPlayer {
+    public:
+        enum: UnsignedInt {
+            /** Track not used */
+            NoTrack = ~UnsignedInt{}
+        };
+
+        /**
+         * @brief Constructor
+         * @param vectorTracks          Translation and scaling tracks
+         * @param rotationTracks        Rotation tracks
+         * @param dualQuaternionTracks  Dual quaternion transformation tracks
+         */
+        explicit AnimationPlayer(const AnimationTracks<Vector3>& vectorTracks, const AnimationTracks<Quaternion>& rotationTracks, const AnimationTracks<DualQuaternion>& dualQuaternionTracks);
+
+        /** @brief Copying is not allowed */
+        AnimationPlayer(const AnimationPlayer<Transformation>&) = delete;
+
+        /** @brief Moving is not allowed */
+        AnimationPlayer(AnimationPlayer<Transformation>&&) = delete;
+
+        /** @brief Copying is not allowed */
+        AnimationPlayer<Transformation>& operator=(const AnimationPlayer<Transformation>&) = delete;
+
+        /** @brief Moving is not allowed */
+        AnimationPlayer<Transformation>& operator=(AnimationPlayer<Transformation>&&) = delete;
+
+        /** @brief Whether there are no bound objects */
+        bool isEmpty() const { return _bindings.empty(); }
+
+        /** @brief Count of bound objects */
+        std::size_t size() const { return _bindings.size(); }
+
+        /**
+         * @brief Bind object to translation, rotation and scaling tracks
+         * @param object            Object
+         * @param translationTrack  Translation track ID or @ref NoTrack
+         * @param rotationTrack     Rotation track ID or @ref NoTrack
+         * @param scalingTrack      Scaling track ID or @ref NoTrack
+         * @return Reference to self (for method chaining)
+         *
+         * Missing translation and rotation are identity, missing scaling is
+         * @f$ (1, 1, 1) @f$. The object transformation is set to translation
+         * combined with rotation and scaling. Expects that the tracks exist.
+         * Scaling is not supported by rigid transformations.
+         */
+        AnimationPlayer<Transformation>& addTranslationRotationScaling(Object<Transformation>& object, UnsignedInt translationTrack, UnsignedInt rotationTrack, UnsignedInt scalingTrack = NoTrack);
+
+        /**
+         * @brief Bind object to dual quaternion track
+         * @param object            Object
+         * @param track             Dual quaternion track ID
+         * @return Reference to self (for method chaining)
+         *
+         * The object transformation is set to the sampled dual quaternion.
+         * Expects that the track exists.
+         */
+        AnimationPlayer<Transformation>& addTransformation(Object<Transformation>& object, UnsignedInt track);
+
+        /** @brief Remove all bound objects */
+        void clear() { _bindings.clear(); }
+
+        /**
+         * @brief Apply animation
+         * @param time      Animation time
+         *
+         * Samples the tracks at @p time and sets transformations of all bound
+         * objects.
+         */
+        void apply(Float time);
+
+    private:
+        struct Binding {
+            Object<Transformation>* object;
+            UnsignedInt translation, rotation, scaling, transformation;
+        };
+
+        const AnimationTracks<Vector3>& _vectorTracks;
+        const AnimationTracks<Quaternion>& _rotationTracks;
+        const AnimationTracks<DualQuaternion>& _dualQuaternionTracks;
+        std::vector<Binding> _bindings;
+
+        /* Sampling hints and results, reused between calls */
+        std::vector<UnsignedInt> _vectorHints, _rotationHints, _dualQuaternionHints;
+        std::vector<Vector3> _vectors;
+        std::vector<Quaternion> _rotations;
+        std::vector<DualQuaternion> _dualQuaternions;
+        std::vector<typename Transformation::DataType> _transformations;
+};
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT AnimationPlayer<BasicDualQuaternionTransformation<Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT AnimationPlayer<BasicMatrixTransformation3D<Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT AnimationPlayer<BasicRigidMatrixTransformation3D<Float>>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef Magnum_SceneGraph_AnimationPlayer_hpp
+#define Magnum_SceneGraph_AnimationPlayer_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AnimationPlayer.h
+ */
+
+#include "Magnum/SceneGraph/AnimationPlayer.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/AnimationTracks.h"
+#include "Magnum/SceneGraph/Object.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+template<class TransformationType> struct AnimationPlayerTraits {
+    enum: bool { SupportsScaling = true };
+
+    static typename TransformationType::DataType fromTranslationRotationScaling(const Vector3& translation, const Quaternion& rotation, const Vector3& scaling) {
+        Matrix3x3 rotationScaling = rotation.toMatrix();
+        rotationScaling[0] *= scaling.x();
+        rotationScaling[1] *= scaling.y();
+        rotationScaling[2] *= scaling.z();
+        return Transformation<TransformationType>::fromMatrix(Matrix4::from(rotationScaling, translation));
+    }
+
+    static typename TransformationType::DataType fromDualQuaternion(const DualQuaternion& transformation) {
+        return Transformation<TransformationType>::fromMatrix(transformation.toMatrix());
+    }
+};
+
+template<> struct AnimationPlayerTraits<BasicRigidMatrixTransformation3D<Float>> {
+    enum: bool { SupportsScaling = false };
+
+    static Matrix4 fromTranslationRotationScaling(const Vector3& translation, const Quaternion& rotation, const Vector3&) {
+        return Matrix4::from(rotation.toMatrix(), translation);
+    }
+
+    static Matrix4 fromDualQuaternion(const DualQuaternion& transformation) {
+        return transformation.toMatrix();
+    }
+};
+
+template<> struct AnimationPlayerTraits<BasicDualQuaternionTransformation<Float>> {
+    enum: bool { SupportsScaling = false };
+
+    static DualQuaternion fromTranslationRotationScaling(const Vector3& translation, const Quaternion& rotation, const Vector3&) {
+        return DualQuaternion::translation(translation)*DualQuaternion{rotation};
+    }
+
+    static DualQuaternion fromDualQuaternion(const DualQuaternion& transformation) {
+        return transformation;
+    }
+};
+
+}
+
+template<class Transformation> AnimationPlayer<Transformation>::AnimationPlayer(const AnimationTracks<Vector3>& vectorTracks, const AnimationTracks<Quaternion>& rotationTracks, const AnimationTracks<DualQuaternion>& dualQuaternionTracks): _vectorTracks(vectorTracks), _rotationTracks(rotationTracks), _dualQuaternionTracks(dualQuaternionTracks) {}
+
+template<class Transformation> AnimationPlayer<Transformation>& AnimationPlayer<Transformation>::addTranslationRotationScaling(Object<Transformation>& object, const UnsignedInt translationTrack, const UnsignedInt rotationTrack, const UnsignedInt scalingTrack) {
+    CORRADE_ASSERT((translationTrack == NoTrack || translationTrack < _vectorTracks.size()) &&
+                   (rotationTrack == NoTrack || rotationTrack < _rotationTracks.size()) &&
+                   (scalingTrack == NoTrack || scalingTrack < _vectorTracks.size()),
+        "SceneGraph::AnimationPlayer::addTranslationRotationScaling(): track out of range", *this);
+    CORRADE_ASSERT(scalingTrack == NoTrack || Implementation::AnimationPlayerTraits<Transformation>::SupportsScaling,
+        "SceneGraph::AnimationPlayer::addTranslationRotationScaling(): scaling is not supported by rigid transformations", *this);
+    _bindings.push_back({&object, translationTrack, rotationTrack, scalingTrack, NoTrack});
+    return *this;
+}
+
+template<class Transformation> AnimationPlayer<Transformation>& AnimationPlayer<Transformation>::addTransformation(Object<Transformation>& object, const UnsignedInt track) {
+    CORRADE_ASSERT(track < _dualQuaternionTracks.size(),
+        "SceneGraph::AnimationPlayer::addTransformation(): track out of range", *this);
+    _bindings.push_back({&object, NoTrack, NoTrack, NoTrack, track});
+    return *this;
+}
+
+template<class Transformation> void AnimationPlayer<Transformation>::apply(const Float time) {
+    typedef Implementation::AnimationPlayerTraits<Transformation> Traits;
+
+    /* Sample all tracks. Resizing keeps the existing hints if the track sets
+       only grew since the last call. */
+    _vectorHints.resize(_vectorTracks.size());
+    _vectors.resize(_vectorTracks.size());
+    _vectorTracks.sample(time, {_vectorHints.data(), _vectorHints.size()}, {_vectors.data(), _vectors.size()});
+    _rotationHints.resize(_rotationTracks.size());
+    _rotations.resize(_rotationTracks.size());
+    _rotationTracks.sample(time, {_rotationHints.data(), _rotationHints.size()}, {_rotations.data(), _rotations.size()});
+    _dualQuaternionHints.resize(_dualQuaternionTracks.size());
+    _dualQuaternions.resize(_dualQuaternionTracks.size());
+    _dualQuaternionTracks.sample(time, {_dualQuaternionHints.data(), _dualQuaternionHints.size()}, {_dualQuaternions.data(), _dualQuaternions.size()});
+
+    /* Calculate all transformations */
+    _transformations.resize(_bindings.size());
+    for(std::size_t i = 0; i != _bindings.size(); ++i) {
+        const Binding& binding = _bindings[i];
+        if(binding.transformation != NoTrack) {
+            _transformations[i] = Traits::fromDualQuaternion(_dualQuaternions[binding.transformation]);
+            continue;
+        }
+
+        _transformations[i] = Traits::fromTranslationRotationScaling(
+            binding.translation == NoTrack ? Vector3{} : _vectors[binding.translation],
+            binding.rotation == NoTrack ? Quaternion{} : _rotations[binding.rotation],
+            binding.scaling == NoTrack ? Vector3{1.0f} : _vectors[binding.scaling]);
+    }
+
+    /* Set them to the objects */
+    for(std::size_t i = 0; i != _bindings.size(); ++i)
+        _bindings[i].object->setTransformation(_transformations[i]);
+}
+
+}}
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef Magnum_SceneGraph_AnimationTracks_h
+#define Magnum_SceneGraph_AnimationTracks_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::AnimationTracks, enum @ref Magnum::SceneGraph::AnimationInterpolation
+ */
+
+#include <initializer_list>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Animation interpolation
+
+@see @ref AnimationTracks::add()
+*/
+enum class AnimationInterpolation: UnsignedByte {
+    /**
+     * The value of the previous keyframe is used until the next keyframe is
+     * reached.
+     */
+    Step,
+
+    /**
+     * Linear interpolation. Rotations are interpolated using normalized
+     * linear interpolation along the shortest path.
+     */
+    Linear,
+
+    /**
+     * Spherical interpolation. Quaternions are interpolated using
+     * @ref Math::slerpShortestPath(), dual quaternions using
+     * @ref Math::sclerp(). Equivalent to @ref AnimationInterpolation::Linear
+     * for other types.
+     */
+    Spherical,
+
+    /**
+     * Cubic Hermite spline interpolation. Each keyframe has an in-tangent,
+     * a value and an out-tangent, in this order. Tangents are specified per
+     * unit of time. Interpolated rotations are renormalized.
+     */
+    CubicHermite
+};
+
+/** @debugoperatorenum{Magnum::SceneGraph::AnimationInterpolation} */
+MAGNUM_SCENEGRAPH_EXPORT Debug& operator<<(Debug& debug, AnimationInterpolation value);
+
+/**
+@brief Animation tracks
+
+Stores keyframes of any number of animation tracks of the same type in
+contiguous memory, so sampling many tracks at once touches memory linearly.
+Each track has its own keyframe times and interpolation. Example usage,
+sampling a position track from @ref Animable::animationStep():
+@code
+SceneGraph::AnimationTracks<Vector3> positions;
+UnsignedInt track = positions.add(
+    {0.0f, 1.0f, 2.5f},
+    {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 2.0f, 0.0f}},
+    SceneGraph::AnimationInterpolation::Linear);
+
+UnsignedInt hint = 0;
+void AnimableObject::animationStep(Float time, Float) {
+    setTranslation(positions.at(track, time, hint));
+}
+@endcode
+
+Before the first keyframe and after the last keyframe the track is clamped to
+the first and last value.
+
+@anchor SceneGraph-AnimationTracks-hints
+## Sampling hints
+
+Finding the keyframes surrounding given time would need a binary search on
+each sample. The sampling functions can take a *hint* --- index of keyframe
+found by the previous sample of the same track, which is updated on every
+call. If the time didn't advance past the next keyframe or moved back only by
+one keyframe, the lookup is done in constant time, otherwise it falls back to
+binary search. Sequential playback is thus amortized @f$ \mathcal{O}(1) @f$.
+Hints are owned by the caller, so the same tracks can be sampled
+independently at different times, for example by more than one
+@ref AnimationPlayer. Initialize the hints to zero.
+
+Use @ref sample() to sample all tracks at once into a preallocated array.
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref AnimationTracks.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref AnimationTracks "AnimationTracks<Float>"
+-   @ref AnimationTracks "AnimationTracks<Vector3>"
+-   @ref AnimationTracks "AnimationTracks<Quaternion>"
+-   @ref AnimationTracks "AnimationTracks<DualQuaternion>"
+
+@see @ref scenegraph, @ref AnimationPlayer
+*/
+template<class T> class AnimationTracks {
+    public:
+        /** @brief Constructor */
+        explicit AnimationTracks();
+
+        /** @brief Whether there are no tracks */
+        bool isEmpty() const { return _tracks.empty(); }
+
+        /** @brief Count of tracks */
+        std::size_t size() const { return _tracks.size(); }
+
+        /**
+         * @brief Duration
+         *
+         * Time of the last keyframe of all tracks.
+         */
+        Float duration() const { return _duration; }
+
+        /**
+         * @brief Add track
+         * @param keys          Keyframe times
+         * @param values        Keyframe values
+         * @param interpolation Interpolation
+         * @return ID of the track
+         *
+         * Expects that there is at least one keyframe, the keyframe times
+         * are strictly increasing and there is one value for each keyframe,
+         * or three values for @ref AnimationInterpolation::CubicHermite. For
+         * rotation tracks the values (but not tangents) are expected to be
+         * normalized. The data are copied.
+         */
+        UnsignedInt add(Containers::ArrayView<const Float> keys, Containers::ArrayView<const T> values, AnimationInterpolation interpolation);
+
+        /** @overload */
+        UnsignedInt add(std::initializer_list<Float> keys, std::initializer_list<T> values, AnimationInterpolation interpolation) {
+            return add(Containers::ArrayView<const Float>{keys.begin(), keys.size()}, Containers::ArrayView<const T>{values.begin(), values.size()}, interpolation);
+        }
+
+        /** @brief Remove all tracks */
+        void clear();
+
+        /** @brief Track interpolation */
+        AnimationInterpolation interpolation(UnsignedInt track) const;
+
+        /** @brief Track keyframe times */
+        Containers::ArrayView<const Float> keys(UnsignedInt track) const;
+
+        /**
+         * @brief Track keyframe values
+         *
+         * For @ref AnimationInterpolation::CubicHermite contains tangents as
+         * well, see @ref add() for more information.
+         */
+        Containers::ArrayView<const T> values(UnsignedInt track) const;
+
+        /**
+         * @brief Sample a track
+         *
+         * Finds the surrounding keyframes using binary search. See
+         * @ref at(UnsignedInt, Float, UnsignedInt&) const for a faster
+         * alternative for sequential playback.
+         */
+        T at(UnsignedInt track, Float time) const;
+
+        /**
+         * @brief Sample a track using a hint
+         *
+         * The @p hint is used for finding the surrounding keyframes and
+         * updated afterwards. See @ref SceneGraph-AnimationTracks-hints "class documentation"
+         * for more information.
+         */
+        T at(UnsignedInt track, Float time, UnsignedInt& hint) const;
+
+        /**
+         * @brief Sample all tracks
+         * @param[in] time      Time
+         * @param[in,out] hints Sampling hints, one for each track
+         * @param[out] out      Sampled values, one for each track
+         *
+         * Expects that both @p hints and @p out have @ref size() items.
+         */
+        void sample(Float time, Containers::ArrayView<UnsignedInt> hints, Containers::ArrayView<T> out) const;
+
+    private:
+        struct Track {
+            UnsignedInt keyOffset, keyCount, valueOffset;
+            AnimationInterpolation interpolation;
+        };
+
+        T sampleInternal(const Track& track, Float time, UnsignedInt& hint) const;
+
+        std::vector<Track> _tracks;
+        std::vector<Float> _keys;
+        std::vector<T> _values;
+        Float _duration;
+};
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT AnimationTracks<Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT AnimationTracks<Vector3>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT AnimationTracks<Quaternion>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT AnimationTracks<DualQuaternion>;
+#endif
+
+}}
+
+#endif
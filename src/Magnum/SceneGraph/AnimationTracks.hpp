@@ -0,0 +1,210 @@
+#ifndef Magnum_SceneGraph_AnimationTracks_hpp
+#define Magnum_SceneGraph_AnimationTracks_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AnimationTracks.h
+ */
+
+#include "Magnum/SceneGraph/AnimationTracks.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+template<class T> struct AnimationTrackTraits {
+    static bool isNormalized(const T&) { return true; }
+    static T normalized(const T& value) { return value; }
+    static T lerp(const T& a, const T& b, Float t) { return Math::lerp(a, b, t); }
+    static T slerp(const T& a, const T& b, Float t) { return Math::lerp(a, b, t); }
+};
+
+/* The rotation variants don't assert on normalization, the values are
+   checked when adding the track */
+template<class T> struct AnimationTrackTraits<Math::Quaternion<T>> {
+    static bool isNormalized(const Math::Quaternion<T>& value) { return value.isNormalized(); }
+    static Math::Quaternion<T> normalized(const Math::Quaternion<T>& value) { return value.normalized(); }
+    static Math::Quaternion<T> lerp(const Math::Quaternion<T>& a, const Math::Quaternion<T>& b, const T t) {
+        const T d = Math::dot(a, b);
+        return ((T(1) - t)*a + (d < T(0) ? -t : t)*b).normalized();
+    }
+    static Math::Quaternion<T> slerp(const Math::Quaternion<T>& a, const Math::Quaternion<T>& b, const T t) {
+        const T d = Math::dot(a, b);
+        return d < T(0) ?
+            Math::Implementation::slerp(a, -b, -d, t) :
+            Math::Implementation::slerp(a, b, d, t);
+    }
+};
+
+template<class T> struct AnimationTrackTraits<Math::DualQuaternion<T>> {
+    static bool isNormalized(const Math::DualQuaternion<T>& value) { return value.isNormalized(); }
+    static Math::DualQuaternion<T> normalized(const Math::DualQuaternion<T>& value) { return value.normalized(); }
+    /* Dual quaternion linear blending */
+    static Math::DualQuaternion<T> lerp(const Math::DualQuaternion<T>& a, const Math::DualQuaternion<T>& b, const T t) {
+        const T tb = Math::dot(a.real(), b.real()) < T(0) ? -t : t;
+        return Math::DualQuaternion<T>{(T(1) - t)*a.real() + tb*b.real(), (T(1) - t)*a.dual() + tb*b.dual()}.normalized();
+    }
+    static Math::DualQuaternion<T> slerp(const Math::DualQuaternion<T>& a, const Math::DualQuaternion<T>& b, const T t) {
+        return Math::Implementation::sclerp(a, b, t);
+    }
+};
+
+/* Value-wise cubic Hermite spline, dual quaternions are interpolated
+   component-wise */
+template<class T, class U> inline T animationHermite(const T& a, const T& outTangentA, const T& b, const T& inTangentB, const U t, const U duration) {
+    const U t2 = t*t;
+    const U t3 = t2*t;
+    return (U(2)*t3 - U(3)*t2 + U(1))*a + (t3 - U(2)*t2 + t)*duration*outTangentA + (U(3)*t2 - U(2)*t3)*b + (t3 - t2)*duration*inTangentB;
+}
+template<class U> inline Math::DualQuaternion<U> animationHermite(const Math::DualQuaternion<U>& a, const Math::DualQuaternion<U>& outTangentA, const Math::DualQuaternion<U>& b, const Math::DualQuaternion<U>& inTangentB, const U t, const U duration) {
+    return {animationHermite(a.real(), outTangentA.real(), b.real(), inTangentB.real(), t, duration),
+            animationHermite(a.dual(), outTangentA.dual(), b.dual(), inTangentB.dual(), t, duration)};
+}
+
+/* Finds keyframe `i` so that keys[i] <= time < keys[i + 1], clamped to
+   [0, count - 2]. The hint and its neighbors are checked first, falling
+   back to binary search. Expects at least two keys. */
+inline UnsignedInt animationKeyframe(const Float* const keys, const UnsignedInt count, const Float time, UnsignedInt hint) {
+    const UnsignedInt last = count - 2;
+    if(hint > last) hint = last;
+
+    if(time >= keys[hint]) {
+        if(hint == last || time < keys[hint + 1]) return hint;
+        /* The common case for forward playback */
+        if(hint + 1 == last || time < keys[hint + 2]) return hint + 1;
+    } else {
+        if(hint == 0) return 0;
+        if(time >= keys[hint - 1]) return hint - 1;
+    }
+
+    const UnsignedInt found = std::upper_bound(keys, keys + count, time) - keys;
+    return found ? std::min(found - 1, last) : 0;
+}
+
+}
+
+template<class T> AnimationTracks<T>::AnimationTracks(): _duration{0.0f} {}
+
+template<class T> UnsignedInt AnimationTracks<T>::add(const Containers::ArrayView<const Float> keys, const Containers::ArrayView<const T> values, const AnimationInterpolation interpolation) {
+    CORRADE_ASSERT(!keys.empty(),
+        "SceneGraph::AnimationTracks::add(): expected at least one keyframe", {});
+    const std::size_t valuesPerKey = interpolation == AnimationInterpolation::CubicHermite ? 3 : 1;
+    CORRADE_ASSERT(values.size() == keys.size()*valuesPerKey,
+        "SceneGraph::AnimationTracks::add(): expected" << keys.size()*valuesPerKey << "values but got" << values.size(), {});
+    for(std::size_t i = 1; i < keys.size(); ++i) CORRADE_ASSERT(keys[i - 1] < keys[i],
+        "SceneGraph::AnimationTracks::add(): keyframe times are not strictly increasing", {});
+    for(std::size_t i = valuesPerKey/2; i < values.size(); i += valuesPerKey) CORRADE_ASSERT(Implementation::AnimationTrackTraits<T>::isNormalized(values[i]),
+        "SceneGraph::AnimationTracks::add(): values are not normalized", {});
+
+    _tracks.push_back({UnsignedInt(_keys.size()), UnsignedInt(keys.size()), UnsignedInt(_values.size()), interpolation});
+    _keys.insert(_keys.end(), keys.begin(), keys.end());
+    _values.insert(_values.end(), values.begin(), values.end());
+    _duration = std::max(_duration, keys[keys.size() - 1]);
+    return _tracks.size() - 1;
+}
+
+template<class T> void AnimationTracks<T>::clear() {
+    _tracks.clear();
+    _keys.clear();
+    _values.clear();
+    _duration = 0.0f;
+}
+
+template<class T> AnimationInterpolation AnimationTracks<T>::interpolation(const UnsignedInt track) const {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::AnimationTracks::interpolation(): index" << track << "out of range for" << _tracks.size() << "tracks", {});
+    return _tracks[track].interpolation;
+}
+
+template<class T> Containers::ArrayView<const Float> AnimationTracks<T>::keys(const UnsignedInt track) const {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::AnimationTracks::keys(): index" << track << "out of range for" << _tracks.size() << "tracks", {});
+    return {_keys.data() + _tracks[track].keyOffset, _tracks[track].keyCount};
+}
+
+template<class T> Containers::ArrayView<const T> AnimationTracks<T>::values(const UnsignedInt track) const {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::AnimationTracks::values(): index" << track << "out of range for" << _tracks.size() << "tracks", {});
+    const Track& t = _tracks[track];
+    return {_values.data() + t.valueOffset, t.interpolation == AnimationInterpolation::CubicHermite ? t.keyCount*3 : t.keyCount};
+}
+
+template<class T> T AnimationTracks<T>::at(const UnsignedInt track, const Float time) const {
+    UnsignedInt hint = ~UnsignedInt{};
+    return at(track, time, hint);
+}
+
+template<class T> T AnimationTracks<T>::at(const UnsignedInt track, const Float time, UnsignedInt& hint) const {
+    CORRADE_ASSERT(track < _tracks.size(),
+        "SceneGraph::AnimationTracks::at(): index" << track << "out of range for" << _tracks.size() << "tracks", {});
+    return sampleInternal(_tracks[track], time, hint);
+}
+
+template<class T> void AnimationTracks<T>::sample(const Float time, const Containers::ArrayView<UnsignedInt> hints, const Containers::ArrayView<T> out) const {
+    CORRADE_ASSERT(hints.size() == _tracks.size() && out.size() == _tracks.size(),
+        "SceneGraph::AnimationTracks::sample(): expected" << _tracks.size() << "hints and output values but got" << hints.size() << "and" << out.size(), );
+    for(std::size_t i = 0; i != _tracks.size(); ++i)
+        out[i] = sampleInternal(_tracks[i], time, hints[i]);
+}
+
+template<class T> T AnimationTracks<T>::sampleInternal(const Track& track, const Float time, UnsignedInt& hint) const {
+    typedef Implementation::AnimationTrackTraits<T> Traits;
+    const Float* const keys = _keys.data() + track.keyOffset;
+    const T* const values = _values.data() + track.valueOffset;
+
+    /* Single keyframe, the value is constant */
+    if(track.keyCount == 1) {
+        hint = 0;
+        return track.interpolation == AnimationInterpolation::CubicHermite ? values[1] : values[0];
+    }
+
+    const UnsignedInt i = hint = Implementation::animationKeyframe(keys, track.keyCount, time, hint);
+    const Float duration = keys[i + 1] - keys[i];
+    const Float t = Math::clamp((time - keys[i])/duration, 0.0f, 1.0f);
+
+    switch(track.interpolation) {
+        case AnimationInterpolation::Step:
+            return t < 1.0f ? values[i] : values[i + 1];
+        case AnimationInterpolation::Linear:
+            return Traits::lerp(values[i], values[i + 1], t);
+        case AnimationInterpolation::Spherical:
+            return Traits::slerp(values[i], values[i + 1], t);
+        case AnimationInterpolation::CubicHermite:
+            return Traits::normalized(Implementation::animationHermite(values[i*3 + 1], values[i*3 + 2], values[i*3 + 4], values[i*3 + 3], t, duration));
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}}
+
+#endif
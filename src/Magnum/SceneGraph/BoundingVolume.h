@@ -0,0 +1,255 @@
+#ifndef Magnum_SceneGraph_BoundingVolume_h
+#define Magnum_SceneGraph_BoundingVolume_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BoundingVolume, enum @ref Magnum::SceneGraph::BoundingVolumeType, alias @ref Magnum::SceneGraph::BasicBoundingVolume2D, @ref Magnum::SceneGraph::BasicBoundingVolume3D, typedef @ref Magnum::SceneGraph::BoundingVolume2D, @ref Magnum::SceneGraph::BoundingVolume3D
+ */
+
+#include <vector>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume type
+
+@see @ref BoundingVolume::type()
+*/
+enum class BoundingVolumeType: UnsignedByte {
+    Box,        /**< Axis-aligned box */
+    Sphere      /**< Sphere (circle in 2D) */
+};
+
+/**
+@brief Bounding volume
+
+Describes extents of an object in its local coordinate space, either as an
+axis-aligned box or as a sphere. The volume is transformed with absolute
+transformation of the object each time the object is cleaned and the
+transformed volume is then used by @ref Camera::draw() for frustum culling of
+@ref Drawable features associated with it using
+@ref Drawable::setBoundingVolume():
+@code
+auto object = new Object3D{&scene};
+auto drawable = new MyDrawable{*object, &drawables};
+auto volume = new SceneGraph::BoundingVolume3D{*object, Range3D{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}};
+drawable->setBoundingVolume(volume);
+
+camera.setFrustumCulling(true)
+    .draw(drawables);
+@endcode
+
+The volume can be also put into a @ref SpatialIndex to be able to do fast
+spatial queries on the objects.
+
+The transformed box is again axis-aligned, enclosing the original box
+transformed with the object transformation. The transformed sphere has its
+radius scaled by the largest scaling factor of the object transformation. The
+transformed volume is thus conservative also for non-uniformly scaled and
+sheared objects.
+
+@anchor SceneGraph-BoundingVolume-explicit-specializations
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref BoundingVolume.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref BoundingVolume2D
+-   @ref BoundingVolume3D
+
+@see @ref scenegraph, @ref BasicBoundingVolume2D, @ref BasicBoundingVolume3D,
+    @ref BoundingVolume2D, @ref BoundingVolume3D
+*/
+template<UnsignedInt dimensions, class T> class BoundingVolume: public AbstractFeature<dimensions, T> {
+    public:
+        /**
+         * @brief Construct an axis-aligned box volume
+         * @param object    Object this volume belongs to
+         * @param box       Box in object coordinate space
+         * @param index     Spatial index to add the volume to
+         *
+         * @see @ref SpatialIndex::add()
+         */
+        explicit BoundingVolume(AbstractObject<dimensions, T>& object, const Math::Range<dimensions, T>& box, SpatialIndex<dimensions, T>* index = nullptr);
+
+        /**
+         * @brief Construct a sphere volume
+         * @param object    Object this volume belongs to
+         * @param center    Sphere center in object coordinate space
+         * @param radius    Sphere radius in object coordinate space
+         * @param index     Spatial index to add the volume to
+         *
+         * @see @ref SpatialIndex::add()
+         */
+        explicit BoundingVolume(AbstractObject<dimensions, T>& object, const VectorTypeFor<dimensions, T>& center, T radius, SpatialIndex<dimensions, T>* index = nullptr);
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the volume from spatial index, if it belongs to any, and
+         * from all drawables referencing it.
+         * @see @ref Drawable::setBoundingVolume()
+         */
+        ~BoundingVolume();
+
+        /**
+         * @brief Spatial index this volume belongs to
+         *
+         * @see @ref SpatialIndex::add(), @ref SpatialIndex::remove()
+         */
+        SpatialIndex<dimensions, T>* index() { return _index; }
+
+        /** @overload */
+        const SpatialIndex<dimensions, T>* index() const { return _index; }
+
+        /** @brief Volume type */
+        BoundingVolumeType type() const { return _type; }
+
+        /**
+         * @brief Box in object coordinate space
+         *
+         * For spheres returns the box enclosing the sphere.
+         */
+        Math::Range<dimensions, T> box() const {
+            const VectorTypeFor<dimensions, T> halfSize = _halfSize + VectorTypeFor<dimensions, T>{_radius};
+            return {_center - halfSize, _center + halfSize};
+        }
+
+        /** @brief Volume center in object coordinate space */
+        VectorTypeFor<dimensions, T> center() const { return _center; }
+
+        /**
+         * @brief Sphere radius in object coordinate space
+         *
+         * For boxes returns `0`.
+         */
+        T radius() const { return _radius; }
+
+        /**
+         * @brief Set axis-aligned box volume
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the object as dirty so the transformed volume gets updated.
+         */
+        BoundingVolume<dimensions, T>& setBox(const Math::Range<dimensions, T>& box);
+
+        /**
+         * @brief Set sphere volume
+         * @return Reference to self (for method chaining)
+         *
+         * Marks the object as dirty so the transformed volume gets updated.
+         */
+        BoundingVolume<dimensions, T>& setSphere(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /**
+         * @brief Volume center in world coordinate space
+         *
+         * Valid only if the object is clean.
+         * @see @ref AbstractObject::setClean()
+         */
+        VectorTypeFor<dimensions, T> transformedCenter() const { return _transformedCenter; }
+
+        /**
+         * @brief Half size of transformed box in world coordinate space
+         *
+         * Valid only if the object is clean. For spheres returns zero vector.
+         */
+        VectorTypeFor<dimensions, T> transformedHalfSize() const { return _transformedHalfSize; }
+
+        /**
+         * @brief Radius of transformed sphere in world coordinate space
+         *
+         * Valid only if the object is clean. For boxes returns `0`.
+         */
+        T transformedRadius() const { return _transformedRadius; }
+
+    private:
+        friend SpatialIndex<dimensions, T>;
+        friend Drawable<dimensions, T>;
+
+        void markDirty() override;
+        void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override;
+
+        SpatialIndex<dimensions, T>* _index;
+        std::size_t _indexPosition, _indexItem;
+        bool _indexDirty;
+        BoundingVolumeType _type;
+        VectorTypeFor<dimensions, T> _center, _halfSize,
+            _transformedCenter, _transformedHalfSize;
+        T _radius, _transformedRadius;
+        std::vector<Drawable<dimensions, T>*> _drawables;
+};
+
+/**
+@brief Bounding volume for two-dimensional scenes
+
+Convenience alternative to `BoundingVolume<2, T>`. See @ref BoundingVolume for
+more information.
+@see @ref BoundingVolume2D, @ref BasicBoundingVolume3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+#endif
+
+/**
+@brief Bounding volume for two-dimensional float scenes
+
+@see @ref BoundingVolume3D
+*/
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+
+/**
+@brief Bounding volume for three-dimensional scenes
+
+Convenience alternative to `BoundingVolume<3, T>`. See @ref BoundingVolume for
+more information.
+@see @ref BoundingVolume3D, @ref BasicBoundingVolume2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+#endif
+
+/**
+@brief Bounding volume for three-dimensional float scenes
+
+@see @ref BoundingVolume2D
+*/
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolume<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolume<3, Float>;
+#endif
+
+}}
+
+#endif
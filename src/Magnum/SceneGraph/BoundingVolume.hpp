@@ -0,0 +1,107 @@
+#ifndef Magnum_SceneGraph_BoundingVolume_hpp
+#define Magnum_SceneGraph_BoundingVolume_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref BoundingVolume.h
+ */
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/BoundingVolume.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>::BoundingVolume(AbstractObject<dimensions, T>& object, const Math::Range<dimensions, T>& box, SpatialIndex<dimensions, T>* const index): AbstractFeature<dimensions, T>(object), _index{}, _indexPosition{}, _indexItem{}, _indexDirty{}, _transformedRadius{} {
+    AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::Absolute);
+    AbstractFeature<dimensions, T>::setCleanThreadSafe(true);
+    setBox(box);
+    if(index) index->add(*this);
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>::BoundingVolume(AbstractObject<dimensions, T>& object, const VectorTypeFor<dimensions, T>& center, const T radius, SpatialIndex<dimensions, T>* const index): AbstractFeature<dimensions, T>(object), _index{}, _indexPosition{}, _indexItem{}, _indexDirty{}, _transformedRadius{} {
+    AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::Absolute);
+    AbstractFeature<dimensions, T>::setCleanThreadSafe(true);
+    setSphere(center, radius);
+    if(index) index->add(*this);
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>::~BoundingVolume() {
+    if(_index) _index->remove(*this);
+    for(Drawable<dimensions, T>* drawable: _drawables)
+        drawable->_boundingVolume = nullptr;
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>& BoundingVolume<dimensions, T>::setBox(const Math::Range<dimensions, T>& box) {
+    _type = BoundingVolumeType::Box;
+    _center = box.center();
+    _halfSize = box.size()/T(2);
+    _radius = T(0);
+    AbstractFeature<dimensions, T>::object().setDirty();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>& BoundingVolume<dimensions, T>::setSphere(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    _type = BoundingVolumeType::Sphere;
+    _center = center;
+    _halfSize = {};
+    _radius = radius;
+    AbstractFeature<dimensions, T>::object().setDirty();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::markDirty() {
+    /* Let the index know it needs to refit the volume on next update */
+    if(_index && !_indexDirty) {
+        _indexDirty = true;
+        _index->_dirty.push_back(this);
+    }
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) {
+    const Math::Matrix<dimensions, T> rotationScaling = absoluteTransformationMatrix.rotationScaling();
+    _transformedCenter = absoluteTransformationMatrix.transformPoint(_center);
+
+    /* Box enclosing the transformed box -- each world axis gets the
+       contributions of all transformed local half-axes. Sphere radius is
+       scaled by the longest transformed axis. */
+    T maxScalingSquared{};
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        T halfSize{};
+        for(std::size_t j = 0; j != dimensions; ++j)
+            halfSize += Math::abs(rotationScaling[j][i])*_halfSize[j];
+        _transformedHalfSize[i] = halfSize;
+        maxScalingSquared = Math::max(maxScalingSquared, rotationScaling[i].dot());
+    }
+    _transformedRadius = _radius*std::sqrt(maxScalingSquared);
+}
+
+}}
+
+#endif
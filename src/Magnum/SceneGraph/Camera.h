@@ -29,6 +29,9 @@
  * @brief Class @ref Magnum::SceneGraph::Camera, enum @ref Magnum::SceneGraph::AspectRatioPolicy, alias @ref Magnum::SceneGraph::BasicCamera2D, @ref Magnum::SceneGraph::BasicCamera3D, typedef @ref Magnum::SceneGraph::Camera2D, @ref Magnum::SceneGraph::Camera3D
  */
 
+#include <functional>
+#include <vector>
+
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/SceneGraph/AbstractFeature.h"
@@ -88,6 +91,37 @@ errors. See also @ref compilation-speedup-hpp for more information.
 -   @ref Camera2D
 -   @ref Camera3D
 
+@anchor SceneGraph-Camera-frustum-culling
+## Frustum culling
+
+By default, @ref draw() computes transformation of every drawable in the group
+relative to the camera and draws all of them. If frustum culling is enabled
+using @ref setFrustumCulling(), the view frustum is extracted from the
+projection and camera matrix and drawables with a @ref BoundingVolume
+associated via @ref Drawable::setBoundingVolume() are first tested against it
+in a single batch. Transformations are then computed and @ref Drawable::draw()
+called only for the drawables that are at least partially inside the frustum
+or don't have any bounding volume. Number of drawn and culled drawables in
+the last @ref draw() call is available through @ref drawnCount() and
+@ref culledCount().
+@code
+SceneGraph::Camera3D camera{&cameraObject};
+camera.setProjectionMatrix(Matrix4::perspectiveProjection(35.0_degf, 1.0f, 0.001f, 100.0f))
+      .setFrustumCulling(true);
+
+// ...
+
+camera.draw(drawables);
+Debug() << camera.culledCount() << "objects culled";
+@endcode
+
+The test is conservative --- a drawable is culled only if its bounding volume
+lies completely on the outer side of one of the frustum planes.
+
+Drawables associated with a @ref LodGroup using @ref Drawable::setLodGroup()
+are drawn only if their level of detail is selected. These are not counted in
+@ref culledCount().
+
 @see @ref scenegraph, @ref BasicCamera2D, @ref BasicCamera3D, @ref Camera2D,
     @ref Camera3D, @ref Drawable, @ref DrawableGroup
 */
@@ -231,13 +265,61 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          */
         virtual void setViewport(const Vector2i& size);
 
+        /** @brief Whether frustum culling is enabled */
+        bool isFrustumCullingEnabled() const { return _frustumCulling; }
+
+        /**
+         * @brief Enable or disable frustum culling
+         * @return Reference to self (for method chaining)
+         *
+         * Disabled by default. See
+         * @ref SceneGraph-Camera-frustum-culling "class documentation" for
+         * more information.
+         */
+        Camera<dimensions, T>& setFrustumCulling(bool enabled) {
+            _frustumCulling = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Count of drawables drawn in last @ref draw() or @ref drawSorted() call
+         *
+         * @see @ref culledCount()
+         */
+        std::size_t drawnCount() const { return _drawnCount; }
+
+        /**
+         * @brief Count of drawables culled in last @ref draw() or @ref drawSorted() call
+         *
+         * Always `0` if frustum culling is disabled. Drawables skipped
+         * because of a different level of detail are not counted.
+         * @see @ref drawnCount(), @ref setFrustumCulling()
+         */
+        std::size_t culledCount() const { return _culledCount; }
+
         /**
          * @brief Draw
          *
-         * Draws given group of drawables.
+         * Draws given group of drawables. If frustum culling is enabled,
+         * drawables with bounding volume completely outside of the view
+         * frustum are skipped. All temporary storage is kept in the camera
+         * and in the scene and reused between calls, so if no object needs
+         * to be cleaned, drawing doesn't allocate in a steady state.
+         * @see @ref setFrustumCulling(),
+         *      @ref Object::transformationMatrices(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>>, Containers::ArrayView<MatrixType>, const MatrixType&) const
          */
         virtual void draw(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Draw in sorted order
+         *
+         * Same as @ref draw(), but the visible drawables are sorted using
+         * @p queue before drawing. Subclasses overriding @ref draw() should
+         * override this function as well, as it doesn't call @ref draw().
+         * @see @ref DrawQueue::sort()
+         */
+        virtual void drawSorted(DrawableGroup<dimensions, T>& group, DrawQueue<dimensions, T>& queue);
+
     private:
         /** Recalculates camera matrix */
         void cleanInverted(const MatrixTypeFor<dimensions, T>& invertedAbsoluteTransformationMatrix) override {
@@ -245,6 +327,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         }
 
         void fixAspectRatio();
+        void cull(DrawableGroup<dimensions, T>& group);
+        void drawInternal(DrawableGroup<dimensions, T>& group, DrawQueue<dimensions, T>* queue);
 
         MatrixTypeFor<dimensions, T> _rawProjectionMatrix;
         AspectRatioPolicy _aspectRatioPolicy;
@@ -253,6 +337,16 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         MatrixTypeFor<dimensions, T> _cameraMatrix;
 
         Vector2i _viewport;
+
+        bool _frustumCulling;
+        std::size_t _drawnCount, _culledCount;
+
+        /* Scratch memory for culling and drawing, reused between draws */
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> _objects;
+        std::vector<MatrixTypeFor<dimensions, T>> _transformations;
+        std::vector<T> _volumes;
+        std::vector<UnsignedInt> _visible;
+        std::vector<UnsignedByte> _inside;
 };
 
 /**
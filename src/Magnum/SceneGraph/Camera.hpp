@@ -29,9 +29,16 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Camera.h
  */
 
+#include <algorithm>
+#include <limits>
+
+#include "Magnum/Math/Frustum.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/BoundingVolume.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawQueue.h"
+#include "Magnum/SceneGraph/LodGroup.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -53,10 +60,24 @@ template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRat
         Math::Vector2<T>(T(1), relativeAspectRatio.x()/relativeAspectRatio.y()), T(1)));
 }
 
+/* Planes bounding the view area in 2D, with normals pointing inside */
+template<class T> void frustumPlanes(const Math::Matrix3<T>& matrix, Math::Vector<3, T>(&planes)[4]) {
+    planes[0] = matrix.row(2) + matrix.row(0);
+    planes[1] = matrix.row(2) - matrix.row(0);
+    planes[2] = matrix.row(2) + matrix.row(1);
+    planes[3] = matrix.row(2) - matrix.row(1);
+}
+
+template<class T> void frustumPlanes(const Math::Matrix4<T>& matrix, Math::Vector<4, T>(&planes)[6]) {
+    const Math::Frustum<T> frustum = Math::Frustum<T>::fromMatrix(matrix);
+    for(std::size_t i = 0; i != 6; ++i) planes[i] = frustum[i];
 }
 
-template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
+}
+
+template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved), _frustumCulling{false}, _drawnCount{}, _culledCount{} {
     AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::InvertedAbsolute);
+    AbstractFeature<dimensions, T>::setCleanThreadSafe(true);
 }
 
 template<UnsignedInt dimensions, class T> Camera<dimensions, T>::~Camera() = default;
@@ -82,24 +103,115 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::setViewpor
     fixAspectRatio();
 }
 
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::cull(DrawableGroup<dimensions, T>& group) {
+    const std::size_t count = group.size();
+
+    /* Update transformed bounding volumes of all dirty objects at once */
+    _objects.clear();
+    for(std::size_t i = 0; i != count; ++i) {
+        BoundingVolume<dimensions, T>* const volume = group[i].boundingVolume();
+        if(volume && volume->object().isDirty())
+            _objects.push_back(volume->object());
+    }
+    if(!_objects.empty()) AbstractObject<dimensions, T>::setClean(_objects);
+
+    /* Gather the transformed volumes into separate arrays of components so
+       the plane tests below can be done on all of them in a single tight
+       loop. Drawables without bounding volume get infinite radius, which
+       makes them pass all the tests. */
+    _volumes.resize((2*dimensions + 1)*count);
+    T* const centers = _volumes.data();
+    T* const halfSizes = centers + dimensions*count;
+    T* const radii = halfSizes + dimensions*count;
+    for(std::size_t i = 0; i != count; ++i) {
+        BoundingVolume<dimensions, T>* const volume = group[i].boundingVolume();
+        if(volume) {
+            const VectorTypeFor<dimensions, T> center = volume->transformedCenter();
+            const VectorTypeFor<dimensions, T> halfSize = volume->transformedHalfSize();
+            for(std::size_t j = 0; j != dimensions; ++j) {
+                centers[j*count + i] = center[j];
+                halfSizes[j*count + i] = halfSize[j];
+            }
+            radii[i] = volume->transformedRadius();
+        } else {
+            for(std::size_t j = 0; j != dimensions; ++j)
+                centers[j*count + i] = halfSizes[j*count + i] = T(0);
+            radii[i] = std::numeric_limits<T>::infinity();
+        }
+    }
+
+    /* Extract frustum planes in world space, normalized so the distances are
+       comparable with the volume extents */
+    Math::Vector<dimensions + 1, T> planes[2*dimensions];
+    Implementation::frustumPlanes(_projectionMatrix*_cameraMatrix, planes);
+
+    /* A volume is outside if it is completely behind any of the planes */
+    _inside.assign(count, 1);
+    for(const Math::Vector<dimensions + 1, T>& plane: planes) {
+        const Math::Vector<dimensions, T> normal = Math::Vector<dimensions, T>::pad(plane);
+        const T length = normal.length();
+        const Math::Vector<dimensions, T> n = normal/length;
+        const Math::Vector<dimensions, T> absN = Math::abs(n);
+        const T w = plane[dimensions]/length;
+
+        for(std::size_t i = 0; i != count; ++i) {
+            T distance = w + radii[i];
+            for(std::size_t j = 0; j != dimensions; ++j)
+                distance += n[j]*centers[j*count + i] + absN[j]*halfSizes[j*count + i];
+            _inside[i] &= UnsignedByte(distance >= T(0));
+        }
+    }
+
+    _visible.clear();
+    for(std::size_t i = 0; i != count; ++i)
+        if(_inside[i]) _visible.push_back(i);
+}
+
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group) {
+    drawInternal(group, nullptr);
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::drawSorted(DrawableGroup<dimensions, T>& group, DrawQueue<dimensions, T>& queue) {
+    drawInternal(group, &queue);
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::drawInternal(DrawableGroup<dimensions, T>& group, DrawQueue<dimensions, T>* const queue) {
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
     CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
 
     /* Compute camera matrix */
     AbstractFeature<dimensions, T>::object().setClean();
 
-    /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
-        objects.push_back(group[i].object());
-    std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
-
-    /* Perform the drawing */
-    for(std::size_t i = 0; i != transformations.size(); ++i)
-        group[i].draw(transformations[i], *this);
+    /* Decide which drawables are visible */
+    if(_frustumCulling) cull(group);
+    else {
+        _visible.resize(group.size());
+        for(std::size_t i = 0; i != group.size(); ++i) _visible[i] = i;
+    }
+    _culledCount = group.size() - _visible.size();
+
+    /* Skip drawables not belonging to the selected level of detail */
+    _visible.erase(std::remove_if(_visible.begin(), _visible.end(), [&group](UnsignedInt i) {
+        const LodGroup<dimensions, T>* const lodGroup = group[i].lodGroup();
+        return lodGroup && lodGroup->level() != group[i].lodLevel();
+    }), _visible.end());
+
+    /* Compute transformations of all visible objects in the group relative to
+       the camera */
+    _objects.clear();
+    for(UnsignedInt i: _visible)
+        _objects.push_back(group[i].object());
+    _transformations.resize(_objects.size());
+    scene->transformationMatrices({_objects.data(), _objects.size()}, {_transformations.data(), _transformations.size()}, _cameraMatrix);
+
+    _drawnCount = _visible.size();
+
+    /* Perform the drawing, sorted if requested */
+    if(queue) {
+        for(UnsignedInt i: queue->sort(group, {_visible.data(), _visible.size()}, {_transformations.data(), _transformations.size()}))
+            group[_visible[i]].draw(_transformations[i], *this);
+    } else for(std::size_t i = 0; i != _transformations.size(); ++i)
+        group[_visible[i]].draw(_transformations[i], *this);
 }
 
 }}
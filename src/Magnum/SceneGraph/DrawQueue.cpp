@@ -0,0 +1,109 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawQueue.h"
+
+#include <cstring>
+#include <utility>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace SceneGraph {
+
+Debug& operator<<(Debug& debug, const DrawOrder value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case DrawOrder::value: return debug << "SceneGraph::DrawOrder::" #value;
+        _c(SortKey)
+        _c(FrontToBack)
+        _c(BackToFront)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "SceneGraph::DrawOrder(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+namespace Implementation {
+
+bool radixSort(const Containers::ArrayView<UnsignedLong> keys, const Containers::ArrayView<UnsignedInt> indices, const Containers::ArrayView<UnsignedLong> keysScratch, const Containers::ArrayView<UnsignedInt> indicesScratch, const std::size_t keyBytes) {
+    CORRADE_INTERNAL_ASSERT(keys.size() == indices.size() && keys.size() == keysScratch.size() && keys.size() == indicesScratch.size() && keyBytes <= 8);
+    const std::size_t count = keys.size();
+    if(!count) return false;
+
+    /* Histograms of all digits in a single pass */
+    std::size_t histograms[8][256]{};
+    for(std::size_t i = 0; i != count; ++i) {
+        const UnsignedLong key = keys[i];
+        for(std::size_t digit = 0; digit != keyBytes; ++digit)
+            ++histograms[digit][(key >> 8*digit) & 0xff];
+    }
+
+    UnsignedLong* keysFrom = keys.data();
+    UnsignedLong* keysTo = keysScratch.data();
+    UnsignedInt* indicesFrom = indices.data();
+    UnsignedInt* indicesTo = indicesScratch.data();
+    bool swapped = false;
+    for(std::size_t digit = 0; digit != keyBytes; ++digit) {
+        const std::size_t shift = 8*digit;
+        std::size_t* const histogram = histograms[digit];
+
+        /* All keys have the same value of this digit, nothing to reorder */
+        if(histogram[(keysFrom[0] >> shift) & 0xff] == count) continue;
+
+        /* Convert counts to offsets */
+        std::size_t offset = 0;
+        for(std::size_t i = 0; i != 256; ++i) {
+            const std::size_t c = histogram[i];
+            histogram[i] = offset;
+            offset += c;
+        }
+
+        for(std::size_t i = 0; i != count; ++i) {
+            const UnsignedLong key = keysFrom[i];
+            const std::size_t position = histogram[(key >> shift) & 0xff]++;
+            keysTo[position] = key;
+            indicesTo[position] = indicesFrom[i];
+        }
+
+        std::swap(keysFrom, keysTo);
+        std::swap(indicesFrom, indicesTo);
+        swapped = !swapped;
+    }
+
+    return swapped;
+}
+
+UnsignedInt depthKey(const Float depth) {
+    /* Flip all bits of negative values so they go in reverse, flip just the
+       sign bit of positive values so they go after negative ones */
+    UnsignedInt bits;
+    std::memcpy(&bits, &depth, sizeof(Float));
+    return bits & 0x80000000u ? ~bits : bits|0x80000000u;
+}
+
+}
+
+}}
@@ -0,0 +1,232 @@
+#ifndef Magnum_SceneGraph_DrawQueue_h
+#define Magnum_SceneGraph_DrawQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::DrawQueue, enum @ref Magnum::SceneGraph::DrawOrder, alias @ref Magnum::SceneGraph::BasicDrawQueue2D, @ref Magnum::SceneGraph::BasicDrawQueue3D, typedef @ref Magnum::SceneGraph::DrawQueue2D, @ref Magnum::SceneGraph::DrawQueue3D
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Draw order
+
+@see @ref DrawQueue::setOrder()
+*/
+enum class DrawOrder: UnsignedByte {
+    /**
+     * Sorted by @ref Drawable::sortKey(), drawables with the same key are
+     * drawn in the order they were added to the group.
+     */
+    SortKey,
+
+    /**
+     * Sorted by @ref Drawable::sortKey(), drawables with the same key are
+     * sorted front to back. Useful for opaque objects, as it minimizes both
+     * state changes and overdraw.
+     */
+    FrontToBack,
+
+    /**
+     * Sorted back to front, drawables with the same depth are sorted by
+     * @ref Drawable::sortKey(). Useful for transparent objects.
+     */
+    BackToFront
+};
+
+/** @debugoperatorenum{Magnum::SceneGraph::DrawOrder} */
+MAGNUM_SCENEGRAPH_EXPORT Debug& operator<<(Debug& debug, DrawOrder value);
+
+namespace Implementation {
+    /* Stable LSD radix sort of key/index pairs, sorting only by the lowest
+       `keyBytes` bytes of the keys. Scratch arrays need to have the same size
+       as the inputs. Returns true if the result ended up in the scratch
+       arrays. */
+    MAGNUM_SCENEGRAPH_EXPORT bool radixSort(Containers::ArrayView<UnsignedLong> keys, Containers::ArrayView<UnsignedInt> indices, Containers::ArrayView<UnsignedLong> keysScratch, Containers::ArrayView<UnsignedInt> indicesScratch, std::size_t keyBytes);
+
+    /* Maps a float to an unsigned integer with the same ordering */
+    MAGNUM_SCENEGRAPH_EXPORT UnsignedInt depthKey(Float depth);
+}
+
+/**
+@brief Draw queue
+
+Sorts visible drawables before they are drawn by @ref Camera::drawSorted()
+in order to minimize state changes and overdraw. The sorting is done using
+the 64-bit @ref Drawable::sortKey() and depth of each drawable relative to
+the camera, according to @ref order(). Example usage with separate queues for
+opaque and transparent drawables:
+@code
+SceneGraph::DrawQueue3D opaqueQueue{SceneGraph::DrawOrder::FrontToBack},
+    transparentQueue{SceneGraph::DrawOrder::BackToFront};
+
+void MyApplication::drawEvent() {
+    camera->drawSorted(opaqueDrawables, opaqueQueue);
+
+    Renderer::enable(Renderer::Feature::Blending);
+    camera->drawSorted(transparentDrawables, transparentQueue);
+    Renderer::disable(Renderer::Feature::Blending);
+
+    // ...
+}
+@endcode
+
+The sort key is opaque to the queue, only its ordering matters. A common
+approach is to put the most expensive state change into the highest bits,
+for example shader ID in bits 48--63, material ID in bits 24--47 and mesh ID
+in bits 0--23, so all drawables using the same shader are drawn together and
+inside that group all drawables using the same material. See
+@ref Drawable::setSortKey() for more information.
+
+The sorting is done using a stable radix sort in linear time. Digits that are
+the same for all drawables are skipped, so unused bits in the keys don't add
+to the sorting cost. Memory for the sorting is kept in the queue and reused,
+so after the first few frames no allocations are done.
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref DrawQueue.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref DrawQueue2D
+-   @ref DrawQueue3D
+
+@see @ref scenegraph, @ref BasicDrawQueue2D, @ref BasicDrawQueue3D,
+    @ref DrawQueue2D, @ref DrawQueue3D
+*/
+template<UnsignedInt dimensions, class T> class DrawQueue {
+    public:
+        /**
+         * @brief Constructor
+         * @param order     Draw order
+         */
+        explicit DrawQueue(DrawOrder order = DrawOrder::SortKey);
+
+        /** @brief Copying is not allowed */
+        DrawQueue(const DrawQueue<dimensions, T>&) = delete;
+
+        /** @brief Move constructor */
+        DrawQueue(DrawQueue<dimensions, T>&&) = default;
+
+        /** @brief Copying is not allowed */
+        DrawQueue<dimensions, T>& operator=(const DrawQueue<dimensions, T>&) = delete;
+
+        /** @brief Move assignment */
+        DrawQueue<dimensions, T>& operator=(DrawQueue<dimensions, T>&&) = default;
+
+        /** @brief Draw order */
+        DrawOrder order() const { return _order; }
+
+        /**
+         * @brief Set draw order
+         * @return Reference to self (for method chaining)
+         */
+        DrawQueue<dimensions, T>& setOrder(DrawOrder order) {
+            _order = order;
+            return *this;
+        }
+
+        /**
+         * @brief Sort drawables
+         * @param group             Drawable group
+         * @param drawables         Indices of drawables in @p group to sort
+         * @param transformations   Transformations of the drawables relative
+         *      to the camera
+         * @return Positions in @p drawables and @p transformations in draw
+         *      order. The view is valid until next call to this function.
+         *
+         * Depth of each drawable is taken from the translation part of its
+         * transformation, with smaller depth being closer to the camera. In
+         * 2D there is no depth and drawables are sorted only by
+         * @ref Drawable::sortKey(). Expects that @p drawables and
+         * @p transformations have the same size. Called from
+         * @ref Camera::drawSorted(),
+         * but can be used also directly.
+         */
+        Containers::ArrayView<const UnsignedInt> sort(DrawableGroup<dimensions, T>& group, Containers::ArrayView<const UnsignedInt> drawables, Containers::ArrayView<const MatrixTypeFor<dimensions, T>> transformations);
+
+    private:
+        DrawOrder _order;
+
+        /* Scratch memory, reused between sorts */
+        std::vector<UnsignedLong> _keys;
+        std::vector<UnsignedInt> _indices;
+};
+
+/**
+@brief Draw queue for two-dimensional scenes
+
+Convenience alternative to `DrawQueue<2, T>`. See @ref DrawQueue for more
+information.
+@see @ref DrawQueue2D, @ref BasicDrawQueue3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicDrawQueue2D = DrawQueue<2, T>;
+#endif
+
+/**
+@brief Draw queue for two-dimensional float scenes
+
+@see @ref DrawQueue3D
+*/
+typedef BasicDrawQueue2D<Float> DrawQueue2D;
+
+/**
+@brief Draw queue for three-dimensional scenes
+
+Convenience alternative to `DrawQueue<3, T>`. See @ref DrawQueue for more
+information.
+@see @ref DrawQueue3D, @ref BasicDrawQueue2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicDrawQueue3D = DrawQueue<3, T>;
+#endif
+
+/**
+@brief Draw queue for three-dimensional float scenes
+
+@see @ref DrawQueue2D
+*/
+typedef BasicDrawQueue3D<Float> DrawQueue3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT DrawQueue<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT DrawQueue<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef Magnum_SceneGraph_DrawQueue_hpp
+#define Magnum_SceneGraph_DrawQueue_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref DrawQueue.h
+ */
+
+#include <utility>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawQueue.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* There's no depth in 2D */
+template<class T> inline T drawDepth(const Math::Matrix3<T>&) { return T(0); }
+
+/* Camera looks in direction of -Z */
+template<class T> inline T drawDepth(const Math::Matrix4<T>& transformation) {
+    return -transformation.translation().z();
+}
+
+}
+
+template<UnsignedInt dimensions, class T> DrawQueue<dimensions, T>::DrawQueue(const DrawOrder order): _order{order} {}
+
+template<UnsignedInt dimensions, class T> Containers::ArrayView<const UnsignedInt> DrawQueue<dimensions, T>::sort(DrawableGroup<dimensions, T>& group, const Containers::ArrayView<const UnsignedInt> drawables, const Containers::ArrayView<const MatrixTypeFor<dimensions, T>> transformations) {
+    CORRADE_ASSERT(drawables.size() == transformations.size(),
+        "SceneGraph::DrawQueue::sort(): expected" << drawables.size() << "transformations but got" << transformations.size(), {});
+
+    /* First half of the memory is for the data, second half for scratch */
+    const std::size_t count = drawables.size();
+    _keys.resize(2*count);
+    _indices.resize(2*count);
+    UnsignedLong* keys = _keys.data();
+    UnsignedLong* keysScratch = keys + count;
+    UnsignedInt* indices = _indices.data();
+    UnsignedInt* indicesScratch = indices + count;
+    for(std::size_t i = 0; i != count; ++i) indices[i] = i;
+
+    /* The sort is stable, so sorting first by the secondary and then by the
+       primary criterion gives the desired order */
+    for(std::size_t pass = 0; pass != 2; ++pass) {
+        std::size_t keyBytes;
+        if((pass == 0 && _order == DrawOrder::BackToFront) ||
+           (pass == 1 && _order != DrawOrder::BackToFront)) {
+            for(std::size_t i = 0; i != count; ++i)
+                keys[i] = group[drawables[indices[i]]].sortKey();
+            keyBytes = 8;
+        } else if(_order == DrawOrder::SortKey) {
+            continue;
+        } else {
+            const UnsignedInt mask = _order == DrawOrder::BackToFront ? 0xffffffffu : 0;
+            for(std::size_t i = 0; i != count; ++i)
+                keys[i] = Implementation::depthKey(Float(Implementation::drawDepth(transformations[indices[i]])))^mask;
+            keyBytes = 4;
+        }
+
+        if(Implementation::radixSort({keys, count}, {indices, count}, {keysScratch, count}, {indicesScratch, count}, keyBytes)) {
+            std::swap(keys, keysScratch);
+            std::swap(indices, indicesScratch);
+        }
+    }
+
+    return {indices, count};
+}
+
+}}
+
+#endif
@@ -155,6 +155,26 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
+## Frustum culling
+
+If the drawables have a @ref BoundingVolume associated using
+@ref setBoundingVolume(), the camera can skip the ones that are outside of its
+view frustum. See @ref Camera::setFrustumCulling() for more information.
+
+## Level of detail
+
+Drawables representing different levels of detail of the same object can
+be associated with a @ref LodGroup using @ref setLodGroup(). The camera then
+draws only the ones for the level selected by @ref LodSelector::select(). See
+@ref LodGroup for more information.
+
+## Sorting drawables
+
+Drawables are by default drawn in the order they were added to the group.
+Passing a @ref DrawQueue to @ref Camera::drawSorted() sorts them by
+@ref sortKey() and distance from the camera first, see its documentation for
+more information.
+
 ## Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -180,6 +200,14 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          */
         explicit Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables = nullptr);
 
+        /**
+         * @brief Destructor
+         *
+         * Removes the drawable from its bounding volume and level of detail
+         * group, if any.
+         */
+        ~Drawable();
+
         /**
          * @brief Group containing this drawable
          *
@@ -194,6 +222,81 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
             return AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>::group();
         }
 
+        /**
+         * @brief Bounding volume
+         *
+         * If the drawable has no bounding volume associated, returns
+         * `nullptr`.
+         * @see @ref Camera::setFrustumCulling()
+         */
+        BoundingVolume<dimensions, T>* boundingVolume() const { return _boundingVolume; }
+
+        /**
+         * @brief Set bounding volume
+         * @return Reference to self (for method chaining)
+         *
+         * The volume is used by @ref Camera::draw() to skip drawables outside
+         * of the camera frustum if @ref Camera::setFrustumCulling() is
+         * enabled. The volume doesn't need to be attached to the same object
+         * as the drawable. If the volume is destroyed, it's removed from all
+         * drawables referencing it. Drawables without any bounding volume
+         * are never culled.
+         */
+        Drawable<dimensions, T>& setBoundingVolume(BoundingVolume<dimensions, T>* volume);
+
+        /**
+         * @brief Level of detail group
+         *
+         * If the drawable has no level of detail group associated, returns
+         * `nullptr`.
+         * @see @ref lodLevel()
+         */
+        LodGroup<dimensions, T>* lodGroup() const { return _lodGroup; }
+
+        /**
+         * @brief Level of detail
+         *
+         * @see @ref lodGroup()
+         */
+        UnsignedInt lodLevel() const { return _lodLevel; }
+
+        /**
+         * @brief Set level of detail group
+         * @param group     Level of detail group or `nullptr`
+         * @param level     Level of detail this drawable represents
+         * @return Reference to self (for method chaining)
+         *
+         * @ref Camera::draw() skips the drawable if @p group is not `nullptr`
+         * and its @ref LodGroup::level() is not @p level. The group doesn't
+         * need to be attached to the same object as the drawable. If the
+         * group is destroyed, it's removed from all drawables referencing
+         * it.
+         */
+        Drawable<dimensions, T>& setLodGroup(LodGroup<dimensions, T>* group, UnsignedInt level);
+
+        /**
+         * @brief Sort key
+         *
+         * Default is `0`.
+         * @see @ref DrawQueue
+         */
+        UnsignedLong sortKey() const { return _sortKey; }
+
+        /**
+         * @brief Set sort key
+         * @return Reference to self (for method chaining)
+         *
+         * Used by @ref DrawQueue to order the drawables so the ones sharing
+         * the same state are drawn together. Only ordering of the keys
+         * matters, so it's up to the application how it encodes shader,
+         * material, mesh or any other state into the key. Put the most
+         * expensive state changes into the highest bits.
+         */
+        Drawable<dimensions, T>& setSortKey(UnsignedLong key) {
+            _sortKey = key;
+            return *this;
+        }
+
         /**
          * @brief Draw the object using given camera
          * @param transformationMatrix  Object transformation relative to camera
@@ -203,6 +306,15 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
          */
         virtual void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+    private:
+        friend BoundingVolume<dimensions, T>;
+        friend LodGroup<dimensions, T>;
+
+        BoundingVolume<dimensions, T>* _boundingVolume;
+        LodGroup<dimensions, T>* _lodGroup;
+        UnsignedInt _lodLevel;
+        UnsignedLong _sortKey;
 };
 
 /**
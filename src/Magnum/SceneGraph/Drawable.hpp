@@ -29,11 +29,47 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Drawable.h
  */
 
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/SceneGraph/BoundingVolume.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/LodGroup.h"
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables) {}
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables), _boundingVolume{}, _lodGroup{}, _lodLevel{}, _sortKey{} {}
+
+namespace Implementation {
+    /* Removes the drawable from back-reference list of a bounding volume or a
+       level of detail group, order doesn't matter */
+    template<class T> void removeDrawable(std::vector<T*>& drawables, T* const drawable) {
+        const auto found = std::find(drawables.begin(), drawables.end(), drawable);
+        CORRADE_INTERNAL_ASSERT(found != drawables.end());
+        *found = drawables.back();
+        drawables.pop_back();
+    }
+}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::~Drawable() {
+    if(_boundingVolume) Implementation::removeDrawable(_boundingVolume->_drawables, this);
+    if(_lodGroup) Implementation::removeDrawable(_lodGroup->_drawables, this);
+}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::setBoundingVolume(BoundingVolume<dimensions, T>* const volume) {
+    if(_boundingVolume) Implementation::removeDrawable(_boundingVolume->_drawables, this);
+    _boundingVolume = volume;
+    if(volume) volume->_drawables.push_back(this);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::setLodGroup(LodGroup<dimensions, T>* const group, const UnsignedInt level) {
+    if(_lodGroup) Implementation::removeDrawable(_lodGroup->_drawables, this);
+    _lodGroup = group;
+    _lodLevel = level;
+    if(group) group->_drawables.push_back(this);
+    return *this;
+}
 
 }}
 
@@ -32,6 +32,7 @@
 #include "Magnum/Math/DualComplex.h"
 #include "Magnum/SceneGraph/AbstractTranslationRotation2D.h"
 #include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -277,6 +278,7 @@ template<class T> struct Transformation<BasicDualComplexTransformation<T>> {
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template class MAGNUM_SCENEGRAPH_EXPORT Object<BasicDualComplexTransformation<Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Scene<BasicDualComplexTransformation<Float>>;
 #endif
 
 }}
@@ -32,6 +32,7 @@
 #include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/SceneGraph/AbstractTranslationRotation3D.h"
 #include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -352,6 +353,7 @@ template<class T> struct Transformation<BasicDualQuaternionTransformation<T>> {
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template class MAGNUM_SCENEGRAPH_EXPORT Object<BasicDualQuaternionTransformation<Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Scene<BasicDualQuaternionTransformation<Float>>;
 #endif
 
 }}
@@ -0,0 +1,243 @@
+#ifndef Magnum_SceneGraph_LodGroup_h
+#define Magnum_SceneGraph_LodGroup_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::LodGroup, alias @ref Magnum::SceneGraph::BasicLodGroup2D, @ref Magnum::SceneGraph::BasicLodGroup3D, typedef @ref Magnum::SceneGraph::LodGroup2D, @ref Magnum::SceneGraph::LodGroup3D
+ */
+
+#include <initializer_list>
+#include <vector>
+
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Level of detail group
+
+Selects one of several levels of detail of an object based on its size on the
+screen. The group is described by a bounding radius around the object origin
+and a list of thresholds. Each @ref LodGroup is part of some @ref LodSelector,
+which calculates the screen size of all its groups in a single pass and
+selects the level for each.
+
+## Usage
+
+The thresholds are fractions of the viewport height that the bounding sphere
+diameter needs to cover for given level to be selected, in decreasing order.
+If the object is smaller than the last threshold, no level is selected and
+@ref level() is equal to @ref levelCount(). The drawables of each level then
+reference the group using @ref Drawable::setLodGroup() and
+@ref Camera::draw() skips those that don't belong to the selected level,
+without any additional calculation:
+@code
+SceneGraph::LodSelector3D lodSelector;
+SceneGraph::DrawableGroup3D drawables;
+
+Object3D* tree = new Object3D{&scene};
+auto lod = new SceneGraph::LodGroup3D{*tree, 2.5f, {0.4f, 0.1f, 0.01f}, &lodSelector};
+(new TreeDrawable{*tree, highDetailMesh, &drawables})->setLodGroup(lod, 0);
+(new TreeDrawable{*tree, mediumDetailMesh, &drawables})->setLodGroup(lod, 1);
+(new TreeDrawable{*tree, billboardMesh, &drawables})->setLodGroup(lod, 2);
+
+void MyApplication::drawEvent() {
+    lodSelector.select(*camera);
+    camera->draw(drawables);
+    // ...
+}
+@endcode
+
+The tree above is drawn with the high detail mesh if it covers at least 40%
+of the viewport height, with the billboard if it covers at least 1% and not
+at all if it's smaller than that. The selected level can be also queried
+directly using @ref level(), for example to switch meshes inside a single
+drawable.
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref LodGroup.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref LodGroup2D, @ref LodSelector2D
+-   @ref LodGroup3D, @ref LodSelector3D
+
+@see @ref scenegraph, @ref BasicLodGroup2D, @ref BasicLodGroup3D,
+    @ref LodGroup2D, @ref LodGroup3D, @ref LodSelector
+*/
+template<UnsignedInt dimensions, class T> class LodGroup: public AbstractGroupedFeature<dimensions, LodGroup<dimensions, T>, T> {
+    friend LodSelector<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object        Object this group belongs to
+         * @param radius        Bounding radius around the object origin
+         * @param thresholds    Screen size thresholds of all levels
+         * @param selector      Selector this group belongs to
+         *
+         * Adds the feature to the object and also to the selector, if
+         * specified. Otherwise you can use @ref LodSelector::add(). See
+         * @ref setThresholds() for requirements on the thresholds. The
+         * finest level is selected until the first call to
+         * @ref LodSelector::select().
+         */
+        explicit LodGroup(AbstractObject<dimensions, T>& object, T radius, std::vector<T> thresholds, LodSelector<dimensions, T>* selector = nullptr);
+
+        /** @overload */
+        explicit LodGroup(AbstractObject<dimensions, T>& object, T radius, std::initializer_list<T> thresholds, LodSelector<dimensions, T>* selector = nullptr): LodGroup{object, radius, std::vector<T>{thresholds}, selector} {}
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the group from all drawables referencing it.
+         * @see @ref Drawable::setLodGroup()
+         */
+        ~LodGroup();
+
+        /**
+         * @brief Selector containing this group
+         *
+         * If the group doesn't belong to any selector, returns `nullptr`.
+         */
+        LodSelector<dimensions, T>* selector();
+        const LodSelector<dimensions, T>* selector() const; /**< @overload */
+
+        /** @brief Bounding radius */
+        T radius() const { return _radius; }
+
+        /**
+         * @brief Set bounding radius
+         * @return Reference to self (for method chaining)
+         *
+         * Radius of a sphere around the object origin containing all levels.
+         * The radius is scaled with the object transformation.
+         */
+        LodGroup<dimensions, T>& setRadius(T radius) {
+            _radius = radius;
+            return *this;
+        }
+
+        /** @brief Screen size thresholds */
+        const std::vector<T>& thresholds() const { return _thresholds; }
+
+        /**
+         * @brief Set screen size thresholds
+         * @return Reference to self (for method chaining)
+         *
+         * Level @f$ i @f$ is selected if the bounding sphere diameter covers
+         * at least @f$ t_i @f$ of the viewport height and the level before
+         * it wasn't selected. Expects that there is at least one threshold
+         * and the thresholds are positive and strictly decreasing. If the
+         * currently selected level doesn't exist anymore, the coarsest level
+         * is selected.
+         */
+        LodGroup<dimensions, T>& setThresholds(std::vector<T> thresholds);
+
+        /** @overload */
+        LodGroup<dimensions, T>& setThresholds(std::initializer_list<T> thresholds) {
+            return setThresholds(std::vector<T>{thresholds});
+        }
+
+        /** @brief Level count */
+        UnsignedInt levelCount() const { return _thresholds.size(); }
+
+        /**
+         * @brief Selected level
+         *
+         * Level selected by the last @ref LodSelector::select(), `0` being
+         * the finest. If the object was too small for any level, returns
+         * @ref levelCount().
+         */
+        UnsignedInt level() const { return _level; }
+
+        /**
+         * @brief Screen size
+         *
+         * Fraction of viewport height covered by the bounding sphere
+         * diameter, calculated in the last @ref LodSelector::select(). If the
+         * camera is inside of the bounding sphere or the object is behind the
+         * camera, the size is infinite.
+         */
+        T screenSize() const { return _screenSize; }
+
+    private:
+        friend Drawable<dimensions, T>;
+
+        T _radius;
+        std::vector<T> _thresholds;
+        T _screenSize;
+        UnsignedInt _level;
+        std::vector<Drawable<dimensions, T>*> _drawables;
+};
+
+/**
+@brief Level of detail group for two-dimensional scenes
+
+Convenience alternative to `LodGroup<2, T>`. See @ref LodGroup for more
+information.
+@see @ref LodGroup2D, @ref BasicLodGroup3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLodGroup2D = LodGroup<2, T>;
+#endif
+
+/**
+@brief Level of detail group for two-dimensional float scenes
+
+@see @ref LodGroup3D
+*/
+typedef BasicLodGroup2D<Float> LodGroup2D;
+
+/**
+@brief Level of detail group for three-dimensional scenes
+
+Convenience alternative to `LodGroup<3, T>`. See @ref LodGroup for more
+information.
+@see @ref LodGroup3D, @ref BasicLodGroup2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLodGroup3D = LodGroup<3, T>;
+#endif
+
+/**
+@brief Level of detail group for three-dimensional float scenes
+
+@see @ref LodGroup2D
+*/
+typedef BasicLodGroup3D<Float> LodGroup3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT LodGroup<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT LodGroup<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef Magnum_SceneGraph_LodGroup_hpp
+#define Magnum_SceneGraph_LodGroup_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref LodGroup.h and @ref LodSelector.h
+ */
+
+#include <limits>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/LodGroup.h"
+#include "Magnum/SceneGraph/LodSelector.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<UnsignedInt dimensions, class T> LodGroup<dimensions, T>::LodGroup(AbstractObject<dimensions, T>& object, const T radius, std::vector<T> thresholds, LodSelector<dimensions, T>* selector): AbstractGroupedFeature<dimensions, LodGroup<dimensions, T>, T>(object, selector), _radius{radius}, _screenSize{}, _level{} {
+    setThresholds(std::move(thresholds));
+}
+
+template<UnsignedInt dimensions, class T> LodGroup<dimensions, T>::~LodGroup() {
+    for(Drawable<dimensions, T>* drawable: _drawables)
+        drawable->_lodGroup = nullptr;
+}
+
+template<UnsignedInt dimensions, class T> LodSelector<dimensions, T>* LodGroup<dimensions, T>::selector() {
+    return static_cast<LodSelector<dimensions, T>*>(AbstractGroupedFeature<dimensions, LodGroup<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> const LodSelector<dimensions, T>* LodGroup<dimensions, T>::selector() const {
+    return static_cast<const LodSelector<dimensions, T>*>(AbstractGroupedFeature<dimensions, LodGroup<dimensions, T>, T>::group());
+}
+
+template<UnsignedInt dimensions, class T> LodGroup<dimensions, T>& LodGroup<dimensions, T>::setThresholds(std::vector<T> thresholds) {
+    CORRADE_ASSERT(!thresholds.empty(),
+        "SceneGraph::LodGroup::setThresholds(): expected at least one threshold", *this);
+    for(std::size_t i = 0; i != thresholds.size(); ++i) CORRADE_ASSERT(thresholds[i] > T(0) && (i == 0 || thresholds[i] < thresholds[i - 1]),
+        "SceneGraph::LodGroup::setThresholds(): thresholds are not positive and strictly decreasing", *this);
+
+    _thresholds = std::move(thresholds);
+    _level = Math::min(_level, UnsignedInt(_thresholds.size()));
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void LodSelector<dimensions, T>::select(Camera<dimensions, T>& camera) {
+    const std::size_t count = this->size();
+    if(!count) return;
+
+    AbstractObject<dimensions, T>* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::LodSelector::select(): camera is not part of any scene", );
+
+    /* Compute camera matrix */
+    camera.object().setClean();
+
+    /* Transformations of all objects relative to the camera at once */
+    _objects.clear();
+    for(std::size_t i = 0; i != count; ++i)
+        _objects.push_back((*this)[i].object());
+    _transformations.resize(count);
+    scene->transformationMatrices({_objects.data(), _objects.size()}, {_transformations.data(), _transformations.size()}, camera.cameraMatrix());
+
+    /* Bounding sphere diameter relative to viewport height. The last row of
+       the projection matrix gives the w coordinate (i.e. depth for
+       perspective projection and 1 for orthographic), the vertical scale
+       gives how much of the [-1, 1] range an unit at depth 1 covers. Largest
+       axis scale of each object is applied to the radius. */
+    const MatrixTypeFor<dimensions, T>& projection = camera.projectionMatrix();
+    const Math::Vector<dimensions + 1, T> w = projection.row(dimensions);
+    const T projectionScale = Math::abs(projection[1][1]);
+    _screenSizes.resize(count);
+    for(std::size_t i = 0; i != count; ++i) {
+        const MatrixTypeFor<dimensions, T>& transformation = _transformations[i];
+
+        T scaleSquared{};
+        T depth = w[dimensions];
+        for(std::size_t j = 0; j != dimensions; ++j) {
+            T axisSquared{};
+            for(std::size_t k = 0; k != dimensions; ++k)
+                axisSquared += transformation[j][k]*transformation[j][k];
+            scaleSquared = Math::max(scaleSquared, axisSquared);
+            depth += w[j]*transformation[dimensions][j];
+        }
+
+        _screenSizes[i] = depth > T(0) ?
+            (*this)[i]._radius*std::sqrt(scaleSquared)*projectionScale/depth :
+            std::numeric_limits<T>::infinity();
+    }
+
+    /* Select the levels. Thresholds between the current level and coarser
+       levels are lowered and thresholds between the current level and finer
+       levels raised by the hysteresis, so small changes in the size don't
+       cause switching back and forth. */
+    const T lower = T(1) - _hysteresis;
+    const T upper = T(1) + _hysteresis;
+    for(std::size_t i = 0; i != count; ++i) {
+        LodGroup<dimensions, T>& group = (*this)[i];
+        const T size = group._screenSize = _screenSizes[i];
+        const UnsignedInt levelCount = group._thresholds.size();
+
+        UnsignedInt level = 0;
+        for(; level != levelCount; ++level)
+            if(size >= group._thresholds[level]*(group._level <= level ? lower : upper)) break;
+        group._level = level;
+    }
+}
+
+}}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef Magnum_SceneGraph_LodSelector_h
+#define Magnum_SceneGraph_LodSelector_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::LodSelector, alias @ref Magnum::SceneGraph::BasicLodSelector2D, @ref Magnum::SceneGraph::BasicLodSelector3D, typedef @ref Magnum::SceneGraph::LodSelector2D, @ref Magnum::SceneGraph::LodSelector3D
+ */
+
+#include <functional>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Level of detail selector
+
+Group of @ref LodGroup features. See @ref LodGroup for more information.
+
+@anchor SceneGraph-LodSelector-hysteresis
+## Hysteresis
+
+An object with screen size near one of the thresholds would switch back and
+forth between two levels on small camera movements, causing visible popping.
+With @ref setHysteresis() the switch to a coarser level happens only after the
+screen size drops given fraction below the threshold and the switch back to
+the finer level only after it gets the same fraction above it.
+
+## Performance
+
+@ref select() calculates transformations of all objects relative to the
+camera in a single batch using @ref AbstractObject::transformationMatrices(),
+then calculates the screen sizes in one tight loop and selects the levels in
+another. Memory for the calculation is kept in the selector and reused, so
+after the first call no allocations are done.
+
+@see @ref scenegraph, @ref BasicLodSelector2D, @ref BasicLodSelector3D,
+    @ref LodSelector2D, @ref LodSelector3D
+*/
+template<UnsignedInt dimensions, class T> class LodSelector: public FeatureGroup<dimensions, LodGroup<dimensions, T>, T> {
+    public:
+        /** @brief Constructor */
+        explicit LodSelector(): _hysteresis{T(0)} {}
+
+        /**
+         * @brief Hysteresis
+         *
+         * Default is `0`.
+         */
+        T hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Set hysteresis
+         * @return Reference to self (for method chaining)
+         *
+         * Fraction of the threshold by which the screen size needs to
+         * cross it to switch to another level. See
+         * @ref SceneGraph-LodSelector-hysteresis "class documentation" for
+         * more information. Expects that the value is in range
+         * @f$ [0, 1) @f$.
+         */
+        LodSelector<dimensions, T>& setHysteresis(T hysteresis) {
+            CORRADE_ASSERT(hysteresis >= T(0) && hysteresis < T(1),
+                "SceneGraph::LodSelector::setHysteresis(): expected a value in range [0, 1) but got" << hysteresis, *this);
+            _hysteresis = hysteresis;
+            return *this;
+        }
+
+        /**
+         * @brief Select levels for given camera
+         *
+         * Calculates @ref LodGroup::screenSize() of all groups using
+         * projection of given camera and updates @ref LodGroup::level()
+         * accordingly. Expects that the camera is part of the same scene as
+         * all the groups.
+         */
+        void select(Camera<dimensions, T>& camera);
+
+    private:
+        T _hysteresis;
+
+        /* Scratch memory, reused between calls */
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> _objects;
+        std::vector<MatrixTypeFor<dimensions, T>> _transformations;
+        std::vector<T> _screenSizes;
+};
+
+/**
+@brief Level of detail selector for two-dimensional scenes
+
+Convenience alternative to `LodSelector<2, T>`. See @ref LodGroup for more
+information.
+@see @ref LodSelector2D, @ref BasicLodSelector3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLodSelector2D = LodSelector<2, T>;
+#endif
+
+/**
+@brief Level of detail selector for two-dimensional float scenes
+
+@see @ref LodSelector3D
+*/
+typedef BasicLodSelector2D<Float> LodSelector2D;
+
+/**
+@brief Level of detail selector for three-dimensional scenes
+
+Convenience alternative to `LodSelector<3, T>`. See @ref LodGroup for more
+information.
+@see @ref LodSelector3D, @ref BasicLodSelector2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicLodSelector3D = LodSelector<3, T>;
+#endif
+
+/**
+@brief Level of detail selector for three-dimensional float scenes
+
+@see @ref LodSelector2D
+*/
+typedef BasicLodSelector3D<Float> LodSelector3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT LodSelector<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT LodSelector<3, Float>;
+#endif
+
+}}
+
+#endif
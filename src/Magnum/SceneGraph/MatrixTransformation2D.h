@@ -32,6 +32,7 @@
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/SceneGraph/AbstractTranslationRotationScaling2D.h"
 #include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -320,6 +321,7 @@ template<class T> struct Transformation<BasicMatrixTransformation2D<T>> {
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template class MAGNUM_SCENEGRAPH_EXPORT Object<BasicMatrixTransformation2D<Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Scene<BasicMatrixTransformation2D<Float>>;
 #endif
 
 }}
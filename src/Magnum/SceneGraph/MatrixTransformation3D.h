@@ -32,6 +32,7 @@
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/SceneGraph/AbstractTranslationRotationScaling3D.h"
 #include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -455,6 +456,7 @@ template<class T> struct Transformation<BasicMatrixTransformation3D<T>> {
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template class MAGNUM_SCENEGRAPH_EXPORT Object<BasicMatrixTransformation3D<Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Scene<BasicMatrixTransformation3D<Float>>;
 #endif
 
 }}
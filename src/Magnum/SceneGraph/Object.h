@@ -41,12 +41,16 @@ namespace Implementation {
     enum class ObjectFlag: UnsignedByte {
         Dirty = 1 << 0,
         Visited = 1 << 1,
-        Joint = 1 << 2
+        Joint = 1 << 2,
+        FlattenedDirty = 1 << 3,
+        HierarchyChanged = 1 << 4
     };
 
     typedef Containers::EnumSet<ObjectFlag> ObjectFlags;
 
     CORRADE_ENUMSET_OPERATORS(ObjectFlags)
+
+    template<class> struct ObjectSnapshot;
 }
 
 /**
@@ -113,6 +117,8 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 {
     friend Containers::LinkedList<Object<Transformation>>;
     friend Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
+    friend Scene<Transformation>;
+    friend Implementation::ObjectSnapshot<Transformation>;
 
     public:
         /** @brief Matrix type */
@@ -295,16 +301,43 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object
+         *
+         * Same as above, but puts the result into @p out, which is expected
+         * to have the same size as @p objects. The temporary storage is kept
+         * in the scene and reused between calls, so in a steady state this
+         * function doesn't allocate.
+         */
+        void transformationMatrices(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
         /**
          * @brief Transformations of given group of objects relative to this object
          *
          * All transformations can be premultiplied with @p initialTransformation,
-         * if specified.
+         * if specified. If this object is a @ref Scene with
+         * @ref Scene::setFlattened() "flattened hierarchy" enabled, the
+         * flattened hierarchy is updated and the transformations are taken
+         * from it instead of walking the hierarchy up from each object.
          * @see @ref transformationMatrices()
          */
-        /* `objects` passed by copy intentionally (to allow move from
-           transformationMatrices() and avoid copy in the function itself) */
-        std::vector<typename Transformation::DataType> transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation =
+        std::vector<typename Transformation::DataType> transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const typename Transformation::DataType& initialTransformation =
+            #ifndef CORRADE_MSVC2015_COMPATIBILITY /* I hate this inconsistency */
+            typename Transformation::DataType()
+            #else
+            Transformation::DataType()
+            #endif
+            ) const;
+
+        /**
+         * @brief Transformations of given group of objects relative to this object
+         *
+         * Same as above, but puts the result into @p out, which is expected
+         * to have the same size as @p objects. The temporary storage is kept
+         * in the scene and reused between calls, so in a steady state this
+         * function doesn't allocate.
+         */
+        void transformations(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, Containers::ArrayView<typename Transformation::DataType> out, const typename Transformation::DataType& initialTransformation =
             #ifndef CORRADE_MSVC2015_COMPATIBILITY /* I hate this inconsistency */
             typename Transformation::DataType()
             #else
@@ -323,8 +356,12 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /**
          * @brief Clean absolute transformations of given set of objects
          *
-         * Only dirty objects in the list are cleaned.
-         * @see @ref setClean()
+         * Only dirty objects in the list are cleaned. The absolute
+         * transformations are computed in a single batch and converted to
+         * matrices in bulk before features are cleaned. See
+         * @ref SceneGraph-Scene-clean for a way to clean thread-safe features
+         * in parallel.
+         * @see @ref setClean(), @ref Scene::beginClean()
          */
         /* `objects` passed by copy intentionally (to avoid copy internally) */
         static void setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects);
@@ -374,6 +411,11 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         }
 
         std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const override final;
+        void doTransformationMatrices(Containers::ArrayView<const std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>> objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix) const override final;
+
+        /* Computes the transformations into temporary storage in the scene,
+           returns empty view on failure */
+        Containers::ArrayView<const typename Transformation::DataType> MAGNUM_SCENEGRAPH_LOCAL computeTransformations(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const;
 
         typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
 
@@ -381,13 +423,19 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
         void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) override final;
+        std::size_t doBeginClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) override final;
+        void doCleanChunk(std::size_t chunk) override final;
 
         void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal(const typename Transformation::DataType& absoluteTransformation);
 
+        /* Topmost parent, the scene if the object is part of any */
+        Object<Transformation>* root();
+
         typedef Implementation::ObjectFlag Flag;
         typedef Implementation::ObjectFlags Flags;
         UnsignedShort counter;
         Flags flags;
+        UnsignedInt flattenedIndex;
 };
 
 }}
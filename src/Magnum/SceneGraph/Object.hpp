@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AbstractObject.h, @ref AbstractTransformation.h and @ref Object.h
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AbstractObject.h, @ref AbstractTransformation.h, @ref Object.h and @ref Scene.h
  */
 
 #include <algorithm>
@@ -43,11 +43,30 @@ template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~Abstra
 
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
-template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
+template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty|Flag::FlattenedDirty), flattenedIndex(0xFFFFFFFFu) {
     setParent(parent);
 }
 
-template<class Transformation> Object<Transformation>::~Object() = default;
+template<class Transformation> Object<Transformation>::~Object() {
+    /* Removing the object changes the hierarchy of the scene it's in */
+    if(parent()) {
+        root()->flags |= Flag::HierarchyChanged;
+        parent()->Containers::template LinkedList<Object<Transformation>>::cut(this);
+    }
+
+    /* Delete the children now, while they can be disconnected from this
+       object first, so they don't need to look for a scene anymore */
+    while(Object<Transformation>* child = children().first()) {
+        children().cut(child);
+        delete child;
+    }
+}
+
+template<class Transformation> Object<Transformation>* Object<Transformation>::root() {
+    Object<Transformation>* p = this;
+    while(p->parent()) p = p->parent();
+    return p;
+}
 
 template<class Transformation> Scene<Transformation>* Object<Transformation>::scene() {
     Object<Transformation>* p(this);
@@ -82,19 +101,26 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
     /** @todo Assert for setting parent to scene */
     if(this->parent() == parent || isScene()) return *this;
 
-    /* Object cannot be parented to its child */
-    Object<Transformation>* p = parent;
-    while(p) {
+    /* Object cannot be parented to its child. Remember the topmost parent
+       to mark its hierarchy as changed. */
+    Object<Transformation>* newRoot = nullptr;
+    for(Object<Transformation>* p = parent; p; p = p->parent()) {
         /** @todo Assert for this */
         if(p == this) return *this;
-        p = p->parent();
+        newRoot = p;
     }
 
     /* Remove the object from old parent children list */
-    if(this->parent()) this->parent()->Containers::template LinkedList<Object<Transformation>>::cut(this);
+    if(this->parent()) {
+        root()->flags |= Flag::HierarchyChanged;
+        this->parent()->Containers::template LinkedList<Object<Transformation>>::cut(this);
+    }
 
     /* Add the object to list of new parent */
-    if(parent) parent->Containers::LinkedList<Object<Transformation>>::insert(this);
+    if(parent) {
+        newRoot->flags |= Flag::HierarchyChanged;
+        parent->Containers::LinkedList<Object<Transformation>>::insert(this);
+    }
 
     setDirty();
     return *this;
@@ -117,12 +143,12 @@ template<class Transformation> typename Transformation::DataType Object<Transfor
 }
 
 template<class Transformation> void Object<Transformation>::setDirty() {
-    /* The transformation of this object (and all children) is already dirty,
-       nothing to do */
-    if(flags & Flag::Dirty) return;
+    /* The transformation of this object (and all children) is already dirty
+       both for features and for the flattened hierarchy, nothing to do */
+    if((flags & (Flag::Dirty|Flag::FlattenedDirty)) == (Flag::Dirty|Flag::FlattenedDirty)) return;
 
-    /* Make all features dirty */
-    for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features())
+    /* Make all features dirty, if not already */
+    if(!(flags & Flag::Dirty)) for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features())
         feature.markDirty();
 
     /* Make all children dirty */
@@ -130,7 +156,7 @@ template<class Transformation> void Object<Transformation>::setDirty() {
         child.setDirty();
 
     /* Mark object as dirty */
-    flags |= Flag::Dirty;
+    flags |= Flag::Dirty|Flag::FlattenedDirty;
 }
 
 template<class Transformation> void Object<Transformation>::setClean() {
@@ -176,18 +202,54 @@ template<class Transformation> auto Object<Transformation>::doTransformationMatr
     /** @todo Ensure this doesn't crash, somehow */
     for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
 
-    return transformationMatrices(std::move(castObjects), initialTransformationMatrix);
+    return transformationMatrices(castObjects, initialTransformationMatrix);
+}
+
+template<class Transformation> void Object<Transformation>::doTransformationMatrices(Containers::ArrayView<const std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>> objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix) const {
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", );
+
+    /* The function is const only because it doesn't change the
+       transformations, the temporary storage is updated the same way as the
+       object flags in computeTransformations() */
+    Scene<Transformation>& scene = const_cast<Scene<Transformation>&>(static_cast<const Scene<Transformation>&>(*this));
+    scene._scratchCastObjects.clear();
+    /** @todo Ensure this doesn't crash, somehow */
+    for(auto o: objects) scene._scratchCastObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+
+    transformationMatrices({scene._scratchCastObjects.data(), scene._scratchCastObjects.size()}, out, initialTransformationMatrix);
 }
 
 template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
+    const Containers::ArrayView<const typename Transformation::DataType> transformations = computeTransformations({objects.data(), objects.size()}, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
     std::vector<MatrixType> transformationMatrices(transformations.size());
-    for(std::size_t i = 0; i != objects.size(); ++i)
+    for(std::size_t i = 0; i != transformations.size(); ++i)
         transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
 
     return transformationMatrices;
 }
 
+template<class Transformation> void Object<Transformation>::transformationMatrices(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, Containers::ArrayView<MatrixType> out, const MatrixType& initialTransformationMatrix) const {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::Object::transformationMatrices(): expected" << objects.size() << "output matrices but got" << out.size(), );
+
+    const Containers::ArrayView<const typename Transformation::DataType> transformations = computeTransformations(objects, Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        out[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+}
+
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const typename Transformation::DataType& initialTransformation) const {
+    const Containers::ArrayView<const typename Transformation::DataType> transformations = computeTransformations({objects.data(), objects.size()}, initialTransformation);
+    return std::vector<typename Transformation::DataType>(transformations.begin(), transformations.end());
+}
+
+template<class Transformation> void Object<Transformation>::transformations(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, Containers::ArrayView<typename Transformation::DataType> out, const typename Transformation::DataType& initialTransformation) const {
+    CORRADE_ASSERT(out.size() == objects.size(),
+        "SceneGraph::Object::transformations(): expected" << objects.size() << "output transformations but got" << out.size(), );
+
+    const Containers::ArrayView<const typename Transformation::DataType> transformations = computeTransformations(objects, initialTransformation);
+    std::copy(transformations.begin(), transformations.end(), out.begin());
+}
+
 /*
 Computing absolute transformations for given list of objects
 
@@ -201,12 +263,40 @@ divided into two groups:
 Then for all joints their transformation (relative to parent joint) is
 computed and recursively concatenated together. Resulting transformations for
 joints which were originally in `object` list is then returned.
+
+All temporary storage is kept in the scene and reused between calls.
 */
-template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
+template<class Transformation> auto Object<Transformation>::computeTransformations(const Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> originalObjects, const typename Transformation::DataType& initialTransformation) const -> Containers::ArrayView<const typename Transformation::DataType> {
+    /* Nearest common ancestor not yet implemented - assert this is done on scene */
+    CORRADE_ASSERT(isScene(), "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
+
+    /* The function is const only because it doesn't change the
+       transformations, the caches and temporary storage are updated the same
+       way as the object flags below */
+    Scene<Transformation>& scene = const_cast<Scene<Transformation>&>(static_cast<const Scene<Transformation>&>(*this));
+    std::vector<typename Transformation::DataType>& jointTransformations = scene._scratchJointTransformations;
+
+    /* If this is a scene with flattened hierarchy, just pick the cached
+       transformations from there */
+    if(scene.isFlattened()) {
+        scene.updateFlattened();
+
+        jointTransformations.clear();
+        for(Object<Transformation>& o: originalObjects) {
+            CORRADE_ASSERT(o.flattenedIndex < scene._flattenedObjects.size() && scene._flattenedObjects[o.flattenedIndex] == &o,
+                "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
+            jointTransformations.push_back(Implementation::Transformation<Transformation>::compose(initialTransformation, scene._flattenedTransformations[o.flattenedIndex]));
+        }
+
+        return {jointTransformations.data(), jointTransformations.size()};
+    }
+
+    CORRADE_ASSERT(originalObjects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
 
     /* Remember object count for later */
-    std::size_t objectCount = objects.size();
+    std::size_t objectCount = originalObjects.size();
+    std::vector<std::reference_wrapper<Object<Transformation>>>& objects = scene._scratchObjects;
+    objects.assign(originalObjects.begin(), originalObjects.end());
 
     /* Mark all original objects as joints and create initial list of joints
        from them */
@@ -218,15 +308,8 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
         objects[i].get().counter = UnsignedShort(i);
         objects[i].get().flags |= Flag::Joint;
     }
-    std::vector<std::reference_wrapper<Object<Transformation>>> jointObjects(objects);
-
-    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
-    /* Scene object */
-    const Scene<Transformation>* scene = this->scene();
-    #endif
-
-    /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
+    std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects = scene._scratchJointObjects;
+    jointObjects.assign(objects.begin(), objects.end());
 
     /* Mark all objects up the hierarchy as visited */
     auto it = objects.begin();
@@ -244,7 +327,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
 
         /* If this is root object, remove from list */
         if(!parent) {
-            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
+            CORRADE_ASSERT(&it->get() == &scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
             it = objects.erase(it);
 
         /* Parent is an joint or already visited - remove current from list */
@@ -270,7 +353,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     }
 
     /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
+    jointTransformations.resize(jointObjects.size());
 
     /* Compute transformations for all joints */
     for(std::size_t i = 0; i != jointTransformations.size(); ++i)
@@ -292,9 +375,8 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
         i.get().counter = 0xFFFFu;
     }
 
-    /* Shrink the array to contain only transformations of requested objects and return */
-    jointTransformations.resize(objectCount);
-    return jointTransformations;
+    /* Only transformations of requested objects are returned */
+    return {jointTransformations.data(), objectCount};
 }
 
 template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
@@ -343,43 +425,35 @@ template<class Transformation> void Object<Transformation>::doSetClean(const std
     setClean(std::move(castObjects));
 }
 
-template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects) {
-    /* Remove all clean objects from the list */
-    auto firstClean = std::remove_if(objects.begin(), objects.end(), [](Object<Transformation>& o) { return !o.isDirty(); });
-    objects.erase(firstClean, objects.end());
+template<class Transformation> std::size_t Object<Transformation>::doBeginClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) {
+    std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
+    castObjects.reserve(objects.size());
+    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
 
-    /* No dirty objects left, done */
-    if(objects.empty()) return;
+    /* Find the scene of the first dirty object, nothing to do if there is
+       none */
+    auto firstDirty = std::find_if(castObjects.begin(), castObjects.end(), [](Object<Transformation>& o) { return o.isDirty(); });
+    if(firstDirty == castObjects.end()) return 0;
 
-    /* Add non-clean parents to the list. Mark each added object as visited, so
-       they aren't added more than once */
-    for(std::size_t end = objects.size(), i = 0; i != end; ++i) {
-        Object<Transformation>& o = objects[i];
-        o.flags |= Flag::Visited;
+    Scene<Transformation>* scene = firstDirty->get().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::AbstractObject::beginClean(): objects must be part of some scene", 0);
+    return scene->beginClean(castObjects);
+}
 
-        Object<Transformation>* parent = o.parent();
-        while(parent && !(parent->flags & Flag::Visited) && parent->isDirty()) {
-            objects.push_back(*parent);
-            parent = parent->parent();
-        }
-    }
+template<class Transformation> void Object<Transformation>::doCleanChunk(const std::size_t chunk) {
+    CORRADE_ASSERT(isScene(), "SceneGraph::AbstractObject::cleanChunk(): the object is not a scene", );
+    static_cast<Scene<Transformation>*>(this)->cleanChunk(chunk);
+}
 
-    /* Cleanup all marks */
-    for(auto o: objects) o.get().flags &= ~Flag::Visited;
+template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects) {
+    /* Find the scene of the first dirty object, nothing to do if there is
+       none */
+    auto firstDirty = std::find_if(objects.begin(), objects.end(), [](Object<Transformation>& o) { return o.isDirty(); });
+    if(firstDirty == objects.end()) return;
 
-    /* Compute absolute transformations */
-    Scene<Transformation>* scene = objects[0].get().scene();
+    Scene<Transformation>* scene = firstDirty->get().scene();
     CORRADE_ASSERT(scene, "Object::setClean(): objects must be part of some scene", );
-    std::vector<typename Transformation::DataType> transformations(scene->transformations(objects));
-
-    /* Go through all objects and clean them */
-    for(std::size_t i = 0; i != objects.size(); ++i) {
-        /* The object might be duplicated in the list, don't clean it more than once */
-        if(!objects[i].get().isDirty()) continue;
-
-        objects[i].get().setCleanInternal(transformations[i]);
-        CORRADE_ASSERT(!objects[i].get().isDirty(), "SceneGraph::Object::setClean(): original implementation was not called", );
-    }
+    scene->cleanInternal({objects.data(), objects.size()}, false);
 }
 
 template<class Transformation> void Object<Transformation>::setCleanInternal(const typename Transformation::DataType& absoluteTransformation) {
@@ -417,6 +491,248 @@ template<class Transformation> void Object<Transformation>::setCleanInternal(con
     flags &= ~Flag::Dirty;
 }
 
+namespace Implementation {
+
+/* Measures the clean phases only if there's a callback */
+template<class Callback> struct CleanTimer {
+    explicit CleanTimer(Callback callback, void* userData): callback{callback}, userData{userData} {
+        if(callback) previous = std::chrono::high_resolution_clock::now();
+    }
+
+    void phase(CleanPhase phase) {
+        if(!callback) return;
+        const std::chrono::high_resolution_clock::time_point now = std::chrono::high_resolution_clock::now();
+        callback(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(now - previous), userData);
+        previous = now;
+    }
+
+    Callback callback;
+    void* userData;
+    std::chrono::high_resolution_clock::time_point previous;
+};
+
+}
+
+template<class Transformation> Scene<Transformation>& Scene<Transformation>::setCleanChunkSize(const std::size_t size) {
+    CORRADE_ASSERT(size, "SceneGraph::Scene::setCleanChunkSize(): chunk size can't be zero", *this);
+    _cleanChunkSize = size;
+    return *this;
+}
+
+template<class Transformation> std::size_t Scene<Transformation>::beginClean(const Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects) {
+    CORRADE_ASSERT(!_cleaning, "SceneGraph::Scene::beginClean(): can't be called from a feature being cleaned", 0);
+    return cleanInternal(objects, true);
+}
+
+template<class Transformation> std::size_t Scene<Transformation>::cleanInternal(const Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, const bool deferThreadSafe) {
+    typedef typename Object<Transformation>::Flag Flag;
+    Implementation::CleanTimer<CleanTimingCallback> timer{_cleanTimingCallback, _cleanTimingUserData};
+
+    /* If called from a feature being cleaned, the storage is still being
+       iterated by the outer call, so use a local one instead */
+    CleanStorage local;
+    CleanStorage& s = _cleaning ? local : _clean;
+
+    /* Chunks from the previous call are expected to be executed already */
+    s.deferred.clear();
+
+    /* Collect dirty objects, each only once. Mark each added object as
+       visited, so it isn't added again when it's duplicated in the list or is
+       a common parent of more objects. */
+    s.objects.clear();
+    for(Object<Transformation>& o: objects) {
+        if(!o.isDirty() || (o.flags & Flag::Visited)) continue;
+        o.flags |= Flag::Visited;
+        s.objects.push_back(o);
+    }
+
+    /* Add their dirty parents */
+    for(std::size_t end = s.objects.size(), i = 0; i != end; ++i) {
+        Object<Transformation>* parent = s.objects[i].get().parent();
+        while(parent && !(parent->flags & Flag::Visited) && parent->isDirty()) {
+            parent->flags |= Flag::Visited;
+            s.objects.push_back(*parent);
+            parent = parent->parent();
+        }
+    }
+
+    /* Cleanup all marks and gather which transformations the features need.
+       If deferring, the transformations needed only by thread-safe features
+       are computed in cleanChunk() as well, so the expensive inversions get
+       parallelized too. */
+    s.immediateCachedTransformations.clear();
+    s.deferredCachedTransformations.clear();
+    for(Object<Transformation>& o: s.objects) {
+        o.flags &= ~Flag::Visited;
+
+        CachedTransformations immediate, deferred;
+        for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: o.features()) {
+            if(deferThreadSafe && feature.isCleanThreadSafe())
+                deferred |= feature.cachedTransformations();
+            else immediate |= feature.cachedTransformations();
+        }
+        s.immediateCachedTransformations.push_back(immediate);
+        s.deferredCachedTransformations.push_back(deferred);
+    }
+
+    timer.phase(CleanPhase::Collect);
+
+    /* Nothing to clean */
+    if(s.objects.empty()) return 0;
+
+    /* Compute absolute transformations in a single batch. The returned view
+       points to temporary storage that might get overwritten by the features,
+       so it's copied. */
+    const Containers::ArrayView<const typename Transformation::DataType> transformations = this->computeTransformations({s.objects.data(), s.objects.size()}, typename Transformation::DataType{});
+    if(transformations.size() != s.objects.size()) return 0;
+    s.transformations.assign(transformations.begin(), transformations.end());
+
+    timer.phase(CleanPhase::Transformations);
+
+    /* Convert to matrices and invert in bulk, only where needed */
+    if(s.matrices.size() < s.objects.size()) {
+        s.matrices.resize(s.objects.size());
+        s.invertedMatrices.resize(s.objects.size());
+    }
+    for(std::size_t i = 0; i != s.objects.size(); ++i) {
+        if(s.immediateCachedTransformations[i] & CachedTransformation::Absolute)
+            s.matrices[i] = Implementation::Transformation<Transformation>::toMatrix(s.transformations[i]);
+    }
+    for(std::size_t i = 0; i != s.objects.size(); ++i) {
+        if(s.immediateCachedTransformations[i] & CachedTransformation::InvertedAbsolute)
+            s.invertedMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(
+                Implementation::Transformation<Transformation>::inverted(s.transformations[i]));
+    }
+
+    timer.phase(CleanPhase::Matrices);
+
+    /* Clean the features, defer objects with thread-safe features if
+       requested */
+    const bool wasCleaning = _cleaning;
+    _cleaning = true;
+    for(std::size_t i = 0; i != s.objects.size(); ++i) {
+        Object<Transformation>& o = s.objects[i];
+
+        if(s.immediateCachedTransformations[i]) for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: o.features()) {
+            if(deferThreadSafe && feature.isCleanThreadSafe()) continue;
+
+            if(feature.cachedTransformations() & CachedTransformation::Absolute)
+                feature.clean(s.matrices[i]);
+            if(feature.cachedTransformations() & CachedTransformation::InvertedAbsolute)
+                feature.cleanInverted(s.invertedMatrices[i]);
+        }
+
+        if(s.deferredCachedTransformations[i])
+            s.deferred.push_back(UnsignedInt(i));
+
+        o.flags &= ~Flag::Dirty;
+    }
+
+    _cleaning = wasCleaning;
+
+    timer.phase(CleanPhase::Features);
+
+    return (s.deferred.size() + _cleanChunkSize - 1)/_cleanChunkSize;
+}
+
+template<class Transformation> void Scene<Transformation>::cleanChunk(const std::size_t chunk) {
+    CORRADE_ASSERT(chunk < cleanChunkCount(),
+        "SceneGraph::Scene::cleanChunk(): index" << chunk << "out of range for" << cleanChunkCount() << "chunks", );
+
+    const std::size_t end = std::min(_clean.deferred.size(), (chunk + 1)*_cleanChunkSize);
+    for(std::size_t i = chunk*_cleanChunkSize; i != end; ++i) {
+        const UnsignedInt index = _clean.deferred[i];
+
+        /* Compute the transformations that weren't needed by any feature
+           cleaned in beginClean(). Each object is in just one chunk, so this
+           doesn't race with other threads. */
+        const CachedTransformations missing = _clean.deferredCachedTransformations[index] & ~_clean.immediateCachedTransformations[index];
+        if(missing & CachedTransformation::Absolute)
+            _clean.matrices[index] = Implementation::Transformation<Transformation>::toMatrix(_clean.transformations[index]);
+        if(missing & CachedTransformation::InvertedAbsolute)
+            _clean.invertedMatrices[index] = Implementation::Transformation<Transformation>::toMatrix(
+                Implementation::Transformation<Transformation>::inverted(_clean.transformations[index]));
+
+        for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: _clean.objects[index].get().features()) {
+            if(!feature.isCleanThreadSafe()) continue;
+
+            if(feature.cachedTransformations() & CachedTransformation::Absolute)
+                feature.clean(_clean.matrices[index]);
+            if(feature.cachedTransformations() & CachedTransformation::InvertedAbsolute)
+                feature.cleanInverted(_clean.invertedMatrices[index]);
+        }
+    }
+}
+
+template<class Transformation> Scene<Transformation>& Scene<Transformation>::setFlattened(const bool enabled) {
+    _flattened = enabled;
+
+    /* Force a rebuild on next update, free the memory if disabling */
+    this->flags |= Object<Transformation>::Flag::HierarchyChanged;
+    if(!enabled) {
+        std::vector<Object<Transformation>*>{}.swap(_flattenedObjects);
+        std::vector<UnsignedInt>{}.swap(_flattenedParents);
+        std::vector<typename Transformation::DataType>{}.swap(_flattenedTransformations);
+    }
+
+    return *this;
+}
+
+template<class Transformation> UnsignedInt Scene<Transformation>::flattenedIndex(const Object<Transformation>& object) const {
+    CORRADE_ASSERT(object.flattenedIndex < _flattenedObjects.size() && _flattenedObjects[object.flattenedIndex] == &object,
+        "SceneGraph::Scene::flattenedIndex(): the object is not part of the flattened hierarchy", {});
+    return object.flattenedIndex;
+}
+
+template<class Transformation> void Scene<Transformation>::updateFlattened() {
+    CORRADE_ASSERT(_flattened, "SceneGraph::Scene::updateFlattened(): flattened hierarchy is not enabled", );
+
+    typedef typename Object<Transformation>::Flag Flag;
+
+    /* The hierarchy changed since last time, rebuild it. Done as a depth-first
+       traversal going through the linked lists, so parents are always before
+       their children. All transformations are recomputed after that. */
+    if(this->flags & Flag::HierarchyChanged) {
+        _flattenedObjects.clear();
+        _flattenedParents.clear();
+
+        Object<Transformation>* o = this;
+        while(o) {
+            o->flattenedIndex = UnsignedInt(_flattenedObjects.size());
+            o->flags |= Flag::FlattenedDirty;
+            _flattenedObjects.push_back(o);
+            _flattenedParents.push_back(o == this ? 0xFFFFFFFFu : o->parent()->flattenedIndex);
+
+            /* Next object is either the first child, next sibling or next
+               sibling of the nearest parent that has one */
+            if(o->children().first()) {
+                o = o->children().first();
+                continue;
+            }
+            while(o != this && !o->nextSibling()) o = o->parent();
+            o = o == this ? nullptr : o->nextSibling();
+        }
+
+        _flattenedTransformations.resize(_flattenedObjects.size());
+        this->flags &= ~Flag::HierarchyChanged;
+    }
+
+    /* Recompute dirty transformations in one linear pass. Whole subtree is
+       marked dirty by setDirty(), so parent transformation is always
+       up-to-date at this point. */
+    if(this->flags & Flag::FlattenedDirty) {
+        _flattenedTransformations[0] = this->transformation();
+        this->flags &= ~Flag::FlattenedDirty;
+    }
+    for(std::size_t i = 1; i < _flattenedObjects.size(); ++i) {
+        Object<Transformation>& o = *_flattenedObjects[i];
+        if(!(o.flags & Flag::FlattenedDirty)) continue;
+
+        _flattenedTransformations[i] = Implementation::Transformation<Transformation>::compose(_flattenedTransformations[_flattenedParents[i]], o.transformation());
+        o.flags &= ~Flag::FlattenedDirty;
+    }
+}
+
 }}
 
 #endif
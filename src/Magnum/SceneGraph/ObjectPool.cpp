@@ -0,0 +1,173 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ObjectPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+    /* Slabs of all live pools sorted by address, so the deallocation can find
+       the pool owning given memory. Objects are deleted through it also when
+       they're not allocated from any pool, possibly on other threads than
+       the pools are used on, so the access is guarded by a mutex. The pool
+       count allows skipping the lookup altogether if no pool exists. */
+    struct SlabRegistry {
+        std::mutex mutex;
+        std::atomic<std::size_t> poolCount{};
+        std::vector<std::pair<std::uintptr_t, ObjectPool*>> slabs;
+    };
+
+    SlabRegistry& slabRegistry() {
+        static SlabRegistry registry;
+        return registry;
+    }
+
+    ObjectPool* findPool(const void* const memory) {
+        SlabRegistry& registry = slabRegistry();
+        if(!registry.poolCount) return nullptr;
+
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        const std::vector<std::pair<std::uintptr_t, ObjectPool*>>& slabs = registry.slabs;
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory);
+
+        /* Find the last slab starting at or before given address */
+        auto found = std::upper_bound(slabs.begin(), slabs.end(), address,
+            [](const std::uintptr_t a, const std::pair<std::uintptr_t, ObjectPool*>& b) { return a < b.first; });
+        if(found == slabs.begin()) return nullptr;
+        --found;
+        return address < found->first + found->second->slabSize() ? found->second : nullptr;
+    }
+}
+
+ObjectPool::ObjectPool(const std::size_t slabSize): _slabSize{slabSize}, _allocationCount{}, _current{}, _end{}, _free{} {
+    CORRADE_ASSERT(slabSize >= MaxPooledSize,
+        "SceneGraph::ObjectPool: slab size" << slabSize << "is smaller than" << std::size_t(MaxPooledSize) << "bytes", );
+
+    /* This also ensures the registry is constructed before the pool, so
+       it's destroyed after it also when the pool is a global */
+    ++slabRegistry().poolCount;
+}
+
+ObjectPool::~ObjectPool() {
+    CORRADE_ASSERT(!_allocationCount,
+        "SceneGraph::ObjectPool: destroyed with" << _allocationCount << "live allocations", );
+
+    SlabRegistry& registry = slabRegistry();
+    {
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        registry.slabs.erase(std::remove_if(registry.slabs.begin(), registry.slabs.end(),
+            [this](const std::pair<std::uintptr_t, ObjectPool*>& slab) { return slab.second == this; }), registry.slabs.end());
+    }
+    --registry.poolCount;
+    for(char* slab: _slabs) delete[] slab;
+}
+
+void* ObjectPool::allocate(const std::size_t size) {
+    CORRADE_ASSERT(size <= MaxPooledSize,
+        "SceneGraph::ObjectPool::allocate(): expected at most" << std::size_t(MaxPooledSize) << "bytes but got" << size, nullptr);
+
+    const std::size_t sizeClass = (size + Granularity - 1)/Granularity;
+    const std::size_t roundedSize = sizeClass*Granularity;
+    ++_allocationCount;
+
+    /* Reuse previously freed memory, if any */
+    void*& free = _free[sizeClass - 1];
+    if(free) {
+        void* const memory = free;
+        free = *reinterpret_cast<void**>(memory);
+        return memory;
+    }
+
+    /* Take memory from the current slab, allocate a new one if it doesn't
+       fit. The rest of the old slab is wasted. */
+    if(std::size_t(_end - _current) < roundedSize) {
+        /* new[] gives memory aligned for the largest fundamental type. The
+           allocations are multiples of Granularity, which isn't smaller than
+           that, so they're all aligned the same way. */
+        _slabs.push_back(new char[_slabSize]);
+        _current = _slabs.back();
+        _end = _current + _slabSize;
+
+        SlabRegistry& registry = slabRegistry();
+        const std::pair<std::uintptr_t, ObjectPool*> slab{reinterpret_cast<std::uintptr_t>(_current), this};
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        registry.slabs.insert(std::upper_bound(registry.slabs.begin(), registry.slabs.end(), slab), slab);
+    }
+
+    void* const memory = _current;
+    _current += roundedSize;
+    return memory;
+}
+
+void ObjectPool::deallocate(void* const memory, const std::size_t size) {
+    CORRADE_INTERNAL_ASSERT(memory && size && size <= MaxPooledSize && _allocationCount);
+
+    /* Put the memory on front of the free list for given size class */
+    void*& free = _free[(size + Granularity - 1)/Granularity - 1];
+    *reinterpret_cast<void**>(memory) = free;
+    free = memory;
+    --_allocationCount;
+}
+
+namespace Implementation {
+
+void* ObjectPoolAllocated::operator new(const std::size_t size) {
+    return ::operator new(size);
+}
+
+void* ObjectPoolAllocated::operator new(const std::size_t size, ObjectPool& pool) {
+    /* Too large, fall back to heap */
+    if(size > ObjectPool::MaxPooledSize) return ::operator new(size);
+
+    return pool.allocate(size);
+}
+
+void ObjectPoolAllocated::operator delete(void* const memory, const std::size_t size) noexcept {
+    if(!memory) return;
+
+    /* Larger allocations are never done from the pool, no need to look */
+    ObjectPool* const pool = size <= ObjectPool::MaxPooledSize ? findPool(memory) : nullptr;
+    if(pool) pool->deallocate(memory, size);
+    else ::operator delete(memory);
+}
+
+void ObjectPoolAllocated::operator delete(void* const memory, ObjectPool&) noexcept {
+    /* Called only if a constructor throws. The size is not known here, so
+       the memory is not reused, only released together with the slab. */
+    if(ObjectPool* const pool = findPool(memory)) --pool->_allocationCount;
+    else ::operator delete(memory);
+}
+
+}
+
+}}
@@ -0,0 +1,181 @@
+#ifndef Magnum_SceneGraph_ObjectPool_h
+#define Magnum_SceneGraph_ObjectPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::ObjectPool
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation { struct ObjectPoolAllocated; }
+
+/**
+@brief Pool allocator for objects and features
+
+By default every @ref Object and every feature is allocated separately on the
+heap, which means that they end up scattered in memory and both creating and
+traversing large scenes is slow. The pool allocates memory in large
+contiguous slabs and recycles memory of deleted objects, so objects and
+features created one after another are next to each other in memory.
+
+The pool is opt-in. An object or a feature is allocated from the pool by
+passing it to the @cpp new @ce expression, everything else stays the same ---
+the objects are still owned by their parents and features by their objects
+and are deleted the usual way:
+@code
+SceneGraph::ObjectPool pool;
+Scene3D scene;
+
+auto object = new(pool) Object3D{&scene};
+new(pool) MyDrawable{*object, &drawables};
+
+// ...
+
+delete object; // memory goes back to the pool
+@endcode
+
+Objects allocated from the pool and from the heap can be freely mixed in the
+same hierarchy. A common approach is to have one pool per scene. The pool has
+to outlive all objects and features allocated from it, so it's usually
+declared before the scene. Allocations larger than @ref MaxPooledSize bytes
+are done on the heap.
+
+Objects and features allocated from the heap have no memory overhead. On
+deletion, the memory address is looked up in slabs of all live pools to find
+where the memory came from. If no pool exists, the lookup is skipped,
+otherwise it's a binary search guarded by a mutex, so objects and features
+can be deleted from any thread regardless of whether and where pools are
+used. A single pool is not thread-safe, objects and features allocated from
+it should be created and deleted only from one thread at a time.
+@see @ref scenegraph
+*/
+class MAGNUM_SCENEGRAPH_EXPORT ObjectPool {
+    public:
+        /** @brief Largest allocation served from the pool, in bytes */
+        enum: std::size_t { MaxPooledSize = 1024 };
+
+        /**
+         * @brief Constructor
+         * @param slabSize  Size of one slab in bytes
+         *
+         * The slabs are allocated lazily. Expects that the slab size is at
+         * least @ref MaxPooledSize.
+         */
+        explicit ObjectPool(std::size_t slabSize = 256*1024);
+
+        /** @brief Copying is not allowed */
+        ObjectPool(const ObjectPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool(ObjectPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all objects allocated from the pool were already
+         * deleted.
+         */
+        ~ObjectPool();
+
+        /** @brief Copying is not allowed */
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        /** @brief Slab size in bytes */
+        std::size_t slabSize() const { return _slabSize; }
+
+        /** @brief Count of allocated slabs */
+        std::size_t slabCount() const { return _slabs.size(); }
+
+        /** @brief Count of live allocations */
+        std::size_t allocationCount() const { return _allocationCount; }
+
+        /**
+         * @brief Allocate memory
+         *
+         * Reuses memory of a previously deallocated block of the same size
+         * class, if there is any, otherwise takes new memory from the last
+         * slab. Returned memory has fundamental alignment, same as memory
+         * returned by @cpp new @ce. Expects that @p size is not larger than
+         * @ref MaxPooledSize.
+         * @see @ref deallocate()
+         */
+        void* allocate(std::size_t size);
+
+        /**
+         * @brief Deallocate memory
+         *
+         * The @p size has to be the same as was passed to @ref allocate().
+         * The memory is not returned to the system until the pool is
+         * destroyed.
+         */
+        void deallocate(void* memory, std::size_t size);
+
+    private:
+        friend Implementation::ObjectPoolAllocated;
+
+        enum: std::size_t {
+            Granularity = 16,
+            SizeClassCount = MaxPooledSize/Granularity
+        };
+
+        std::size_t _slabSize, _allocationCount;
+        std::vector<char*> _slabs;
+        char *_current, *_end;
+        void* _free[SizeClassCount];
+};
+
+namespace Implementation {
+
+/* Common base of AbstractObject and AbstractFeature providing allocation
+   functions. Being a static member in a common base, the lookup from classes
+   deriving from both an object and a feature is not ambiguous. The sized
+   delete gets the size of the most derived class, so the allocations don't
+   need to store it anywhere. */
+struct MAGNUM_SCENEGRAPH_EXPORT ObjectPoolAllocated {
+    static void* operator new(std::size_t size);
+    static void* operator new(std::size_t size, ObjectPool& pool);
+    static void* operator new(std::size_t, void* memory) noexcept { return memory; }
+
+    static void operator delete(void* memory, std::size_t size) noexcept;
+    static void operator delete(void* memory, ObjectPool&) noexcept;
+    static void operator delete(void*, void*) noexcept {}
+};
+
+}
+
+}}
+
+#endif
@@ -33,6 +33,7 @@
 #include "Magnum/Math/Algorithms/GramSchmidt.h"
 #include "Magnum/SceneGraph/AbstractTranslationRotation2D.h"
 #include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -323,6 +324,7 @@ template<class T> struct Transformation<BasicRigidMatrixTransformation2D<T>> {
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template class MAGNUM_SCENEGRAPH_EXPORT Object<BasicRigidMatrixTransformation2D<Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Scene<BasicRigidMatrixTransformation2D<Float>>;
 #endif
 
 }}
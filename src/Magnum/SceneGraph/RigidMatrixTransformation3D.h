@@ -33,6 +33,7 @@
 #include "Magnum/Math/Algorithms/GramSchmidt.h"
 #include "Magnum/SceneGraph/AbstractTranslationRotation3D.h"
 #include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -458,6 +459,7 @@ template<class T> struct Transformation<BasicRigidMatrixTransformation3D<T>> {
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template class MAGNUM_SCENEGRAPH_EXPORT Object<BasicRigidMatrixTransformation3D<Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Scene<BasicRigidMatrixTransformation3D<Float>>;
 #endif
 
 }}
@@ -26,25 +26,317 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::SceneGraph::Scene
+ * @brief Class @ref Magnum::SceneGraph::Scene, enum @ref Magnum::SceneGraph::CleanPhase
  */
 
+#include <chrono>
+#include <vector>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
 #include "Magnum/SceneGraph/Object.h"
 
 namespace Magnum { namespace SceneGraph {
 
+/**
+@brief Phase of batched object cleaning
+
+@see @ref Scene::setCleanTimingCallback()
+*/
+enum class CleanPhase: UnsignedByte {
+    /**
+     * Filtering out clean objects, collecting their dirty parents and
+     * gathering the transformations cached by their features
+     */
+    Collect,
+
+    /** Computing absolute transformations of all collected objects */
+    Transformations,
+
+    /**
+     * Converting the absolute transformations to matrices and inverting them
+     * for features that need it
+     */
+    Matrices,
+
+    /**
+     * Calling @ref AbstractFeature::clean() and
+     * @ref AbstractFeature::cleanInverted() on the calling thread
+     */
+    Features
+};
+
+/** @debugoperatorenum{Magnum::SceneGraph::CleanPhase} */
+MAGNUM_SCENEGRAPH_EXPORT Debug& operator<<(Debug& debug, CleanPhase value);
+
 /**
 @brief Scene
 
 Basically @ref Object which cannot have parent or non-default transformation.
 See @ref scenegraph for introduction.
+
+@anchor SceneGraph-Scene-flattened
+## Flattened hierarchy
+
+By default, @ref Object::transformations() walks the hierarchy up from each
+object every time it's called, which gets slow for large scenes. If enabled
+using @ref setFlattened(), the scene keeps a list of all its objects sorted so
+parents are always before their children, together with an array of parent
+indices and cached absolute transformations.
+The list is rebuilt in @ref updateFlattened() if any object was added,
+removed or reparented since last time, otherwise only transformations of
+objects marked with @ref Object::setDirty() (and their children) are
+recomputed in a single linear pass. The storage is reused, so in a steady
+state there are no allocations. @ref Object::transformations(),
+@ref Object::transformationMatrices() and everything depending on them, such
+as @ref Camera::draw() or @ref Object::setClean(std::vector<std::reference_wrapper<Object<Transformation>>>),
+automatically use the flattened hierarchy when called on a scene that has it
+enabled.
+@code
+Scene3D scene;
+scene.setFlattened(true);
+
+// ...
+
+scene.updateFlattened();
+for(std::size_t i = 0; i != scene.flattenedObjects().size(); ++i) {
+    const Matrix4& absolute = scene.flattenedTransformations()[i];
+    // ...
+}
+@endcode
+
+@anchor SceneGraph-Scene-clean
+## Batched and parallel cleaning
+
+@ref Object::setClean(std::vector<std::reference_wrapper<Object<Transformation>>>)
+computes absolute transformations of all dirty objects in a single batch,
+converts them to matrices and inverts them in bulk for features which need
+it and then calls @ref AbstractFeature::clean() and
+@ref AbstractFeature::cleanInverted() on all features of all objects.
+
+If some features are marked as thread-safe using
+@ref AbstractFeature::setCleanThreadSafe(), the cleaning can be split into
+two phases. @ref beginClean() does everything on the calling thread except
+for cleaning the thread-safe features. Objects having them are split into
+chunks of @ref cleanChunkSize() objects, which can be then executed using
+@ref cleanChunk() from any thread. Matrices and inverted matrices needed only
+by the thread-safe features are computed in the chunks as well. The scene
+doesn't create any threads on its own, executing the chunks is up to the
+application, see @ref scenegraph-parallel for an example:
+@code
+std::size_t chunkCount = scene.beginClean(objects);
+runChunks(threadCount, chunkCount, [&](std::size_t chunk) {
+    scene.cleanChunk(chunk);
+});
+@endcode
+
+The objects are marked as clean already in @ref beginClean(), but the
+thread-safe features have up-to-date cached transformations only after all
+chunks are executed. The chunks have to be executed before the next call to
+@ref beginClean() or @ref Object::setClean() and before any of the cleaned
+objects or features are modified or destroyed.
+
+Features may clean other objects using @ref Object::setClean() from their
+@ref AbstractFeature::clean() implementation, but calling @ref beginClean()
+from there is not allowed.
+
+Timing of the individual phases can be retrieved using
+@ref setCleanTimingCallback(), for example to feed them to a profiler. The
+chunks executed using @ref cleanChunk() are not timed, as they run on
+application threads.
+
+@see @ref Object::setParent(), @ref Object::setDirty()
 */
 template<class Transformation> class Scene: public Object<Transformation> {
     public:
+        /**
+         * @brief Clean timing callback
+         *
+         * Called with the phase, its duration and the user pointer passed
+         * to @ref setCleanTimingCallback().
+         */
+        typedef void(*CleanTimingCallback)(CleanPhase, std::chrono::nanoseconds, void*);
+
         explicit Scene() = default;
 
+        /**
+         * @brief Whether flattened hierarchy is enabled
+         *
+         * @see @ref setFlattened()
+         */
+        bool isFlattened() const { return _flattened; }
+
+        /**
+         * @brief Enable or disable flattened hierarchy
+         * @return Reference to self (for method chaining)
+         *
+         * Disabled by default. Disabling frees all memory used by the
+         * flattened hierarchy. See @ref SceneGraph-Scene-flattened for more
+         * information.
+         */
+        Scene<Transformation>& setFlattened(bool enabled);
+
+        /**
+         * @brief Update the flattened hierarchy
+         *
+         * Expects that the flattened hierarchy is enabled. Rebuilds the
+         * object list if the hierarchy changed and recomputes absolute
+         * transformations of all dirty objects. Note that this doesn't affect
+         * @ref Object::isDirty() and doesn't clean any features. See
+         * @ref SceneGraph-Scene-flattened for more information.
+         */
+        void updateFlattened();
+
+        /**
+         * @brief Objects in the flattened hierarchy
+         *
+         * The scene itself is always first, every object is after its parent.
+         * Valid only right after @ref updateFlattened() was called, as
+         * subsequent hierarchy changes might make the contents dangling.
+         * @see @ref flattenedParents(), @ref flattenedTransformations(),
+         *      @ref flattenedIndex()
+         */
+        const std::vector<Object<Transformation>*>& flattenedObjects() const {
+            return _flattenedObjects;
+        }
+
+        /**
+         * @brief Parent indices in the flattened hierarchy
+         *
+         * Index of parent of each object in @ref flattenedObjects(), the
+         * first item (which is the scene itself) has the parent set to
+         * @cpp 0xffffffffu @ce. Valid only right after @ref updateFlattened()
+         * was called.
+         */
+        const std::vector<UnsignedInt>& flattenedParents() const {
+            return _flattenedParents;
+        }
+
+        /**
+         * @brief Absolute transformations in the flattened hierarchy
+         *
+         * Absolute transformation of each object in @ref flattenedObjects().
+         * Valid only right after @ref updateFlattened() was called.
+         */
+        const std::vector<typename Transformation::DataType>& flattenedTransformations() const {
+            return _flattenedTransformations;
+        }
+
+        /**
+         * @brief Index of given object in the flattened hierarchy
+         *
+         * Expects that the object is a part of the flattened hierarchy, i.e.
+         * it was a part of the scene when @ref updateFlattened() was called
+         * last time.
+         */
+        UnsignedInt flattenedIndex(const Object<Transformation>& object) const;
+
+        /**
+         * @brief Chunk size for parallel cleaning
+         *
+         * Default is `1024`.
+         * @see @ref beginClean()
+         */
+        std::size_t cleanChunkSize() const { return _cleanChunkSize; }
+
+        /**
+         * @brief Set chunk size for parallel cleaning
+         * @return Reference to self (for method chaining)
+         *
+         * Count of objects with thread-safe features cleaned in one call to
+         * @ref cleanChunk(). Expects that the size is not zero.
+         */
+        Scene<Transformation>& setCleanChunkSize(std::size_t size);
+
+        /**
+         * @brief Begin cleaning given objects
+         * @return Count of chunks to execute with @ref cleanChunk()
+         *
+         * Does the same as @ref Object::setClean(std::vector<std::reference_wrapper<Object<Transformation>>>),
+         * except that features marked with
+         * @ref AbstractFeature::setCleanThreadSafe() are not cleaned, but
+         * deferred to @ref cleanChunk(). Expects that all dirty objects are
+         * part of this scene. See @ref SceneGraph-Scene-clean for more
+         * information.
+         */
+        std::size_t beginClean(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects);
+
+        /** @overload */
+        std::size_t beginClean(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects) {
+            return beginClean({objects.data(), objects.size()});
+        }
+
+        /**
+         * @brief Count of chunks to execute
+         *
+         * Count of chunks to execute after last call to @ref beginClean().
+         */
+        std::size_t cleanChunkCount() const {
+            return (_clean.deferred.size() + _cleanChunkSize - 1)/_cleanChunkSize;
+        }
+
+        /**
+         * @brief Clean given chunk of thread-safe features
+         *
+         * Can be called from any thread, each chunk should be executed only
+         * once after each @ref beginClean(). Expects that @p chunk is less
+         * than @ref cleanChunkCount().
+         */
+        void cleanChunk(std::size_t chunk);
+
+        /**
+         * @brief Clean timing callback
+         *
+         * @see @ref setCleanTimingCallback()
+         */
+        CleanTimingCallback cleanTimingCallback() const { return _cleanTimingCallback; }
+
+        /**
+         * @brief Set clean timing callback
+         * @return Reference to self (for method chaining)
+         *
+         * If set, @p callback is called at the end of each @ref CleanPhase
+         * in @ref beginClean() and @ref Object::setClean(std::vector<std::reference_wrapper<Object<Transformation>>>)
+         * with duration of the phase and @p userData. Set to
+         * @cpp nullptr @ce to disable the timing. Default is
+         * @cpp nullptr @ce.
+         */
+        Scene<Transformation>& setCleanTimingCallback(CleanTimingCallback callback, void* userData = nullptr) {
+            _cleanTimingCallback = callback;
+            _cleanTimingUserData = userData;
+            return *this;
+        }
+
     private:
         bool isScene() const override final { return true; }
+
+        friend Object<Transformation>;
+
+        bool _flattened{};
+        std::vector<Object<Transformation>*> _flattenedObjects;
+        std::vector<UnsignedInt> _flattenedParents;
+        std::vector<typename Transformation::DataType> _flattenedTransformations;
+
+        /* Temporary storage for Object::transformations(), reused between
+           calls */
+        std::vector<std::reference_wrapper<Object<Transformation>>> _scratchCastObjects, _scratchObjects, _scratchJointObjects;
+        std::vector<typename Transformation::DataType> _scratchJointTransformations;
+
+        /* Cleans given objects, deferring thread-safe features if requested.
+           Returns chunk count. */
+        std::size_t MAGNUM_SCENEGRAPH_LOCAL cleanInternal(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, bool deferThreadSafe);
+
+        /* Storage for cleanInternal(), reused between calls */
+        struct CleanStorage {
+            std::vector<std::reference_wrapper<Object<Transformation>>> objects;
+            std::vector<CachedTransformations> immediateCachedTransformations, deferredCachedTransformations;
+            std::vector<typename Transformation::DataType> transformations;
+            std::vector<typename Object<Transformation>::MatrixType> matrices, invertedMatrices;
+            std::vector<UnsignedInt> deferred;
+        } _clean;
+        bool _cleaning{};
+        std::size_t _cleanChunkSize{1024};
+        CleanTimingCallback _cleanTimingCallback{};
+        void* _cleanTimingUserData{};
 };
 
 }}
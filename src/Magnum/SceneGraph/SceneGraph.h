@@ -98,12 +98,26 @@ template<class T> using BasicAnimableGroup3D = AnimableGroup<3, T>;
 typedef BasicAnimableGroup2D<Float> AnimableGroup2D;
 typedef BasicAnimableGroup3D<Float> AnimableGroup3D;
 
+enum class AnimationInterpolation: UnsignedByte;
+template<class> class AnimationPlayer;
+template<class> class AnimationTracks;
+
+template<UnsignedInt, class> class BoundingVolume;
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+
+enum class BoundingVolumeType: UnsignedByte;
+
 template<UnsignedInt, class> class Camera;
 template<class T> using BasicCamera2D = Camera<2, T>;
 template<class T> using BasicCamera3D = Camera<3, T>;
 typedef BasicCamera2D<Float> Camera2D;
 typedef BasicCamera3D<Float> Camera3D;
 
+enum class CleanPhase: UnsignedByte;
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 template<UnsignedInt dimensions, class T> using AbstractCamera CORRADE_DEPRECATED_ALIAS("use BasicCamera2D instead") = Camera<dimensions, T>;
 template<class T> using AbstractBasicCamera2D CORRADE_DEPRECATED_ALIAS("use BasicCamera2D instead") = BasicCamera2D<T>;
@@ -118,6 +132,14 @@ template<class T> using BasicDrawable3D = Drawable<3, T>;
 typedef BasicDrawable2D<Float> Drawable2D;
 typedef BasicDrawable3D<Float> Drawable3D;
 
+enum class DrawOrder: UnsignedByte;
+
+template<UnsignedInt, class> class DrawQueue;
+template<class T> using BasicDrawQueue2D = DrawQueue<2, T>;
+template<class T> using BasicDrawQueue3D = DrawQueue<3, T>;
+typedef BasicDrawQueue2D<Float> DrawQueue2D;
+typedef BasicDrawQueue3D<Float> DrawQueue3D;
+
 template<class> class BasicDualComplexTransformation;
 template<class> class BasicDualQuaternionTransformation;
 typedef BasicDualComplexTransformation<Float> DualComplexTransformation;
@@ -140,7 +162,20 @@ template<class> class BasicMatrixTransformation3D;
 typedef BasicMatrixTransformation2D<Float> MatrixTransformation2D;
 typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
+template<UnsignedInt, class> class LodGroup;
+template<class T> using BasicLodGroup2D = LodGroup<2, T>;
+template<class T> using BasicLodGroup3D = LodGroup<3, T>;
+typedef BasicLodGroup2D<Float> LodGroup2D;
+typedef BasicLodGroup3D<Float> LodGroup3D;
+
+template<UnsignedInt, class> class LodSelector;
+template<class T> using BasicLodSelector2D = LodSelector<2, T>;
+template<class T> using BasicLodSelector3D = LodSelector<3, T>;
+typedef BasicLodSelector2D<Float> LodSelector2D;
+typedef BasicLodSelector3D<Float> LodSelector3D;
+
 template<class Transformation> class Object;
+class ObjectPool;
 
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
@@ -149,6 +184,12 @@ typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
 template<class Transformation> class Scene;
 
+template<UnsignedInt, class> class SpatialIndex;
+template<class T> using BasicSpatialIndex2D = SpatialIndex<2, T>;
+template<class T> using BasicSpatialIndex3D = SpatialIndex<3, T>;
+typedef BasicSpatialIndex2D<Float> SpatialIndex2D;
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
 template<class T, class TranslationType = T> using BasicTranslationTransformation3D = TranslationTransformation<3, T, TranslationType>;
@@ -0,0 +1,134 @@
+#ifndef Magnum_SceneGraph_Snapshot_h
+#define Magnum_SceneGraph_Snapshot_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneGraph::saveSnapshot(), @ref Magnum::SceneGraph::loadSnapshot()
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Implementation {
+
+struct SnapshotHeader {
+    char magic[4];
+    UnsignedByte version;
+    UnsignedByte bigEndian;
+    UnsignedByte dimensions;
+    UnsignedByte typeSize;
+    UnsignedInt dataSize;
+    UnsignedInt objectCount;
+};
+
+static_assert(sizeof(SnapshotHeader) == 16, "improper size of snapshot header");
+
+template<class Transformation> struct ObjectSnapshot {
+    typedef typename Transformation::Type Type;
+    typedef typename Transformation::DataType DataType;
+
+    enum: UnsignedByte { Version = 1 };
+    enum: UnsignedInt { NoParent = 0xffffffffu };
+
+    /* Parent indices are padded so the transformations are aligned to the
+       underlying type if the data itself are */
+    static std::size_t parentsSize(std::size_t count) {
+        return (count*sizeof(UnsignedInt) + sizeof(Type) - 1)/sizeof(Type)*sizeof(Type);
+    }
+
+    static std::vector<char> save(const Object<Transformation>& root);
+    static std::vector<Object<Transformation>*> load(Object<Transformation>& parent, Containers::ArrayView<const char> data, ObjectPool* pool);
+};
+
+}
+#endif
+
+/**
+@brief Save a binary snapshot of an object hierarchy
+
+Saves all descendants of @p root (but not @p root itself) into a compact
+binary representation that can be loaded back using @ref loadSnapshot(). The
+objects are stored in breadth-first order, so a parent is always before its
+children, and the original order of children is preserved. Only the hierarchy
+and the transformations are saved, features are not.
+
+The snapshot consists of a 16-byte header, an array of 32-bit parent indices
+(with @cpp 0xffffffffu @ce denoting a direct child of @p root), padded to
+a multiple of the underlying scalar type size, and an array of packed
+transformations in the same representation as returned by
+@ref Scene::flattenedTransformations(). The data are in machine byte order and
+thus not portable across platforms with different endianness.
+@see @ref scenegraph-snapshots
+*/
+template<class Transformation> inline std::vector<char> saveSnapshot(const Object<Transformation>& root) {
+    return Implementation::ObjectSnapshot<Transformation>::save(root);
+}
+
+/**
+@brief Load a binary snapshot of an object hierarchy
+@param parent   Parent for the topmost loaded objects
+@param data     Snapshot data created with @ref saveSnapshot()
+@param pool     Pool to allocate the objects from or @cpp nullptr @ce to
+    allocate them on the heap
+
+Creates all objects from the snapshot and returns them in the order in which
+they were saved, so features can be attached to them afterwards. The objects
+are owned by @p parent, as if they were created with @ref Object::Object().
+
+Unlike creating the objects one by one using @ref Object::setParent() and
+@ref Object::setTransformation(), the objects are linked into the hierarchy
+directly without looking up the scene and propagating the dirty state for
+each of them, the scene is marked as changed only once. The snapshot is
+validated in full before any object is created. On failure prints a message
+to error output and returns an empty vector, leaving the hierarchy
+untouched.
+@see @ref scenegraph-snapshots
+*/
+template<class Transformation> inline std::vector<Object<Transformation>*> loadSnapshot(Object<Transformation>& parent, Containers::ArrayView<const char> data, ObjectPool* pool = nullptr) {
+    return Implementation::ObjectSnapshot<Transformation>::load(parent, data, pool);
+}
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template struct MAGNUM_SCENEGRAPH_EXPORT Implementation::ObjectSnapshot<BasicDualComplexTransformation<Float>>;
+extern template struct MAGNUM_SCENEGRAPH_EXPORT Implementation::ObjectSnapshot<BasicDualQuaternionTransformation<Float>>;
+extern template struct MAGNUM_SCENEGRAPH_EXPORT Implementation::ObjectSnapshot<BasicMatrixTransformation2D<Float>>;
+extern template struct MAGNUM_SCENEGRAPH_EXPORT Implementation::ObjectSnapshot<BasicMatrixTransformation3D<Float>>;
+extern template struct MAGNUM_SCENEGRAPH_EXPORT Implementation::ObjectSnapshot<BasicRigidMatrixTransformation2D<Float>>;
+extern template struct MAGNUM_SCENEGRAPH_EXPORT Implementation::ObjectSnapshot<BasicRigidMatrixTransformation3D<Float>>;
+extern template struct MAGNUM_SCENEGRAPH_EXPORT Implementation::ObjectSnapshot<TranslationTransformation<2, Float>>;
+extern template struct MAGNUM_SCENEGRAPH_EXPORT Implementation::ObjectSnapshot<TranslationTransformation<3, Float>>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef Magnum_SceneGraph_Snapshot_hpp
+#define Magnum_SceneGraph_Snapshot_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Snapshot.h
+ */
+
+#include "Magnum/SceneGraph/Snapshot.h"
+
+#include <cstring>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/ObjectPool.h"
+
+namespace Magnum { namespace SceneGraph { namespace Implementation {
+
+template<class Transformation> std::vector<char> ObjectSnapshot<Transformation>::save(const Object<Transformation>& root) {
+    /* Gather the objects in breadth-first order. The object list is used as
+       the queue, so parents are always before their children and siblings
+       stay in their original order. */
+    std::vector<const Object<Transformation>*> objects;
+    std::vector<UnsignedInt> parents;
+    for(const Object<Transformation>& child: root.children()) {
+        objects.push_back(&child);
+        parents.push_back(NoParent);
+    }
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        for(const Object<Transformation>& child: objects[i]->children()) {
+            objects.push_back(&child);
+            parents.push_back(UnsignedInt(i));
+        }
+    }
+
+    const std::size_t parentsSize = ObjectSnapshot<Transformation>::parentsSize(objects.size());
+    std::vector<char> out(sizeof(SnapshotHeader) + parentsSize + objects.size()*sizeof(DataType));
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, "MGSG", 4);
+    header.version = Version;
+    header.bigEndian = Utility::Endianness::isBigEndian();
+    header.dimensions = Transformation::Dimensions;
+    header.typeSize = sizeof(Type);
+    header.dataSize = sizeof(DataType);
+    header.objectCount = UnsignedInt(objects.size());
+    std::memcpy(out.data(), &header, sizeof(SnapshotHeader));
+
+    if(!parents.empty())
+        std::memcpy(out.data() + sizeof(SnapshotHeader), parents.data(), parents.size()*sizeof(UnsignedInt));
+
+    char* transformations = out.data() + sizeof(SnapshotHeader) + parentsSize;
+    for(std::size_t i = 0; i != objects.size(); ++i) {
+        const DataType transformation = objects[i]->transformation();
+        std::memcpy(transformations + i*sizeof(DataType), &transformation, sizeof(DataType));
+    }
+
+    return out;
+}
+
+template<class Transformation> std::vector<Object<Transformation>*> ObjectSnapshot<Transformation>::load(Object<Transformation>& parent, const Containers::ArrayView<const char> data, ObjectPool* const pool) {
+    if(data.size() < sizeof(SnapshotHeader)) {
+        Error() << "SceneGraph::loadSnapshot(): expected at least" << sizeof(SnapshotHeader) << "bytes but got" << data.size();
+        return {};
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, data.data(), sizeof(SnapshotHeader));
+    if(std::memcmp(header.magic, "MGSG", 4) != 0) {
+        Error() << "SceneGraph::loadSnapshot(): invalid signature";
+        return {};
+    }
+    if(header.version != Version) {
+        Error() << "SceneGraph::loadSnapshot(): unsupported version" << UnsignedInt(header.version);
+        return {};
+    }
+    if(bool(header.bigEndian) != Utility::Endianness::isBigEndian()) {
+        Error() << "SceneGraph::loadSnapshot(): the snapshot was saved with different endianness";
+        return {};
+    }
+    if(header.dimensions != Transformation::Dimensions || header.typeSize != sizeof(Type) || header.dataSize != sizeof(DataType)) {
+        Error() << "SceneGraph::loadSnapshot(): expected" << Transformation::Dimensions << Debug::nospace << "D transformation of" << sizeof(DataType) << "bytes but got" << UnsignedInt(header.dimensions) << Debug::nospace << "D transformation of" << header.dataSize << "bytes";
+        return {};
+    }
+
+    const std::size_t parentsSize = ObjectSnapshot<Transformation>::parentsSize(header.objectCount);
+    const std::size_t expectedSize = sizeof(SnapshotHeader) + parentsSize + std::size_t(header.objectCount)*sizeof(DataType);
+    if(data.size() != expectedSize) {
+        Error() << "SceneGraph::loadSnapshot(): expected" << expectedSize << "bytes for" << header.objectCount << "objects but got" << data.size();
+        return {};
+    }
+
+    /* Verify the parent references before creating anything so a broken
+       snapshot doesn't leave the hierarchy half-populated */
+    const char* const parents = data.data() + sizeof(SnapshotHeader);
+    for(UnsignedInt i = 0; i != header.objectCount; ++i) {
+        UnsignedInt parentIndex;
+        std::memcpy(&parentIndex, parents + i*sizeof(UnsignedInt), sizeof(UnsignedInt));
+        if(parentIndex != NoParent && parentIndex >= i) {
+            Error() << "SceneGraph::loadSnapshot(): invalid parent index" << parentIndex << "for object" << i;
+            return {};
+        }
+    }
+
+    /* The objects are freshly constructed and thus already dirty, so they are
+       linked into their parents directly instead of going through setParent(),
+       which would look up the root and propagate the dirty state every time.
+       Setting the transformation then doesn't propagate anything either. */
+    std::vector<Object<Transformation>*> objects;
+    objects.reserve(header.objectCount);
+    const char* const transformations = parents + parentsSize;
+    for(UnsignedInt i = 0; i != header.objectCount; ++i) {
+        Object<Transformation>* const object = pool ? new(*pool) Object<Transformation> : new Object<Transformation>;
+
+        DataType transformation;
+        std::memcpy(&transformation, transformations + i*sizeof(DataType), sizeof(DataType));
+        object->setTransformation(transformation);
+
+        UnsignedInt parentIndex;
+        std::memcpy(&parentIndex, parents + i*sizeof(UnsignedInt), sizeof(UnsignedInt));
+        Object<Transformation>* const objectParent = parentIndex == NoParent ? &parent : objects[parentIndex];
+        objectParent->Containers::template LinkedList<Object<Transformation>>::insert(object);
+
+        objects.push_back(object);
+    }
+
+    /* Mark the hierarchy as changed just once for the whole batch */
+    if(!objects.empty()) parent.root()->flags |= Object<Transformation>::Flag::HierarchyChanged;
+
+    return objects;
+}
+
+}}}
+
+#endif
@@ -0,0 +1,313 @@
+#ifndef Magnum_SceneGraph_SpatialIndex_h
+#define Magnum_SceneGraph_SpatialIndex_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::SpatialIndex, alias @ref Magnum::SceneGraph::BasicSpatialIndex2D, @ref Magnum::SceneGraph::BasicSpatialIndex3D, typedef @ref Magnum::SceneGraph::SpatialIndex2D, @ref Magnum::SceneGraph::SpatialIndex3D
+ */
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    template<UnsignedInt dimensions, class T> struct SpatialIndexNode {
+        Math::Range<dimensions, T> bounds;
+        UnsignedInt parent;
+        /* First child for inner nodes (the second one is right after it),
+           first item for leaves */
+        UnsignedInt first;
+        /* Item count for leaves, 0 for inner nodes */
+        UnsignedInt count;
+    };
+
+    template<UnsignedInt dimensions, class T> struct SpatialIndexItem {
+        Math::Range<dimensions, T> bounds;
+        BoundingVolume<dimensions, T>* volume;
+        UnsignedInt leaf;
+    };
+}
+
+/**
+@brief Spatial index
+
+Group of @ref BoundingVolume features organized in a bounding volume hierarchy
+for fast spatial queries. Finding all volumes intersecting given sphere,
+frustum or ray or finding volumes nearest to given point is done in
+logarithmic time on average, as opposed to testing all volumes one by one.
+@code
+SceneGraph::SpatialIndex3D index;
+
+auto object = new Object3D{&scene};
+new SceneGraph::BoundingVolume3D{*object, {}, 0.5f, &index};
+
+// ...
+
+for(SceneGraph::BoundingVolume3D* volume: index.intersectingSphere({}, 10.0f)) {
+    // ...
+}
+@endcode
+
+@anchor SceneGraph-SpatialIndex-updates
+## Updating the index
+
+The hierarchy is updated lazily on @ref setClean(), which is done
+implicitly by all queries. When an object with volume in the index is marked
+as dirty using @ref AbstractObject::setDirty(), the volume is scheduled for
+update. On the next update all dirty objects are cleaned in a single batch
+using @ref AbstractObject::setClean(std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>)
+and the bounds of affected leaves and their parents are recalculated without
+changing the hierarchy structure. Adding or removing volumes or updating more
+volumes than is their total count since the last rebuild makes the next update
+rebuild the whole hierarchy. You can also force the rebuild using
+@ref rebuild(), which is useful e.g. after moving most objects far away from
+their original location.
+
+@anchor SceneGraph-SpatialIndex-explicit-specializations
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref SpatialIndex.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref SpatialIndex2D
+-   @ref SpatialIndex3D
+
+@see @ref scenegraph, @ref BasicSpatialIndex2D, @ref BasicSpatialIndex3D,
+    @ref SpatialIndex2D, @ref SpatialIndex3D
+*/
+template<UnsignedInt dimensions, class T> class SpatialIndex {
+    friend BoundingVolume<dimensions, T>;
+
+    public:
+        /** @brief Max count of volumes in a leaf node */
+        enum: std::size_t { LeafSize = 4 };
+
+        explicit SpatialIndex();
+
+        /** @brief Copying is not allowed */
+        SpatialIndex(const SpatialIndex<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpatialIndex(SpatialIndex<dimensions, T>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all volumes belonging to this index, but not deletes them.
+         */
+        ~SpatialIndex();
+
+        /** @brief Copying is not allowed */
+        SpatialIndex<dimensions, T>& operator=(const SpatialIndex<dimensions, T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpatialIndex<dimensions, T>& operator=(SpatialIndex<dimensions, T>&&) = delete;
+
+        /** @brief Whether the index is empty */
+        bool isEmpty() const { return _volumes.empty(); }
+
+        /** @brief Count of volumes in the index */
+        std::size_t size() const { return _volumes.size(); }
+
+        /**
+         * @brief Volume at given index
+         *
+         * The order is not preserved when removing volumes.
+         */
+        BoundingVolume<dimensions, T>& operator[](std::size_t index) {
+            return *_volumes[index];
+        }
+
+        /** @overload */
+        const BoundingVolume<dimensions, T>& operator[](std::size_t index) const {
+            return *_volumes[index];
+        }
+
+        /**
+         * @brief Add volume to the index
+         * @return Reference to self (for method chaining)
+         *
+         * If the volume is part of another index, it is removed from it.
+         * Causes full rebuild on next @ref setClean().
+         * @see @ref remove(), @ref BoundingVolume::BoundingVolume()
+         */
+        SpatialIndex<dimensions, T>& add(BoundingVolume<dimensions, T>& volume);
+
+        /**
+         * @brief Remove volume from the index
+         * @return Reference to self (for method chaining)
+         *
+         * The volume must be part of the index. Causes full rebuild on next
+         * @ref setClean().
+         * @see @ref add()
+         */
+        SpatialIndex<dimensions, T>& remove(BoundingVolume<dimensions, T>& volume);
+
+        /**
+         * @brief Whether the index needs to be updated
+         *
+         * @see @ref setClean()
+         */
+        bool isDirty() const { return _rebuildNeeded || !_dirty.empty(); }
+
+        /**
+         * @brief Update the index
+         *
+         * Cleans all dirty objects and refits or rebuilds the hierarchy. See
+         * @ref SceneGraph-SpatialIndex-updates for more information. Called
+         * implicitly by all queries.
+         */
+        void setClean();
+
+        /**
+         * @brief Rebuild the index
+         * @return Reference to self (for method chaining)
+         *
+         * Cleans all dirty objects and rebuilds the whole hierarchy from
+         * scratch.
+         */
+        SpatialIndex<dimensions, T>& rebuild();
+
+        /**
+         * @brief Count of nodes in the hierarchy
+         *
+         * Valid only if the index is clean.
+         * @see @ref isDirty(), @ref setClean()
+         */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /**
+         * @brief Volumes intersecting given sphere
+         *
+         * Returns volumes whose transformed box or sphere intersects sphere
+         * with given center and radius in world coordinate space. The order is
+         * unspecified.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> intersectingSphere(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /**
+         * @brief Volumes intersecting given frustum
+         *
+         * Returns volumes which are not completely behind any of the frustum
+         * planes. Same as with @ref Camera::setFrustumCulling() the test is
+         * conservative, i.e. it might return also some volumes near frustum
+         * corners which don't actually intersect it. The order is unspecified.
+         * Available only in 3D.
+         */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        template<UnsignedInt d = dimensions, class = typename std::enable_if<d == 3>::type>
+        #endif
+        std::vector<BoundingVolume<dimensions, T>*> intersectingFrustum(const Math::Frustum<T>& frustum) {
+            Math::Vector<dimensions + 1, T> planes[6];
+            for(std::size_t i = 0; i != 6; ++i) planes[i] = frustum[i];
+            return intersectingPlanes(planes);
+        }
+
+        /**
+         * @brief Volumes intersecting given ray
+         *
+         * Returns volumes intersected by ray starting at @p origin and going
+         * in @p direction, together with distance of the first intersection
+         * in multiples of @p direction length, sorted by the distance. If the
+         * ray starts inside a volume, the distance is `0`.
+         */
+        std::vector<std::pair<T, BoundingVolume<dimensions, T>*>> intersectingRay(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction);
+
+        /**
+         * @brief Volumes nearest to given point
+         *
+         * Returns at most @p count volumes with smallest distance between
+         * their transformed box or sphere and given point, sorted by the
+         * distance. Volumes containing the point have zero distance.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> nearest(const VectorTypeFor<dimensions, T>& point, std::size_t count);
+
+    private:
+        void build(UnsignedInt node, std::size_t begin, std::size_t end);
+        std::vector<BoundingVolume<dimensions, T>*> intersectingPlanes(const Math::Vector<dimensions + 1, T>(&planes)[2*dimensions]);
+
+        std::vector<BoundingVolume<dimensions, T>*> _volumes, _dirty;
+        std::vector<Implementation::SpatialIndexNode<dimensions, T>> _nodes;
+        std::vector<Implementation::SpatialIndexItem<dimensions, T>> _items;
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> _objects;
+        std::size_t _refitCount;
+        bool _rebuildNeeded;
+};
+
+/**
+@brief Spatial index for two-dimensional scenes
+
+Convenience alternative to `SpatialIndex<2, T>`. See @ref SpatialIndex for
+more information.
+@see @ref SpatialIndex2D, @ref BasicSpatialIndex3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatialIndex2D = SpatialIndex<2, T>;
+#endif
+
+/**
+@brief Spatial index for two-dimensional float scenes
+
+@see @ref SpatialIndex3D
+*/
+typedef BasicSpatialIndex2D<Float> SpatialIndex2D;
+
+/**
+@brief Spatial index for three-dimensional scenes
+
+Convenience alternative to `SpatialIndex<3, T>`. See @ref SpatialIndex for
+more information.
+@see @ref SpatialIndex3D, @ref BasicSpatialIndex2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicSpatialIndex3D = SpatialIndex<3, T>;
+#endif
+
+/**
+@brief Spatial index for three-dimensional float scenes
+
+@see @ref SpatialIndex2D
+*/
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialIndex<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT SpatialIndex<3, Float>;
+#endif
+
+}}
+
+#endif
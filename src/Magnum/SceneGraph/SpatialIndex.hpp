@@ -0,0 +1,404 @@
+#ifndef Magnum_SceneGraph_SpatialIndex_hpp
+#define Magnum_SceneGraph_SpatialIndex_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref SpatialIndex.h
+ */
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/BoundingVolume.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Box enclosing the transformed volume. Boxes have zero radius and spheres
+   have zero half size, so the same formula works for both. */
+template<UnsignedInt dimensions, class T> Math::Range<dimensions, T> spatialIndexBounds(const BoundingVolume<dimensions, T>& volume) {
+    const VectorTypeFor<dimensions, T> extent = volume.transformedHalfSize() + VectorTypeFor<dimensions, T>{volume.transformedRadius()};
+    return {volume.transformedCenter() - extent, volume.transformedCenter() + extent};
+}
+
+/* Math::join() treats zero-sized ranges as empty, which is not desired here
+   as volumes with zero size are still valid points */
+template<UnsignedInt dimensions, class T> inline Math::Range<dimensions, T> spatialIndexJoin(const Math::Range<dimensions, T>& a, const Math::Range<dimensions, T>& b) {
+    return {Math::min(a.min(), b.min()), Math::max(a.max(), b.max())};
+}
+
+template<UnsignedInt dimensions, class T> inline T spatialIndexDistanceSquared(const Math::Range<dimensions, T>& range, const VectorTypeFor<dimensions, T>& point) {
+    return Math::max(Math::max(range.min() - point, point - range.max()), VectorTypeFor<dimensions, T>{T(0)}).dot();
+}
+
+template<UnsignedInt dimensions, class T> T spatialIndexDistanceSquared(const BoundingVolume<dimensions, T>& volume, const VectorTypeFor<dimensions, T>& point) {
+    const VectorTypeFor<dimensions, T> distance = Math::max(Math::abs(point - volume.transformedCenter()) - volume.transformedHalfSize(), VectorTypeFor<dimensions, T>{T(0)});
+    if(volume.type() == BoundingVolumeType::Box) return distance.dot();
+
+    const T sphereDistance = Math::max(distance.length() - volume.transformedRadius(), T(0));
+    return sphereDistance*sphereDistance;
+}
+
+/* Distance at which the ray enters the box, infinity if it misses it. Zero
+   direction components give infinite inverse direction, NaNs resulting from
+   multiplying it with zero are ignored by the comparisons. */
+template<UnsignedInt dimensions, class T> T spatialIndexRayDistance(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& inverseDirection, const VectorTypeFor<dimensions, T>& min, const VectorTypeFor<dimensions, T>& max) {
+    T near{0};
+    T far = std::numeric_limits<T>::infinity();
+    for(std::size_t i = 0; i != dimensions; ++i) {
+        T a = (min[i] - origin[i])*inverseDirection[i];
+        T b = (max[i] - origin[i])*inverseDirection[i];
+        if(a > b) std::swap(a, b);
+        if(a > near) near = a;
+        if(b < far) far = b;
+    }
+    return near <= far ? near : std::numeric_limits<T>::infinity();
+}
+
+template<UnsignedInt dimensions, class T> T spatialIndexRayDistance(const BoundingVolume<dimensions, T>& volume, const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction, const VectorTypeFor<dimensions, T>& inverseDirection) {
+    if(volume.type() == BoundingVolumeType::Box)
+        return spatialIndexRayDistance<dimensions, T>(origin, inverseDirection,
+            volume.transformedCenter() - volume.transformedHalfSize(),
+            volume.transformedCenter() + volume.transformedHalfSize());
+
+    const VectorTypeFor<dimensions, T> fromCenter = origin - volume.transformedCenter();
+    const T c = fromCenter.dot() - volume.transformedRadius()*volume.transformedRadius();
+    if(c <= T(0)) return T(0);
+
+    /* Origin is outside, the sphere is missed if it is behind the origin or
+       if the ray doesn't hit it at all */
+    const T a = direction.dot();
+    const T b = Math::dot(fromCenter, direction);
+    const T discriminant = b*b - a*c;
+    if(b >= T(0) || discriminant < T(0)) return std::numeric_limits<T>::infinity();
+    return (-b - std::sqrt(discriminant))/a;
+}
+
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>::SpatialIndex(): _refitCount{}, _rebuildNeeded{} {}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>::~SpatialIndex() {
+    for(BoundingVolume<dimensions, T>* volume: _volumes) volume->_index = nullptr;
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>& SpatialIndex<dimensions, T>::add(BoundingVolume<dimensions, T>& volume) {
+    /* Remove from previous index */
+    if(volume._index) volume._index->remove(volume);
+
+    volume._index = this;
+    volume._indexPosition = _volumes.size();
+    volume._indexDirty = false;
+    _volumes.push_back(&volume);
+    _rebuildNeeded = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>& SpatialIndex<dimensions, T>::remove(BoundingVolume<dimensions, T>& volume) {
+    CORRADE_ASSERT(volume._index == this,
+        "SceneGraph::SpatialIndex::remove(): volume is not part of this index", *this);
+
+    /* Replace the volume with the last one. The dirty list and the hierarchy
+       might now contain dangling pointers, but they are discarded by the
+       rebuild without being accessed. */
+    BoundingVolume<dimensions, T>* const last = _volumes.back();
+    _volumes[volume._indexPosition] = last;
+    last->_indexPosition = volume._indexPosition;
+    _volumes.pop_back();
+
+    volume._index = nullptr;
+    _rebuildNeeded = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> SpatialIndex<dimensions, T>& SpatialIndex<dimensions, T>::rebuild() {
+    _rebuildNeeded = true;
+    setClean();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::setClean() {
+    /* Refitting too much degrades the hierarchy quality, rebuild it instead */
+    if(!_rebuildNeeded && _refitCount + _dirty.size() > _volumes.size())
+        _rebuildNeeded = true;
+
+    /* Clean all dirty objects at once */
+    _objects.clear();
+    for(BoundingVolume<dimensions, T>* volume: _rebuildNeeded ? _volumes : _dirty)
+        if(volume->object().isDirty()) _objects.push_back(volume->object());
+    if(!_objects.empty()) AbstractObject<dimensions, T>::setClean(_objects);
+
+    /* Rebuild the whole hierarchy */
+    if(_rebuildNeeded) {
+        _dirty.clear();
+        _items.resize(_volumes.size());
+        for(std::size_t i = 0; i != _volumes.size(); ++i) {
+            _volumes[i]->_indexDirty = false;
+            _items[i].bounds = Implementation::spatialIndexBounds(*_volumes[i]);
+            _items[i].volume = _volumes[i];
+        }
+
+        _nodes.clear();
+        if(!_items.empty()) {
+            _nodes.reserve(2*(_items.size()/LeafSize) + 1);
+            _nodes.emplace_back();
+            _nodes.back().parent = ~UnsignedInt{};
+            build(0, 0, _items.size());
+        }
+
+        /* The items got reordered during the build */
+        for(std::size_t i = 0; i != _items.size(); ++i)
+            _items[i].volume->_indexItem = i;
+
+        _refitCount = 0;
+        _rebuildNeeded = false;
+        return;
+    }
+
+    /* Update bounds of dirty volumes and propagate the change up the
+       hierarchy until it no longer changes anything */
+    for(BoundingVolume<dimensions, T>* volume: _dirty) {
+        volume->_indexDirty = false;
+        Implementation::SpatialIndexItem<dimensions, T>& item = _items[volume->_indexItem];
+        item.bounds = Implementation::spatialIndexBounds(*volume);
+
+        Implementation::SpatialIndexNode<dimensions, T>* node = &_nodes[item.leaf];
+        Math::Range<dimensions, T> bounds = _items[node->first].bounds;
+        for(std::size_t i = node->first + 1; i != node->first + node->count; ++i)
+            bounds = Implementation::spatialIndexJoin(bounds, _items[i].bounds);
+
+        for(;;) {
+            if(node->bounds == bounds) break;
+            node->bounds = bounds;
+            if(node->parent == ~UnsignedInt{}) break;
+
+            node = &_nodes[node->parent];
+            bounds = Implementation::spatialIndexJoin(_nodes[node->first].bounds, _nodes[node->first + 1].bounds);
+        }
+    }
+
+    _refitCount += _dirty.size();
+    _dirty.clear();
+}
+
+template<UnsignedInt dimensions, class T> void SpatialIndex<dimensions, T>::build(const UnsignedInt node, const std::size_t begin, const std::size_t end) {
+    Math::Range<dimensions, T> bounds = _items[begin].bounds;
+    Math::Range<dimensions, T> centers{bounds.center(), bounds.center()};
+    for(std::size_t i = begin + 1; i != end; ++i) {
+        bounds = Implementation::spatialIndexJoin(bounds, _items[i].bounds);
+        const VectorTypeFor<dimensions, T> center = _items[i].bounds.center();
+        centers = {Math::min(centers.min(), center), Math::max(centers.max(), center)};
+    }
+    _nodes[node].bounds = bounds;
+
+    /* Leaf node */
+    if(end - begin <= LeafSize) {
+        _nodes[node].first = begin;
+        _nodes[node].count = end - begin;
+        for(std::size_t i = begin; i != end; ++i) _items[i].leaf = node;
+        return;
+    }
+
+    /* Split in half along the axis with largest spread of volume centers.
+       Splitting at the median instead of the spatial center keeps the tree
+       balanced and the traversal stack shallow. */
+    const VectorTypeFor<dimensions, T> spread = centers.size();
+    std::size_t axis = 0;
+    for(std::size_t i = 1; i != dimensions; ++i)
+        if(spread[i] > spread[axis]) axis = i;
+    const std::size_t middle = begin + (end - begin)/2;
+    std::nth_element(_items.begin() + begin, _items.begin() + middle, _items.begin() + end,
+        [axis](const Implementation::SpatialIndexItem<dimensions, T>& a, const Implementation::SpatialIndexItem<dimensions, T>& b) {
+            return a.bounds.min()[axis] + a.bounds.max()[axis] < b.bounds.min()[axis] + b.bounds.max()[axis];
+        });
+
+    const UnsignedInt first = _nodes.size();
+    _nodes.resize(first + 2);
+    _nodes[node].first = first;
+    _nodes[node].count = 0;
+    _nodes[first].parent = _nodes[first + 1].parent = node;
+    build(first, begin, middle);
+    build(first + 1, middle, end);
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> SpatialIndex<dimensions, T>::intersectingSphere(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    setClean();
+
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    if(_nodes.empty()) return out;
+
+    /* The tree is balanced, so its depth is logarithmic in the item count */
+    const T radiusSquared = radius*radius;
+    UnsignedInt stack[64];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize) {
+        const Implementation::SpatialIndexNode<dimensions, T>& node = _nodes[stack[--stackSize]];
+        if(Implementation::spatialIndexDistanceSquared(node.bounds, center) > radiusSquared)
+            continue;
+
+        if(!node.count) {
+            stack[stackSize++] = node.first;
+            stack[stackSize++] = node.first + 1;
+            continue;
+        }
+
+        for(std::size_t i = node.first; i != node.first + node.count; ++i) {
+            const Implementation::SpatialIndexItem<dimensions, T>& item = _items[i];
+            if(Implementation::spatialIndexDistanceSquared(item.bounds, center) <= radiusSquared &&
+               Implementation::spatialIndexDistanceSquared(*item.volume, center) <= radiusSquared)
+                out.push_back(item.volume);
+        }
+    }
+
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> SpatialIndex<dimensions, T>::intersectingPlanes(const Math::Vector<dimensions + 1, T>(&planes)[2*dimensions]) {
+    setClean();
+
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    if(_nodes.empty()) return out;
+
+    /* Normalize the planes so the distances are comparable with the volume
+       extents */
+    Math::Vector<dimensions, T> normals[2*dimensions], absNormals[2*dimensions];
+    T distances[2*dimensions];
+    for(std::size_t i = 0; i != 2*dimensions; ++i) {
+        const Math::Vector<dimensions, T> normal = Math::Vector<dimensions, T>::pad(planes[i]);
+        const T length = normal.length();
+        normals[i] = normal/length;
+        absNormals[i] = Math::abs(normals[i]);
+        distances[i] = planes[i][dimensions]/length;
+    }
+
+    /* A box or sphere is outside if it is completely behind any of the
+       planes */
+    auto outside = [&](const VectorTypeFor<dimensions, T>& center, const VectorTypeFor<dimensions, T>& halfSize, const T radius) {
+        for(std::size_t i = 0; i != 2*dimensions; ++i)
+            if(distances[i] + radius + Math::dot(normals[i], center) + Math::dot(absNormals[i], halfSize) < T(0))
+                return true;
+        return false;
+    };
+
+    UnsignedInt stack[64];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize) {
+        const Implementation::SpatialIndexNode<dimensions, T>& node = _nodes[stack[--stackSize]];
+        if(outside(node.bounds.center(), node.bounds.size()/T(2), T(0)))
+            continue;
+
+        if(!node.count) {
+            stack[stackSize++] = node.first;
+            stack[stackSize++] = node.first + 1;
+            continue;
+        }
+
+        for(std::size_t i = node.first; i != node.first + node.count; ++i) {
+            const BoundingVolume<dimensions, T>& volume = *_items[i].volume;
+            if(!outside(volume.transformedCenter(), volume.transformedHalfSize(), volume.transformedRadius()))
+                out.push_back(_items[i].volume);
+        }
+    }
+
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<std::pair<T, BoundingVolume<dimensions, T>*>> SpatialIndex<dimensions, T>::intersectingRay(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction) {
+    setClean();
+
+    std::vector<std::pair<T, BoundingVolume<dimensions, T>*>> out;
+    if(_nodes.empty()) return out;
+
+    const VectorTypeFor<dimensions, T> inverseDirection = T(1)/direction;
+    UnsignedInt stack[64];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize) {
+        const Implementation::SpatialIndexNode<dimensions, T>& node = _nodes[stack[--stackSize]];
+        if(Implementation::spatialIndexRayDistance<dimensions, T>(origin, inverseDirection, node.bounds.min(), node.bounds.max()) == std::numeric_limits<T>::infinity())
+            continue;
+
+        if(!node.count) {
+            stack[stackSize++] = node.first;
+            stack[stackSize++] = node.first + 1;
+            continue;
+        }
+
+        for(std::size_t i = node.first; i != node.first + node.count; ++i) {
+            const T distance = Implementation::spatialIndexRayDistance(*_items[i].volume, origin, direction, inverseDirection);
+            if(distance != std::numeric_limits<T>::infinity())
+                out.emplace_back(distance, _items[i].volume);
+        }
+    }
+
+    std::sort(out.begin(), out.end(), [](const std::pair<T, BoundingVolume<dimensions, T>*>& a, const std::pair<T, BoundingVolume<dimensions, T>*>& b) {
+        return a.first < b.first;
+    });
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> SpatialIndex<dimensions, T>::nearest(const VectorTypeFor<dimensions, T>& point, const std::size_t count) {
+    setClean();
+
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    if(_nodes.empty() || !count) return out;
+
+    /* Best-first traversal. Distance of a node is never larger than distance
+       of anything inside it, so the volumes are taken out of the queue in
+       order of increasing distance. Items are identified by their index
+       offset by node count. */
+    typedef std::pair<T, std::size_t> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    queue.emplace(Implementation::spatialIndexDistanceSquared(_nodes[0].bounds, point), 0);
+    while(!queue.empty() && out.size() < count) {
+        const std::size_t id = queue.top().second;
+        queue.pop();
+
+        if(id >= _nodes.size()) {
+            out.push_back(_items[id - _nodes.size()].volume);
+            continue;
+        }
+
+        const Implementation::SpatialIndexNode<dimensions, T>& node = _nodes[id];
+        if(!node.count) {
+            for(std::size_t i = node.first; i != node.first + 2; ++i)
+                queue.emplace(Implementation::spatialIndexDistanceSquared(_nodes[i].bounds, point), i);
+        } else for(std::size_t i = node.first; i != node.first + node.count; ++i)
+            queue.emplace(Implementation::spatialIndexDistanceSquared(*_items[i].volume, point), _nodes.size() + i);
+    }
+
+    return out;
+}
+
+}}
+
+#endif
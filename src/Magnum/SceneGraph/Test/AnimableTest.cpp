@@ -23,11 +23,16 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/SceneGraph/Animable.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 
 namespace Magnum { namespace SceneGraph { namespace Test {
@@ -41,8 +46,16 @@ struct AnimableTest: TestSuite::Tester {
     void repeat();
     void stop();
     void pause();
+    void stepParallel();
+    void stepParallelStateChanges();
+    void stepParallelNothingRunning();
+    void stepChunkOutOfRange();
+    void chunkSizeZero();
 
     void debug();
+
+    void benchmarkStep();
+    template<std::size_t threadCount> void benchmarkStepParallel();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
@@ -54,8 +67,19 @@ AnimableTest::AnimableTest() {
               &AnimableTest::repeat,
               &AnimableTest::stop,
               &AnimableTest::pause,
+              &AnimableTest::stepParallel,
+              &AnimableTest::stepParallelStateChanges,
+              &AnimableTest::stepParallelNothingRunning,
+              &AnimableTest::stepChunkOutOfRange,
+              &AnimableTest::chunkSizeZero,
 
               &AnimableTest::debug});
+
+    addBenchmarks({&AnimableTest::benchmarkStep,
+                   &AnimableTest::benchmarkStepParallel<1>,
+                   &AnimableTest::benchmarkStepParallel<2>,
+                   &AnimableTest::benchmarkStepParallel<4>,
+                   &AnimableTest::benchmarkStepParallel<8>}, 10);
 }
 
 void AnimableTest::state() {
@@ -351,12 +375,216 @@ void AnimableTest::pause() {
     CORRADE_COMPARE(animable.time, 2.0f);
 }
 
+namespace {
+
+class LoggingAnimable: public SceneGraph::Animable3D {
+    public:
+        LoggingAnimable(AbstractObject3D& object, AnimableGroup3D* group, std::string& log, char name, bool threadSafe): SceneGraph::Animable3D(object, group), log(log), name(name), time(-1.0f), delta(-1.0f) {
+            setDuration(10.0f);
+            setThreadSafe(threadSafe);
+            setState(AnimationState::Running);
+        }
+
+        std::string& log;
+        char name;
+        Float time, delta;
+
+    protected:
+        void animationStep(Float time, Float delta) override {
+            log += name;
+            this->time = time;
+            this->delta = delta;
+        }
+
+        void animationStarted() override {
+            log += '+';
+            log += name;
+        }
+
+        void animationStopped() override {
+            log += '-';
+            log += name;
+        }
+};
+
+}
+
+void AnimableTest::stepParallel() {
+    Object3D object;
+    AnimableGroup3D group;
+    group.setChunkSize(2);
+    CORRADE_COMPARE(group.chunkSize(), 2);
+
+    std::string log;
+    LoggingAnimable a{object, &group, log, 'a', true};
+    LoggingAnimable b{object, &group, log, 'b', false};
+    LoggingAnimable c{object, &group, log, 'c', true};
+    LoggingAnimable d{object, &group, log, 'd', true};
+    CORRADE_VERIFY(a.isThreadSafe());
+    CORRADE_VERIFY(!b.isThreadSafe());
+
+    /* State changes and non-thread-safe steps are done immediately */
+    CORRADE_COMPARE(group.beginStep(1.0f, 0.5f), 2);
+    CORRADE_COMPARE(group.stepChunkCount(), 2);
+    CORRADE_COMPARE(log, "+a+bb+c+d");
+    CORRADE_COMPARE(group.runningCount(), 4);
+    CORRADE_COMPARE(b.time, 0.0f);
+    CORRADE_COMPARE(b.delta, 0.5f);
+    CORRADE_COMPARE(a.time, -1.0f);
+
+    /* Chunks can be executed in any order */
+    log.clear();
+    group.stepChunk(1);
+    CORRADE_COMPARE(log, "d");
+    group.stepChunk(0);
+    CORRADE_COMPARE(log, "dac");
+    CORRADE_COMPARE(a.time, 0.0f);
+    CORRADE_COMPARE(a.delta, 0.5f);
+
+    /* Next step */
+    log.clear();
+    CORRADE_COMPARE(group.beginStep(3.0f, 2.0f), 2);
+    group.stepChunk(0);
+    group.stepChunk(1);
+    CORRADE_COMPARE(log, "bacd");
+    CORRADE_COMPARE(c.time, 2.0f);
+    CORRADE_COMPARE(c.delta, 2.0f);
+    CORRADE_COMPARE(d.time, 2.0f);
+}
+
+void AnimableTest::stepParallelStateChanges() {
+    Object3D object;
+    AnimableGroup3D group;
+    std::string log;
+    LoggingAnimable a{object, &group, log, 'a', true};
+    LoggingAnimable b{object, &group, log, 'b', true};
+
+    CORRADE_COMPARE(group.beginStep(1.0f, 0.5f), 1);
+    group.stepChunk(0);
+    CORRADE_COMPARE(log, "+a+bab");
+
+    /* Stopped animation is not stepped anymore, duration exceeded as well */
+    log.clear();
+    a.setState(AnimationState::Stopped);
+    CORRADE_COMPARE(group.beginStep(15.0f, 0.5f), 0);
+    CORRADE_COMPARE(log, "-a-b");
+    CORRADE_COMPARE(group.runningCount(), 0);
+}
+
+void AnimableTest::stepParallelNothingRunning() {
+    Object3D object;
+    AnimableGroup3D group;
+    std::string log;
+    LoggingAnimable a{object, &group, log, 'a', true};
+
+    CORRADE_COMPARE(group.beginStep(1.0f, 0.5f), 1);
+    a.setState(AnimationState::Stopped);
+    CORRADE_COMPARE(group.beginStep(2.0f, 0.5f), 0);
+    CORRADE_COMPARE(group.beginStep(3.0f, 0.5f), 0);
+    CORRADE_COMPARE(group.stepChunkCount(), 0);
+}
+
+void AnimableTest::stepChunkOutOfRange() {
+    Object3D object;
+    AnimableGroup3D group;
+    std::string log;
+    LoggingAnimable a{object, &group, log, 'a', true};
+    group.beginStep(1.0f, 0.5f);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    group.stepChunk(1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::AnimableGroup::stepChunk(): chunk index 1 out of range for 1 chunks\n");
+}
+
+void AnimableTest::chunkSizeZero() {
+    AnimableGroup3D group;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    group.setChunkSize(0);
+    CORRADE_COMPARE(group.chunkSize(), 1024);
+    CORRADE_COMPARE(out.str(), "SceneGraph::AnimableGroup::setChunkSize(): chunk size can't be zero\n");
+}
+
 void AnimableTest::debug() {
     std::ostringstream o;
     Debug(&o) << AnimationState::Running << AnimationState(0xbe);
     CORRADE_COMPARE(o.str(), "SceneGraph::AnimationState::Running SceneGraph::AnimationState(0xbe)\n");
 }
 
+namespace {
+
+enum: std::size_t { BenchmarkAnimableCount = 50000 };
+
+class BenchmarkAnimable: public SceneGraph::Animable3D {
+    public:
+        BenchmarkAnimable(AbstractObject3D& object, AnimableGroup3D& group, Float phase): SceneGraph::Animable3D(object, &group), phase(phase), value() {
+            setThreadSafe(true);
+            setState(AnimationState::Running);
+        }
+
+        Float phase, value;
+
+    private:
+        /* Some nontrivial amount of work */
+        void animationStep(Float time, Float) override {
+            Float v = phase;
+            for(std::size_t i = 0; i != 16; ++i)
+                v = Math::sin(Rad(v + time));
+            value = v;
+        }
+};
+
+Float benchmarkChecksum(const AnimableGroup3D& group) {
+    Float sum{};
+    for(std::size_t i = 0; i != group.size(); ++i)
+        sum += static_cast<const BenchmarkAnimable&>(group[i]).value;
+    return sum;
+}
+
+}
+
+void AnimableTest::benchmarkStep() {
+    Object3D object;
+    AnimableGroup3D group;
+    for(std::size_t i = 0; i != BenchmarkAnimableCount; ++i)
+        new BenchmarkAnimable{object, group, Float(i)};
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(10)
+        group.step(time += 0.016f, 0.016f);
+
+    CORRADE_VERIFY(benchmarkChecksum(group) != 0.0f);
+}
+
+template<std::size_t threadCount> void AnimableTest::benchmarkStepParallel() {
+    setTestCaseName(std::string{"benchmarkStepParallel<"} + std::to_string(threadCount) + ">");
+
+    Object3D object;
+    AnimableGroup3D group;
+    for(std::size_t i = 0; i != BenchmarkAnimableCount; ++i)
+        new BenchmarkAnimable{object, group, Float(i)};
+
+    /* Chunks are picked dynamically, so faster threads take over the work
+       of slower ones */
+    Float time = 0.0f;
+    std::vector<std::thread> threads(threadCount - 1);
+    CORRADE_BENCHMARK(10) {
+        const std::size_t chunkCount = group.beginStep(time += 0.016f, 0.016f);
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]() {
+            for(std::size_t chunk; (chunk = next++) < chunkCount; )
+                group.stepChunk(chunk);
+        };
+        for(std::thread& thread: threads) thread = std::thread{worker};
+        worker();
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    CORRADE_VERIFY(benchmarkChecksum(group) != 0.0f);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::AnimableTest)
@@ -0,0 +1,290 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/SceneGraph/AnimationPlayer.h"
+#include "Magnum/SceneGraph/AnimationTracks.h"
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/RigidMatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct AnimationPlayerTest: TestSuite::Tester {
+    explicit AnimationPlayerTest();
+
+    void construct();
+    void translationRotationScaling();
+    void translationRotationScalingRigid();
+    void translationRotationScalingDualQuaternion();
+    void transformation();
+    void transformationDualQuaternion();
+    void tracksAddedLater();
+    void clear();
+
+    void addTrackOutOfRange();
+    void addScalingRigid();
+
+    void benchmarkApply();
+};
+
+typedef SceneGraph::Object<SceneGraph::DualQuaternionTransformation> Object3D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> MatrixObject3D;
+typedef SceneGraph::Object<SceneGraph::RigidMatrixTransformation3D> RigidObject3D;
+
+namespace {
+    enum: std::size_t { BenchmarkObjectCount = 10000 };
+}
+
+AnimationPlayerTest::AnimationPlayerTest() {
+    addTests({&AnimationPlayerTest::construct,
+              &AnimationPlayerTest::translationRotationScaling,
+              &AnimationPlayerTest::translationRotationScalingRigid,
+              &AnimationPlayerTest::translationRotationScalingDualQuaternion,
+              &AnimationPlayerTest::transformation,
+              &AnimationPlayerTest::transformationDualQuaternion,
+              &AnimationPlayerTest::tracksAddedLater,
+              &AnimationPlayerTest::clear,
+
+              &AnimationPlayerTest::addTrackOutOfRange,
+              &AnimationPlayerTest::addScalingRigid});
+
+    addBenchmarks({&AnimationPlayerTest::benchmarkApply}, 10);
+}
+
+void AnimationPlayerTest::construct() {
+    AnimationTracks<Vector3> vectors;
+    AnimationTracks<Quaternion> rotations;
+    AnimationTracks<DualQuaternion> dualQuaternions;
+    AnimationPlayer<MatrixTransformation3D> player{vectors, rotations, dualQuaternions};
+    CORRADE_VERIFY(player.isEmpty());
+    CORRADE_COMPARE(player.size(), 0);
+
+    /* Nothing to do */
+    player.apply(1.0f);
+}
+
+void AnimationPlayerTest::translationRotationScaling() {
+    AnimationTracks<Vector3> vectors;
+    const UnsignedInt translation = vectors.add({0.0f, 2.0f}, {Vector3{}, Vector3{2.0f, 4.0f, 0.0f}}, AnimationInterpolation::Linear);
+    const UnsignedInt scaling = vectors.add({0.0f, 2.0f}, {Vector3{1.0f}, Vector3{3.0f}}, AnimationInterpolation::Linear);
+    AnimationTracks<Quaternion> rotations;
+    const UnsignedInt rotation = rotations.add({0.0f, 2.0f}, {Quaternion{}, Quaternion::rotation(Deg(90.0f), Vector3::zAxis())}, AnimationInterpolation::Spherical);
+    AnimationTracks<DualQuaternion> dualQuaternions;
+
+    MatrixObject3D a, b, c;
+    AnimationPlayer<MatrixTransformation3D> player{vectors, rotations, dualQuaternions};
+    player.addTranslationRotationScaling(a, translation, rotation, scaling)
+          .addTranslationRotationScaling(b, translation, AnimationPlayer<MatrixTransformation3D>::NoTrack)
+          .addTranslationRotationScaling(c, AnimationPlayer<MatrixTransformation3D>::NoTrack, rotation);
+    CORRADE_COMPARE(player.size(), 3);
+
+    player.apply(1.0f);
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation({1.0f, 2.0f, 0.0f})*Matrix4::rotationZ(Deg(45.0f))*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(b.transformation(), Matrix4::translation({1.0f, 2.0f, 0.0f}));
+    CORRADE_COMPARE(c.transformation(), Matrix4::rotationZ(Deg(45.0f)));
+
+    player.apply(3.0f);
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation({2.0f, 4.0f, 0.0f})*Matrix4::rotationZ(Deg(90.0f))*Matrix4::scaling(Vector3{3.0f}));
+}
+
+void AnimationPlayerTest::translationRotationScalingRigid() {
+    AnimationTracks<Vector3> vectors;
+    vectors.add({0.0f, 2.0f}, {Vector3{}, Vector3{2.0f, 4.0f, 0.0f}}, AnimationInterpolation::Linear);
+    AnimationTracks<Quaternion> rotations;
+    rotations.add({0.0f, 2.0f}, {Quaternion{}, Quaternion::rotation(Deg(90.0f), Vector3::zAxis())}, AnimationInterpolation::Linear);
+    AnimationTracks<DualQuaternion> dualQuaternions;
+
+    RigidObject3D a;
+    AnimationPlayer<RigidMatrixTransformation3D> player{vectors, rotations, dualQuaternions};
+    player.addTranslationRotationScaling(a, 0, 0);
+
+    player.apply(1.0f);
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation({1.0f, 2.0f, 0.0f})*Matrix4::rotationZ(Deg(45.0f)));
+}
+
+void AnimationPlayerTest::translationRotationScalingDualQuaternion() {
+    AnimationTracks<Vector3> vectors;
+    vectors.add({0.0f, 2.0f}, {Vector3{}, Vector3{2.0f, 4.0f, 0.0f}}, AnimationInterpolation::Linear);
+    AnimationTracks<Quaternion> rotations;
+    rotations.add({0.0f, 2.0f}, {Quaternion{}, Quaternion::rotation(Deg(90.0f), Vector3::zAxis())}, AnimationInterpolation::Linear);
+    AnimationTracks<DualQuaternion> dualQuaternions;
+
+    Object3D a;
+    AnimationPlayer<DualQuaternionTransformation> player{vectors, rotations, dualQuaternions};
+    player.addTranslationRotationScaling(a, 0, 0);
+
+    player.apply(1.0f);
+    CORRADE_COMPARE(a.transformation(), DualQuaternion::translation({1.0f, 2.0f, 0.0f})*DualQuaternion::rotation(Deg(45.0f), Vector3::zAxis()));
+}
+
+void AnimationPlayerTest::transformation() {
+    const DualQuaternion a = DualQuaternion::translation({1.0f, 2.0f, 0.0f})*DualQuaternion::rotation(Deg(15.0f), Vector3::xAxis());
+    const DualQuaternion b = DualQuaternion::translation({-1.0f, 0.5f, 3.0f})*DualQuaternion::rotation(Deg(120.0f), Vector3::yAxis());
+
+    AnimationTracks<Vector3> vectors;
+    AnimationTracks<Quaternion> rotations;
+    AnimationTracks<DualQuaternion> dualQuaternions;
+    dualQuaternions.add({0.0f, 1.0f}, {a, b}, AnimationInterpolation::Spherical);
+
+    MatrixObject3D o;
+    AnimationPlayer<MatrixTransformation3D> player{vectors, rotations, dualQuaternions};
+    player.addTransformation(o, 0);
+
+    player.apply(0.25f);
+    CORRADE_COMPARE(o.transformation(), Math::sclerp(a, b, 0.25f).toMatrix());
+}
+
+void AnimationPlayerTest::transformationDualQuaternion() {
+    const DualQuaternion a = DualQuaternion::translation({1.0f, 2.0f, 0.0f})*DualQuaternion::rotation(Deg(15.0f), Vector3::xAxis());
+    const DualQuaternion b = DualQuaternion::translation({-1.0f, 0.5f, 3.0f})*DualQuaternion::rotation(Deg(120.0f), Vector3::yAxis());
+
+    AnimationTracks<Vector3> vectors;
+    AnimationTracks<Quaternion> rotations;
+    AnimationTracks<DualQuaternion> dualQuaternions;
+    dualQuaternions.add({0.0f, 1.0f}, {a, b}, AnimationInterpolation::Spherical);
+
+    Object3D o;
+    AnimationPlayer<DualQuaternionTransformation> player{vectors, rotations, dualQuaternions};
+    player.addTransformation(o, 0);
+
+    player.apply(0.25f);
+    CORRADE_COMPARE(o.transformation(), Math::sclerp(a, b, 0.25f));
+}
+
+void AnimationPlayerTest::tracksAddedLater() {
+    AnimationTracks<Vector3> vectors;
+    vectors.add({0.0f, 1.0f}, {Vector3{}, Vector3{1.0f}}, AnimationInterpolation::Linear);
+    AnimationTracks<Quaternion> rotations;
+    AnimationTracks<DualQuaternion> dualQuaternions;
+
+    MatrixObject3D a, b;
+    AnimationPlayer<MatrixTransformation3D> player{vectors, rotations, dualQuaternions};
+    player.addTranslationRotationScaling(a, 0, AnimationPlayer<MatrixTransformation3D>::NoTrack);
+    player.apply(0.5f);
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation(Vector3{0.5f}));
+
+    /* The sampling arrays get enlarged */
+    vectors.add({0.0f, 1.0f}, {Vector3{}, Vector3{2.0f}}, AnimationInterpolation::Linear);
+    player.addTranslationRotationScaling(b, 1, AnimationPlayer<MatrixTransformation3D>::NoTrack);
+    player.apply(0.5f);
+    CORRADE_COMPARE(a.transformation(), Matrix4::translation(Vector3{0.5f}));
+    CORRADE_COMPARE(b.transformation(), Matrix4::translation(Vector3{1.0f}));
+}
+
+void AnimationPlayerTest::clear() {
+    AnimationTracks<Vector3> vectors;
+    vectors.add({0.0f, 1.0f}, {Vector3{}, Vector3{1.0f}}, AnimationInterpolation::Linear);
+    AnimationTracks<Quaternion> rotations;
+    AnimationTracks<DualQuaternion> dualQuaternions;
+
+    MatrixObject3D a;
+    AnimationPlayer<MatrixTransformation3D> player{vectors, rotations, dualQuaternions};
+    player.addTranslationRotationScaling(a, 0, AnimationPlayer<MatrixTransformation3D>::NoTrack);
+    player.clear();
+    CORRADE_VERIFY(player.isEmpty());
+
+    /* The object is not touched anymore */
+    player.apply(0.5f);
+    CORRADE_COMPARE(a.transformation(), Matrix4{});
+}
+
+void AnimationPlayerTest::addTrackOutOfRange() {
+    AnimationTracks<Vector3> vectors;
+    vectors.add({0.0f}, {Vector3{}}, AnimationInterpolation::Linear);
+    AnimationTracks<Quaternion> rotations;
+    rotations.add({0.0f}, {Quaternion{}}, AnimationInterpolation::Linear);
+    AnimationTracks<DualQuaternion> dualQuaternions;
+
+    MatrixObject3D o;
+    AnimationPlayer<MatrixTransformation3D> player{vectors, rotations, dualQuaternions};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    player.addTranslationRotationScaling(o, 1, 0)
+          .addTranslationRotationScaling(o, 0, 1)
+          .addTranslationRotationScaling(o, 0, 0, 1)
+          .addTransformation(o, 0);
+    CORRADE_VERIFY(player.isEmpty());
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::AnimationPlayer::addTranslationRotationScaling(): track out of range\n"
+        "SceneGraph::AnimationPlayer::addTranslationRotationScaling(): track out of range\n"
+        "SceneGraph::AnimationPlayer::addTranslationRotationScaling(): track out of range\n"
+        "SceneGraph::AnimationPlayer::addTransformation(): track out of range\n");
+}
+
+void AnimationPlayerTest::addScalingRigid() {
+    AnimationTracks<Vector3> vectors;
+    vectors.add({0.0f}, {Vector3{1.0f}}, AnimationInterpolation::Linear);
+    AnimationTracks<Quaternion> rotations;
+    AnimationTracks<DualQuaternion> dualQuaternions;
+
+    Object3D a;
+    RigidObject3D b;
+    AnimationPlayer<DualQuaternionTransformation> playerA{vectors, rotations, dualQuaternions};
+    AnimationPlayer<RigidMatrixTransformation3D> playerB{vectors, rotations, dualQuaternions};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    playerA.addTranslationRotationScaling(a, AnimationPlayer<DualQuaternionTransformation>::NoTrack, AnimationPlayer<DualQuaternionTransformation>::NoTrack, 0);
+    playerB.addTranslationRotationScaling(b, AnimationPlayer<RigidMatrixTransformation3D>::NoTrack, AnimationPlayer<RigidMatrixTransformation3D>::NoTrack, 0);
+    CORRADE_VERIFY(playerA.isEmpty());
+    CORRADE_VERIFY(playerB.isEmpty());
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::AnimationPlayer::addTranslationRotationScaling(): scaling is not supported by rigid transformations\n"
+        "SceneGraph::AnimationPlayer::addTranslationRotationScaling(): scaling is not supported by rigid transformations\n");
+}
+
+void AnimationPlayerTest::benchmarkApply() {
+    AnimationTracks<Vector3> vectors;
+    AnimationTracks<Quaternion> rotations;
+    AnimationTracks<DualQuaternion> dualQuaternions;
+
+    Scene<MatrixTransformation3D> scene;
+    AnimationPlayer<MatrixTransformation3D> player{vectors, rotations, dualQuaternions};
+    for(std::size_t i = 0; i != BenchmarkObjectCount; ++i) {
+        const Float offset = Float(i%100);
+        const UnsignedInt translation = vectors.add({0.0f, 1.0f, 2.0f, 4.0f}, {Vector3{offset}, Vector3{offset + 1.0f}, Vector3{offset - 1.0f}, Vector3{offset}}, AnimationInterpolation::Linear);
+        const UnsignedInt rotation = rotations.add({0.0f, 2.0f, 4.0f}, {Quaternion{}, Quaternion::rotation(Deg(offset), Vector3::yAxis()), Quaternion{}}, AnimationInterpolation::Spherical);
+        player.addTranslationRotationScaling(*(new MatrixObject3D{&scene}), translation, rotation);
+    }
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(10) {
+        time = std::fmod(time + 1.0f/60.0f, 4.0f);
+        player.apply(time);
+    }
+
+    CORRADE_VERIFY(scene.children().last()->isDirty());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::AnimationPlayerTest)
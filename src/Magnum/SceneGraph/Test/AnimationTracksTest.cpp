@@ -0,0 +1,497 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/SceneGraph/AnimationTracks.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct AnimationTracksTest: TestSuite::Tester {
+    explicit AnimationTracksTest();
+
+    void construct();
+    void add();
+    void addCubicHermite();
+    void addNoKeyframes();
+    void addWrongValueCount();
+    void addNotIncreasing();
+    void addNotNormalized();
+    void clear();
+    void indexOutOfRange();
+
+    void step();
+    void linear();
+    void linearQuaternion();
+    void linearDualQuaternion();
+    void spherical();
+    void sphericalDualQuaternion();
+    void cubicHermite();
+    void cubicHermiteQuaternion();
+    void singleKeyframe();
+    void clamp();
+
+    void hint();
+    void hintSequential();
+    void sample();
+    void sampleWrongSize();
+
+    void debugInterpolation();
+
+    void benchmarkSampleHint();
+    void benchmarkSampleNoHint();
+    void benchmarkSampleSpherical();
+
+    private:
+        AnimationTracks<Vector3> _benchmarkVectors;
+        AnimationTracks<Quaternion> _benchmarkRotations;
+        std::vector<UnsignedInt> _benchmarkHints;
+        std::vector<Vector3> _benchmarkVectorsOut;
+        std::vector<Quaternion> _benchmarkRotationsOut;
+        Float _benchmarkTime;
+};
+
+namespace {
+    enum: std::size_t {
+        BenchmarkTrackCount = 100000,
+        BenchmarkKeyCount = 16
+    };
+
+    /* 60 FPS playback */
+    constexpr Float BenchmarkFrameTime = 1.0f/60.0f;
+}
+
+AnimationTracksTest::AnimationTracksTest(): _benchmarkTime{} {
+    addTests({&AnimationTracksTest::construct,
+              &AnimationTracksTest::add,
+              &AnimationTracksTest::addCubicHermite,
+              &AnimationTracksTest::addNoKeyframes,
+              &AnimationTracksTest::addWrongValueCount,
+              &AnimationTracksTest::addNotIncreasing,
+              &AnimationTracksTest::addNotNormalized,
+              &AnimationTracksTest::clear,
+              &AnimationTracksTest::indexOutOfRange,
+
+              &AnimationTracksTest::step,
+              &AnimationTracksTest::linear,
+              &AnimationTracksTest::linearQuaternion,
+              &AnimationTracksTest::linearDualQuaternion,
+              &AnimationTracksTest::spherical,
+              &AnimationTracksTest::sphericalDualQuaternion,
+              &AnimationTracksTest::cubicHermite,
+              &AnimationTracksTest::cubicHermiteQuaternion,
+              &AnimationTracksTest::singleKeyframe,
+              &AnimationTracksTest::clamp,
+
+              &AnimationTracksTest::hint,
+              &AnimationTracksTest::hintSequential,
+              &AnimationTracksTest::sample,
+              &AnimationTracksTest::sampleWrongSize,
+
+              &AnimationTracksTest::debugInterpolation});
+
+    addBenchmarks({&AnimationTracksTest::benchmarkSampleHint,
+                   &AnimationTracksTest::benchmarkSampleNoHint,
+                   &AnimationTracksTest::benchmarkSampleSpherical}, 10);
+
+    /* Tracks with randomly spaced keyframes, each starting at a different
+       time */
+    std::minstd_rand rand;
+    std::uniform_real_distribution<Float> distribution{0.1f, 1.0f};
+    Float keys[BenchmarkKeyCount];
+    Vector3 vectors[BenchmarkKeyCount];
+    Quaternion rotations[BenchmarkKeyCount];
+    for(std::size_t i = 0; i != BenchmarkTrackCount; ++i) {
+        Float time = distribution(rand) - 1.0f;
+        for(std::size_t j = 0; j != BenchmarkKeyCount; ++j) {
+            keys[j] = time;
+            time += distribution(rand);
+            vectors[j] = {distribution(rand), distribution(rand), distribution(rand)};
+            rotations[j] = Quaternion::rotation(Deg(distribution(rand)*360.0f), Vector3{distribution(rand), distribution(rand), distribution(rand)}.normalized());
+        }
+
+        _benchmarkVectors.add(keys, vectors, AnimationInterpolation::Linear);
+        _benchmarkRotations.add(keys, rotations, AnimationInterpolation::Spherical);
+    }
+
+    _benchmarkHints.resize(BenchmarkTrackCount);
+    _benchmarkVectorsOut.resize(BenchmarkTrackCount);
+    _benchmarkRotationsOut.resize(BenchmarkTrackCount);
+}
+
+void AnimationTracksTest::construct() {
+    AnimationTracks<Float> tracks;
+    CORRADE_VERIFY(tracks.isEmpty());
+    CORRADE_COMPARE(tracks.size(), 0);
+    CORRADE_COMPARE(tracks.duration(), 0.0f);
+}
+
+void AnimationTracksTest::add() {
+    AnimationTracks<Vector3> tracks;
+    CORRADE_COMPARE(tracks.add({0.0f, 1.0f, 3.0f}, {Vector3::xAxis(), Vector3::yAxis(), Vector3::zAxis()}, AnimationInterpolation::Linear), 0);
+    CORRADE_COMPARE(tracks.add({-1.0f, 2.0f}, {Vector3{1.0f}, Vector3{2.0f}}, AnimationInterpolation::Step), 1);
+
+    CORRADE_VERIFY(!tracks.isEmpty());
+    CORRADE_COMPARE(tracks.size(), 2);
+    CORRADE_COMPARE(tracks.duration(), 3.0f);
+
+    CORRADE_COMPARE(tracks.interpolation(0), AnimationInterpolation::Linear);
+    CORRADE_COMPARE(tracks.interpolation(1), AnimationInterpolation::Step);
+    CORRADE_COMPARE(tracks.keys(0).size(), 3);
+    CORRADE_COMPARE(tracks.keys(0)[2], 3.0f);
+    CORRADE_COMPARE(tracks.keys(1).size(), 2);
+    CORRADE_COMPARE(tracks.keys(1)[0], -1.0f);
+    CORRADE_COMPARE(tracks.values(0).size(), 3);
+    CORRADE_COMPARE(tracks.values(0)[1], Vector3::yAxis());
+    CORRADE_COMPARE(tracks.values(1).size(), 2);
+    CORRADE_COMPARE(tracks.values(1)[1], Vector3{2.0f});
+}
+
+void AnimationTracksTest::addCubicHermite() {
+    AnimationTracks<Float> tracks;
+    tracks.add({0.0f, 1.0f}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f}, AnimationInterpolation::CubicHermite);
+
+    CORRADE_COMPARE(tracks.keys(0).size(), 2);
+    CORRADE_COMPARE(tracks.values(0).size(), 6);
+    CORRADE_COMPARE(tracks.values(0)[4], 4.0f);
+}
+
+void AnimationTracksTest::addNoKeyframes() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    AnimationTracks<Float> tracks;
+    tracks.add(nullptr, nullptr, AnimationInterpolation::Linear);
+    CORRADE_VERIFY(tracks.isEmpty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::AnimationTracks::add(): expected at least one keyframe\n");
+}
+
+void AnimationTracksTest::addWrongValueCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    AnimationTracks<Float> tracks;
+    tracks.add({0.0f, 1.0f}, {0.0f, 1.0f, 2.0f}, AnimationInterpolation::Linear);
+    tracks.add({0.0f, 1.0f}, {0.0f, 1.0f}, AnimationInterpolation::CubicHermite);
+    CORRADE_VERIFY(tracks.isEmpty());
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::AnimationTracks::add(): expected 2 values but got 3\n"
+        "SceneGraph::AnimationTracks::add(): expected 6 values but got 2\n");
+}
+
+void AnimationTracksTest::addNotIncreasing() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    AnimationTracks<Float> tracks;
+    tracks.add({0.0f, 1.0f, 1.0f}, {0.0f, 1.0f, 2.0f}, AnimationInterpolation::Linear);
+    CORRADE_VERIFY(tracks.isEmpty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::AnimationTracks::add(): keyframe times are not strictly increasing\n");
+}
+
+void AnimationTracksTest::addNotNormalized() {
+    /* Tangents don't need to be normalized */
+    AnimationTracks<Quaternion> tracks;
+    tracks.add({0.0f}, {Quaternion{}*2.0f, Quaternion{}, Quaternion{}*0.5f}, AnimationInterpolation::CubicHermite);
+    CORRADE_COMPARE(tracks.size(), 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    tracks.add({0.0f, 1.0f}, {Quaternion{}, Quaternion{}*2.0f}, AnimationInterpolation::Linear);
+    CORRADE_COMPARE(tracks.size(), 1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::AnimationTracks::add(): values are not normalized\n");
+}
+
+void AnimationTracksTest::clear() {
+    AnimationTracks<Float> tracks;
+    tracks.add({0.0f, 1.0f}, {0.0f, 1.0f}, AnimationInterpolation::Linear);
+    tracks.clear();
+
+    CORRADE_VERIFY(tracks.isEmpty());
+    CORRADE_COMPARE(tracks.duration(), 0.0f);
+    CORRADE_COMPARE(tracks.add({2.0f, 3.0f}, {0.0f, 1.0f}, AnimationInterpolation::Linear), 0);
+    CORRADE_COMPARE(tracks.keys(0)[0], 2.0f);
+}
+
+void AnimationTracksTest::indexOutOfRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    AnimationTracks<Float> tracks;
+    tracks.add({0.0f, 1.0f}, {0.0f, 1.0f}, AnimationInterpolation::Linear);
+    tracks.interpolation(1);
+    tracks.keys(1);
+    tracks.values(1);
+    tracks.at(1, 0.0f);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::AnimationTracks::interpolation(): index 1 out of range for 1 tracks\n"
+        "SceneGraph::AnimationTracks::keys(): index 1 out of range for 1 tracks\n"
+        "SceneGraph::AnimationTracks::values(): index 1 out of range for 1 tracks\n"
+        "SceneGraph::AnimationTracks::at(): index 1 out of range for 1 tracks\n");
+}
+
+void AnimationTracksTest::step() {
+    AnimationTracks<Float> tracks;
+    tracks.add({0.0f, 1.0f, 3.0f}, {2.0f, 4.0f, 8.0f}, AnimationInterpolation::Step);
+
+    CORRADE_COMPARE(tracks.at(0, 0.0f), 2.0f);
+    CORRADE_COMPARE(tracks.at(0, 0.9f), 2.0f);
+    CORRADE_COMPARE(tracks.at(0, 1.0f), 4.0f);
+    CORRADE_COMPARE(tracks.at(0, 2.9f), 4.0f);
+    CORRADE_COMPARE(tracks.at(0, 3.0f), 8.0f);
+}
+
+void AnimationTracksTest::linear() {
+    AnimationTracks<Vector3> tracks;
+    tracks.add({0.0f, 1.0f, 3.0f}, {Vector3{}, Vector3{2.0f}, Vector3{1.0f, 2.0f, 4.0f}}, AnimationInterpolation::Linear);
+
+    CORRADE_COMPARE(tracks.at(0, 0.0f), Vector3{});
+    CORRADE_COMPARE(tracks.at(0, 0.25f), Vector3{0.5f});
+    CORRADE_COMPARE(tracks.at(0, 1.0f), Vector3{2.0f});
+    CORRADE_COMPARE(tracks.at(0, 2.0f), (Vector3{1.5f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(tracks.at(0, 3.0f), (Vector3{1.0f, 2.0f, 4.0f}));
+}
+
+void AnimationTracksTest::linearQuaternion() {
+    /* The second rotation is negated, interpolation should go the shortest
+       path anyway */
+    AnimationTracks<Quaternion> tracks;
+    tracks.add({0.0f, 2.0f}, {Quaternion{}, -Quaternion::rotation(Deg(90.0f), Vector3::yAxis())}, AnimationInterpolation::Linear);
+
+    const Quaternion q = tracks.at(0, 1.0f);
+    CORRADE_VERIFY(q.isNormalized());
+    CORRADE_COMPARE(q, Quaternion::rotation(Deg(45.0f), Vector3::yAxis()));
+    CORRADE_COMPARE(tracks.at(0, 0.5f), Math::lerpShortestPath(Quaternion{}, -Quaternion::rotation(Deg(90.0f), Vector3::yAxis()), 0.25f));
+}
+
+void AnimationTracksTest::linearDualQuaternion() {
+    AnimationTracks<DualQuaternion> tracks;
+    tracks.add({0.0f, 1.0f}, {DualQuaternion{}, DualQuaternion::translation({2.0f, 0.0f, 0.0f})}, AnimationInterpolation::Linear);
+
+    const DualQuaternion q = tracks.at(0, 0.5f);
+    CORRADE_VERIFY(q.isNormalized());
+    CORRADE_COMPARE(q, DualQuaternion::translation({1.0f, 0.0f, 0.0f}));
+}
+
+void AnimationTracksTest::spherical() {
+    const Quaternion a = Quaternion::rotation(Deg(15.0f), Vector3::xAxis());
+    const Quaternion b = Quaternion::rotation(Deg(160.0f), Vector3::yAxis());
+
+    AnimationTracks<Quaternion> tracks;
+    tracks.add({0.0f, 1.0f}, {a, -b}, AnimationInterpolation::Spherical);
+
+    CORRADE_COMPARE(tracks.at(0, 0.0f), a);
+    CORRADE_COMPARE(tracks.at(0, 0.3f), Math::slerpShortestPath(a, -b, 0.3f));
+    CORRADE_COMPARE(tracks.at(0, 0.3f), Math::slerp(a, b, 0.3f));
+}
+
+void AnimationTracksTest::sphericalDualQuaternion() {
+    const DualQuaternion a = DualQuaternion::translation({1.0f, 2.0f, 0.0f})*DualQuaternion::rotation(Deg(15.0f), Vector3::xAxis());
+    const DualQuaternion b = DualQuaternion::translation({-1.0f, 0.5f, 3.0f})*DualQuaternion::rotation(Deg(120.0f), Vector3::yAxis());
+
+    AnimationTracks<DualQuaternion> tracks;
+    tracks.add({0.0f, 1.0f}, {a, b}, AnimationInterpolation::Spherical);
+
+    CORRADE_COMPARE(tracks.at(0, 0.7f), Math::sclerp(a, b, 0.7f));
+}
+
+void AnimationTracksTest::cubicHermite() {
+    AnimationTracks<Float> tracks;
+    /* Value 1 with out-tangent 0.5, value 3 with in-tangent 1 */
+    tracks.add({0.0f, 2.0f}, {0.0f, 1.0f, 0.5f, 1.0f, 3.0f, 0.0f}, AnimationInterpolation::CubicHermite);
+
+    CORRADE_COMPARE(tracks.at(0, 0.0f), 1.0f);
+    CORRADE_COMPARE(tracks.at(0, 1.0f), 1.875f);
+    CORRADE_COMPARE(tracks.at(0, 2.0f), 3.0f);
+}
+
+void AnimationTracksTest::cubicHermiteQuaternion() {
+    const Quaternion a = Quaternion::rotation(Deg(0.0f), Vector3::zAxis());
+    const Quaternion b = Quaternion::rotation(Deg(90.0f), Vector3::zAxis());
+
+    /* Zero tangents, the result is the same as normalized lerp with smoothed
+       phase */
+    AnimationTracks<Quaternion> tracks;
+    tracks.add({0.0f, 1.0f}, {Quaternion{{}, 0.0f}, a, Quaternion{{}, 0.0f}, Quaternion{{}, 0.0f}, b, Quaternion{{}, 0.0f}}, AnimationInterpolation::CubicHermite);
+
+    const Quaternion q = tracks.at(0, 0.25f);
+    CORRADE_VERIFY(q.isNormalized());
+    CORRADE_COMPARE(q, Math::lerp(a, b, 0.15625f));
+    CORRADE_COMPARE(tracks.at(0, 0.5f), Quaternion::rotation(Deg(45.0f), Vector3::zAxis()));
+}
+
+void AnimationTracksTest::singleKeyframe() {
+    AnimationTracks<Float> tracks;
+    tracks.add({1.0f}, {3.0f}, AnimationInterpolation::Linear);
+    tracks.add({1.0f}, {0.0f, 5.0f, 0.0f}, AnimationInterpolation::CubicHermite);
+
+    UnsignedInt hint = 7;
+    CORRADE_COMPARE(tracks.at(0, 0.0f, hint), 3.0f);
+    CORRADE_COMPARE(hint, 0);
+    CORRADE_COMPARE(tracks.at(0, 2.0f), 3.0f);
+    CORRADE_COMPARE(tracks.at(1, 0.0f), 5.0f);
+    CORRADE_COMPARE(tracks.at(1, 2.0f), 5.0f);
+}
+
+void AnimationTracksTest::clamp() {
+    AnimationTracks<Float> tracks;
+    tracks.add({1.0f, 2.0f, 4.0f}, {3.0f, 5.0f, -1.0f}, AnimationInterpolation::Linear);
+    tracks.add({1.0f, 2.0f}, {0.0f, 3.0f, 1.0f, 1.0f, 5.0f, 0.0f}, AnimationInterpolation::CubicHermite);
+
+    CORRADE_COMPARE(tracks.at(0, -10.0f), 3.0f);
+    CORRADE_COMPARE(tracks.at(0, 10.0f), -1.0f);
+    CORRADE_COMPARE(tracks.at(1, -10.0f), 3.0f);
+    CORRADE_COMPARE(tracks.at(1, 10.0f), 5.0f);
+}
+
+void AnimationTracksTest::hint() {
+    AnimationTracks<Float> tracks;
+    tracks.add({0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f}, {0.0f, 10.0f, 20.0f, 30.0f, 40.0f, 50.0f}, AnimationInterpolation::Linear);
+
+    /* Binary search from an out-of-range hint */
+    UnsignedInt hint = 100;
+    CORRADE_COMPARE(tracks.at(0, 2.5f, hint), 25.0f);
+    CORRADE_COMPARE(hint, 2);
+
+    /* Same segment */
+    CORRADE_COMPARE(tracks.at(0, 2.75f, hint), 27.5f);
+    CORRADE_COMPARE(hint, 2);
+
+    /* Next segment */
+    CORRADE_COMPARE(tracks.at(0, 3.5f, hint), 35.0f);
+    CORRADE_COMPARE(hint, 3);
+
+    /* Previous segment */
+    CORRADE_COMPARE(tracks.at(0, 2.5f, hint), 25.0f);
+    CORRADE_COMPARE(hint, 2);
+
+    /* Jump forward */
+    CORRADE_COMPARE(tracks.at(0, 4.5f, hint), 45.0f);
+    CORRADE_COMPARE(hint, 4);
+
+    /* Jump backward */
+    CORRADE_COMPARE(tracks.at(0, 0.5f, hint), 5.0f);
+    CORRADE_COMPARE(hint, 0);
+
+    /* Clamped on both ends */
+    CORRADE_COMPARE(tracks.at(0, -1.0f, hint), 0.0f);
+    CORRADE_COMPARE(hint, 0);
+    CORRADE_COMPARE(tracks.at(0, 10.0f, hint), 50.0f);
+    CORRADE_COMPARE(hint, 4);
+    CORRADE_COMPARE(tracks.at(0, 5.0f, hint), 50.0f);
+    CORRADE_COMPARE(hint, 4);
+}
+
+void AnimationTracksTest::hintSequential() {
+    AnimationTracks<Vector3> tracks;
+    tracks.add({0.0f, 0.1f, 0.5f, 0.55f, 1.5f, 1.6f, 3.0f},
+        {Vector3{0.0f}, Vector3{1.0f}, Vector3{-1.0f}, Vector3{2.0f}, Vector3{0.5f}, Vector3{0.0f}, Vector3{3.0f}},
+        AnimationInterpolation::Linear);
+
+    /* Sampling with a hint gives the same result as binary search, both
+       forward and backward */
+    UnsignedInt hint = 0;
+    for(Float time = -0.5f; time < 3.5f; time += 0.03f)
+        CORRADE_COMPARE(tracks.at(0, time, hint), tracks.at(0, time));
+    for(Float time = 3.5f; time > -0.5f; time -= 0.07f)
+        CORRADE_COMPARE(tracks.at(0, time, hint), tracks.at(0, time));
+}
+
+void AnimationTracksTest::sample() {
+    AnimationTracks<Float> tracks;
+    tracks.add({0.0f, 1.0f}, {0.0f, 10.0f}, AnimationInterpolation::Linear);
+    tracks.add({0.0f, 1.0f, 2.0f}, {1.0f, 2.0f, 3.0f}, AnimationInterpolation::Step);
+    tracks.add({1.0f}, {7.0f}, AnimationInterpolation::Linear);
+
+    UnsignedInt hints[3]{};
+    Float out[3];
+    tracks.sample(1.5f, hints, out);
+    CORRADE_COMPARE(out[0], 10.0f);
+    CORRADE_COMPARE(out[1], 2.0f);
+    CORRADE_COMPARE(out[2], 7.0f);
+    CORRADE_COMPARE(hints[0], 0);
+    CORRADE_COMPARE(hints[1], 1);
+    CORRADE_COMPARE(hints[2], 0);
+}
+
+void AnimationTracksTest::sampleWrongSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    AnimationTracks<Float> tracks;
+    tracks.add({0.0f, 1.0f}, {0.0f, 10.0f}, AnimationInterpolation::Linear);
+    tracks.add({0.0f, 1.0f}, {0.0f, 10.0f}, AnimationInterpolation::Linear);
+
+    UnsignedInt hints[2]{};
+    Float values[3];
+    tracks.sample(0.0f, hints, values);
+    CORRADE_COMPARE(out.str(), "SceneGraph::AnimationTracks::sample(): expected 2 hints and output values but got 2 and 3\n");
+}
+
+void AnimationTracksTest::debugInterpolation() {
+    std::ostringstream out;
+    Debug(&out) << AnimationInterpolation::CubicHermite << AnimationInterpolation(0xbe);
+    CORRADE_COMPARE(out.str(), "SceneGraph::AnimationInterpolation::CubicHermite SceneGraph::AnimationInterpolation(0xbe)\n");
+}
+
+void AnimationTracksTest::benchmarkSampleHint() {
+    /* Sequential playback, continuing from the previous benchmark run */
+    CORRADE_BENCHMARK(10) {
+        _benchmarkTime = std::fmod(_benchmarkTime + BenchmarkFrameTime, 10.0f);
+        _benchmarkVectors.sample(_benchmarkTime, {_benchmarkHints.data(), _benchmarkHints.size()}, {_benchmarkVectorsOut.data(), _benchmarkVectorsOut.size()});
+    }
+
+    CORRADE_VERIFY(_benchmarkVectorsOut[0] != Vector3{});
+}
+
+void AnimationTracksTest::benchmarkSampleNoHint() {
+    CORRADE_BENCHMARK(10) {
+        _benchmarkTime = std::fmod(_benchmarkTime + BenchmarkFrameTime, 10.0f);
+        for(std::size_t i = 0; i != BenchmarkTrackCount; ++i)
+            _benchmarkVectorsOut[i] = _benchmarkVectors.at(i, _benchmarkTime);
+    }
+
+    CORRADE_VERIFY(_benchmarkVectorsOut[0] != Vector3{});
+}
+
+void AnimationTracksTest::benchmarkSampleSpherical() {
+    /* The rotation tracks have the same keyframe times as the vector tracks,
+       so the hints can be shared */
+    CORRADE_BENCHMARK(10) {
+        _benchmarkTime = std::fmod(_benchmarkTime + BenchmarkFrameTime, 10.0f);
+        _benchmarkRotations.sample(_benchmarkTime, {_benchmarkHints.data(), _benchmarkHints.size()}, {_benchmarkRotationsOut.data(), _benchmarkRotationsOut.size()});
+    }
+
+    CORRADE_VERIFY(_benchmarkRotationsOut[0].isNormalized());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::AnimationTracksTest)
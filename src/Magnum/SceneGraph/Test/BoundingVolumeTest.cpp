@@ -0,0 +1,148 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/BoundingVolume.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct BoundingVolumeTest: TestSuite::Tester {
+    explicit BoundingVolumeTest();
+
+    void box();
+    void sphere();
+    void transformedBox();
+    void transformedBox2D();
+    void transformedSphere();
+    void setVolumeMarksDirty();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+BoundingVolumeTest::BoundingVolumeTest() {
+    addTests({&BoundingVolumeTest::box,
+              &BoundingVolumeTest::sphere,
+              &BoundingVolumeTest::transformedBox,
+              &BoundingVolumeTest::transformedBox2D,
+              &BoundingVolumeTest::transformedSphere,
+              &BoundingVolumeTest::setVolumeMarksDirty});
+}
+
+void BoundingVolumeTest::box() {
+    Object3D o;
+    BoundingVolume3D volume{o, Range3D{{-1.0f, 0.0f, 2.0f}, {3.0f, 1.0f, 4.0f}}};
+
+    CORRADE_VERIFY(volume.type() == BoundingVolumeType::Box);
+    CORRADE_COMPARE(volume.center(), (Vector3{1.0f, 0.5f, 3.0f}));
+    CORRADE_COMPARE(volume.radius(), 0.0f);
+    CORRADE_COMPARE(volume.box(), (Range3D{{-1.0f, 0.0f, 2.0f}, {3.0f, 1.0f, 4.0f}}));
+}
+
+void BoundingVolumeTest::sphere() {
+    Object3D o;
+    BoundingVolume3D volume{o, Vector3{1.0f, 2.0f, 3.0f}, 0.5f};
+
+    CORRADE_VERIFY(volume.type() == BoundingVolumeType::Sphere);
+    CORRADE_COMPARE(volume.center(), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(volume.radius(), 0.5f);
+    CORRADE_COMPARE(volume.box(), (Range3D{{0.5f, 1.5f, 2.5f}, {1.5f, 2.5f, 3.5f}}));
+}
+
+void BoundingVolumeTest::transformedBox() {
+    Scene3D scene;
+    Object3D parent{&scene};
+    parent.translate({0.0f, 10.0f, 0.0f});
+    Object3D o{&parent};
+    o.scale({2.0f, 1.0f, 1.0f})
+     .rotateZ(Deg(90.0f));
+    BoundingVolume3D volume{o, Range3D{{0.0f, -1.0f, -1.0f}, {2.0f, 1.0f, 1.0f}}};
+
+    o.setClean();
+    CORRADE_COMPARE(volume.transformedCenter(), (Vector3{0.0f, 12.0f, 0.0f}));
+    CORRADE_COMPARE(volume.transformedHalfSize(), (Vector3{1.0f, 2.0f, 1.0f}));
+    CORRADE_COMPARE(volume.transformedRadius(), 0.0f);
+
+    /* Rotation by 45 degrees makes the enclosing box larger */
+    o.resetTransformation()
+     .rotateZ(Deg(45.0f));
+    o.setClean();
+    CORRADE_COMPARE(volume.transformedCenter(), (Vector3{Constants::sqrt2()*0.5f, 10.0f + Constants::sqrt2()*0.5f, 0.0f}));
+    CORRADE_COMPARE(volume.transformedHalfSize(), (Vector3{Constants::sqrt2(), Constants::sqrt2(), 1.0f}));
+}
+
+void BoundingVolumeTest::transformedBox2D() {
+    Object2D o;
+    o.translate({3.0f, 0.0f});
+    BoundingVolume2D volume{o, Range2D{{-1.0f, -2.0f}, {1.0f, 2.0f}}};
+
+    o.setClean();
+    CORRADE_COMPARE(volume.transformedCenter(), (Vector2{3.0f, 0.0f}));
+    CORRADE_COMPARE(volume.transformedHalfSize(), (Vector2{1.0f, 2.0f}));
+}
+
+void BoundingVolumeTest::transformedSphere() {
+    Object3D o;
+    o.scale({1.0f, 3.0f, 2.0f})
+     .translate({1.0f, 0.0f, 0.0f});
+    BoundingVolume3D volume{o, Vector3{0.0f, 1.0f, 0.0f}, 0.5f};
+
+    /* Radius is scaled by the largest scaling factor */
+    o.setClean();
+    CORRADE_COMPARE(volume.transformedCenter(), (Vector3{1.0f, 3.0f, 0.0f}));
+    CORRADE_COMPARE(volume.transformedHalfSize(), Vector3{});
+    CORRADE_COMPARE(volume.transformedRadius(), 1.5f);
+}
+
+void BoundingVolumeTest::setVolumeMarksDirty() {
+    Object3D o;
+    o.translate({1.0f, 0.0f, 0.0f});
+    BoundingVolume3D volume{o, Vector3{}, 1.0f};
+    o.setClean();
+    CORRADE_VERIFY(!o.isDirty());
+    CORRADE_COMPARE(volume.transformedCenter(), (Vector3{1.0f, 0.0f, 0.0f}));
+
+    volume.setBox({{1.0f, 1.0f, 1.0f}, {3.0f, 3.0f, 3.0f}});
+    CORRADE_VERIFY(o.isDirty());
+    o.setClean();
+    CORRADE_COMPARE(volume.transformedCenter(), (Vector3{3.0f, 2.0f, 2.0f}));
+    CORRADE_COMPARE(volume.transformedHalfSize(), (Vector3{1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(volume.transformedRadius(), 0.0f);
+
+    volume.setSphere({}, 2.0f);
+    CORRADE_VERIFY(o.isDirty());
+    o.setClean();
+    CORRADE_COMPARE(volume.transformedCenter(), (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(volume.transformedRadius(), 2.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BoundingVolumeTest)
@@ -23,17 +23,26 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstdlib>
+#include <new>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/SceneGraph/Camera.hpp" /* only for aspectRatioFix(), so it doesn't have to be exported */
+#include "Magnum/SceneGraph/BoundingVolume.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawQueue.h"
+#include "Magnum/SceneGraph/LodGroup.h"
+#include "Magnum/SceneGraph/LodSelector.h"
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph { namespace Test {
 
+/* Incremented by the global operator new below */
+std::size_t allocationCount = 0;
+
 struct CameraTest: TestSuite::Tester {
     explicit CameraTest();
 
@@ -46,10 +55,19 @@ struct CameraTest: TestSuite::Tester {
     void projectionSizePerspective();
     void projectionSizeViewport();
     void draw();
+    void drawCulled();
+    void drawCulled2D();
+    void drawLod();
+    void drawDeletedBoundingVolume();
+    void drawDeletedLodGroup();
+    void drawSorted();
+    void drawSortedSubclass();
+    void drawNoAllocations();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
 CameraTest::CameraTest() {
@@ -61,7 +79,15 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeOrthographic,
               &CameraTest::projectionSizePerspective,
               &CameraTest::projectionSizeViewport,
-              &CameraTest::draw});
+              &CameraTest::draw,
+              &CameraTest::drawCulled,
+              &CameraTest::drawCulled2D,
+              &CameraTest::drawLod,
+              &CameraTest::drawDeletedBoundingVolume,
+              &CameraTest::drawDeletedLodGroup,
+              &CameraTest::drawSorted,
+              &CameraTest::drawSortedSubclass,
+              &CameraTest::drawNoAllocations});
 }
 
 void CameraTest::fixAspectRatio() {
@@ -210,6 +236,425 @@ void CameraTest::draw() {
     CORRADE_COMPARE(thirdTransformation, Matrix4());
 }
 
+namespace {
+
+template<UnsignedInt dimensions> class CountingDrawable: public SceneGraph::Drawable<dimensions, Float> {
+    public:
+        CountingDrawable(AbstractObject<dimensions, Float>& object, DrawableGroup<dimensions, Float>* group): SceneGraph::Drawable<dimensions, Float>(object, group), count() {}
+
+        Int count;
+
+    protected:
+        void draw(const MatrixTypeFor<dimensions, Float>&, Camera<dimensions, Float>&) override {
+            ++count;
+        }
+};
+
+}
+
+void CameraTest::drawCulled() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    /* In front of the camera */
+    Object3D front{&scene};
+    front.translate(Vector3::zAxis(-10.0f));
+    BoundingVolume3D frontVolume{front, Vector3{}, 1.0f};
+    CountingDrawable<3> frontDrawable{front, &group};
+    frontDrawable.setBoundingVolume(&frontVolume);
+
+    /* Behind the camera */
+    Object3D behind{&scene};
+    behind.translate(Vector3::zAxis(10.0f));
+    BoundingVolume3D behindVolume{behind, Vector3{}, 1.0f};
+    CountingDrawable<3> behindDrawable{behind, &group};
+    behindDrawable.setBoundingVolume(&behindVolume);
+
+    /* Center outside of the frustum, but the box intersects it */
+    Object3D side{&scene};
+    side.translate({12.0f, 0.0f, -10.0f});
+    BoundingVolume3D sideVolume{side, Range3D{{-10.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}};
+    CountingDrawable<3> sideDrawable{side, &group};
+    sideDrawable.setBoundingVolume(&sideVolume);
+
+    /* Far away on the side, without bounding volume */
+    Object3D unbounded{&scene};
+    unbounded.translate({100.0f, 0.0f, 0.0f});
+    CountingDrawable<3> unboundedDrawable{unbounded, &group};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f));
+    CORRADE_VERIFY(!camera.isFrustumCullingEnabled());
+
+    /* Without culling everything is drawn */
+    camera.draw(group);
+    CORRADE_COMPARE(frontDrawable.count, 1);
+    CORRADE_COMPARE(behindDrawable.count, 1);
+    CORRADE_COMPARE(sideDrawable.count, 1);
+    CORRADE_COMPARE(unboundedDrawable.count, 1);
+    CORRADE_COMPARE(camera.drawnCount(), 4);
+    CORRADE_COMPARE(camera.culledCount(), 0);
+
+    camera.setFrustumCulling(true);
+    CORRADE_VERIFY(camera.isFrustumCullingEnabled());
+    camera.draw(group);
+    CORRADE_COMPARE(frontDrawable.count, 2);
+    CORRADE_COMPARE(behindDrawable.count, 1);
+    CORRADE_COMPARE(sideDrawable.count, 2);
+    CORRADE_COMPARE(unboundedDrawable.count, 2);
+    CORRADE_COMPARE(camera.drawnCount(), 3);
+    CORRADE_COMPARE(camera.culledCount(), 1);
+
+    /* Moving the objects updates the volumes, turning the camera updates the
+       frustum */
+    side.translate(Vector3::xAxis(20.0f));
+    cameraObject.rotateY(Deg(180.0f));
+    camera.draw(group);
+    CORRADE_COMPARE(frontDrawable.count, 2);
+    CORRADE_COMPARE(behindDrawable.count, 2);
+    CORRADE_COMPARE(sideDrawable.count, 2);
+    CORRADE_COMPARE(unboundedDrawable.count, 3);
+    CORRADE_COMPARE(camera.drawnCount(), 2);
+    CORRADE_COMPARE(camera.culledCount(), 2);
+
+    /* Beyond the far plane */
+    cameraObject.resetTransformation()
+        .translate(Vector3::zAxis(100.0f));
+    camera.draw(group);
+    CORRADE_COMPARE(frontDrawable.count, 2);
+    CORRADE_COMPARE(behindDrawable.count, 3);
+    CORRADE_COMPARE(camera.culledCount(), 2);
+}
+
+void CameraTest::drawCulled2D() {
+    DrawableGroup2D group;
+    Scene2D scene;
+
+    Object2D inside{&scene};
+    inside.translate({1.5f, 0.0f});
+    BoundingVolume2D insideVolume{inside, Range2D{{-1.0f, -1.0f}, {1.0f, 1.0f}}};
+    CountingDrawable<2> insideDrawable{inside, &group};
+    insideDrawable.setBoundingVolume(&insideVolume);
+
+    Object2D outside{&scene};
+    outside.translate({0.0f, -3.5f});
+    BoundingVolume2D outsideVolume{outside, Vector2{}, 1.0f};
+    CountingDrawable<2> outsideDrawable{outside, &group};
+    outsideDrawable.setBoundingVolume(&outsideVolume);
+
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix3::projection({4.0f, 4.0f}))
+        .setFrustumCulling(true);
+    camera.draw(group);
+    CORRADE_COMPARE(insideDrawable.count, 1);
+    CORRADE_COMPARE(outsideDrawable.count, 0);
+    CORRADE_COMPARE(camera.drawnCount(), 1);
+    CORRADE_COMPARE(camera.culledCount(), 1);
+}
+
+void CameraTest::drawLod() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(-10.0f));
+    LodSelector3D selector;
+    LodGroup3D lod{object, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+    CountingDrawable<3> fine{object, &group};
+    CountingDrawable<3> medium{object, &group};
+    CountingDrawable<3> coarse{object, &group};
+    CountingDrawable<3> always{object, &group};
+    fine.setLodGroup(&lod, 0);
+    medium.setLodGroup(&lod, 1);
+    coarse.setLodGroup(&lod, 2);
+    CORRADE_COMPARE(medium.lodGroup(), &lod);
+    CORRADE_COMPARE(medium.lodLevel(), 1);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 1000.0f));
+
+    /* Before selection the finest level is drawn */
+    camera.draw(group);
+    CORRADE_COMPARE(fine.count, 1);
+    CORRADE_COMPARE(medium.count, 0);
+    CORRADE_COMPARE(coarse.count, 0);
+    CORRADE_COMPARE(always.count, 1);
+    CORRADE_COMPARE(camera.drawnCount(), 2);
+    CORRADE_COMPARE(camera.culledCount(), 0);
+
+    selector.select(camera);
+    camera.draw(group);
+    CORRADE_COMPARE(fine.count, 1);
+    CORRADE_COMPARE(medium.count, 0);
+    CORRADE_COMPARE(coarse.count, 1);
+    CORRADE_COMPARE(always.count, 2);
+
+    /* Too far for any level */
+    object.translate(Vector3::zAxis(-100.0f));
+    selector.select(camera);
+    camera.draw(group);
+    CORRADE_COMPARE(fine.count, 1);
+    CORRADE_COMPARE(medium.count, 0);
+    CORRADE_COMPARE(coarse.count, 1);
+    CORRADE_COMPARE(always.count, 3);
+    CORRADE_COMPARE(camera.drawnCount(), 1);
+    CORRADE_COMPARE(camera.culledCount(), 0);
+}
+
+void CameraTest::drawDeletedBoundingVolume() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    /* Behind the camera */
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(10.0f));
+    CountingDrawable<3> a{object, &group};
+    CountingDrawable<3> b{object, &group};
+    auto volume = new BoundingVolume3D{object, Vector3{}, 1.0f};
+    a.setBoundingVolume(volume);
+    b.setBoundingVolume(volume);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f))
+        .setFrustumCulling(true);
+
+    camera.draw(group);
+    CORRADE_COMPARE(camera.drawnCount(), 0);
+
+    /* Deleting the volume removes it from the drawables, which are then
+       never culled */
+    delete volume;
+    CORRADE_VERIFY(!a.boundingVolume());
+    CORRADE_VERIFY(!b.boundingVolume());
+    camera.draw(group);
+    CORRADE_COMPARE(a.count, 1);
+    CORRADE_COMPARE(b.count, 1);
+    CORRADE_COMPARE(camera.drawnCount(), 2);
+
+    /* Deleting a drawable removes it from the volume, so the volume
+       destructor doesn't access it */
+    BoundingVolume3D other{object, Vector3{}, 1.0f};
+    {
+        CountingDrawable<3> c{object, &group};
+        c.setBoundingVolume(&other);
+        a.setBoundingVolume(&other);
+    }
+    CORRADE_VERIFY(a.boundingVolume() == &other);
+}
+
+void CameraTest::drawDeletedLodGroup() {
+    DrawableGroup3D group;
+    Scene3D scene;
+
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(-10.0f));
+    LodSelector3D selector;
+    auto lod = new LodGroup3D{object, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+    CountingDrawable<3> fine{object, &group};
+    CountingDrawable<3> coarse{object, &group};
+    fine.setLodGroup(lod, 0);
+    coarse.setLodGroup(lod, 2);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 1000.0f));
+
+    camera.draw(group);
+    CORRADE_COMPARE(camera.drawnCount(), 1);
+
+    /* Deleting the group removes it from the drawables, which are then
+       always drawn */
+    delete lod;
+    CORRADE_VERIFY(!fine.lodGroup());
+    CORRADE_VERIFY(!coarse.lodGroup());
+    camera.draw(group);
+    CORRADE_COMPARE(fine.count, 2);
+    CORRADE_COMPARE(coarse.count, 1);
+    CORRADE_COMPARE(camera.drawnCount(), 2);
+
+    /* Switching the group removes the drawable from the previous one */
+    LodGroup3D other{object, 1.0f, {0.5f}};
+    {
+        LodGroup3D another{object, 1.0f, {0.5f}};
+        fine.setLodGroup(&another, 0);
+        fine.setLodGroup(&other, 0);
+    }
+    CORRADE_VERIFY(fine.lodGroup() == &other);
+}
+
+void CameraTest::drawSorted() {
+    class OrderDrawable: public SceneGraph::Drawable3D {
+        public:
+            OrderDrawable(AbstractObject3D& object, DrawableGroup3D* group, std::string& order, char name): SceneGraph::Drawable3D(object, group), order(order), name(name) {}
+
+        protected:
+            void draw(const Matrix4&, Camera3D&) override {
+                order += name;
+            }
+
+        private:
+            std::string& order;
+            char name;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::string order;
+
+    Object3D a{&scene};
+    a.translate(Vector3::zAxis(-3.0f));
+    (new OrderDrawable{a, &group, order, 'a'})->setSortKey(1);
+
+    Object3D b{&scene};
+    b.translate(Vector3::zAxis(-1.0f));
+    (new OrderDrawable{b, &group, order, 'b'})->setSortKey(2);
+
+    Object3D c{&scene};
+    c.translate(Vector3::zAxis(-2.0f));
+    (new OrderDrawable{c, &group, order, 'c'})->setSortKey(1);
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    camera.draw(group);
+    CORRADE_COMPARE(order, "abc");
+
+    DrawQueue3D queue{DrawOrder::FrontToBack};
+    order.clear();
+    camera.drawSorted(group, queue);
+    CORRADE_COMPARE(order, "cab");
+    CORRADE_COMPARE(camera.drawnCount(), 3);
+
+    queue.setOrder(DrawOrder::BackToFront);
+    order.clear();
+    camera.drawSorted(group, queue);
+    CORRADE_COMPARE(order, "acb");
+}
+
+void CameraTest::drawSortedSubclass() {
+    /* Overriding draw() doesn't hide drawSorted() and both can be
+       customized */
+    class MyCamera: public Camera3D {
+        public:
+            explicit MyCamera(AbstractObject3D& object, std::string& log): Camera3D{object}, log(log) {}
+
+            void draw(DrawableGroup3D& group) override {
+                log += "draw ";
+                Camera3D::draw(group);
+            }
+
+            void drawSorted(DrawableGroup3D& group, DrawQueue3D& queue) override {
+                log += "drawSorted ";
+                Camera3D::drawSorted(group, queue);
+            }
+
+        private:
+            std::string& log;
+    };
+
+    class MyDrawable: public SceneGraph::Drawable3D {
+        public:
+            explicit MyDrawable(AbstractObject3D& object, DrawableGroup3D* group, std::string& log): SceneGraph::Drawable3D(object, group), log(log) {}
+
+        protected:
+            void draw(const Matrix4&, Camera3D&) override {
+                log += "drawable ";
+            }
+
+        private:
+            std::string& log;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::string log;
+
+    Object3D a{&scene};
+    new MyDrawable{a, &group, log};
+
+    Object3D cameraObject{&scene};
+    MyCamera myCamera{cameraObject, log};
+    Camera3D& camera = myCamera;
+    DrawQueue3D queue{DrawOrder::FrontToBack};
+
+    myCamera.drawSorted(group, queue);
+    camera.draw(group);
+    camera.drawSorted(group, queue);
+    CORRADE_COMPARE(log, "drawSorted drawable draw drawable drawSorted drawable ");
+}
+
+void CameraTest::drawNoAllocations() {
+    class CountingDrawable: public SceneGraph::Drawable3D {
+        public:
+            CountingDrawable(AbstractObject3D& object, DrawableGroup3D* group, std::size_t& count): SceneGraph::Drawable3D(object, group), count(count) {}
+
+        protected:
+            void draw(const Matrix4&, Camera3D&) override {
+                ++count;
+            }
+
+        private:
+            std::size_t& count;
+    };
+
+    Scene3D scene;
+    DrawableGroup3D group;
+    std::size_t count = 0;
+    for(Int i = 0; i != 100; ++i) {
+        auto parent = new Object3D{&scene};
+        parent->translate(Vector3::xAxis(Float(i)));
+        auto o = new Object3D{parent};
+        o->translate(Vector3::zAxis(-5.0f));
+        auto drawable = new CountingDrawable{*o, &group, count};
+        drawable->setSortKey(i % 3);
+        if(i % 2) drawable->setBoundingVolume(new BoundingVolume3D{*o, Vector3{}, 1.0f});
+    }
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f))
+        .setFrustumCulling(true);
+    DrawQueue3D queue{DrawOrder::FrontToBack};
+
+    /* First draws allocate the temporary storage */
+    camera.draw(group);
+    camera.drawSorted(group, queue);
+    CORRADE_COMPARE(camera.drawnCount(), 53);
+
+    /* Subsequent draws reuse it */
+    count = 0;
+    const std::size_t allocations = allocationCount;
+    camera.draw(group);
+    camera.drawSorted(group, queue);
+    CORRADE_COMPARE(allocationCount - allocations, 0);
+    CORRADE_COMPARE(count, 2*53);
+
+    /* Same with flattened hierarchy */
+    scene.setFlattened(true);
+    camera.drawSorted(group, queue);
+    count = 0;
+    const std::size_t flattenedAllocations = allocationCount;
+    camera.drawSorted(group, queue);
+    CORRADE_COMPARE(allocationCount - flattenedAllocations, 0);
+    CORRADE_COMPARE(count, 53);
+}
+
 }}}
 
+/* Counting all allocations done by the test. The default implementations of
+   array new and delete use these. */
+void* operator new(std::size_t size) {
+    ++Magnum::SceneGraph::Test::allocationCount;
+    if(void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraTest)
@@ -0,0 +1,323 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawQueue.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct DrawQueueTest: TestSuite::Tester {
+    explicit DrawQueueTest();
+
+    void radixSort();
+    void radixSortSkipDigits();
+    void depthKey();
+
+    void sortKey();
+    void frontToBack();
+    void backToFront();
+    void sort2D();
+    void sortEmpty();
+    void sortSizeMismatch();
+
+    void debugOrder();
+
+    void benchmarkRadixSort();
+    void benchmarkStdStableSort();
+    void benchmarkQueue();
+
+    private:
+        std::vector<UnsignedLong> _benchmarkKeys;
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+namespace {
+    enum: std::size_t { BenchmarkSize = 100000 };
+
+    template<UnsignedInt dimensions> struct NullDrawable: SceneGraph::Drawable<dimensions, Float> {
+        explicit NullDrawable(AbstractObject<dimensions, Float>& object, DrawableGroup<dimensions, Float>& group, UnsignedLong key): SceneGraph::Drawable<dimensions, Float>{object, &group} {
+            this->setSortKey(key);
+        }
+
+        void draw(const MatrixTypeFor<dimensions, Float>&, Camera<dimensions, Float>&) override {}
+    };
+}
+
+DrawQueueTest::DrawQueueTest() {
+    addTests({&DrawQueueTest::radixSort,
+              &DrawQueueTest::radixSortSkipDigits,
+              &DrawQueueTest::depthKey,
+
+              &DrawQueueTest::sortKey,
+              &DrawQueueTest::frontToBack,
+              &DrawQueueTest::backToFront,
+              &DrawQueueTest::sort2D,
+              &DrawQueueTest::sortEmpty,
+              &DrawQueueTest::sortSizeMismatch,
+
+              &DrawQueueTest::debugOrder});
+
+    addBenchmarks({&DrawQueueTest::benchmarkRadixSort,
+                   &DrawQueueTest::benchmarkStdStableSort,
+                   &DrawQueueTest::benchmarkQueue}, 10);
+
+    /* Keys with only some bits used, as usual for state sort keys */
+    std::minstd_rand rand;
+    _benchmarkKeys.resize(BenchmarkSize);
+    for(UnsignedLong& key: _benchmarkKeys)
+        key = (UnsignedLong(rand() % 16) << 48)|(UnsignedLong(rand() % 256) << 24)|UnsignedLong(rand() % 1024);
+}
+
+void DrawQueueTest::radixSort() {
+    std::minstd_rand rand;
+    std::vector<UnsignedLong> keys(1000), scratchKeys(1000);
+    std::vector<UnsignedInt> indices(1000), scratchIndices(1000);
+    for(std::size_t i = 0; i != keys.size(); ++i) {
+        /* Few distinct values so the stability gets tested */
+        keys[i] = UnsignedLong(rand() % 37) << 40 | UnsignedLong(rand() % 3);
+        indices[i] = i;
+    }
+
+    std::vector<UnsignedInt> expected = indices;
+    std::stable_sort(expected.begin(), expected.end(), [&keys](UnsignedInt a, UnsignedInt b) { return keys[a] < keys[b]; });
+
+    const bool swapped = Implementation::radixSort({keys.data(), keys.size()}, {indices.data(), indices.size()}, {scratchKeys.data(), scratchKeys.size()}, {scratchIndices.data(), scratchIndices.size()}, 8);
+    CORRADE_VERIFY(swapped ? scratchIndices == expected : indices == expected);
+    const std::vector<UnsignedLong>& sortedKeys = swapped ? scratchKeys : keys;
+    CORRADE_VERIFY(std::is_sorted(sortedKeys.begin(), sortedKeys.end()));
+}
+
+void DrawQueueTest::radixSortSkipDigits() {
+    UnsignedLong keys[]{0x0300000000000000ull, 0x0100000000000000ull, 0x0200000000000000ull};
+    UnsignedInt indices[]{0, 1, 2};
+    UnsignedLong scratchKeys[3];
+    UnsignedInt scratchIndices[3];
+
+    /* Only one digit differs, so the data get moved just once */
+    CORRADE_VERIFY(Implementation::radixSort(keys, indices, scratchKeys, scratchIndices, 8));
+    CORRADE_COMPARE(scratchIndices[0], 1);
+    CORRADE_COMPARE(scratchIndices[1], 2);
+    CORRADE_COMPARE(scratchIndices[2], 0);
+
+    /* Sorting only the lowest digits does nothing */
+    CORRADE_VERIFY(!Implementation::radixSort(keys, indices, scratchKeys, scratchIndices, 4));
+    CORRADE_COMPARE(indices[0], 0);
+    CORRADE_COMPARE(indices[1], 1);
+    CORRADE_COMPARE(indices[2], 2);
+}
+
+void DrawQueueTest::depthKey() {
+    const Float depths[]{-1000.0f, -2.5f, -1.0f, -0.0f, 0.0f, 0.001f, 1.0f, 2.5f, 1.0e10f};
+    for(std::size_t i = 1; i != 9; ++i)
+        CORRADE_VERIFY(Implementation::depthKey(depths[i - 1]) <= Implementation::depthKey(depths[i]));
+}
+
+void DrawQueueTest::sortKey() {
+    Object3D o;
+    DrawableGroup3D group;
+    new NullDrawable<3>{o, group, 30};
+    new NullDrawable<3>{o, group, 10};
+    new NullDrawable<3>{o, group, 20};
+    new NullDrawable<3>{o, group, 10};
+
+    /* Sorting only some drawables, the depth is ignored */
+    const UnsignedInt drawables[]{3, 0, 1, 2};
+    const Matrix4 transformations[]{
+        Matrix4::translation(Vector3::zAxis(-1.0f)),
+        Matrix4::translation(Vector3::zAxis(-3.0f)),
+        Matrix4::translation(Vector3::zAxis(-2.0f)),
+        Matrix4::translation(Vector3::zAxis(-4.0f))};
+
+    DrawQueue3D queue;
+    CORRADE_VERIFY(queue.order() == DrawOrder::SortKey);
+    Containers::ArrayView<const UnsignedInt> order = queue.sort(group, drawables, transformations);
+    CORRADE_COMPARE(order.size(), 4);
+    CORRADE_COMPARE(order[0], 0);
+    CORRADE_COMPARE(order[1], 2);
+    CORRADE_COMPARE(order[2], 3);
+    CORRADE_COMPARE(order[3], 1);
+}
+
+void DrawQueueTest::frontToBack() {
+    Object3D o;
+    DrawableGroup3D group;
+    new NullDrawable<3>{o, group, 2};
+    new NullDrawable<3>{o, group, 1};
+    new NullDrawable<3>{o, group, 2};
+    new NullDrawable<3>{o, group, 1};
+    new NullDrawable<3>{o, group, 2};
+
+    const UnsignedInt drawables[]{0, 1, 2, 3, 4};
+    const Matrix4 transformations[]{
+        Matrix4::translation(Vector3::zAxis(-5.0f)),
+        Matrix4::translation(Vector3::zAxis(-7.0f)),
+        Matrix4::translation(Vector3::zAxis(-1.0f)),
+        Matrix4::translation(Vector3::zAxis(-3.0f)),
+        /* Behind the camera */
+        Matrix4::translation(Vector3::zAxis(2.0f))};
+
+    DrawQueue3D queue{DrawOrder::FrontToBack};
+    Containers::ArrayView<const UnsignedInt> order = queue.sort(group, drawables, transformations);
+    CORRADE_COMPARE(order.size(), 5);
+    CORRADE_COMPARE(order[0], 3);
+    CORRADE_COMPARE(order[1], 1);
+    CORRADE_COMPARE(order[2], 4);
+    CORRADE_COMPARE(order[3], 2);
+    CORRADE_COMPARE(order[4], 0);
+}
+
+void DrawQueueTest::backToFront() {
+    Object3D o;
+    DrawableGroup3D group;
+    new NullDrawable<3>{o, group, 2};
+    new NullDrawable<3>{o, group, 1};
+    new NullDrawable<3>{o, group, 2};
+    new NullDrawable<3>{o, group, 1};
+
+    const UnsignedInt drawables[]{0, 1, 2, 3};
+    const Matrix4 transformations[]{
+        Matrix4::translation(Vector3::zAxis(-5.0f)),
+        Matrix4::translation(Vector3::zAxis(-7.0f)),
+        Matrix4::translation(Vector3::zAxis(-1.0f)),
+        /* Same depth as the first, has lower key */
+        Matrix4::translation(Vector3::zAxis(-5.0f))};
+
+    DrawQueue3D queue;
+    queue.setOrder(DrawOrder::BackToFront);
+    Containers::ArrayView<const UnsignedInt> order = queue.sort(group, drawables, transformations);
+    CORRADE_COMPARE(order.size(), 4);
+    CORRADE_COMPARE(order[0], 1);
+    CORRADE_COMPARE(order[1], 3);
+    CORRADE_COMPARE(order[2], 0);
+    CORRADE_COMPARE(order[3], 2);
+}
+
+void DrawQueueTest::sort2D() {
+    Object2D o;
+    DrawableGroup2D group;
+    new NullDrawable<2>{o, group, 7};
+    new NullDrawable<2>{o, group, 3};
+    new NullDrawable<2>{o, group, 7};
+
+    const UnsignedInt drawables[]{0, 1, 2};
+    const Matrix3 transformations[]{
+        Matrix3::translation(Vector2::yAxis(-5.0f)),
+        Matrix3::translation(Vector2::yAxis(5.0f)),
+        Matrix3::translation(Vector2::xAxis(1.0f))};
+
+    /* No depth in 2D, so just sort key and stable order */
+    DrawQueue2D queue{DrawOrder::BackToFront};
+    Containers::ArrayView<const UnsignedInt> order = queue.sort(group, drawables, transformations);
+    CORRADE_COMPARE(order.size(), 3);
+    CORRADE_COMPARE(order[0], 1);
+    CORRADE_COMPARE(order[1], 0);
+    CORRADE_COMPARE(order[2], 2);
+}
+
+void DrawQueueTest::sortEmpty() {
+    DrawableGroup3D group;
+    DrawQueue3D queue{DrawOrder::FrontToBack};
+    CORRADE_COMPARE(queue.sort(group, nullptr, nullptr).size(), 0);
+}
+
+void DrawQueueTest::sortSizeMismatch() {
+    Object3D o;
+    DrawableGroup3D group;
+    new NullDrawable<3>{o, group, 0};
+
+    const UnsignedInt drawables[]{0};
+    std::ostringstream out;
+    Error redirectError{&out};
+    DrawQueue3D queue;
+    queue.sort(group, drawables, nullptr);
+    CORRADE_COMPARE(out.str(), "SceneGraph::DrawQueue::sort(): expected 1 transformations but got 0\n");
+}
+
+void DrawQueueTest::debugOrder() {
+    std::ostringstream out;
+    Debug(&out) << DrawOrder::FrontToBack << DrawOrder(0xbe);
+    CORRADE_COMPARE(out.str(), "SceneGraph::DrawOrder::FrontToBack SceneGraph::DrawOrder(0xbe)\n");
+}
+
+void DrawQueueTest::benchmarkRadixSort() {
+    std::vector<UnsignedLong> keys(BenchmarkSize), scratchKeys(BenchmarkSize);
+    std::vector<UnsignedInt> indices(BenchmarkSize), scratchIndices(BenchmarkSize);
+    UnsignedInt first = 0;
+    CORRADE_BENCHMARK(10) {
+        keys = _benchmarkKeys;
+        for(std::size_t i = 0; i != indices.size(); ++i) indices[i] = i;
+        const bool swapped = Implementation::radixSort({keys.data(), keys.size()}, {indices.data(), indices.size()}, {scratchKeys.data(), scratchKeys.size()}, {scratchIndices.data(), scratchIndices.size()}, 8);
+        first += swapped ? scratchIndices[0] : indices[0];
+    }
+
+    CORRADE_VERIFY(first < BenchmarkSize*10);
+}
+
+void DrawQueueTest::benchmarkStdStableSort() {
+    std::vector<UnsignedInt> indices(BenchmarkSize);
+    UnsignedInt first = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != indices.size(); ++i) indices[i] = i;
+        std::stable_sort(indices.begin(), indices.end(), [this](UnsignedInt a, UnsignedInt b) {
+            return _benchmarkKeys[a] < _benchmarkKeys[b];
+        });
+        first += indices[0];
+    }
+
+    CORRADE_VERIFY(first < BenchmarkSize*10);
+}
+
+void DrawQueueTest::benchmarkQueue() {
+    Object3D o;
+    DrawableGroup3D group;
+    std::vector<UnsignedInt> drawables(BenchmarkSize);
+    std::vector<Matrix4> transformations(BenchmarkSize);
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) {
+        new NullDrawable<3>{o, group, _benchmarkKeys[i]};
+        drawables[i] = i;
+        transformations[i] = Matrix4::translation(Vector3::zAxis(-Float(_benchmarkKeys[i] % 997)));
+    }
+
+    DrawQueue3D queue{DrawOrder::FrontToBack};
+    UnsignedInt first = 0;
+    CORRADE_BENCHMARK(10)
+        first += queue.sort(group, {drawables.data(), drawables.size()}, {transformations.data(), transformations.size()})[0];
+
+    CORRADE_VERIFY(first < BenchmarkSize*10);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::DrawQueueTest)
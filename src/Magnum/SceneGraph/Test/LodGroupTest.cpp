@@ -0,0 +1,363 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <limits>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/LodGroup.h"
+#include "Magnum/SceneGraph/LodSelector.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct LodGroupTest: TestSuite::Tester {
+    explicit LodGroupTest();
+
+    void construct();
+    void setThresholds();
+    void setThresholdsInvalid();
+    void setThresholdsFewerLevels();
+    void setHysteresisInvalid();
+
+    void selectPerspective();
+    void selectScaled();
+    void selectBehindCamera();
+    void selectCameraTransformation();
+    void select2D();
+    void selectEmpty();
+    void selectNoScene();
+    void hysteresis();
+
+    void benchmarkSelect();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+namespace {
+    enum: std::size_t { BenchmarkSize = 100000 };
+
+    /* Unit at distance 1 covers the whole viewport height */
+    Matrix4 perspective() {
+        return Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 1000.0f);
+    }
+}
+
+LodGroupTest::LodGroupTest() {
+    addTests({&LodGroupTest::construct,
+              &LodGroupTest::setThresholds,
+              &LodGroupTest::setThresholdsInvalid,
+              &LodGroupTest::setThresholdsFewerLevels,
+              &LodGroupTest::setHysteresisInvalid,
+
+              &LodGroupTest::selectPerspective,
+              &LodGroupTest::selectScaled,
+              &LodGroupTest::selectBehindCamera,
+              &LodGroupTest::selectCameraTransformation,
+              &LodGroupTest::select2D,
+              &LodGroupTest::selectEmpty,
+              &LodGroupTest::selectNoScene,
+              &LodGroupTest::hysteresis});
+
+    addBenchmarks({&LodGroupTest::benchmarkSelect}, 10);
+}
+
+void LodGroupTest::construct() {
+    Object3D object;
+    LodSelector3D selector;
+    LodGroup3D lod{object, 2.5f, {0.5f, 0.1f}, &selector};
+
+    CORRADE_COMPARE(lod.selector(), &selector);
+    CORRADE_COMPARE(selector.size(), 1);
+    CORRADE_COMPARE(lod.radius(), 2.5f);
+    CORRADE_COMPARE(lod.thresholds(), (std::vector<Float>{0.5f, 0.1f}));
+    CORRADE_COMPARE(lod.levelCount(), 2);
+    CORRADE_COMPARE(lod.level(), 0);
+    CORRADE_COMPARE(lod.screenSize(), 0.0f);
+    CORRADE_COMPARE(selector.hysteresis(), 0.0f);
+}
+
+void LodGroupTest::setThresholds() {
+    Object3D object;
+    LodGroup3D lod{object, 1.0f, {0.5f}};
+    CORRADE_VERIFY(!lod.selector());
+
+    lod.setRadius(3.0f)
+       .setThresholds({0.7f, 0.3f, 0.01f});
+    CORRADE_COMPARE(lod.radius(), 3.0f);
+    CORRADE_COMPARE(lod.thresholds(), (std::vector<Float>{0.7f, 0.3f, 0.01f}));
+    CORRADE_COMPARE(lod.levelCount(), 3);
+}
+
+void LodGroupTest::setThresholdsInvalid() {
+    Object3D object;
+    LodGroup3D lod{object, 1.0f, {0.5f}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    lod.setThresholds(std::vector<Float>{});
+    lod.setThresholds({0.5f, 0.5f});
+    lod.setThresholds({0.5f, 0.0f});
+    CORRADE_COMPARE(lod.thresholds(), std::vector<Float>{0.5f});
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::LodGroup::setThresholds(): expected at least one threshold\n"
+        "SceneGraph::LodGroup::setThresholds(): thresholds are not positive and strictly decreasing\n"
+        "SceneGraph::LodGroup::setThresholds(): thresholds are not positive and strictly decreasing\n");
+}
+
+void LodGroupTest::setThresholdsFewerLevels() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(-100.0f));
+    LodSelector3D selector;
+    LodGroup3D lod{object, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+    selector.select(camera);
+    CORRADE_COMPARE(lod.level(), 3);
+
+    /* No level is selected until the next selection */
+    lod.setThresholds({0.5f});
+    CORRADE_COMPARE(lod.level(), 1);
+}
+
+void LodGroupTest::setHysteresisInvalid() {
+    LodSelector3D selector;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    selector.setHysteresis(-0.1f)
+            .setHysteresis(1.0f);
+    CORRADE_COMPARE(selector.hysteresis(), 0.0f);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::LodSelector::setHysteresis(): expected a value in range [0, 1) but got -0.1\n"
+        "SceneGraph::LodSelector::setHysteresis(): expected a value in range [0, 1) but got 1\n");
+}
+
+void LodGroupTest::selectPerspective() {
+    Scene3D scene;
+    LodSelector3D selector;
+
+    Object3D near{&scene}, middle{&scene}, far{&scene}, tooFar{&scene};
+    near.translate(Vector3::zAxis(-1.5f));
+    middle.translate({3.0f, 2.0f, -4.0f});
+    far.translate(Vector3::zAxis(-10.0f));
+    tooFar.translate(Vector3::zAxis(-100.0f));
+    LodGroup3D nearLod{near, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+    LodGroup3D middleLod{middle, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+    LodGroup3D farLod{far, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+    LodGroup3D tooFarLod{tooFar, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+    selector.select(camera);
+
+    CORRADE_COMPARE(nearLod.screenSize(), 1.0f/1.5f);
+    CORRADE_COMPARE(nearLod.level(), 0);
+    /* Only depth matters, not distance */
+    CORRADE_COMPARE(middleLod.screenSize(), 0.25f);
+    CORRADE_COMPARE(middleLod.level(), 1);
+    CORRADE_COMPARE(farLod.screenSize(), 0.1f);
+    CORRADE_COMPARE(farLod.level(), 2);
+    CORRADE_COMPARE(tooFarLod.screenSize(), 0.01f);
+    CORRADE_COMPARE(tooFarLod.level(), 3);
+}
+
+void LodGroupTest::selectScaled() {
+    Scene3D scene;
+    LodSelector3D selector;
+
+    /* Largest axis scale is used */
+    Object3D parent{&scene};
+    parent.scale({1.0f, 3.0f, 0.5f});
+    Object3D object{&parent};
+    object.translate(Vector3::zAxis(-10.0f));
+    LodGroup3D lod{object, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+    selector.select(camera);
+
+    CORRADE_COMPARE(lod.screenSize(), 0.6f);
+    CORRADE_COMPARE(lod.level(), 0);
+}
+
+void LodGroupTest::selectBehindCamera() {
+    Scene3D scene;
+    LodSelector3D selector;
+
+    Object3D object{&scene};
+    object.translate(Vector3::zAxis(10.0f));
+    LodGroup3D lod{object, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+    selector.select(camera);
+
+    CORRADE_COMPARE(lod.screenSize(), std::numeric_limits<Float>::infinity());
+    CORRADE_COMPARE(lod.level(), 0);
+}
+
+void LodGroupTest::selectCameraTransformation() {
+    Scene3D scene;
+    LodSelector3D selector;
+
+    Object3D object{&scene};
+    LodGroup3D lod{object, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+
+    Object3D cameraObject{&scene};
+    cameraObject.rotateY(Deg(180.0f))
+        .translate(Vector3::zAxis(-10.0f));
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+    selector.select(camera);
+
+    CORRADE_COMPARE(lod.screenSize(), 0.1f);
+    CORRADE_COMPARE(lod.level(), 2);
+}
+
+void LodGroupTest::select2D() {
+    Scene2D scene;
+    LodSelector2D selector;
+
+    /* Orthographic projection, the distance doesn't matter */
+    Object2D small{&scene}, large{&scene};
+    small.translate({100.0f, 0.0f});
+    large.scale(Vector2{4.0f});
+    LodGroup2D smallLod{small, 1.0f, {0.75f, 0.25f}, &selector};
+    LodGroup2D largeLod{large, 1.0f, {0.75f, 0.25f}, &selector};
+
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix3::projection({4.0f, 4.0f}));
+    selector.select(camera);
+
+    CORRADE_COMPARE(smallLod.screenSize(), 0.5f);
+    CORRADE_COMPARE(smallLod.level(), 1);
+    CORRADE_COMPARE(largeLod.screenSize(), 2.0f);
+    CORRADE_COMPARE(largeLod.level(), 0);
+}
+
+void LodGroupTest::selectEmpty() {
+    Object3D cameraObject;
+    Camera3D camera{cameraObject};
+
+    /* Shouldn't complain about missing scene */
+    LodSelector3D selector;
+    selector.select(camera);
+}
+
+void LodGroupTest::selectNoScene() {
+    Object3D object;
+    LodSelector3D selector;
+    LodGroup3D lod{object, 1.0f, {0.5f}, &selector};
+
+    Object3D cameraObject;
+    Camera3D camera{cameraObject};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    selector.select(camera);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LodSelector::select(): camera is not part of any scene\n");
+}
+
+void LodGroupTest::hysteresis() {
+    Scene3D scene;
+    LodSelector3D selector;
+    selector.setHysteresis(0.1f);
+
+    Object3D object{&scene};
+    LodGroup3D lod{object, 1.0f, {0.5f, 0.2f}, &selector};
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+
+    /* Screen size 0.48, within the hysteresis band of the first threshold */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f/0.48f)));
+    selector.select(camera);
+    CORRADE_COMPARE(lod.level(), 0);
+
+    /* Screen size 0.44, below the band */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f/0.44f)));
+    selector.select(camera);
+    CORRADE_COMPARE(lod.level(), 1);
+
+    /* Screen size 0.52, within the band, staying at the coarser level */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f/0.52f)));
+    selector.select(camera);
+    CORRADE_COMPARE(lod.level(), 1);
+
+    /* Screen size 0.56, above the band */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f/0.56f)));
+    selector.select(camera);
+    CORRADE_COMPARE(lod.level(), 0);
+
+    /* Jumping over more levels at once */
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f/0.1f)));
+    selector.select(camera);
+    CORRADE_COMPARE(lod.level(), 2);
+    object.setTransformation(Matrix4::translation(Vector3::zAxis(-1.0f/0.52f)));
+    selector.select(camera);
+    CORRADE_COMPARE(lod.level(), 1);
+}
+
+void LodGroupTest::benchmarkSelect() {
+    Scene3D scene;
+    scene.setFlattened(true);
+    LodSelector3D selector;
+    LodGroup3D* last{};
+    for(std::size_t i = 0; i != BenchmarkSize; ++i) {
+        Object3D* object = new Object3D{&scene};
+        object->translate({Float(i%100), Float(i/100%100), -10.0f - Float(i/10000)});
+        last = new LodGroup3D{*object, 1.0f, {0.5f, 0.2f, 0.05f}, &selector};
+    }
+
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(perspective());
+
+    CORRADE_BENCHMARK(10) {
+        selector.select(camera);
+    }
+
+    CORRADE_COMPARE(last->level(), 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::LodGroupTest)
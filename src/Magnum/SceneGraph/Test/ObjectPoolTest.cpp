@@ -0,0 +1,392 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <thread>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/ObjectPool.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct ObjectPoolTest: TestSuite::Tester {
+    explicit ObjectPoolTest();
+
+    void allocate();
+    void allocateReuse();
+    void allocateNewSlab();
+    void allocateTooLarge();
+    void slabTooSmall();
+    void destroyLive();
+
+    void objects();
+    void objectsMixed();
+    void objectsMultiplePools();
+    void objectsOtherThread();
+    void objectTooLarge();
+    void objectAndFeature();
+
+    void benchmarkCreateHeap();
+    void benchmarkCreatePool();
+    void benchmarkDestroyHeap();
+    void benchmarkDestroyPool();
+    void benchmarkTraverseHeap();
+    void benchmarkTraversePool();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+ObjectPoolTest::ObjectPoolTest() {
+    addTests({&ObjectPoolTest::allocate,
+              &ObjectPoolTest::allocateReuse,
+              &ObjectPoolTest::allocateNewSlab,
+              &ObjectPoolTest::allocateTooLarge,
+              &ObjectPoolTest::slabTooSmall,
+              &ObjectPoolTest::destroyLive,
+
+              &ObjectPoolTest::objects,
+              &ObjectPoolTest::objectsMixed,
+              &ObjectPoolTest::objectsMultiplePools,
+              &ObjectPoolTest::objectsOtherThread,
+              &ObjectPoolTest::objectTooLarge,
+              &ObjectPoolTest::objectAndFeature});
+
+    addBenchmarks({&ObjectPoolTest::benchmarkCreateHeap,
+                   &ObjectPoolTest::benchmarkCreatePool,
+                   &ObjectPoolTest::benchmarkDestroyHeap,
+                   &ObjectPoolTest::benchmarkDestroyPool,
+                   &ObjectPoolTest::benchmarkTraverseHeap,
+                   &ObjectPoolTest::benchmarkTraversePool}, 3);
+}
+
+void ObjectPoolTest::allocate() {
+    ObjectPool pool;
+    CORRADE_COMPARE(pool.slabSize(), 256*1024);
+    CORRADE_COMPARE(pool.slabCount(), 0);
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+
+    char* a = static_cast<char*>(pool.allocate(24));
+    char* b = static_cast<char*>(pool.allocate(16));
+    char* c = static_cast<char*>(pool.allocate(1));
+    CORRADE_COMPARE(pool.slabCount(), 1);
+    CORRADE_COMPARE(pool.allocationCount(), 3);
+
+    /* Consecutive allocations are next to each other, rounded up to 16 bytes */
+    CORRADE_COMPARE(b - a, 32);
+    CORRADE_COMPARE(c - b, 16);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a) % 16, 0);
+
+    pool.deallocate(a, 24);
+    pool.deallocate(b, 16);
+    pool.deallocate(c, 1);
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void ObjectPoolTest::allocateReuse() {
+    ObjectPool pool;
+    void* a = pool.allocate(100);
+    void* b = pool.allocate(100);
+    pool.deallocate(a, 100);
+    pool.deallocate(b, 100);
+
+    /* Memory of the same size class is reused in LIFO order */
+    CORRADE_VERIFY(pool.allocate(112) == b);
+    CORRADE_VERIFY(pool.allocate(97) == a);
+
+    /* Different size class gets new memory */
+    void* c = pool.allocate(200);
+    CORRADE_VERIFY(c != a && c != b);
+    CORRADE_COMPARE(pool.allocationCount(), 3);
+
+    pool.deallocate(a, 97);
+    pool.deallocate(b, 112);
+    pool.deallocate(c, 200);
+}
+
+void ObjectPoolTest::allocateNewSlab() {
+    ObjectPool pool{2048};
+    void* a = pool.allocate(1024);
+    void* b = pool.allocate(1000);
+    CORRADE_COMPARE(pool.slabCount(), 1);
+
+    /* Doesn't fit into the remaining 16 bytes */
+    void* c = pool.allocate(32);
+    CORRADE_COMPARE(pool.slabCount(), 2);
+
+    pool.deallocate(a, 1024);
+    pool.deallocate(b, 1000);
+    pool.deallocate(c, 32);
+}
+
+void ObjectPoolTest::allocateTooLarge() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    ObjectPool pool;
+    CORRADE_VERIFY(!pool.allocate(1025));
+    CORRADE_COMPARE(out.str(), "SceneGraph::ObjectPool::allocate(): expected at most 1024 bytes but got 1025\n");
+}
+
+void ObjectPoolTest::slabTooSmall() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    ObjectPool pool{1000};
+    CORRADE_COMPARE(out.str(), "SceneGraph::ObjectPool: slab size 1000 is smaller than 1024 bytes\n");
+}
+
+void ObjectPoolTest::destroyLive() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    {
+        ObjectPool pool;
+        pool.allocate(16);
+    }
+
+    CORRADE_COMPARE(out.str(), "SceneGraph::ObjectPool: destroyed with 1 live allocations\n");
+}
+
+void ObjectPoolTest::objects() {
+    ObjectPool pool;
+
+    {
+        Scene3D scene;
+        Object3D* a = new(pool) Object3D{&scene};
+        Object3D* b = new(pool) Object3D{a};
+        new(pool) Object3D{b};
+        new(pool) Object3D{a};
+        CORRADE_COMPARE(pool.allocationCount(), 4);
+
+        /* Deleting an object deletes its children as usual */
+        delete b;
+        CORRADE_COMPARE(pool.allocationCount(), 2);
+
+        /* The freed memory gets reused */
+        Object3D* c = new(pool) Object3D{a};
+        CORRADE_VERIFY(c == b);
+        CORRADE_COMPARE(pool.allocationCount(), 3);
+
+        c->translate(Vector3::xAxis(1.0f));
+        CORRADE_COMPARE(c->absoluteTransformation(), Matrix4::translation(Vector3::xAxis(1.0f)));
+    }
+
+    /* Scene deleted all its children */
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void ObjectPoolTest::objectsMixed() {
+    ObjectPool pool;
+
+    {
+        Scene3D scene;
+        Object3D* a = new Object3D{&scene};
+        new(pool) Object3D{a};
+        Object3D* b = new(pool) Object3D{&scene};
+        new Object3D{b};
+        CORRADE_COMPARE(pool.allocationCount(), 2);
+    }
+
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void ObjectPoolTest::objectsMultiplePools() {
+    /* Small slabs so each pool has more of them interleaved in memory */
+    ObjectPool a{2048}, b{2048};
+
+    {
+        Scene3D scene;
+        for(std::size_t i = 0; i != 50; ++i) {
+            new(a) Object3D{&scene};
+            new(b) Object3D{&scene};
+            new Object3D{&scene};
+        }
+        CORRADE_COMPARE(a.allocationCount(), 50);
+        CORRADE_COMPARE(b.allocationCount(), 50);
+        CORRADE_VERIFY(a.slabCount() > 1);
+
+        /* Each object goes back to the pool it came from */
+        for(std::size_t i = 0; i != 30; ++i)
+            delete scene.children().last();
+        CORRADE_COMPARE(a.allocationCount(), 40);
+        CORRADE_COMPARE(b.allocationCount(), 40);
+    }
+
+    CORRADE_COMPARE(a.allocationCount(), 0);
+    CORRADE_COMPARE(b.allocationCount(), 0);
+}
+
+void ObjectPoolTest::objectsOtherThread() {
+    /* Heap objects are created and deleted on another thread while pools are
+       created, filled and destroyed on this one */
+    std::thread thread{[]() {
+        for(std::size_t i = 0; i != 100; ++i) {
+            Scene3D scene;
+            for(std::size_t j = 0; j != 100; ++j) new Object3D{&scene};
+        }
+    }};
+
+    for(std::size_t i = 0; i != 20; ++i) {
+        ObjectPool pool{2048};
+        {
+            Scene3D scene;
+            for(std::size_t j = 0; j != 100; ++j) new(pool) Object3D{&scene};
+            CORRADE_COMPARE(pool.allocationCount(), 100);
+        }
+        CORRADE_COMPARE(pool.allocationCount(), 0);
+    }
+
+    thread.join();
+}
+
+void ObjectPoolTest::objectTooLarge() {
+    struct LargeObject: Object3D {
+        explicit LargeObject(Object3D* parent): Object3D{parent} {}
+
+        char data[2048];
+    };
+
+    ObjectPool pool;
+
+    /* Falls back to heap allocation */
+    Scene3D scene;
+    LargeObject* o = new(pool) LargeObject{&scene};
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+    delete o;
+}
+
+void ObjectPoolTest::objectAndFeature() {
+    /* Class deriving from both object and feature */
+    class ObjectFeature: public Object3D, public AbstractFeature3D {
+        public:
+            explicit ObjectFeature(Object3D* parent): Object3D{parent}, AbstractFeature3D{static_cast<AbstractObject3D&>(*this)} {}
+    };
+
+    class Feature: public AbstractFeature3D {
+        public:
+            explicit Feature(AbstractObject3D& object): AbstractFeature3D{object} {}
+    };
+
+    ObjectPool pool;
+
+    {
+        Scene3D scene;
+        ObjectFeature* o = new(pool) ObjectFeature{&scene};
+        new(pool) Feature{*o};
+        new Feature{*o};
+        CORRADE_COMPARE(pool.allocationCount(), 2);
+
+        /* Features get deleted with the object */
+        delete o;
+        CORRADE_COMPARE(pool.allocationCount(), 0);
+
+        new(pool) ObjectFeature{&scene};
+        CORRADE_COMPARE(pool.allocationCount(), 1);
+    }
+
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+namespace {
+    enum: std::size_t {
+        BenchmarkChildCount = 1000,
+        BenchmarkGrandchildCount = 1000
+    };
+
+    /* 1M nodes, each node in the middle level has 1000 children */
+    void populate(Scene3D& scene, ObjectPool* pool) {
+        for(std::size_t i = 0; i != BenchmarkChildCount; ++i) {
+            Object3D* child = pool ? new(*pool) Object3D{&scene} : new Object3D{&scene};
+            for(std::size_t j = 0; j != BenchmarkGrandchildCount; ++j) {
+                Object3D* grandchild = pool ? new(*pool) Object3D{child} : new Object3D{child};
+                grandchild->translate(Vector3::xAxis(Float(j)));
+            }
+        }
+    }
+
+    Float traverse(Object3D& object) {
+        Float sum = object.transformation().translation().x();
+        for(Object3D& child: object.children()) sum += traverse(child);
+        return sum;
+    }
+}
+
+void ObjectPoolTest::benchmarkCreateHeap() {
+    Scene3D scene;
+    CORRADE_BENCHMARK(1) populate(scene, nullptr);
+    CORRADE_VERIFY(!scene.children().isEmpty());
+}
+
+void ObjectPoolTest::benchmarkCreatePool() {
+    ObjectPool pool;
+    Scene3D scene;
+    CORRADE_BENCHMARK(1) populate(scene, &pool);
+    CORRADE_COMPARE(pool.allocationCount(), BenchmarkChildCount*(BenchmarkGrandchildCount + 1));
+}
+
+void ObjectPoolTest::benchmarkDestroyHeap() {
+    Scene3D scene;
+    populate(scene, nullptr);
+    CORRADE_BENCHMARK(1) {
+        while(scene.children().first()) delete scene.children().first();
+    }
+    CORRADE_VERIFY(scene.children().isEmpty());
+}
+
+void ObjectPoolTest::benchmarkDestroyPool() {
+    ObjectPool pool;
+    Scene3D scene;
+    populate(scene, &pool);
+    CORRADE_BENCHMARK(1) {
+        while(scene.children().first()) delete scene.children().first();
+    }
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void ObjectPoolTest::benchmarkTraverseHeap() {
+    Scene3D scene;
+    populate(scene, nullptr);
+    Float sum{};
+    CORRADE_BENCHMARK(1) sum += traverse(scene);
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+void ObjectPoolTest::benchmarkTraversePool() {
+    ObjectPool pool;
+    Scene3D scene;
+    populate(scene, &pool);
+    Float sum{};
+    CORRADE_BENCHMARK(1) sum += traverse(scene);
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ObjectPoolTest)
@@ -45,9 +45,14 @@ struct ObjectTest: TestSuite::Tester {
     void transformationsRelative();
     void transformationsOrphan();
     void transformationsDuplicate();
+    void transformationsArrayView();
+    void transformationsArrayViewWrongSize();
+    void transformationsFlattened();
+    void transformationsFlattenedOrphan();
     void setClean();
     void setCleanListHierarchy();
     void setCleanListBulk();
+    void setCleanListReentrant();
 
     void rangeBasedForChildren();
     void rangeBasedForFeatures();
@@ -82,9 +87,14 @@ ObjectTest::ObjectTest() {
               &ObjectTest::transformationsRelative,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationsArrayView,
+              &ObjectTest::transformationsArrayViewWrongSize,
+              &ObjectTest::transformationsFlattened,
+              &ObjectTest::transformationsFlattenedOrphan,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
               &ObjectTest::setCleanListBulk,
+              &ObjectTest::setCleanListReentrant,
 
               &ObjectTest::rangeBasedForChildren,
               &ObjectTest::rangeBasedForFeatures});
@@ -304,6 +314,91 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationsArrayView() {
+    Scene3D s;
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+
+    const Matrix4 initial = Matrix4::translation(Vector3::yAxis(2.0f));
+    const std::reference_wrapper<Object3D> objects[]{second, third, second};
+    Matrix4 transformations[3];
+    s.transformations(objects, transformations, initial);
+    CORRADE_COMPARE(transformations[0], initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)));
+    CORRADE_COMPARE(transformations[1], initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f)));
+    CORRADE_COMPARE(transformations[2], transformations[0]);
+
+    /* Through the abstract interface */
+    const std::reference_wrapper<AbstractObject3D> abstractObjects[]{third, first};
+    Matrix4 transformationMatrices[2];
+    static_cast<AbstractObject3D&>(s).transformationMatrices(abstractObjects, transformationMatrices);
+    CORRADE_COMPARE(transformationMatrices[0], Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f)));
+    CORRADE_COMPARE(transformationMatrices[1], Matrix4::rotationZ(Deg(30.0f)));
+}
+
+void ObjectTest::transformationsArrayViewWrongSize() {
+    std::ostringstream o;
+    Error redirectError{&o};
+
+    Scene3D s;
+    Object3D first(&s);
+    const std::reference_wrapper<Object3D> objects[]{first, first};
+    Matrix4 transformations[1];
+    s.transformations(objects, transformations);
+    s.transformationMatrices(objects, transformations);
+    CORRADE_COMPARE(o.str(),
+        "SceneGraph::Object::transformations(): expected 2 output transformations but got 1\n"
+        "SceneGraph::Object::transformationMatrices(): expected 2 output matrices but got 1\n");
+}
+
+void ObjectTest::transformationsFlattened() {
+    Scene3D s;
+    s.setFlattened(true);
+
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+
+    /* Empty list */
+    CORRADE_COMPARE(s.transformations({}, initial), std::vector<Matrix4>());
+
+    /* Scene alone */
+    CORRADE_COMPARE(s.transformations({s}, initial), std::vector<Matrix4>{initial});
+
+    /* Objects with duplicates */
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+    CORRADE_COMPARE(s.transformations({second, third, second, first, s}, initial), (std::vector<Matrix4>{
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        initial*Matrix4::rotationZ(Deg(30.0f)),
+        initial
+    }));
+
+    /* Changed transformation is picked up */
+    first.rotateZ(Deg(60.0f));
+    CORRADE_COMPARE(s.transformationMatrices({third}), std::vector<Matrix4>{
+        Matrix4::rotationZ(Deg(90.0f))*Matrix4::translation(Vector3::xAxis(5.0f))
+    });
+}
+
+void ObjectTest::transformationsFlattenedOrphan() {
+    std::ostringstream o;
+    Error redirectError{&o};
+
+    Scene3D s;
+    s.setFlattened(true);
+    Object3D orphan;
+    CORRADE_COMPARE(s.transformations({orphan}), std::vector<Matrix4>());
+    CORRADE_COMPARE(o.str(), "SceneGraph::Object::transformations(): the objects are not part of the same tree\n");
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
@@ -484,6 +579,39 @@ void ObjectTest::setCleanListBulk() {
     CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
 }
 
+void ObjectTest::setCleanListReentrant() {
+    /* Feature which cleans another object from its clean() */
+    class CleaningFeature: public AbstractFeature3D {
+        public:
+            explicit CleaningFeature(AbstractObject3D& object, Object3D& other): AbstractFeature3D(object), other(other) {
+                setCachedTransformations(CachedTransformation::Absolute);
+            }
+
+            Object3D& other;
+
+        protected:
+            void clean(const Matrix4&) override {
+                Object3D::setClean({other});
+            }
+    };
+
+    Scene3D scene;
+    Object3D a(&scene);
+    CachingObject b(&scene);
+    b.translate(Vector3::xAxis(2.0f));
+    CachingObject c(&scene);
+    c.translate(Vector3::yAxis(3.0f));
+    CleaningFeature feature{a, c};
+
+    /* Cleaning C from inside A's feature shouldn't affect the outer loop */
+    Object3D::setClean({a, b});
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::yAxis(3.0f)));
+}
+
 void ObjectTest::rangeBasedForChildren() {
     Scene3D scene;
     Object3D a(&scene);
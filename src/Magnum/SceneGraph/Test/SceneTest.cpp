@@ -23,8 +23,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <sstream>
+#include <thread>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/SceneGraph/AbstractFeature.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
 
@@ -35,6 +39,28 @@ struct SceneTest: TestSuite::Tester {
 
     void transformation();
     void parent();
+
+    void flattened();
+    void flattenedDirty();
+    void flattenedHierarchyChanged();
+    void flattenedDestroyed();
+    void flattenedDisable();
+    void flattenedNotEnabled();
+    void flattenedIndexNotInScene();
+
+    void clean();
+    void cleanBegin();
+    void cleanBeginChunks();
+    void cleanBeginNothingDirty();
+    void cleanBeginAbstract();
+    void cleanTiming();
+    void cleanChunkSizeZero();
+    void cleanChunkOutOfRange();
+
+    void debugCleanPhase();
+
+    void benchmarkClean();
+    template<std::size_t threadCount> void benchmarkCleanParallel();
 };
 
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
@@ -42,7 +68,32 @@ typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
 
 SceneTest::SceneTest() {
     addTests({&SceneTest::transformation,
-              &SceneTest::parent});
+              &SceneTest::parent,
+
+              &SceneTest::flattened,
+              &SceneTest::flattenedDirty,
+              &SceneTest::flattenedHierarchyChanged,
+              &SceneTest::flattenedDestroyed,
+              &SceneTest::flattenedDisable,
+              &SceneTest::flattenedNotEnabled,
+              &SceneTest::flattenedIndexNotInScene,
+
+              &SceneTest::clean,
+              &SceneTest::cleanBegin,
+              &SceneTest::cleanBeginChunks,
+              &SceneTest::cleanBeginNothingDirty,
+              &SceneTest::cleanBeginAbstract,
+              &SceneTest::cleanTiming,
+              &SceneTest::cleanChunkSizeZero,
+              &SceneTest::cleanChunkOutOfRange,
+
+              &SceneTest::debugCleanPhase});
+
+    addBenchmarks<SceneTest>({&SceneTest::benchmarkClean,
+                              &SceneTest::benchmarkCleanParallel<1>,
+                              &SceneTest::benchmarkCleanParallel<2>,
+                              &SceneTest::benchmarkCleanParallel<4>,
+                              &SceneTest::benchmarkCleanParallel<8>}, 10);
 }
 
 void SceneTest::transformation() {
@@ -65,6 +116,473 @@ void SceneTest::parent() {
     CORRADE_VERIFY(object.children().isEmpty());
 }
 
+void SceneTest::flattened() {
+    Scene3D scene;
+    CORRADE_VERIFY(!scene.isFlattened());
+
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D b{&scene};
+    b.rotateZ(Deg(90.0f));
+    Object3D c{&a};
+    c.scale(Vector3{2.0f});
+    Object3D d{&b};
+    d.translate(Vector3::yAxis(3.0f));
+    Object3D e{&c};
+    e.translate(Vector3::zAxis(-1.0f));
+
+    scene.setFlattened(true);
+    CORRADE_VERIFY(scene.isFlattened());
+    scene.updateFlattened();
+
+    /* Depth-first order */
+    CORRADE_COMPARE(scene.flattenedObjects(), (std::vector<Object3D*>{&scene, &a, &c, &e, &b, &d}));
+    CORRADE_COMPARE(scene.flattenedParents(), (std::vector<UnsignedInt>{0xffffffffu, 0, 1, 2, 0, 4}));
+    CORRADE_COMPARE(scene.flattenedIndex(scene), 0);
+    CORRADE_COMPARE(scene.flattenedIndex(e), 3);
+    CORRADE_COMPARE(scene.flattenedIndex(d), 5);
+
+    const std::vector<Matrix4>& transformations = scene.flattenedTransformations();
+    CORRADE_COMPARE(transformations.size(), 6);
+    CORRADE_COMPARE(transformations[0], Matrix4{});
+    for(std::size_t i = 1; i != transformations.size(); ++i)
+        CORRADE_COMPARE(transformations[i], scene.flattenedObjects()[i]->absoluteTransformationMatrix());
+}
+
+void SceneTest::flattenedDirty() {
+    Scene3D scene;
+    scene.setFlattened(true);
+
+    Object3D a{&scene};
+    Object3D b{&a};
+    b.translate(Vector3::xAxis(1.0f));
+    Object3D c{&scene};
+    c.translate(Vector3::yAxis(1.0f));
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedTransformations()[scene.flattenedIndex(b)], Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    /* The hierarchy is the same, only the subtree of a gets recomputed.
+       Cleaning the features doesn't affect the flattened hierarchy. */
+    a.setClean();
+    a.rotateZ(Deg(90.0f));
+    a.setClean();
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects(), (std::vector<Object3D*>{&scene, &a, &b, &c}));
+    CORRADE_COMPARE(scene.flattenedTransformations()[scene.flattenedIndex(a)], Matrix4::rotationZ(Deg(90.0f)));
+    CORRADE_COMPARE(scene.flattenedTransformations()[scene.flattenedIndex(b)], Matrix4::rotationZ(Deg(90.0f))*Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_COMPARE(scene.flattenedTransformations()[scene.flattenedIndex(c)], Matrix4::translation(Vector3::yAxis(1.0f)));
+
+    /* The object is still dirty for the features */
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+}
+
+void SceneTest::flattenedHierarchyChanged() {
+    Scene3D scene;
+    scene.setFlattened(true);
+
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    Object3D b{&scene};
+    b.translate(Vector3::yAxis(1.0f));
+    Object3D c{&a};
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects(), (std::vector<Object3D*>{&scene, &a, &c, &b}));
+    CORRADE_COMPARE(scene.flattenedTransformations()[scene.flattenedIndex(c)], Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    /* Reparenting */
+    c.setParent(&b);
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects(), (std::vector<Object3D*>{&scene, &a, &b, &c}));
+    CORRADE_COMPARE(scene.flattenedParents(), (std::vector<UnsignedInt>{0xffffffffu, 0, 0, 2}));
+    CORRADE_COMPARE(scene.flattenedTransformations()[scene.flattenedIndex(c)], Matrix4::translation(Vector3::yAxis(1.0f)));
+
+    /* Adding a subtree built outside of the scene */
+    Object3D d;
+    d.translate(Vector3::zAxis(1.0f));
+    Object3D e{&d};
+    e.translate(Vector3::zAxis(1.0f));
+    d.setParent(&a);
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects(), (std::vector<Object3D*>{&scene, &a, &d, &e, &b, &c}));
+    CORRADE_COMPARE(scene.flattenedTransformations()[scene.flattenedIndex(e)], Matrix4::translation({1.0f, 0.0f, 2.0f}));
+
+    /* Removing it again */
+    d.setParent(nullptr);
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects(), (std::vector<Object3D*>{&scene, &a, &b, &c}));
+}
+
+void SceneTest::flattenedDestroyed() {
+    Scene3D scene;
+    scene.setFlattened(true);
+
+    Object3D a{&scene};
+    Object3D* b = new Object3D{&scene};
+    new Object3D{b};
+    Object3D c{&scene};
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects().size(), 5);
+
+    /* Deleting the object deletes its children as well */
+    delete b;
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects(), (std::vector<Object3D*>{&scene, &a, &c}));
+}
+
+void SceneTest::flattenedDisable() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+
+    scene.setFlattened(true);
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects().size(), 2);
+
+    scene.setFlattened(false);
+    CORRADE_VERIFY(!scene.isFlattened());
+    CORRADE_VERIFY(scene.flattenedObjects().empty());
+
+    /* Enabling again rebuilds everything */
+    a.translate(Vector3::xAxis(1.0f));
+    scene.setFlattened(true);
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedTransformations()[1], Matrix4::translation(Vector3::xAxis(2.0f)));
+}
+
+void SceneTest::flattenedNotEnabled() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D scene;
+    scene.updateFlattened();
+    CORRADE_COMPARE(out.str(), "SceneGraph::Scene::updateFlattened(): flattened hierarchy is not enabled\n");
+}
+
+void SceneTest::flattenedIndexNotInScene() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D scene;
+    scene.setFlattened(true);
+    Object3D a{&scene};
+    Object3D b;
+    scene.flattenedIndex(a);
+    scene.flattenedIndex(b);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::Scene::flattenedIndex(): the object is not part of the flattened hierarchy\n"
+        "SceneGraph::Scene::flattenedIndex(): the object is not part of the flattened hierarchy\n");
+}
+
+namespace {
+    class CachingFeature: public AbstractFeature3D {
+        public:
+            explicit CachingFeature(AbstractObject3D& object, bool threadSafe, CachedTransformations cached = CachedTransformation::Absolute|CachedTransformation::InvertedAbsolute): AbstractFeature3D{object} {
+                setCachedTransformations(cached);
+                setCleanThreadSafe(threadSafe);
+            }
+
+            Matrix4 absolute{Math::ZeroInit}, inverted{Math::ZeroInit};
+            Int cleanCount{}, cleanInvertedCount{};
+
+        private:
+            void clean(const Matrix4& absoluteTransformationMatrix) override {
+                absolute = absoluteTransformationMatrix;
+                ++cleanCount;
+            }
+
+            void cleanInverted(const Matrix4& invertedAbsoluteTransformationMatrix) override {
+                inverted = invertedAbsoluteTransformationMatrix;
+                ++cleanInvertedCount;
+            }
+    };
+}
+
+void SceneTest::clean() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(2.0f));
+    Object3D b{&a};
+    b.scale(Vector3{2.0f});
+    Object3D c{&a};
+    auto fa = new CachingFeature{a, false, CachedTransformation::Absolute};
+    auto fb = new CachingFeature{b, true};
+    auto fc = new CachingFeature{c, true, CachedTransformation::InvertedAbsolute};
+
+    /* Thread-safe features are cleaned right away, parent is cleaned just
+       once even though it's listed twice and is a parent of both */
+    Object3D::setClean({b, a, c, b});
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(fa->cleanCount, 1);
+    CORRADE_COMPARE(fa->cleanInvertedCount, 0);
+    CORRADE_COMPARE(fb->cleanCount, 1);
+    CORRADE_COMPARE(fb->cleanInvertedCount, 1);
+    CORRADE_COMPARE(fc->cleanCount, 0);
+    CORRADE_COMPARE(fc->cleanInvertedCount, 1);
+
+    CORRADE_COMPARE(fa->absolute, Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(fb->absolute, Matrix4::translation(Vector3::xAxis(2.0f))*Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_COMPARE(fb->inverted, fb->absolute.inverted());
+    CORRADE_COMPARE(fc->inverted, Matrix4::translation(Vector3::xAxis(-2.0f)));
+
+    /* Cleaning again does nothing */
+    Object3D::setClean({b, a, c});
+    CORRADE_COMPARE(fa->cleanCount, 1);
+    CORRADE_COMPARE(fb->cleanCount, 1);
+}
+
+void SceneTest::cleanBegin() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(2.0f));
+    Object3D b{&a};
+    b.translate(Vector3::yAxis(3.0f));
+    auto fa = new CachingFeature{a, false};
+    auto fb1 = new CachingFeature{b, true};
+    auto fb2 = new CachingFeature{b, false};
+
+    CORRADE_COMPARE(scene.beginClean({b}), 1);
+    CORRADE_COMPARE(scene.cleanChunkCount(), 1);
+
+    /* The objects and features which are not thread-safe are clean
+       already */
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(fa->cleanCount, 1);
+    CORRADE_COMPARE(fb2->cleanCount, 1);
+    CORRADE_COMPARE(fb2->absolute, Matrix4::translation({2.0f, 3.0f, 0.0f}));
+    CORRADE_COMPARE(fb1->cleanCount, 0);
+    CORRADE_COMPARE(fb1->cleanInvertedCount, 0);
+
+    /* The rest is done in the chunk */
+    scene.cleanChunk(0);
+    CORRADE_COMPARE(fb1->cleanCount, 1);
+    CORRADE_COMPARE(fb1->cleanInvertedCount, 1);
+    CORRADE_COMPARE(fb1->absolute, Matrix4::translation({2.0f, 3.0f, 0.0f}));
+    CORRADE_COMPARE(fb1->inverted, Matrix4::translation({-2.0f, -3.0f, 0.0f}));
+}
+
+void SceneTest::cleanBeginChunks() {
+    Scene3D scene;
+    scene.setCleanChunkSize(2);
+    CORRADE_COMPARE(scene.cleanChunkSize(), 2);
+
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::vector<CachingFeature*> features;
+    for(std::size_t i = 0; i != 5; ++i) {
+        Object3D* o = new Object3D{&scene};
+        o->translate(Vector3::xAxis(Float(i)));
+        objects.push_back(*o);
+        features.push_back(new CachingFeature{*o, true, CachedTransformation::Absolute});
+    }
+
+    CORRADE_COMPARE(scene.beginClean(objects), 3);
+    scene.cleanChunk(2);
+    CORRADE_COMPARE(features[3]->cleanCount, 0);
+    CORRADE_COMPARE(features[4]->cleanCount, 1);
+    scene.cleanChunk(0);
+    scene.cleanChunk(1);
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_COMPARE(features[i]->cleanCount, 1);
+        CORRADE_COMPARE(features[i]->absolute, Matrix4::translation(Vector3::xAxis(Float(i))));
+    }
+
+    /* Serial cleaning doesn't produce any chunks */
+    objects[0].get().setDirty();
+    Object3D::setClean(objects);
+    CORRADE_COMPARE(scene.cleanChunkCount(), 0);
+    CORRADE_COMPARE(features[0]->cleanCount, 2);
+}
+
+void SceneTest::cleanBeginNothingDirty() {
+    Scene3D scene;
+    Object3D a{&scene};
+    new CachingFeature{a, true};
+    a.setClean();
+
+    CORRADE_COMPARE(scene.beginClean({a}), 0);
+    CORRADE_COMPARE(scene.cleanChunkCount(), 0);
+}
+
+void SceneTest::cleanBeginAbstract() {
+    Scene3D scene;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(2.0f));
+    Object3D b{&scene};
+    auto fa = new CachingFeature{a, true, CachedTransformation::Absolute};
+    auto fb = new CachingFeature{b, false, CachedTransformation::Absolute};
+    b.setClean();
+
+    /* Same as Scene::beginClean() and Scene::cleanChunk(), but through the
+       abstract interface */
+    std::vector<std::reference_wrapper<AbstractObject3D>> objects{b, a};
+    CORRADE_COMPARE(AbstractObject3D::beginClean(objects), 1);
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_COMPARE(fa->cleanCount, 0);
+
+    AbstractObject3D& abstractScene = scene;
+    abstractScene.cleanChunk(0);
+    CORRADE_COMPARE(fa->cleanCount, 1);
+    CORRADE_COMPARE(fa->absolute, Matrix4::translation(Vector3::xAxis(2.0f)));
+    CORRADE_COMPARE(fb->cleanCount, 1);
+
+    /* Nothing dirty */
+    CORRADE_COMPARE(AbstractObject3D::beginClean(objects), 0);
+    CORRADE_COMPARE(AbstractObject3D::beginClean({}), 0);
+
+    /* Chunks can be executed only on the scene */
+    std::ostringstream out;
+    Error redirectError{&out};
+    AbstractObject3D& abstractObject = a;
+    abstractObject.cleanChunk(0);
+    CORRADE_COMPARE(out.str(), "SceneGraph::AbstractObject::cleanChunk(): the object is not a scene\n");
+}
+
+void SceneTest::cleanTiming() {
+    Scene3D scene;
+    Object3D a{&scene};
+    new CachingFeature{a, true};
+
+    std::vector<CleanPhase> phases;
+    scene.setCleanTimingCallback([](CleanPhase phase, std::chrono::nanoseconds, void* userData) {
+        static_cast<std::vector<CleanPhase>*>(userData)->push_back(phase);
+    }, &phases);
+    CORRADE_VERIFY(scene.cleanTimingCallback());
+
+    scene.beginClean({a});
+    CORRADE_COMPARE(phases.size(), 4);
+    CORRADE_COMPARE(phases[0], CleanPhase::Collect);
+    CORRADE_COMPARE(phases[1], CleanPhase::Transformations);
+    CORRADE_COMPARE(phases[2], CleanPhase::Matrices);
+    CORRADE_COMPARE(phases[3], CleanPhase::Features);
+
+    /* Only the collection phase is reported if there's nothing to clean */
+    phases.clear();
+    Object3D::setClean({a});
+    scene.beginClean({a});
+    CORRADE_COMPARE(phases.size(), 1);
+    CORRADE_COMPARE(phases[0], CleanPhase::Collect);
+
+    scene.setCleanTimingCallback(nullptr);
+    a.setDirty();
+    phases.clear();
+    scene.beginClean({a});
+    CORRADE_VERIFY(phases.empty());
+}
+
+void SceneTest::cleanChunkSizeZero() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Scene3D scene;
+    scene.setCleanChunkSize(0);
+    CORRADE_COMPARE(scene.cleanChunkSize(), 1024);
+    CORRADE_COMPARE(out.str(), "SceneGraph::Scene::setCleanChunkSize(): chunk size can't be zero\n");
+}
+
+void SceneTest::cleanChunkOutOfRange() {
+    Scene3D scene;
+    Object3D a{&scene};
+    new CachingFeature{a, true};
+    CORRADE_COMPARE(scene.beginClean({a}), 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.cleanChunk(1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::Scene::cleanChunk(): index 1 out of range for 1 chunks\n");
+}
+
+void SceneTest::debugCleanPhase() {
+    std::ostringstream out;
+    Debug(&out) << CleanPhase::Matrices << CleanPhase(0xde);
+    CORRADE_COMPARE(out.str(), "SceneGraph::CleanPhase::Matrices SceneGraph::CleanPhase(0xde)\n");
+}
+
+namespace {
+    enum: std::size_t { BenchmarkObjectCount = 50000 };
+
+    /* Does a bit of work on clean, similarly to collision shapes */
+    class BenchmarkFeature: public AbstractFeature3D {
+        public:
+            explicit BenchmarkFeature(AbstractObject3D& object): AbstractFeature3D{object} {
+                setCachedTransformations(CachedTransformation::Absolute|CachedTransformation::InvertedAbsolute);
+                setCleanThreadSafe(true);
+            }
+
+            Float value{};
+
+        private:
+            void clean(const Matrix4& absoluteTransformationMatrix) override {
+                Vector3 point;
+                for(std::size_t i = 0; i != 16; ++i)
+                    point = absoluteTransformationMatrix.transformPoint(point + Vector3{Float(i)});
+                value = point.length();
+            }
+
+            void cleanInverted(const Matrix4& invertedAbsoluteTransformationMatrix) override {
+                value += invertedAbsoluteTransformationMatrix.translation().x();
+            }
+    };
+
+    void populate(Scene3D& scene, std::vector<std::reference_wrapper<Object3D>>& objects) {
+        for(std::size_t i = 0; i != BenchmarkObjectCount; ++i) {
+            Object3D* o = new Object3D{&scene};
+            o->rotateY(Deg(Float(i)))
+                .translate(Vector3::xAxis(Float(i % 100)));
+            new BenchmarkFeature{*o};
+            objects.push_back(*o);
+        }
+    }
+
+    Float benchmarkChecksum(const std::vector<std::reference_wrapper<Object3D>>& objects) {
+        Float sum{};
+        for(Object3D& o: objects)
+            sum += static_cast<const BenchmarkFeature&>(*o.features().first()).value;
+        return sum;
+    }
+}
+
+void SceneTest::benchmarkClean() {
+    Scene3D scene;
+    scene.setFlattened(true);
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    populate(scene, objects);
+
+    CORRADE_BENCHMARK(10) {
+        scene.setDirty();
+        Object3D::setClean(objects);
+    }
+
+    CORRADE_VERIFY(benchmarkChecksum(objects) != 0.0f);
+}
+
+template<std::size_t threadCount> void SceneTest::benchmarkCleanParallel() {
+    setTestCaseName(std::string{"benchmarkCleanParallel<"} + std::to_string(threadCount) + ">");
+
+    Scene3D scene;
+    scene.setFlattened(true);
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    populate(scene, objects);
+
+    std::vector<std::thread> threads(threadCount - 1);
+    CORRADE_BENCHMARK(10) {
+        scene.setDirty();
+        const std::size_t chunkCount = scene.beginClean(objects);
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]() {
+            for(std::size_t chunk; (chunk = next++) < chunkCount; )
+                scene.cleanChunk(chunk);
+        };
+        for(std::thread& thread: threads) thread = std::thread{worker};
+        worker();
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    CORRADE_VERIFY(benchmarkChecksum(objects) != 0.0f);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SceneTest)
@@ -0,0 +1,455 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/SceneGraph/DualComplexTransformation.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/ObjectPool.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/Snapshot.h"
+#include "Magnum/SceneGraph/TranslationTransformation.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct SnapshotTest: TestSuite::Tester {
+    explicit SnapshotTest();
+
+    void saveLoad();
+    void saveLoadDualComplex();
+    void saveLoadTranslation();
+    void saveSubtree();
+    void saveEmpty();
+    void loadIntoObject();
+    void loadPool();
+    void loadDirty();
+    void loadFlattened();
+
+    void loadTooShort();
+    void loadInvalidSignature();
+    void loadInvalidVersion();
+    void loadInvalidEndianness();
+    void loadWrongTransformation();
+    void loadWrongSize();
+    void loadInvalidParent();
+
+    void benchmarkLoadIncremental();
+    void benchmarkLoadIncrementalPool();
+    void benchmarkLoadSnapshot();
+    void benchmarkLoadSnapshotPool();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+SnapshotTest::SnapshotTest() {
+    addTests({&SnapshotTest::saveLoad,
+              &SnapshotTest::saveLoadDualComplex,
+              &SnapshotTest::saveLoadTranslation,
+              &SnapshotTest::saveSubtree,
+              &SnapshotTest::saveEmpty,
+              &SnapshotTest::loadIntoObject,
+              &SnapshotTest::loadPool,
+              &SnapshotTest::loadDirty,
+              &SnapshotTest::loadFlattened,
+
+              &SnapshotTest::loadTooShort,
+              &SnapshotTest::loadInvalidSignature,
+              &SnapshotTest::loadInvalidVersion,
+              &SnapshotTest::loadInvalidEndianness,
+              &SnapshotTest::loadWrongTransformation,
+              &SnapshotTest::loadWrongSize,
+              &SnapshotTest::loadInvalidParent});
+
+    addBenchmarks({&SnapshotTest::benchmarkLoadIncremental,
+                   &SnapshotTest::benchmarkLoadIncrementalPool,
+                   &SnapshotTest::benchmarkLoadSnapshot,
+                   &SnapshotTest::benchmarkLoadSnapshotPool}, 3);
+}
+
+namespace {
+    /* scene
+        +- a
+        |  +- b
+        |  |  +- d
+        |  +- c
+        +- e */
+    struct Hierarchy {
+        explicit Hierarchy(Object3D& root):
+            a{&root}, b{&a}, c{&a}, d{&b}, e{&root}
+        {
+            a.setTransformation(Matrix4::translation({1.0f, 2.0f, 3.0f}));
+            b.setTransformation(Matrix4::rotationX(Deg(35.0f)));
+            c.setTransformation(Matrix4::scaling({2.0f, 0.5f, 1.0f}));
+            d.setTransformation(Matrix4::translation({-1.0f, 0.0f, 0.5f}));
+            e.setTransformation(Matrix4::rotationZ(Deg(-90.0f)));
+        }
+
+        Object3D a, b, c, d, e;
+    };
+}
+
+void SnapshotTest::saveLoad() {
+    Scene3D scene;
+    Hierarchy h{scene};
+    const std::vector<char> data = saveSnapshot(scene);
+
+    Scene3D loaded;
+    const std::vector<Object3D*> objects = loadSnapshot(loaded, {data.data(), data.size()});
+    CORRADE_COMPARE(objects.size(), 5);
+
+    /* Breadth-first order */
+    Object3D &a = *objects[0], &e = *objects[1], &b = *objects[2], &c = *objects[3], &d = *objects[4];
+    CORRADE_VERIFY(a.parent() == &loaded);
+    CORRADE_VERIFY(b.parent() == &a);
+    CORRADE_VERIFY(c.parent() == &a);
+    CORRADE_VERIFY(d.parent() == &b);
+    CORRADE_VERIFY(e.parent() == &loaded);
+
+    /* The order of children is preserved */
+    CORRADE_VERIFY(loaded.children().first() == &a);
+    CORRADE_VERIFY(loaded.children().last() == &e);
+    CORRADE_VERIFY(a.children().first() == &b);
+    CORRADE_VERIFY(a.children().last() == &c);
+
+    CORRADE_COMPARE(a.transformation(), h.a.transformation());
+    CORRADE_COMPARE(b.transformation(), h.b.transformation());
+    CORRADE_COMPARE(c.transformation(), h.c.transformation());
+    CORRADE_COMPARE(d.transformation(), h.d.transformation());
+    CORRADE_COMPARE(e.transformation(), h.e.transformation());
+    CORRADE_COMPARE(d.absoluteTransformation(), h.d.absoluteTransformation());
+
+    /* Saving the loaded scene again gives the same data */
+    CORRADE_VERIFY(saveSnapshot(loaded) == data);
+}
+
+void SnapshotTest::saveLoadDualComplex() {
+    typedef SceneGraph::Object<SceneGraph::DualComplexTransformation> Object2D;
+    typedef SceneGraph::Scene<SceneGraph::DualComplexTransformation> Scene2D;
+
+    Scene2D scene;
+    Object2D a{&scene};
+    a.setTransformation(DualComplex::translation({3.0f, -1.0f})*DualComplex::rotation(Deg(17.0f)));
+    Object2D b{&a};
+    b.setTransformation(DualComplex::rotation(Deg(-120.0f)));
+
+    const std::vector<char> data = saveSnapshot(scene);
+    /* Header, two parent indices and two dual complex numbers */
+    CORRADE_COMPARE(data.size(), 16 + 2*4 + 2*16);
+
+    Scene2D loaded;
+    const std::vector<Object2D*> objects = loadSnapshot(loaded, {data.data(), data.size()});
+    CORRADE_COMPARE(objects.size(), 2);
+    CORRADE_VERIFY(objects[1]->parent() == objects[0]);
+    CORRADE_COMPARE(objects[0]->transformation(), a.transformation());
+    CORRADE_COMPARE(objects[1]->transformation(), b.transformation());
+}
+
+void SnapshotTest::saveLoadTranslation() {
+    typedef SceneGraph::Object<SceneGraph::TranslationTransformation2D> Object2D;
+    typedef SceneGraph::Scene<SceneGraph::TranslationTransformation2D> Scene2D;
+
+    Scene2D scene;
+    Object2D a{&scene};
+    a.setTransformation({3.0f, -1.0f});
+    Object2D b{&scene};
+    b.setTransformation({0.5f, 7.0f});
+    Object2D c{&scene};
+    c.setTransformation({-2.0f, 1.0f});
+
+    const std::vector<char> data = saveSnapshot(scene);
+    /* Parent indices are already aligned to the four-byte underlying type, so
+       there's no padding */
+    CORRADE_COMPARE(data.size(), 16 + 3*4 + 3*8);
+
+    Scene2D loaded;
+    const std::vector<Object2D*> objects = loadSnapshot(loaded, {data.data(), data.size()});
+    CORRADE_COMPARE(objects.size(), 3);
+    CORRADE_COMPARE(objects[0]->transformation(), (Vector2{3.0f, -1.0f}));
+    CORRADE_COMPARE(objects[1]->transformation(), (Vector2{0.5f, 7.0f}));
+    CORRADE_COMPARE(objects[2]->transformation(), (Vector2{-2.0f, 1.0f}));
+}
+
+void SnapshotTest::saveSubtree() {
+    Scene3D scene;
+    Hierarchy h{scene};
+
+    /* Only the descendants of the root are saved */
+    const std::vector<char> data = saveSnapshot(h.a);
+
+    Scene3D loaded;
+    const std::vector<Object3D*> objects = loadSnapshot(loaded, {data.data(), data.size()});
+    CORRADE_COMPARE(objects.size(), 3);
+    CORRADE_VERIFY(objects[0]->parent() == &loaded);
+    CORRADE_VERIFY(objects[1]->parent() == &loaded);
+    CORRADE_VERIFY(objects[2]->parent() == objects[0]);
+    CORRADE_COMPARE(objects[2]->transformation(), h.d.transformation());
+}
+
+void SnapshotTest::saveEmpty() {
+    Scene3D scene;
+    const std::vector<char> data = saveSnapshot(scene);
+    CORRADE_COMPARE(data.size(), 16);
+
+    Scene3D loaded;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(loadSnapshot(loaded, {data.data(), data.size()}).empty());
+    CORRADE_VERIFY(loaded.children().isEmpty());
+    CORRADE_COMPARE(out.str(), "");
+}
+
+void SnapshotTest::loadIntoObject() {
+    Scene3D scene;
+    Hierarchy h{scene};
+    const std::vector<char> data = saveSnapshot(h.a);
+
+    Scene3D loaded;
+    Object3D parent{&loaded};
+    parent.setTransformation(Matrix4::translation(Vector3::xAxis(5.0f)));
+    const std::vector<Object3D*> objects = loadSnapshot(parent, {data.data(), data.size()});
+    CORRADE_COMPARE(objects.size(), 3);
+    CORRADE_VERIFY(objects[0]->parent() == &parent);
+    CORRADE_VERIFY(objects[2]->scene() == &loaded);
+    CORRADE_COMPARE(objects[2]->absoluteTransformation(),
+        Matrix4::translation(Vector3::xAxis(5.0f))*h.b.transformation()*h.d.transformation());
+}
+
+void SnapshotTest::loadPool() {
+    Scene3D scene;
+    Hierarchy h{scene};
+    const std::vector<char> data = saveSnapshot(scene);
+
+    ObjectPool pool;
+    {
+        Scene3D loaded;
+        CORRADE_COMPARE(loadSnapshot(loaded, {data.data(), data.size()}, &pool).size(), 5);
+        CORRADE_COMPARE(pool.allocationCount(), 5);
+    }
+
+    /* The objects are deleted back into the pool */
+    CORRADE_COMPARE(pool.allocationCount(), 0);
+}
+
+void SnapshotTest::loadDirty() {
+    Scene3D scene;
+    Hierarchy h{scene};
+    const std::vector<char> data = saveSnapshot(scene);
+
+    Scene3D loaded;
+    Object3D parent{&loaded};
+    parent.setClean();
+    CORRADE_VERIFY(!parent.isDirty());
+
+    const std::vector<Object3D*> objects = loadSnapshot(parent, {data.data(), data.size()});
+    CORRADE_COMPARE(objects.size(), 5);
+
+    /* The parent stays clean, the new objects are dirty */
+    CORRADE_VERIFY(!parent.isDirty());
+    for(Object3D* o: objects) CORRADE_VERIFY(o->isDirty());
+
+    objects[4]->setClean();
+    CORRADE_VERIFY(!objects[4]->isDirty());
+    CORRADE_VERIFY(!objects[2]->isDirty());
+    CORRADE_VERIFY(!objects[0]->isDirty());
+    CORRADE_VERIFY(objects[1]->isDirty());
+}
+
+void SnapshotTest::loadFlattened() {
+    Scene3D scene;
+    Hierarchy h{scene};
+    const std::vector<char> data = saveSnapshot(scene);
+
+    Scene3D loaded;
+    loaded.setFlattened(true);
+    Object3D first{&loaded};
+    loaded.updateFlattened();
+    CORRADE_COMPARE(loaded.flattenedObjects().size(), 2);
+
+    /* The hierarchy change is picked up by the flattened scene */
+    const std::vector<Object3D*> objects = loadSnapshot(loaded, {data.data(), data.size()});
+    loaded.updateFlattened();
+    CORRADE_COMPARE(loaded.flattenedObjects().size(), 7);
+    CORRADE_COMPARE(loaded.flattenedTransformations()[loaded.flattenedIndex(*objects[4])],
+        h.d.absoluteTransformation());
+}
+
+void SnapshotTest::loadTooShort() {
+    Scene3D scene;
+    std::ostringstream out;
+    Error redirectError{&out};
+    const char data[15]{};
+    CORRADE_VERIFY(loadSnapshot(scene, data).empty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::loadSnapshot(): expected at least 16 bytes but got 15\n");
+}
+
+void SnapshotTest::loadInvalidSignature() {
+    Scene3D scene;
+    std::vector<char> data = saveSnapshot(scene);
+    data[1] = 'X';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(loadSnapshot(scene, {data.data(), data.size()}).empty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::loadSnapshot(): invalid signature\n");
+}
+
+void SnapshotTest::loadInvalidVersion() {
+    Scene3D scene;
+    std::vector<char> data = saveSnapshot(scene);
+    data[4] = 2;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(loadSnapshot(scene, {data.data(), data.size()}).empty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::loadSnapshot(): unsupported version 2\n");
+}
+
+void SnapshotTest::loadInvalidEndianness() {
+    Scene3D scene;
+    std::vector<char> data = saveSnapshot(scene);
+    data[5] = !data[5];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(loadSnapshot(scene, {data.data(), data.size()}).empty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::loadSnapshot(): the snapshot was saved with different endianness\n");
+}
+
+void SnapshotTest::loadWrongTransformation() {
+    Scene3D scene;
+    Hierarchy h{scene};
+    const std::vector<char> data = saveSnapshot(scene);
+
+    SceneGraph::Scene<SceneGraph::MatrixTransformation2D> loaded;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(loadSnapshot(loaded, {data.data(), data.size()}).empty());
+    CORRADE_VERIFY(loaded.children().isEmpty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::loadSnapshot(): expected 2D transformation of 36 bytes but got 3D transformation of 64 bytes\n");
+}
+
+void SnapshotTest::loadWrongSize() {
+    Scene3D scene;
+    Hierarchy h{scene};
+    std::vector<char> data = saveSnapshot(scene);
+    data.pop_back();
+
+    Scene3D loaded;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(loadSnapshot(loaded, {data.data(), data.size()}).empty());
+    CORRADE_VERIFY(loaded.children().isEmpty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::loadSnapshot(): expected 356 bytes for 5 objects but got 355\n");
+}
+
+void SnapshotTest::loadInvalidParent() {
+    Scene3D scene;
+    Hierarchy h{scene};
+    std::vector<char> data = saveSnapshot(scene);
+
+    /* Make the last object reference itself */
+    const UnsignedInt parent = 4;
+    std::memcpy(data.data() + 16 + 4*4, &parent, 4);
+
+    Scene3D loaded;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(loadSnapshot(loaded, {data.data(), data.size()}).empty());
+    CORRADE_VERIFY(loaded.children().isEmpty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::loadSnapshot(): invalid parent index 4 for object 4\n");
+}
+
+namespace {
+    enum: std::size_t {
+        BenchmarkChainCount = 4000,
+        BenchmarkChainLength = 50,
+        BenchmarkObjectCount = BenchmarkChainCount*BenchmarkChainLength
+    };
+
+    /* Deep hierarchies are where finding the scene in setParent() hurts the
+       most */
+    void populate(Scene3D& scene, ObjectPool* pool) {
+        for(std::size_t i = 0; i != BenchmarkChainCount; ++i) {
+            Object3D* parent = &scene;
+            for(std::size_t j = 0; j != BenchmarkChainLength; ++j) {
+                parent = pool ? new(*pool) Object3D{parent} : new Object3D{parent};
+                parent->setTransformation(Matrix4::translation(Vector3::xAxis(Float(j))));
+            }
+        }
+    }
+
+    std::vector<char> benchmarkSnapshot() {
+        Scene3D scene;
+        populate(scene, nullptr);
+        return saveSnapshot(scene);
+    }
+}
+
+void SnapshotTest::benchmarkLoadIncremental() {
+    Scene3D scene;
+    CORRADE_BENCHMARK(1) populate(scene, nullptr);
+
+    scene.setFlattened(true);
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects().size(), BenchmarkObjectCount + 1);
+}
+
+void SnapshotTest::benchmarkLoadIncrementalPool() {
+    ObjectPool pool;
+    Scene3D scene;
+    CORRADE_BENCHMARK(1) populate(scene, &pool);
+
+    CORRADE_COMPARE(pool.allocationCount(), BenchmarkObjectCount);
+}
+
+void SnapshotTest::benchmarkLoadSnapshot() {
+    const std::vector<char> data = benchmarkSnapshot();
+
+    Scene3D scene;
+    CORRADE_BENCHMARK(1) loadSnapshot(scene, {data.data(), data.size()});
+
+    scene.setFlattened(true);
+    scene.updateFlattened();
+    CORRADE_COMPARE(scene.flattenedObjects().size(), BenchmarkObjectCount + 1);
+}
+
+void SnapshotTest::benchmarkLoadSnapshotPool() {
+    const std::vector<char> data = benchmarkSnapshot();
+
+    ObjectPool pool;
+    Scene3D scene;
+    CORRADE_BENCHMARK(1) loadSnapshot(scene, {data.data(), data.size()}, &pool);
+
+    CORRADE_COMPARE(pool.allocationCount(), BenchmarkObjectCount);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SnapshotTest)
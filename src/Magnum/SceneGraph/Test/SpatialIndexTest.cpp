@@ -0,0 +1,581 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/BoundingVolume.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct SpatialIndexTest: TestSuite::Tester {
+    explicit SpatialIndexTest();
+
+    void construct();
+    void addRemove();
+    void deleteVolume();
+    void deleteIndex();
+    void moveToAnotherIndex();
+    void removeNotInIndex();
+
+    void sphere();
+    void sphere2D();
+    void frustum();
+    void ray();
+    void nearest();
+    void refit();
+    void refitRebuild();
+    void setVolume();
+
+    template<std::size_t count> void benchmarkBuild();
+    template<std::size_t count> void benchmarkRefit();
+    template<std::size_t count> void benchmarkSphere();
+    template<std::size_t count> void benchmarkSphereLinear();
+    template<std::size_t count> void benchmarkRay();
+    template<std::size_t count> void benchmarkNearest();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+SpatialIndexTest::SpatialIndexTest() {
+    addTests({&SpatialIndexTest::construct,
+              &SpatialIndexTest::addRemove,
+              &SpatialIndexTest::deleteVolume,
+              &SpatialIndexTest::deleteIndex,
+              &SpatialIndexTest::moveToAnotherIndex,
+              &SpatialIndexTest::removeNotInIndex,
+
+              &SpatialIndexTest::sphere,
+              &SpatialIndexTest::sphere2D,
+              &SpatialIndexTest::frustum,
+              &SpatialIndexTest::ray,
+              &SpatialIndexTest::nearest,
+              &SpatialIndexTest::refit,
+              &SpatialIndexTest::refitRebuild,
+              &SpatialIndexTest::setVolume});
+
+    addBenchmarks<SpatialIndexTest>({&SpatialIndexTest::benchmarkBuild<10000>,
+                                     &SpatialIndexTest::benchmarkBuild<100000>,
+                                     &SpatialIndexTest::benchmarkBuild<1000000>,
+                                     &SpatialIndexTest::benchmarkRefit<10000>,
+                                     &SpatialIndexTest::benchmarkRefit<100000>,
+                                     &SpatialIndexTest::benchmarkRefit<1000000>,
+                                     &SpatialIndexTest::benchmarkSphere<10000>,
+                                     &SpatialIndexTest::benchmarkSphere<100000>,
+                                     &SpatialIndexTest::benchmarkSphere<1000000>,
+                                     &SpatialIndexTest::benchmarkSphereLinear<10000>,
+                                     &SpatialIndexTest::benchmarkSphereLinear<100000>,
+                                     &SpatialIndexTest::benchmarkSphereLinear<1000000>,
+                                     &SpatialIndexTest::benchmarkRay<10000>,
+                                     &SpatialIndexTest::benchmarkRay<100000>,
+                                     &SpatialIndexTest::benchmarkRay<1000000>,
+                                     &SpatialIndexTest::benchmarkNearest<10000>,
+                                     &SpatialIndexTest::benchmarkNearest<100000>,
+                                     &SpatialIndexTest::benchmarkNearest<1000000>}, 5);
+}
+
+namespace {
+
+/* Deterministic pseudo-random positions in a cube with given edge length */
+std::vector<Vector3> positions(const std::size_t count, const Float size) {
+    std::vector<Vector3> out(count);
+    UnsignedInt state = 1;
+    auto next = [&state, size]() {
+        state = state*1664525u + 1013904223u;
+        return Float(state >> 8)/Float(1 << 24)*size;
+    };
+    for(Vector3& position: out) {
+        position.x() = next();
+        position.y() = next();
+        position.z() = next();
+    }
+    return out;
+}
+
+/* Grid of unit spheres and unit boxes alternating, spaced by 3 units */
+void populate(Scene3D& scene, SpatialIndex3D& index) {
+    for(Int z = 0; z != 8; ++z) for(Int y = 0; y != 8; ++y) for(Int x = 0; x != 8; ++x) {
+        auto o = new Object3D{&scene};
+        o->translate(Vector3{Vector3i{x, y, z}}*3.0f);
+        if((x + y + z) % 2)
+            new BoundingVolume3D{*o, Range3D{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}, &index};
+        else
+            new BoundingVolume3D{*o, Vector3{}, 1.0f, &index};
+    }
+}
+
+std::vector<BoundingVolume3D*> sorted(std::vector<BoundingVolume3D*> volumes) {
+    std::sort(volumes.begin(), volumes.end());
+    return volumes;
+}
+
+/* Reference implementation testing all volumes one by one */
+std::vector<BoundingVolume3D*> bruteForceSphere(SpatialIndex3D& index, const Vector3& center, const Float radius) {
+    std::vector<BoundingVolume3D*> out;
+    for(std::size_t i = 0; i != index.size(); ++i) {
+        BoundingVolume3D& volume = index[i];
+        const Vector3 distance = Math::max(Math::abs(center - volume.transformedCenter()) - volume.transformedHalfSize(), Vector3{});
+        if(distance.length() <= radius + volume.transformedRadius())
+            out.push_back(&volume);
+    }
+    return sorted(out);
+}
+
+}
+
+void SpatialIndexTest::construct() {
+    SpatialIndex3D index;
+    CORRADE_VERIFY(index.isEmpty());
+    CORRADE_COMPARE(index.size(), 0);
+    CORRADE_VERIFY(!index.isDirty());
+
+    /* Queries on empty index are fine */
+    CORRADE_VERIFY(index.intersectingSphere({}, 100.0f).empty());
+    CORRADE_VERIFY(index.intersectingRay({}, Vector3::xAxis()).empty());
+    CORRADE_VERIFY(index.nearest({}, 10).empty());
+    CORRADE_COMPARE(index.nodeCount(), 0);
+}
+
+void SpatialIndexTest::addRemove() {
+    Scene3D scene;
+    Object3D o{&scene};
+    SpatialIndex3D index;
+
+    BoundingVolume3D a{o, Vector3{}, 1.0f, &index};
+    BoundingVolume3D b{o, Vector3{}, 1.0f};
+    BoundingVolume3D c{o, Vector3{}, 1.0f};
+    CORRADE_COMPARE(a.index(), &index);
+    CORRADE_VERIFY(!b.index());
+    CORRADE_COMPARE(index.size(), 1);
+
+    index.add(b).add(c);
+    CORRADE_COMPARE(b.index(), &index);
+    CORRADE_COMPARE(index.size(), 3);
+    CORRADE_VERIFY(index.isDirty());
+
+    index.setClean();
+    CORRADE_VERIFY(!index.isDirty());
+    CORRADE_COMPARE(index.nodeCount(), 1);
+    CORRADE_COMPARE(index.intersectingSphere({}, 0.5f).size(), 3);
+
+    /* The last volume is moved in place of the removed one */
+    index.remove(a);
+    CORRADE_VERIFY(!a.index());
+    CORRADE_VERIFY(index.isDirty());
+    CORRADE_COMPARE(index.size(), 2);
+    CORRADE_COMPARE(&index[0], &c);
+    CORRADE_COMPARE(&index[1], &b);
+    CORRADE_COMPARE(sorted(index.intersectingSphere({}, 0.5f)), sorted({&b, &c}));
+}
+
+void SpatialIndexTest::deleteVolume() {
+    Scene3D scene;
+    SpatialIndex3D index;
+    auto a = new Object3D{&scene};
+    auto b = new Object3D{&scene};
+    new BoundingVolume3D{*a, Vector3{}, 1.0f, &index};
+    BoundingVolume3D* volume = new BoundingVolume3D{*b, Vector3{}, 1.0f, &index};
+    index.setClean();
+
+    /* Deleting the object deletes the volume and removes it from the index */
+    delete a;
+    CORRADE_COMPARE(index.size(), 1);
+    CORRADE_COMPARE(index.intersectingSphere({}, 0.5f), std::vector<BoundingVolume3D*>{volume});
+}
+
+void SpatialIndexTest::deleteIndex() {
+    Scene3D scene;
+    Object3D o{&scene};
+    BoundingVolume3D volume{o, Vector3{}, 1.0f};
+
+    {
+        SpatialIndex3D index;
+        index.add(volume);
+        index.setClean();
+    }
+
+    CORRADE_VERIFY(!volume.index());
+
+    /* Marking the object dirty doesn't access the deleted index */
+    o.setClean();
+    o.translate(Vector3::xAxis());
+    CORRADE_VERIFY(o.isDirty());
+}
+
+void SpatialIndexTest::moveToAnotherIndex() {
+    Scene3D scene;
+    Object3D o{&scene};
+    SpatialIndex3D a, b;
+    BoundingVolume3D volume{o, Vector3{}, 1.0f, &a};
+    a.setClean();
+
+    b.add(volume);
+    CORRADE_COMPARE(volume.index(), &b);
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(b.size(), 1);
+    CORRADE_VERIFY(a.intersectingSphere({}, 1.0f).empty());
+    CORRADE_COMPARE(b.intersectingSphere({}, 1.0f).size(), 1);
+}
+
+void SpatialIndexTest::removeNotInIndex() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Object3D o;
+    BoundingVolume3D volume{o, Vector3{}, 1.0f};
+    SpatialIndex3D index;
+    index.remove(volume);
+
+    CORRADE_COMPARE(out.str(), "SceneGraph::SpatialIndex::remove(): volume is not part of this index\n");
+}
+
+void SpatialIndexTest::sphere() {
+    Scene3D scene;
+    SpatialIndex3D index;
+    populate(scene, index);
+    CORRADE_COMPARE(index.size(), 512);
+
+    /* Hits a single volume */
+    std::vector<BoundingVolume3D*> result = index.intersectingSphere({3.0f, 3.0f, 3.0f}, 0.5f);
+    CORRADE_COMPARE(result.size(), 1);
+    CORRADE_COMPARE(result[0]->transformedCenter(), (Vector3{3.0f, 3.0f, 3.0f}));
+
+    /* The hierarchy got built and isn't degenerate */
+    CORRADE_COMPARE(index.nodeCount(), 255);
+
+    /* Near the corner of a box but outside of a sphere */
+    CORRADE_COMPARE(index.intersectingSphere({4.2f, 4.2f, 4.2f}, 0.5f).size(), 1);
+    CORRADE_COMPARE(index.intersectingSphere({1.2f, 1.2f, 1.2f}, 0.5f).size(), 0);
+
+    /* Larger spheres */
+    for(const Float radius: {2.0f, 5.0f, 11.0f}) {
+        result = index.intersectingSphere({10.0f, 8.0f, 12.0f}, radius);
+        CORRADE_COMPARE(sorted(result), bruteForceSphere(index, {10.0f, 8.0f, 12.0f}, radius));
+    }
+
+    /* Everything */
+    CORRADE_COMPARE(index.intersectingSphere({10.5f, 10.5f, 10.5f}, 100.0f).size(), 512);
+}
+
+void SpatialIndexTest::sphere2D() {
+    Scene2D scene;
+    SpatialIndex2D index;
+    for(Int y = 0; y != 10; ++y) for(Int x = 0; x != 10; ++x) {
+        auto o = new Object2D{&scene};
+        o->translate(Vector2{Vector2i{x, y}}*2.0f);
+        new BoundingVolume2D{*o, Vector2{}, 0.5f, &index};
+    }
+
+    CORRADE_COMPARE(index.intersectingSphere({2.0f, 2.0f}, 0.1f).size(), 1);
+    CORRADE_COMPARE(index.intersectingSphere({3.0f, 2.0f}, 0.6f).size(), 2);
+    CORRADE_COMPARE(index.intersectingSphere({3.0f, 3.0f}, 1.0f).size(), 4);
+    CORRADE_COMPARE(index.intersectingRay({-1.0f, 4.0f}, Vector2::xAxis()).size(), 10);
+    CORRADE_COMPARE(index.nearest({7.1f, 6.9f}, 1)[0]->transformedCenter(), (Vector2{8.0f, 6.0f}));
+}
+
+void SpatialIndexTest::frustum() {
+    Scene3D scene;
+    SpatialIndex3D index;
+    populate(scene, index);
+
+    /* Camera at the grid center looking down -Z */
+    const Matrix4 matrix = Matrix4::perspectiveProjection(Deg(35.0f), 1.0f, 0.1f, 100.0f)*Matrix4::translation({-10.5f, -10.5f, -10.5f});
+    const Frustum frustum = Frustum::fromMatrix(matrix);
+
+    /* Brute-force reference needs up-to-date transformed volumes */
+    index.setClean();
+    std::vector<BoundingVolume3D*> expected;
+    for(std::size_t i = 0; i != index.size(); ++i) {
+        BoundingVolume3D& volume = index[i];
+        bool outside = false;
+        for(const Vector4& plane: frustum.planes()) {
+            const Float length = plane.xyz().length();
+            if(plane.w()/length + volume.transformedRadius() + Math::dot(plane.xyz()/length, volume.transformedCenter()) + Math::dot(Math::abs(plane.xyz()/length), volume.transformedHalfSize()) < 0.0f)
+                outside = true;
+        }
+        if(!outside) expected.push_back(&volume);
+    }
+
+    const std::vector<BoundingVolume3D*> result = index.intersectingFrustum(frustum);
+    CORRADE_COMPARE(sorted(result), sorted(expected));
+
+    /* Only the volumes in front, in a narrow cone */
+    CORRADE_VERIFY(result.size() > 8);
+    CORRADE_VERIFY(result.size() < 64);
+    for(BoundingVolume3D* volume: result)
+        CORRADE_VERIFY(volume->transformedCenter().z() < 12.0f);
+}
+
+void SpatialIndexTest::ray() {
+    Scene3D scene;
+    SpatialIndex3D index;
+    populate(scene, index);
+
+    /* Along the X axis through the row of volumes, sorted by distance */
+    std::vector<std::pair<Float, BoundingVolume3D*>> result = index.intersectingRay({-5.0f, 3.0f, 6.0f}, {2.0f, 0.0f, 0.0f});
+    CORRADE_COMPARE(result.size(), 8);
+    for(std::size_t i = 0; i != result.size(); ++i) {
+        CORRADE_COMPARE(result[i].second->transformedCenter(), (Vector3{i*3.0f, 3.0f, 6.0f}));
+        CORRADE_COMPARE(result[i].first, (i*3.0f + 4.0f)/2.0f);
+    }
+
+    /* Starting inside a sphere, going diagonally through the other spheres
+       and missing the boxes */
+    result = index.intersectingRay({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f});
+    CORRADE_COMPARE(result.size(), 8);
+    CORRADE_COMPARE(result[0].first, 0.0f);
+    CORRADE_COMPARE(result[1].first, 3.0f - Constants::sqrt2()*0.5f);
+    for(const std::pair<Float, BoundingVolume3D*>& hit: result)
+        CORRADE_VERIFY(hit.second->type() == BoundingVolumeType::Sphere);
+
+    /* Pointing away */
+    CORRADE_VERIFY(index.intersectingRay({-5.0f, 3.0f, 6.0f}, {-1.0f, 0.0f, 0.0f}).empty());
+
+    /* Off the sphere centers, the distance to boxes is the same */
+    result = index.intersectingRay({-2.0f, 0.5f, 0.0f}, {1.0f, 0.0f, 0.0f});
+    CORRADE_COMPARE(result.size(), 8);
+    CORRADE_COMPARE(result[0].first, 2.0f - std::sqrt(0.75f));
+    CORRADE_COMPARE(result[1].first, 4.0f);
+}
+
+void SpatialIndexTest::nearest() {
+    Scene3D scene;
+    SpatialIndex3D index;
+    populate(scene, index);
+
+    std::vector<BoundingVolume3D*> result = index.nearest({6.2f, 5.8f, 9.1f}, 1);
+    CORRADE_COMPARE(result.size(), 1);
+    CORRADE_COMPARE(result[0]->transformedCenter(), (Vector3{6.0f, 6.0f, 9.0f}));
+
+    /* Sorted by distance, verify against brute force */
+    const Vector3 point{10.0f, -3.0f, 13.0f};
+    result = index.nearest(point, 20);
+    CORRADE_COMPARE(result.size(), 20);
+    std::vector<std::pair<Float, BoundingVolume3D*>> expected;
+    for(std::size_t i = 0; i != index.size(); ++i) {
+        BoundingVolume3D& volume = index[i];
+        const Vector3 distance = Math::max(Math::abs(point - volume.transformedCenter()) - volume.transformedHalfSize(), Vector3{});
+        expected.emplace_back(Math::max(distance.length() - volume.transformedRadius(), 0.0f), &volume);
+    }
+    std::sort(expected.begin(), expected.end());
+    for(std::size_t i = 0; i != result.size(); ++i) {
+        const Vector3 distance = Math::max(Math::abs(point - result[i]->transformedCenter()) - result[i]->transformedHalfSize(), Vector3{});
+        CORRADE_COMPARE(Math::max(distance.length() - result[i]->transformedRadius(), 0.0f), expected[i].first);
+    }
+
+    /* More than is in the index */
+    CORRADE_COMPARE(index.nearest(point, 1000).size(), 512);
+}
+
+void SpatialIndexTest::refit() {
+    Scene3D scene;
+    SpatialIndex3D index;
+    populate(scene, index);
+    CORRADE_COMPARE(index.intersectingSphere({100.0f, 0.0f, 0.0f}, 1.5f).size(), 0);
+    CORRADE_VERIFY(!index.isDirty());
+
+    /* Moving an object schedules its volume for refit */
+    Object3D& o = static_cast<Object3D&>(index[42].object());
+    o.translate({100.0f, 0.0f, 0.0f});
+    CORRADE_VERIFY(index.isDirty());
+
+    /* The object gets cleaned by the query */
+    std::vector<BoundingVolume3D*> result = index.intersectingSphere({100.0f, 0.0f, 0.0f}, 25.0f);
+    CORRADE_COMPARE(result, std::vector<BoundingVolume3D*>{&index[42]});
+    CORRADE_VERIFY(!o.isDirty());
+    CORRADE_VERIFY(!index.isDirty());
+    CORRADE_COMPARE(index.nodeCount(), 255);
+    CORRADE_COMPARE(index.nearest({1000.0f, 0.0f, 0.0f}, 1), std::vector<BoundingVolume3D*>{&index[42]});
+
+    /* Moving the object back gets the same results as brute force */
+    o.translate({-100.0f, 0.0f, 0.0f});
+    for(const Float radius: {2.0f, 6.0f}) {
+        result = index.intersectingSphere({9.0f, 9.0f, 9.0f}, radius);
+        CORRADE_COMPARE(sorted(result), bruteForceSphere(index, {9.0f, 9.0f, 9.0f}, radius));
+    }
+}
+
+void SpatialIndexTest::refitRebuild() {
+    Scene3D scene;
+    SpatialIndex3D index;
+    Object3D root{&scene};
+    for(Int i = 0; i != 100; ++i) {
+        auto o = new Object3D{&root};
+        o->translate({i*3.0f, 0.0f, 0.0f});
+        new BoundingVolume3D{*o, Vector3{}, 1.0f, &index};
+    }
+    index.setClean();
+
+    /* Moving the parent dirties all children, the index is rebuilt if too
+       many volumes got refitted. The result is the same in any case. */
+    for(Int i = 0; i != 5; ++i) {
+        root.translate({0.0f, 10.0f, 0.0f});
+        CORRADE_VERIFY(index.isDirty());
+        std::vector<std::pair<Float, BoundingVolume3D*>> result = index.intersectingRay({-2.0f, (i + 1)*10.0f, 0.0f}, Vector3::xAxis());
+        CORRADE_COMPARE(result.size(), 100);
+        CORRADE_COMPARE(result.front().first, 1.0f);
+        CORRADE_COMPARE(result.back().first, 298.0f);
+    }
+
+    /* Explicit rebuild */
+    root.translate({0.0f, -50.0f, 0.0f});
+    index.rebuild();
+    CORRADE_VERIFY(!index.isDirty());
+    CORRADE_COMPARE(index.intersectingSphere({150.0f, 0.0f, 0.0f}, 1.5f).size(), 1);
+}
+
+void SpatialIndexTest::setVolume() {
+    Scene3D scene;
+    SpatialIndex3D index;
+    populate(scene, index);
+    index.setClean();
+
+    /* Changing the volume refits it as well */
+    index[7].setSphere({}, 20.0f);
+    CORRADE_VERIFY(index.isDirty());
+    CORRADE_COMPARE(sorted(index.intersectingSphere({21.0f, -19.5f, 0.0f}, 0.1f)),
+        std::vector<BoundingVolume3D*>{&index[7]});
+}
+
+namespace {
+
+struct BenchmarkScene {
+    explicit BenchmarkScene(const std::size_t count) {
+        /* Batch cleaning of more than 65k objects is possible only with the
+           flattened hierarchy */
+        scene.setFlattened(true);
+
+        /* Density stays the same regardless of object count, so the queries
+           return roughly the same amount of volumes */
+        const Float size = std::cbrt(Float(count))*4.0f;
+        for(const Vector3& position: positions(count, size)) {
+            auto o = new Object3D{&scene};
+            o->translate(position);
+            new BoundingVolume3D{*o, Vector3{}, 1.0f, &index};
+        }
+        index.setClean();
+        center = Vector3{size*0.5f};
+    }
+
+    Scene3D scene;
+    SpatialIndex3D index;
+    Vector3 center;
+};
+
+}
+
+template<std::size_t count> void SpatialIndexTest::benchmarkBuild() {
+    setTestCaseName(std::string{"benchmarkBuild<"} + std::to_string(count) + ">");
+
+    BenchmarkScene s{count};
+    CORRADE_BENCHMARK(1)
+        s.index.rebuild();
+
+    CORRADE_COMPARE(s.index.size(), count);
+}
+
+template<std::size_t count> void SpatialIndexTest::benchmarkRefit() {
+    setTestCaseName(std::string{"benchmarkRefit<"} + std::to_string(count) + ">");
+
+    BenchmarkScene s{count};
+
+    /* Move every hundredth object back and forth, which is below the rebuild
+       threshold */
+    std::vector<Object3D*> moved;
+    for(std::size_t i = 0; i < count; i += 100)
+        moved.push_back(&static_cast<Object3D&>(s.index[i].object()));
+
+    Float offset = 1.0f;
+    CORRADE_BENCHMARK(1) {
+        for(Object3D* o: moved) o->translate({offset, 0.0f, 0.0f});
+        offset = -offset;
+        s.index.setClean();
+    }
+
+    CORRADE_VERIFY(!s.index.isDirty());
+}
+
+template<std::size_t count> void SpatialIndexTest::benchmarkSphere() {
+    setTestCaseName(std::string{"benchmarkSphere<"} + std::to_string(count) + ">");
+
+    BenchmarkScene s{count};
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(100)
+        found += s.index.intersectingSphere(s.center, 5.0f).size();
+
+    CORRADE_VERIFY(found);
+}
+
+template<std::size_t count> void SpatialIndexTest::benchmarkSphereLinear() {
+    setTestCaseName(std::string{"benchmarkSphereLinear<"} + std::to_string(count) + ">");
+
+    BenchmarkScene s{count};
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(100) {
+        for(std::size_t i = 0; i != s.index.size(); ++i) {
+            const BoundingVolume3D& volume = s.index[i];
+            if((volume.transformedCenter() - s.center).length() <= 5.0f + volume.transformedRadius())
+                ++found;
+        }
+    }
+
+    CORRADE_VERIFY(found);
+}
+
+template<std::size_t count> void SpatialIndexTest::benchmarkRay() {
+    setTestCaseName(std::string{"benchmarkRay<"} + std::to_string(count) + ">");
+
+    BenchmarkScene s{count};
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(100)
+        found += s.index.intersectingRay({0.0f, s.center.y(), s.center.z()}, Vector3::xAxis()).size();
+
+    CORRADE_VERIFY(found);
+}
+
+template<std::size_t count> void SpatialIndexTest::benchmarkNearest() {
+    setTestCaseName(std::string{"benchmarkNearest<"} + std::to_string(count) + ">");
+
+    BenchmarkScene s{count};
+    std::size_t found = 0;
+    CORRADE_BENCHMARK(100)
+        found += s.index.nearest(s.center, 10).size();
+
+    CORRADE_COMPARE(found, 1000);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SpatialIndexTest)
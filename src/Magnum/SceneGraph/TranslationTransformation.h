@@ -33,6 +33,7 @@
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/SceneGraph/AbstractTranslation.h"
 #include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -231,7 +232,9 @@ template<UnsignedInt dimensions, class T, class TranslationType> struct Transfor
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
 extern template class MAGNUM_SCENEGRAPH_EXPORT Object<TranslationTransformation<2, Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Scene<TranslationTransformation<2, Float>>;
 extern template class MAGNUM_SCENEGRAPH_EXPORT Object<TranslationTransformation<3, Float>>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT Scene<TranslationTransformation<3, Float>>;
 #endif
 
 }}
@@ -25,16 +25,22 @@
 
 #include "Magnum/SceneGraph/AbstractFeature.hpp"
 #include "Magnum/SceneGraph/Animable.hpp"
+#include "Magnum/SceneGraph/AnimationPlayer.hpp"
+#include "Magnum/SceneGraph/BoundingVolume.hpp"
 #include "Magnum/SceneGraph/Camera.hpp"
 #include "Magnum/SceneGraph/Drawable.hpp"
+#include "Magnum/SceneGraph/DrawQueue.hpp"
 #include "Magnum/SceneGraph/DualComplexTransformation.h"
 #include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/FeatureGroup.hpp"
+#include "Magnum/SceneGraph/LodGroup.hpp"
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Object.hpp"
 #include "Magnum/SceneGraph/RigidMatrixTransformation2D.h"
 #include "Magnum/SceneGraph/RigidMatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Snapshot.hpp"
+#include "Magnum/SceneGraph/SpatialIndex.hpp"
 #include "Magnum/SceneGraph/TranslationTransformation.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -63,12 +69,27 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Animable<3, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimableGroup<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimableGroup<3, Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimationPlayer<BasicDualQuaternionTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimationPlayer<BasicMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimationPlayer<BasicRigidMatrixTransformation3D<Float>>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolume<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BoundingVolume<3, Float>;
+
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<3, Float>;
 
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<3, Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP DrawQueue<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP DrawQueue<3, Float>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP LodGroup<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP LodGroup<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP LodSelector<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP LodSelector<3, Float>;
+
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicDualComplexTransformation<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicDualQuaternionTransformation<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicMatrixTransformation2D<Float>>;
@@ -77,6 +98,27 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicRigidMatrixTransformatio
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<BasicRigidMatrixTransformation3D<Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<2, Float>>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Object<TranslationTransformation<3, Float>>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicDualComplexTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicDualQuaternionTransformation<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicRigidMatrixTransformation2D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<BasicRigidMatrixTransformation3D<Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<TranslationTransformation<2, Float>>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP Scene<TranslationTransformation<3, Float>>;
+
+template struct MAGNUM_SCENEGRAPH_EXPORT_HPP Implementation::ObjectSnapshot<BasicDualComplexTransformation<Float>>;
+template struct MAGNUM_SCENEGRAPH_EXPORT_HPP Implementation::ObjectSnapshot<BasicDualQuaternionTransformation<Float>>;
+template struct MAGNUM_SCENEGRAPH_EXPORT_HPP Implementation::ObjectSnapshot<BasicMatrixTransformation2D<Float>>;
+template struct MAGNUM_SCENEGRAPH_EXPORT_HPP Implementation::ObjectSnapshot<BasicMatrixTransformation3D<Float>>;
+template struct MAGNUM_SCENEGRAPH_EXPORT_HPP Implementation::ObjectSnapshot<BasicRigidMatrixTransformation2D<Float>>;
+template struct MAGNUM_SCENEGRAPH_EXPORT_HPP Implementation::ObjectSnapshot<BasicRigidMatrixTransformation3D<Float>>;
+template struct MAGNUM_SCENEGRAPH_EXPORT_HPP Implementation::ObjectSnapshot<TranslationTransformation<2, Float>>;
+template struct MAGNUM_SCENEGRAPH_EXPORT_HPP Implementation::ObjectSnapshot<TranslationTransformation<3, Float>>;
+
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP SpatialIndex<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP SpatialIndex<3, Float>;
 #endif
 
 }}
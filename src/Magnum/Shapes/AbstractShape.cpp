@@ -33,8 +33,9 @@
 
 namespace Magnum { namespace Shapes {
 
-template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float>(object, group) {
+template<UnsignedInt dimensions> AbstractShape<dimensions>::AbstractShape(SceneGraph::AbstractObject<dimensions, Float>& object, ShapeGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, AbstractShape<dimensions>, Float>(object, group), _contactMoved{true}, _contactIndex{~UnsignedInt{}}, _contactGroup{} {
     SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
+    SceneGraph::AbstractFeature<dimensions, Float>::setCleanThreadSafe(true);
 }
 
 template<UnsignedInt dimensions> ShapeGroup<dimensions>* AbstractShape<dimensions>::group() {
@@ -58,6 +59,7 @@ template<UnsignedInt dimensions> Collision<dimensions> AbstractShape<dimensions>
 }
 
 template<UnsignedInt dimensions> void AbstractShape<dimensions>::markDirty() {
+    _contactMoved = true;
     if(group()) group()->setDirty();
 }
 
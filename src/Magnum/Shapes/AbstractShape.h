@@ -57,6 +57,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
     /* Otherwise it complains that this is not a function */
     template<UnsignedInt dimensions_> friend const Implementation::AbstractShape<dimensions_>& Implementation::getAbstractShape(const Shapes::AbstractShape<dimensions_>&);
     #endif
+    friend ShapeGroup<dimensions>;
 
     public:
         enum: UnsignedInt {
@@ -74,7 +75,8 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
             AxisAlignedBox, /**< @ref AxisAlignedBox "Axis aligned box" */
             Box,            /**< Box */
             Composition,    /**< @ref Composition "Shape group" */
-            Plane           /**< Plane (3D only) */
+            Plane,          /**< Plane (3D only) */
+            TriangleMesh    /**< @ref TriangleMesh "Triangle mesh" (3D only) */
         };
         #else
         typedef typename Implementation::ShapeDimensionTraits<dimensions>::Type Type;
@@ -118,6 +120,12 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
 
     private:
         virtual const Implementation::AbstractShape<dimensions> MAGNUM_SHAPES_LOCAL & abstractTransformedShape() const = 0;
+
+        /* State for ShapeGroup::updateContacts() -- whether the shape moved
+           since the last update and where it was in which group */
+        bool _contactMoved;
+        UnsignedInt _contactIndex;
+        const ShapeGroup<dimensions>* _contactGroup;
 };
 
 /** @brief Base class for two-dimensional object shapes */
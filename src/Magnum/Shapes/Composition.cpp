@@ -28,6 +28,15 @@
 #include <algorithm>
 #include <Corrade/Utility/Assert.h>
 
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/TriangleMesh.h"
 #include "Magnum/Shapes/Implementation/CollisionDispatch.h"
 
 namespace Magnum { namespace Shapes {
@@ -58,29 +67,86 @@ Shapes are merged together by concatenating its node and shape list and adding
 new node at the beginning with properly set `rightNode` and `rightShape`.
 Because these values are relative to parent, they don't need to be modified
 when concatenating.
+
+Shapes are stored inline in fixed-size slots together with their type, so
+operations on particular shapes are done by switching over the stored type
+instead of calling virtual functions. All shapes are trivially destructible,
+so the slots are reused without destructing the previous contents, similarly
+to the pixel storage union in Trade::ImageData.
 */
 
+namespace {
+
+/* Calls Operation::run<T>() with concrete shape type corresponding to given
+   type enum */
+template<class Operation, class ...Args> void dispatch(const Implementation::ShapeDimensionTraits<2>::Type type, Args&&... args) {
+    switch(type) {
+        #define _c(value, Class) case Implementation::ShapeDimensionTraits<2>::Type::value: Operation::template run<Class>(std::forward<Args>(args)...); return;
+        _c(Point, Point2D)
+        _c(Line, Line2D)
+        _c(LineSegment, LineSegment2D)
+        _c(Sphere, Sphere2D)
+        _c(InvertedSphere, InvertedSphere2D)
+        _c(Cylinder, Cylinder2D)
+        _c(Capsule, Capsule2D)
+        _c(AxisAlignedBox, AxisAlignedBox2D)
+        _c(Box, Box2D)
+        #undef _c
+        /* Compositions are always flattened */
+        case Implementation::ShapeDimensionTraits<2>::Type::Composition: break;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<class Operation, class ...Args> void dispatch(const Implementation::ShapeDimensionTraits<3>::Type type, Args&&... args) {
+    switch(type) {
+        #define _c(value, Class) case Implementation::ShapeDimensionTraits<3>::Type::value: Operation::template run<Class>(std::forward<Args>(args)...); return;
+        _c(Point, Point3D)
+        _c(Line, Line3D)
+        _c(LineSegment, LineSegment3D)
+        _c(Sphere, Sphere3D)
+        _c(InvertedSphere, InvertedSphere3D)
+        _c(Cylinder, Cylinder3D)
+        _c(Capsule, Capsule3D)
+        _c(AxisAlignedBox, AxisAlignedBox3D)
+        _c(Box, Box3D)
+        _c(Plane, Plane)
+        _c(TriangleMesh, TriangleMesh)
+        #undef _c
+        /* Compositions are always flattened */
+        case Implementation::ShapeDimensionTraits<3>::Type::Composition: break;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+struct CopyShape {
+    template<class T> static void run(const Implementation::AbstractShape<T::Dimensions>& shape, void* const out) {
+        new(out) Implementation::Shape<T>(static_cast<const Implementation::Shape<T>&>(shape).shape);
+    }
+};
+
+struct TransformShape {
+    template<class T> static void run(const Implementation::AbstractShape<T::Dimensions>& shape, const MatrixTypeFor<T::Dimensions, Float>& matrix, Implementation::AbstractShape<T::Dimensions>& out) {
+        static_cast<Implementation::Shape<T>&>(out).shape = static_cast<const Implementation::Shape<T>&>(shape).shape.transformed(matrix);
+    }
+};
+
+}
+
 template<UnsignedInt dimensions> Composition<dimensions>::Composition(const Composition<dimensions>& other): _shapes(other._shapes.size()), _nodes(other._nodes.size()) {
     copyShapes(0, other);
     copyNodes(0, other);
 }
 
-template<UnsignedInt dimensions> Composition<dimensions>::Composition(Composition<dimensions>&& other): _shapes(std::move(other._shapes)), _nodes(std::move(other._nodes)) {
-    other._shapes = nullptr;
-    other._nodes = nullptr;
-}
+template<UnsignedInt dimensions> Composition<dimensions>::Composition(Composition<dimensions>&& other): _shapes(std::move(other._shapes)), _nodes(std::move(other._nodes)) {}
 
-template<UnsignedInt dimensions> Composition<dimensions>::~Composition() {
-    for(std::size_t i = 0; i != _shapes.size(); ++i)
-        delete _shapes[i];
-}
+template<UnsignedInt dimensions> Composition<dimensions>::~Composition() = default;
 
 template<UnsignedInt dimensions> Composition<dimensions>& Composition<dimensions>::operator=(const Composition<dimensions>& other) {
-    for(std::size_t i = 0; i != _shapes.size(); ++i)
-        delete _shapes[i];
-
     if(_shapes.size() != other._shapes.size())
-        _shapes = Containers::Array<Implementation::AbstractShape<dimensions>*>(other._shapes.size());
+        _shapes = Containers::Array<Slot>(other._shapes.size());
 
     if(_nodes.size() != other._nodes.size())
         _nodes = Containers::Array<Node>(other._nodes.size());
@@ -97,16 +163,12 @@ template<UnsignedInt dimensions> Composition<dimensions>& Composition<dimensions
     return *this;
 }
 
-template<UnsignedInt dimensions> void Composition<dimensions>::copyShapes(const std::size_t offset, Composition<dimensions>&& other) {
-    CORRADE_INTERNAL_ASSERT(_shapes.size() >= other._shapes.size()+offset);
-    std::move(other._shapes.begin(), other._shapes.end(), _shapes.begin()+offset);
-    other._shapes = nullptr;
-}
-
 template<UnsignedInt dimensions> void Composition<dimensions>::copyShapes(const std::size_t offset, const Composition<dimensions>& other) {
     CORRADE_INTERNAL_ASSERT(_shapes.size() >= other._shapes.size()+offset);
-    for(Implementation::AbstractShape<dimensions> * const* i = other._shapes.begin(), ** o = _shapes.begin()+offset; i != other._shapes.end(); ++i, ++o)
-        *o = (*i)->clone();
+    for(std::size_t i = 0; i != other._shapes.size(); ++i) {
+        dispatch<CopyShape>(other._shapes[i].type, other.abstractShape(i), &_shapes[offset + i].data);
+        _shapes[offset + i].type = other._shapes[i].type;
+    }
 }
 
 template<UnsignedInt dimensions> void Composition<dimensions>::copyNodes(std::size_t offset, const Composition<dimensions>& other) {
@@ -116,12 +178,19 @@ template<UnsignedInt dimensions> void Composition<dimensions>::copyNodes(std::si
 
 template<UnsignedInt dimensions> Composition<dimensions> Composition<dimensions>::transformed(const MatrixTypeFor<dimensions, Float>& matrix) const {
     Composition<dimensions> out(*this);
-    for(Implementation::AbstractShape<dimensions> * const* i = _shapes.begin(), * const* o = out._shapes.begin(); i != _shapes.end(); ++i, ++o)
-        (*i)->transform(matrix, *o);
+    transformShapes(matrix, out);
     return out;
 }
 
-template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Implementation::AbstractShape<dimensions>& a, const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd) const {
+template<UnsignedInt dimensions> void Composition<dimensions>::transformShapes(const MatrixTypeFor<dimensions, Float>& matrix, Composition<dimensions>& out) const {
+    CORRADE_INTERNAL_ASSERT(out._shapes.size() == _shapes.size());
+    for(std::size_t i = 0; i != _shapes.size(); ++i) {
+        CORRADE_INTERNAL_ASSERT(out._shapes[i].type == _shapes[i].type);
+        dispatch<TransformShape>(_shapes[i].type, abstractShape(i), matrix, out.abstractShape(i));
+    }
+}
+
+template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Type type, const Implementation::AbstractShape<dimensions>& a, const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd) const {
     /* Empty group */
     if(shapeBegin == shapeEnd) return false;
 
@@ -130,8 +199,8 @@ template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Im
     /* Collision on the left child. If the node is leaf one (no left child
        exists), do it directly, recurse instead. */
     const bool collidesLeft = (_nodes[node].rightNode == 0 || _nodes[node].rightNode == 2) ?
-        Implementation::collides(a, *_shapes[shapeBegin]) :
-        collides(a, node+1, shapeBegin, shapeBegin+_nodes[node].rightShape);
+        Implementation::collides<dimensions>(type, a, _shapes[shapeBegin].type, abstractShape(shapeBegin)) :
+        collides(type, a, node+1, shapeBegin, shapeBegin+_nodes[node].rightShape);
 
     /* NOT operation */
     if(_nodes[node].operation == CompositionOperation::Not)
@@ -144,8 +213,8 @@ template<UnsignedInt dimensions> bool Composition<dimensions>::collides(const Im
     /* Now the collision result depends only on the right child. Similar to
        collision on the left child. */
     return (_nodes[node].rightNode < 2) ?
-        Implementation::collides(a, *_shapes[shapeBegin+_nodes[node].rightShape]) :
-        collides(a, node+_nodes[node].rightNode-1, shapeBegin+_nodes[node].rightShape, shapeEnd);
+        Implementation::collides<dimensions>(type, a, _shapes[shapeBegin+_nodes[node].rightShape].type, abstractShape(shapeBegin+_nodes[node].rightShape)) :
+        collides(type, a, node+_nodes[node].rightNode-1, shapeBegin+_nodes[node].rightShape, shapeEnd);
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Shapes::Composition, typedef @ref Magnum::Shapes::Composition2D, @ref Magnum::Shapes::Composition3D, enum @ref Magnum::Shapes::CompositionOperation
  */
 
+#include <new>
 #include <type_traits>
 #include <utility>
 #include <Corrade/Containers/Array.h>
@@ -45,10 +46,10 @@ namespace Implementation {
     template<class> struct ShapeHelper;
 
     template<UnsignedInt dimensions> inline AbstractShape<dimensions>& getAbstractShape(Composition<dimensions>& group, std::size_t i) {
-        return *group._shapes[i];
+        return group.abstractShape(i);
     }
     template<UnsignedInt dimensions> inline const AbstractShape<dimensions>& getAbstractShape(const Composition<dimensions>& group, std::size_t i) {
-        return *group._shapes[i];
+        return group.abstractShape(i);
     }
 }
 
@@ -63,6 +64,11 @@ enum class CompositionOperation: UnsignedByte {
 @brief Composition of shapes
 
 Result of logical operations on shapes. See @ref shapes for brief introduction.
+
+The shapes are stored inline in a single array of fixed-size slots, each
+tagged with type of the shape, so copying, moving and transforming the
+composition doesn't allocate each shape separately and the collision
+detection doesn't need to query the shape types through virtual calls.
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
     friend Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(Composition<dimensions>&, std::size_t);
@@ -86,7 +92,8 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
             Capsule,        /**< Capsule */
             AxisAlignedBox, /**< @ref AxisAlignedBox "Axis aligned box" */
             Box,            /**< Box */
-            Plane           /**< Plane (3D only) */
+            Plane,          /**< Plane (3D only) */
+            TriangleMesh    /**< @ref TriangleMesh "Triangle mesh" (3D only) */
         };
         #else
         typedef typename Implementation::ShapeDimensionTraits<dimensions>::Type Type;
@@ -135,7 +142,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
         std::size_t size() const { return _shapes.size(); }
 
         /** @brief Type of shape at given position */
-        Type type(std::size_t i) const { return _shapes[i]->type(); }
+        Type type(std::size_t i) const { return _shapes[i].type; }
 
         /** @brief Shape at given position */
         template<class T> const T& get(std::size_t i) const;
@@ -146,20 +153,38 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
         #else
         template<class T> auto operator%(const T& other) const -> typename std::enable_if<std::is_same<decltype(Implementation::TypeOf<T>::type()), typename Implementation::ShapeDimensionTraits<dimensions>::Type>::value, bool>::type {
         #endif
-            return collides(Implementation::Shape<T>(other));
+            return collides(Implementation::TypeOf<T>::type(), Implementation::Shape<T>(other));
         }
 
     private:
         struct Node {
-            std::size_t rightNode, rightShape;
+            UnsignedInt rightNode, rightShape;
             CompositionOperation operation;
         };
 
-        bool collides(const Implementation::AbstractShape<dimensions>& a) const {
-            return collides(a, 0, 0, _shapes.size());
+        /* Big enough to hold any shape wrapper of given dimension count,
+           checked in copyShapes() */
+        struct Slot {
+            typename std::aligned_storage<Implementation::ShapeDimensionTraits<dimensions>::ShapeSize, alignof(void*)>::type data;
+            Type type;
+        };
+
+        /* The wrapper has the abstract base at the beginning, checked in
+           copyShapes() */
+        Implementation::AbstractShape<dimensions>& abstractShape(std::size_t i) {
+            return *reinterpret_cast<Implementation::AbstractShape<dimensions>*>(&_shapes[i].data);
+        }
+        const Implementation::AbstractShape<dimensions>& abstractShape(std::size_t i) const {
+            return *reinterpret_cast<const Implementation::AbstractShape<dimensions>*>(&_shapes[i].data);
         }
 
-        bool collides(const Implementation::AbstractShape<dimensions>& a, std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd) const;
+        bool collides(Type type, const Implementation::AbstractShape<dimensions>& a) const {
+            return collides(type, a, 0, 0, _shapes.size());
+        }
+
+        bool collides(Type type, const Implementation::AbstractShape<dimensions>& a, std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd) const;
+
+        void transformShapes(const MatrixTypeFor<dimensions, Float>& matrix, Composition<dimensions>& out) const;
 
         template<class T> constexpr static std::size_t shapeCount(const T&) {
             return 1;
@@ -175,15 +200,19 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
         }
 
         template<class T> void copyShapes(std::size_t offset, const T& shape) {
-            _shapes[offset] = new Implementation::Shape<T>(shape);
+            static_assert(sizeof(Implementation::Shape<T>) <= sizeof(Slot::data) && alignof(Implementation::Shape<T>) <= alignof(decltype(Slot::data)),
+                "shape doesn't fit into composition slot");
+            Implementation::AbstractShape<dimensions>* const out = new(&_shapes[offset].data) Implementation::Shape<T>(shape);
+            CORRADE_INTERNAL_ASSERT(out == &abstractShape(offset));
+            static_cast<void>(out);
+            _shapes[offset].type = Implementation::TypeOf<T>::type();
         }
-        void copyShapes(std::size_t offset, Composition<dimensions>&& other);
         void copyShapes(std::size_t offset, const Composition<dimensions>& other);
 
         template<class T> void copyNodes(std::size_t, const T&) {}
         void copyNodes(std::size_t offset, const Composition<dimensions>& other);
 
-        Containers::Array<Implementation::AbstractShape<dimensions>*> _shapes;
+        Containers::Array<Slot> _shapes;
         Containers::Array<Node> _nodes;
 };
 
@@ -288,10 +317,10 @@ template<UnsignedInt dimensions> template<class T, class U> Composition<dimensio
 }
 
 template<UnsignedInt dimensions> template<class T> inline const T& Composition<dimensions>::get(std::size_t i) const {
-    CORRADE_ASSERT(_shapes[i]->type() == Implementation::TypeOf<T>::type(),
+    CORRADE_ASSERT(_shapes[i].type == Implementation::TypeOf<T>::type(),
         "Shapes::Composition::get(): given shape is not of type" << Implementation::TypeOf<T>::type() <<
-        "but" << _shapes[i]->type(), *static_cast<T*>(nullptr));
-    return static_cast<Implementation::Shape<T>*>(_shapes[i])->shape;
+        "but" << _shapes[i].type, *static_cast<T*>(nullptr));
+    return static_cast<const Implementation::Shape<T>&>(abstractShape(i)).shape;
 }
 
 }}
@@ -0,0 +1,120 @@
+#ifndef Magnum_Shapes_Contact_h
+#define Magnum_Shapes_Contact_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::Contact, enum @ref Magnum::Shapes::ContactState, typedef @ref Magnum::Shapes::Contact2D, @ref Magnum::Shapes::Contact3D
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Shapes/Collision.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Contact state
+
+@see @ref Contact::state(), @ref ShapeGroup::updateContacts()
+*/
+enum class ContactState: UnsignedByte {
+    /** The shapes started colliding in this update */
+    Begin,
+
+    /** The shapes were colliding already in the previous update */
+    Persist,
+
+    /** The shapes stopped colliding in this update */
+    End
+};
+
+/** @debugoperatorenum{Magnum::Shapes::ContactState} */
+MAGNUM_SHAPES_EXPORT Debug& operator<<(Debug& debug, ContactState value);
+
+/**
+@brief Contact between two shapes
+
+Returned from @ref ShapeGroup::updateContacts(). The first shape is always the
+one earlier in the group. If the contact ended because one of the shapes was
+removed from the group, the removed shape might not exist anymore and only
+its address can be used.
+@see @ref Contact2D, @ref Contact3D
+*/
+template<UnsignedInt dimensions> class Contact {
+    public:
+        /**
+         * @brief Constructor
+         * @param a         First shape
+         * @param b         Second shape
+         * @param state     Contact state
+         * @param collision Collision data
+         */
+        explicit Contact(AbstractShape<dimensions>& a, AbstractShape<dimensions>& b, ContactState state, const Collision<dimensions>& collision) noexcept: _a(&a), _b(&b), _collision(collision), _state(state) {}
+
+        /** @brief First shape */
+        AbstractShape<dimensions>& a() const { return *_a; }
+
+        /** @brief Second shape */
+        AbstractShape<dimensions>& b() const { return *_b; }
+
+        /** @brief Contact state */
+        ContactState state() const { return _state; }
+
+        /**
+         * @brief Collision data
+         *
+         * Result of @ref AbstractShape::collision() of the two shapes. For
+         * @ref ContactState::End it's the data from the last update in which
+         * the shapes were colliding. Empty for shape pairs which don't have
+         * detailed collision implemented.
+         */
+        const Collision<dimensions>& collision() const { return _collision; }
+
+    private:
+        AbstractShape<dimensions>* _a;
+        AbstractShape<dimensions>* _b;
+        Collision<dimensions> _collision;
+        ContactState _state;
+};
+
+/**
+@brief Contact between two-dimensional shapes
+
+@see @ref Contact3D
+*/
+typedef Contact<2> Contact2D;
+
+/**
+@brief Contact between three-dimensional shapes
+
+@see @ref Contact2D
+*/
+typedef Contact<3> Contact3D;
+
+}}
+
+#endif
@@ -33,14 +33,15 @@
 #include "Magnum/Shapes/Plane.h"
 #include "Magnum/Shapes/Point.h"
 #include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/TriangleMesh.h"
 #include "Magnum/Shapes/shapeImplementation.h"
 
 namespace Magnum { namespace Shapes { namespace Implementation {
 
-template<> bool collides(const AbstractShape<2>& a, const AbstractShape<2>& b) {
-    if(a.type() < b.type()) return collides(b, a);
+template<> bool collides(const ShapeDimensionTraits<2>::Type aType, const AbstractShape<2>& a, const ShapeDimensionTraits<2>::Type bType, const AbstractShape<2>& b) {
+    if(aType < bType) return collides<2>(bType, b, aType, a);
 
-    switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
+    switch(UnsignedInt(aType)*UnsignedInt(bType)) {
         #define _c(aType, aClass, bType, bClass) \
             case UnsignedInt(ShapeDimensionTraits<2>::Type::aType)*UnsignedInt(ShapeDimensionTraits<2>::Type::bType): \
                 return static_cast<const Shape<aClass>&>(a).shape % static_cast<const Shape<bClass>&>(b).shape;
@@ -65,6 +66,10 @@ template<> bool collides(const AbstractShape<2>& a, const AbstractShape<2>& b) {
     return false;
 }
 
+template<> bool collides(const AbstractShape<2>& a, const AbstractShape<2>& b) {
+    return collides<2>(a.type(), a, b.type(), b);
+}
+
 template<> Collision<2> collision(const AbstractShape<2>& a, const AbstractShape<2>& b) {
     if(a.type() < b.type()) return collision(b, a);
 
@@ -80,10 +85,10 @@ template<> Collision<2> collision(const AbstractShape<2>& a, const AbstractShape
     return {};
 }
 
-template<> bool collides(const AbstractShape<3>& a, const AbstractShape<3>& b) {
-    if(a.type() < b.type()) return collides(b, a);
+template<> bool collides(const ShapeDimensionTraits<3>::Type aType, const AbstractShape<3>& a, const ShapeDimensionTraits<3>::Type bType, const AbstractShape<3>& b) {
+    if(aType < bType) return collides<3>(bType, b, aType, a);
 
-    switch(UnsignedInt(a.type())*UnsignedInt(b.type())) {
+    switch(UnsignedInt(aType)*UnsignedInt(bType)) {
         #define _c(aType, aClass, bType, bClass) \
             case UnsignedInt(ShapeDimensionTraits<3>::Type::aType)*UnsignedInt(ShapeDimensionTraits<3>::Type::bType): \
                 return static_cast<const Shape<aClass>&>(a).shape % static_cast<const Shape<bClass>&>(b).shape;
@@ -105,12 +110,22 @@ template<> bool collides(const AbstractShape<3>& a, const AbstractShape<3>& b) {
 
         _c(Plane, Plane, Line, Line3D)
         _c(Plane, Plane, LineSegment, LineSegment3D)
+
+        _c(TriangleMesh, TriangleMesh, Point, Point3D)
+        _c(TriangleMesh, TriangleMesh, Line, Line3D)
+        _c(TriangleMesh, TriangleMesh, LineSegment, LineSegment3D)
+        _c(TriangleMesh, TriangleMesh, Sphere, Sphere3D)
+        _c(TriangleMesh, TriangleMesh, Capsule, Capsule3D)
         #undef _c
     }
 
     return false;
 }
 
+template<> bool collides(const AbstractShape<3>& a, const AbstractShape<3>& b) {
+    return collides<3>(a.type(), a, b.type(), b);
+}
+
 template<> Collision<3> collision(const AbstractShape<3>& a, const AbstractShape<3>& b) {
     if(a.type() < b.type()) return collision(b, a);
 
@@ -120,6 +135,8 @@ template<> Collision<3> collision(const AbstractShape<3>& a, const AbstractShape
                 return static_cast<const Shape<aClass>&>(a).shape / static_cast<const Shape<bClass>&>(b).shape;
         _c(Sphere, Sphere3D, Point, Point3D)
         _c(Sphere, Sphere3D, Sphere, Sphere3D)
+
+        _c(TriangleMesh, TriangleMesh, Sphere, Sphere3D)
         #undef _c
     }
 
@@ -31,6 +31,7 @@
 namespace Magnum { namespace Shapes { namespace Implementation {
 
 template<UnsignedInt> struct AbstractShape;
+template<UnsignedInt> struct ShapeDimensionTraits;
 
 /*
 Shape collision double-dispatch:
@@ -46,6 +47,10 @@ template<UnsignedInt dimensions> bool collides(const AbstractShape<dimensions>&
 
 template<UnsignedInt dimensions> Collision<dimensions> collision(const AbstractShape<dimensions>& a, const AbstractShape<dimensions>& b);
 
+/* Variant with already known shape types, used by Composition which stores
+   the types next to the shapes to avoid virtual type() calls */
+template<UnsignedInt dimensions> bool collides(typename ShapeDimensionTraits<dimensions>::Type aType, const AbstractShape<dimensions>& a, typename ShapeDimensionTraits<dimensions>::Type bType, const AbstractShape<dimensions>& b);
+
 }}}
 
 #endif
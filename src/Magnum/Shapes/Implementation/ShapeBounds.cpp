@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShapeBounds.h"
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/TriangleMesh.h"
+#include "Magnum/Shapes/shapeImplementation.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+namespace {
+
+/* Shapes common for 2D and 3D */
+template<UnsignedInt dimensions> bool commonShapeBounds(const AbstractShape<dimensions>& shape, RangeTypeFor<dimensions, Float>& bounds) {
+    typedef VectorTypeFor<dimensions, Float> VectorType;
+    typedef typename ShapeDimensionTraits<dimensions>::Type Type;
+
+    switch(shape.type()) {
+        case Type::Point: {
+            const VectorType position = static_cast<const Shape<Point<dimensions>>&>(shape).shape.position();
+            bounds = {position, position};
+            return true;
+        }
+
+        case Type::LineSegment: {
+            const LineSegment<dimensions>& s = static_cast<const Shape<LineSegment<dimensions>>&>(shape).shape;
+            bounds = {Math::min(s.a(), s.b()), Math::max(s.a(), s.b())};
+            return true;
+        }
+
+        case Type::Sphere: {
+            const Sphere<dimensions>& s = static_cast<const Shape<Sphere<dimensions>>&>(shape).shape;
+            bounds = {s.position() - VectorType{s.radius()}, s.position() + VectorType{s.radius()}};
+            return true;
+        }
+
+        case Type::Capsule: {
+            const Capsule<dimensions>& s = static_cast<const Shape<Capsule<dimensions>>&>(shape).shape;
+            bounds = {Math::min(s.a(), s.b()) - VectorType{s.radius()}, Math::max(s.a(), s.b()) + VectorType{s.radius()}};
+            return true;
+        }
+
+        /* Negative scaling might swap the corners */
+        case Type::AxisAlignedBox: {
+            const AxisAlignedBox<dimensions>& s = static_cast<const Shape<AxisAlignedBox<dimensions>>&>(shape).shape;
+            bounds = {Math::min(s.min(), s.max()), Math::max(s.min(), s.max())};
+            return true;
+        }
+
+        /* Unit box, the extent along each axis is sum of absolute values of
+           the corresponding row of the rotation/scaling part */
+        case Type::Box: {
+            const MatrixTypeFor<dimensions, Float> transformation = static_cast<const Shape<Box<dimensions>>&>(shape).shape.transformation();
+            VectorType extent;
+            for(std::size_t col = 0; col != dimensions; ++col)
+                for(std::size_t row = 0; row != dimensions; ++row)
+                    extent[row] += Math::abs(transformation[col][row]);
+            const VectorType center = transformation.translation();
+            bounds = {center - extent, center + extent};
+            return true;
+        }
+
+        default: return false;
+    }
+}
+
+}
+
+template<> bool shapeBounds<2>(const AbstractShape<2>& shape, Range2D& bounds) {
+    return commonShapeBounds<2>(shape, bounds);
+}
+
+template<> bool shapeBounds<3>(const AbstractShape<3>& shape, Range3D& bounds) {
+    if(shape.type() != ShapeDimensionTraits<3>::Type::TriangleMesh)
+        return commonShapeBounds<3>(shape, bounds);
+
+    /* Bounds of the triangle data with transformed corners */
+    const TriangleMesh& s = static_cast<const Shape<TriangleMesh>&>(shape).shape;
+    if(!s.data()) {
+        bounds = {s.transformation().translation(), s.transformation().translation()};
+        return true;
+    }
+
+    const Range3D dataBounds = s.data()->bounds();
+    Vector3 min{Constants::inf()}, max{-Constants::inf()};
+    for(UnsignedInt i = 0; i != 8; ++i) {
+        const Vector3 corner = s.transformation().transformPoint({
+            (i & 1 ? dataBounds.max() : dataBounds.min()).x(),
+            (i & 2 ? dataBounds.max() : dataBounds.min()).y(),
+            (i & 4 ? dataBounds.max() : dataBounds.min()).z()});
+        min = Math::min(min, corner);
+        max = Math::max(max, corner);
+    }
+    bounds = {min, max};
+    return true;
+}
+
+}}}
@@ -0,0 +1,55 @@
+#ifndef Magnum_Shapes_Implementation_ShapeBounds_h
+#define Magnum_Shapes_Implementation_ShapeBounds_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shapes/Shapes.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+template<UnsignedInt> struct AbstractShape;
+
+/*
+Axis-aligned bounds of transformed shape, used by ShapeGroup broad phase:
+
+Dispatched on shape type the same way as in CollisionDispatch. Returns false
+if the shape has no finite bounds (lines, planes, cylinders, inverted spheres
+and compositions, which can contain negated subshapes) and thus has to be
+tested against everything else. Triangle mesh without any data has the bounds
+collapsed to its origin.
+*/
+
+template<UnsignedInt dimensions> bool shapeBounds(const AbstractShape<dimensions>& shape, RangeTypeFor<dimensions, Float>& bounds);
+
+/* Whether two bounds overlap, touching counts as overlap */
+template<UnsignedInt dimensions> inline bool boundsOverlap(const RangeTypeFor<dimensions, Float>& a, const RangeTypeFor<dimensions, Float>& b) {
+    return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+}
+
+}}}
+
+#endif
@@ -25,10 +25,61 @@
 
 #include "Shape.h"
 
+#include "Magnum/SceneGraph/AbstractTranslation.h"
+#include "Magnum/SceneGraph/AbstractTranslationRotationScaling2D.h"
+#include "Magnum/SceneGraph/AbstractTranslationRotationScaling3D.h"
+#include "Magnum/Shapes/Capsule.h"
 #include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Sphere.h"
 
 namespace Magnum { namespace Shapes { namespace Implementation {
 
+/* All objects in one scene have the same transformation implementation, so if
+   this object can't be scaled, none of its parents can be either and the
+   absolute transformation is rigid. Integral translations are not detected,
+   they just go through the general path. */
+bool isRigidTransformation(const SceneGraph::AbstractObject2D& object) {
+    return dynamic_cast<const SceneGraph::AbstractTranslation2D*>(&object) &&
+          !dynamic_cast<const SceneGraph::AbstractTranslationRotationScaling2D*>(&object);
+}
+
+bool isRigidTransformation(const SceneGraph::AbstractObject3D& object) {
+    return dynamic_cast<const SceneGraph::AbstractTranslation3D*>(&object) &&
+          !dynamic_cast<const SceneGraph::AbstractTranslationRotationScaling3D*>(&object);
+}
+
+template<UnsignedInt dimensions> Sphere<dimensions> RigidTransformation<Sphere<dimensions>>::transformed(const Sphere<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& matrix) {
+    return Sphere<dimensions>{matrix.transformPoint(shape.position()), shape.radius()};
+}
+
+template<UnsignedInt dimensions> InvertedSphere<dimensions> RigidTransformation<InvertedSphere<dimensions>>::transformed(const InvertedSphere<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& matrix) {
+    return InvertedSphere<dimensions>{matrix.transformPoint(shape.position()), shape.radius()};
+}
+
+template<UnsignedInt dimensions> Capsule<dimensions> RigidTransformation<Capsule<dimensions>>::transformed(const Capsule<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& matrix) {
+    return Capsule<dimensions>{matrix.transformPoint(shape.a()), matrix.transformPoint(shape.b()), shape.radius()};
+}
+
+template<UnsignedInt dimensions> Cylinder<dimensions> RigidTransformation<Cylinder<dimensions>>::transformed(const Cylinder<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& matrix) {
+    return Cylinder<dimensions>{matrix.transformPoint(shape.a()), matrix.transformPoint(shape.b()), shape.radius()};
+}
+
+Plane RigidTransformation<Plane>::transformed(const Plane& shape, const Matrix4& matrix) {
+    /* The rotation part is orthonormal, so the normal stays normalized */
+    return Plane{matrix.transformPoint(shape.position()), matrix.transformVector(shape.normal())};
+}
+
+template struct MAGNUM_SHAPES_EXPORT RigidTransformation<Sphere<2>>;
+template struct MAGNUM_SHAPES_EXPORT RigidTransformation<Sphere<3>>;
+template struct MAGNUM_SHAPES_EXPORT RigidTransformation<InvertedSphere<2>>;
+template struct MAGNUM_SHAPES_EXPORT RigidTransformation<InvertedSphere<3>>;
+template struct MAGNUM_SHAPES_EXPORT RigidTransformation<Capsule<2>>;
+template struct MAGNUM_SHAPES_EXPORT RigidTransformation<Capsule<3>>;
+template struct MAGNUM_SHAPES_EXPORT RigidTransformation<Cylinder<2>>;
+template struct MAGNUM_SHAPES_EXPORT RigidTransformation<Cylinder<3>>;
+
 template<UnsignedInt dimensions> void ShapeHelper<Composition<dimensions>>::set(Shapes::Shape<Composition<dimensions>>& shape, const Composition<dimensions>& composition) {
     shape._transformedShape.shape = shape._shape.shape = composition;
 }
@@ -37,10 +88,10 @@ template<UnsignedInt dimensions> void ShapeHelper<Composition<dimensions>>::set(
     shape._transformedShape.shape = shape._shape.shape = std::move(composition);
 }
 
-template<UnsignedInt dimensions> void ShapeHelper<Composition<dimensions>>::transform(Shapes::Shape<Composition<dimensions>>& shape, const MatrixTypeFor<dimensions, Float>& absoluteTransformationMatrix) {
-    CORRADE_INTERNAL_ASSERT(shape._shape.shape.size() == shape._transformedShape.shape.size());
-    for(std::size_t i = 0; i != shape.shape().size(); ++i)
-        shape._shape.shape._shapes[i]->transform(absoluteTransformationMatrix, shape._transformedShape.shape._shapes[i]);
+template<UnsignedInt dimensions> void ShapeHelper<Composition<dimensions>>::transform(const Shapes::Shape<Composition<dimensions>>& shape, const MatrixTypeFor<dimensions, Float>& absoluteTransformationMatrix, bool) {
+    /* The shapes inside are transformed through the type-erased dispatch,
+       which has only the general path */
+    shape._shape.shape.transformShapes(absoluteTransformationMatrix, shape._transformedShape.shape);
 }
 
 template struct MAGNUM_SHAPES_EXPORT ShapeHelper<Composition<2>>;
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Shapes::Shape
  */
 
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Shapes/AbstractShape.h"
 #include "Magnum/Shapes/Shapes.h"
 #include "Magnum/Shapes/visibility.h"
@@ -37,6 +39,9 @@ namespace Magnum { namespace Shapes {
 
 namespace Implementation {
     template<class> struct ShapeHelper;
+
+    MAGNUM_SHAPES_EXPORT bool isRigidTransformation(const SceneGraph::AbstractObject2D& object);
+    MAGNUM_SHAPES_EXPORT bool isRigidTransformation(const SceneGraph::AbstractObject3D& object);
 }
 
 /**
@@ -63,6 +68,29 @@ auto shape = new Shapes::Shape<Shapes::Sphere3D>(object, {{}, 0.75f}, &shapes);
 Shapes::AbstractShape3D* firstCollision = shapes.firstCollision(shape);
 @endcode
 
+@anchor Shapes-Shape-lazy-transformation
+## Lazy transformation
+
+When the object is cleaned, the shape only remembers its absolute
+transformation matrix. The shape itself is transformed on first access using
+@ref transformedShape(), @ref collides() or @ref collision() (or by any
+@ref ShapeGroup query) and the result is cached until the object is marked
+dirty again. Shapes of objects which are cleaned only for rendering and aren't
+queried for collisions thus don't pay for the transformation at all.
+
+If the object uses a transformation which can't scale (i.e. it implements
+@ref SceneGraph::AbstractTranslation but not
+@ref SceneGraph::AbstractTranslationRotationScaling2D "SceneGraph::AbstractTranslationRotationScaling*D",
+such as @ref SceneGraph::RigidMatrixTransformation3D or
+@ref SceneGraph::DualQuaternionTransformation), spheres, capsules, cylinders
+and planes are transformed without extracting the scaling from the matrix.
+
+@attention The first access transforms the shape in place and is thus not
+    thread-safe. @ref ShapeGroup transforms all dirty shapes in the group
+    before computing bounds, so the chunked queries described in
+    @ref Shapes-ShapeGroup-parallel "ShapeGroup documentation" are not
+    affected.
+
 @see @ref scenegraph, @ref ShapeGroup2D, @ref ShapeGroup3D,
     @ref DebugTools::ShapeRenderer
 */
@@ -76,17 +104,17 @@ template<class T> class Shape: public AbstractShape<T::Dimensions> {
          * @param shape     Shape
          * @param group     Group this shape belongs to
          */
-        explicit Shape(SceneGraph::AbstractObject<T::Dimensions, Float>& object, const T& shape, ShapeGroup<T::Dimensions>* group = nullptr): AbstractShape<T::Dimensions>(object, group) {
+        explicit Shape(SceneGraph::AbstractObject<T::Dimensions, Float>& object, const T& shape, ShapeGroup<T::Dimensions>* group = nullptr): Shape<T>{object, group} {
             Implementation::ShapeHelper<T>::set(*this, shape);
         }
 
         /** @overload */
-        explicit Shape(SceneGraph::AbstractObject<T::Dimensions, Float>& object, T&& shape, ShapeGroup<T::Dimensions>* group = nullptr): AbstractShape<T::Dimensions>(object, group) {
+        explicit Shape(SceneGraph::AbstractObject<T::Dimensions, Float>& object, T&& shape, ShapeGroup<T::Dimensions>* group = nullptr): Shape<T>{object, group} {
             Implementation::ShapeHelper<T>::set(*this, std::move(shape));
         }
 
         /** @overload */
-        explicit Shape(SceneGraph::AbstractObject<T::Dimensions, Float>& object, ShapeGroup<T::Dimensions>* group = nullptr): AbstractShape<T::Dimensions>(object, group) {}
+        explicit Shape(SceneGraph::AbstractObject<T::Dimensions, Float>& object, ShapeGroup<T::Dimensions>* group = nullptr): AbstractShape<T::Dimensions>(object, group), _rigid{Implementation::isRigidTransformation(object)}, _transformationDirty{false} {}
 
         /** @brief Shape */
         const T& shape() const { return _shape.shape; }
@@ -102,20 +130,33 @@ template<class T> class Shape: public AbstractShape<T::Dimensions> {
         /**
          * @brief Transformed shape
          *
-         * Cleans the feature before returning the shape.
+         * Cleans the feature and applies the transformation to the shape,
+         * if not already, before returning it. See
+         * @ref Shapes-Shape-lazy-transformation "class documentation" for
+         * more information.
          */
         const T& transformedShape();
 
     protected:
-        /** Applies transformation to associated shape. */
+        /**
+         * Saves the transformation, it is applied to associated shape on
+         * first access.
+         */
         void clean(const MatrixTypeFor<T::Dimensions, Float>& absoluteTransformationMatrix) override;
 
     private:
         const Implementation::AbstractShape<T::Dimensions>& abstractTransformedShape() const override {
+            if(_transformationDirty) transform();
             return _transformedShape;
         }
 
-        Implementation::Shape<T> _shape, _transformedShape;
+        void transform() const;
+
+        Implementation::Shape<T> _shape;
+        mutable Implementation::Shape<T> _transformedShape;
+        MatrixTypeFor<T::Dimensions, Float> _transformation;
+        bool _rigid;
+        mutable bool _transformationDirty;
 };
 
 template<class T> inline Shape<T>& Shape<T>::setShape(const T& shape) {
@@ -126,21 +167,55 @@ template<class T> inline Shape<T>& Shape<T>::setShape(const T& shape) {
 
 template<class T> inline const T& Shape<T>::transformedShape() {
     this->object().setClean();
+    if(_transformationDirty) transform();
     return _transformedShape.shape;
 }
 
 template<class T> void Shape<T>::clean(const MatrixTypeFor<T::Dimensions, Float>& absoluteTransformationMatrix) {
-    Implementation::ShapeHelper<T>::transform(*this, absoluteTransformationMatrix);
+    _transformation = absoluteTransformationMatrix;
+    _transformationDirty = true;
+}
+
+template<class T> void Shape<T>::transform() const {
+    Implementation::ShapeHelper<T>::transform(*this, _transformation, _rigid);
+    _transformationDirty = false;
 }
 
 namespace Implementation {
+    /* Transformation of shapes with transformation that doesn't scale. By
+       default the same as the general one, specialized for shapes which would
+       otherwise need to extract the scaling from the matrix. */
+    template<class T> struct RigidTransformation {
+        static T transformed(const T& shape, const MatrixTypeFor<T::Dimensions, Float>& matrix) {
+            return shape.transformed(matrix);
+        }
+    };
+
+    template<UnsignedInt dimensions> struct MAGNUM_SHAPES_EXPORT RigidTransformation<Sphere<dimensions>> {
+        static Sphere<dimensions> transformed(const Sphere<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& matrix);
+    };
+    template<UnsignedInt dimensions> struct MAGNUM_SHAPES_EXPORT RigidTransformation<InvertedSphere<dimensions>> {
+        static InvertedSphere<dimensions> transformed(const InvertedSphere<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& matrix);
+    };
+    template<UnsignedInt dimensions> struct MAGNUM_SHAPES_EXPORT RigidTransformation<Capsule<dimensions>> {
+        static Capsule<dimensions> transformed(const Capsule<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& matrix);
+    };
+    template<UnsignedInt dimensions> struct MAGNUM_SHAPES_EXPORT RigidTransformation<Cylinder<dimensions>> {
+        static Cylinder<dimensions> transformed(const Cylinder<dimensions>& shape, const MatrixTypeFor<dimensions, Float>& matrix);
+    };
+    template<> struct MAGNUM_SHAPES_EXPORT RigidTransformation<Plane> {
+        static Plane transformed(const Plane& shape, const Matrix4& matrix);
+    };
+
     template<class T> struct ShapeHelper {
         static void set(Shapes::Shape<T>& shape, const T& s) {
             shape._shape.shape = s;
         }
 
-        static void transform(Shapes::Shape<T>& shape, const MatrixTypeFor<T::Dimensions, Float>& absoluteTransformationMatrix) {
-            shape._transformedShape.shape = shape._shape.shape.transformed(absoluteTransformationMatrix);
+        static void transform(const Shapes::Shape<T>& shape, const MatrixTypeFor<T::Dimensions, Float>& absoluteTransformationMatrix, bool rigid) {
+            shape._transformedShape.shape = rigid ?
+                RigidTransformation<T>::transformed(shape._shape.shape, absoluteTransformationMatrix) :
+                shape._shape.shape.transformed(absoluteTransformationMatrix);
         }
     };
 
@@ -148,7 +223,7 @@ namespace Implementation {
         static void set(Shapes::Shape<Composition<dimensions>>& shape, const Composition<dimensions>& composition);
         static void set(Shapes::Shape<Composition<dimensions>>& shape, Composition<dimensions>&& composition);
 
-        static void transform(Shapes::Shape<Composition<dimensions>>& shape, const MatrixTypeFor<dimensions, Float>& absoluteTransformationMatrix);
+        static void transform(const Shapes::Shape<Composition<dimensions>>& shape, const MatrixTypeFor<dimensions, Float>& absoluteTransformationMatrix, bool rigid);
     };
 }
 
@@ -0,0 +1,446 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShapeBatch.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes {
+
+/*
+Batch implementation notes:
+
+Each component of the shapes is stored in a separate array, the collision
+kernels below then go through the arrays with plain loops of floating-point
+operations without any branches, which the compiler is able to vectorize. The
+kernels process the batch in blocks of BlockSize shapes, first writing one
+byte per shape into a small buffer on stack and then packing the bytes into
+the output mask or pair list. This keeps the vectorized part free of any bit
+manipulation and the functions free of any allocations.
+*/
+
+namespace {
+
+constexpr std::size_t BlockSize = 256;
+
+/* Packing and unpacking of particular shapes */
+
+template<UnsignedInt dimensions> void pack(const Point<dimensions>& shape, std::vector<Float>* const components, const std::size_t i) {
+    for(std::size_t j = 0; j != dimensions; ++j)
+        components[j][i] = shape.position()[j];
+}
+
+template<UnsignedInt dimensions> void unpack(Point<dimensions>& shape, const std::vector<Float>* const components, const std::size_t i) {
+    VectorTypeFor<dimensions, Float> position;
+    for(std::size_t j = 0; j != dimensions; ++j)
+        position[j] = components[j][i];
+    shape.setPosition(position);
+}
+
+template<UnsignedInt dimensions> void pack(const Sphere<dimensions>& shape, std::vector<Float>* const components, const std::size_t i) {
+    for(std::size_t j = 0; j != dimensions; ++j)
+        components[j][i] = shape.position()[j];
+    components[dimensions][i] = shape.radius();
+}
+
+template<UnsignedInt dimensions> void unpack(Sphere<dimensions>& shape, const std::vector<Float>* const components, const std::size_t i) {
+    VectorTypeFor<dimensions, Float> position;
+    for(std::size_t j = 0; j != dimensions; ++j)
+        position[j] = components[j][i];
+    shape.setPosition(position);
+    shape.setRadius(components[dimensions][i]);
+}
+
+template<UnsignedInt dimensions> void pack(const AxisAlignedBox<dimensions>& shape, std::vector<Float>* const components, const std::size_t i) {
+    for(std::size_t j = 0; j != dimensions; ++j) {
+        components[j][i] = shape.min()[j];
+        components[dimensions + j][i] = shape.max()[j];
+    }
+}
+
+template<UnsignedInt dimensions> void unpack(AxisAlignedBox<dimensions>& shape, const std::vector<Float>* const components, const std::size_t i) {
+    VectorTypeFor<dimensions, Float> min, max;
+    for(std::size_t j = 0; j != dimensions; ++j) {
+        min[j] = components[j][i];
+        max[j] = components[dimensions + j][i];
+    }
+    shape.setMin(min);
+    shape.setMax(max);
+}
+
+/* Center, then normalized axes (axis after axis), then half extents */
+template<UnsignedInt dimensions> void pack(const Box<dimensions>& shape, std::vector<Float>* const components, const std::size_t i) {
+    const MatrixTypeFor<dimensions, Float> transformation = shape.transformation();
+    for(std::size_t j = 0; j != dimensions; ++j) {
+        components[j][i] = transformation.translation()[j];
+
+        Math::Vector<dimensions, Float> axis;
+        for(std::size_t k = 0; k != dimensions; ++k)
+            axis[k] = transformation[j][k];
+        const Float extent = axis.length();
+        if(extent != 0.0f) axis /= extent;
+        for(std::size_t k = 0; k != dimensions; ++k)
+            components[dimensions + j*dimensions + k][i] = axis[k];
+        components[dimensions + dimensions*dimensions + j][i] = extent;
+    }
+}
+
+template<UnsignedInt dimensions> void unpack(Box<dimensions>& shape, const std::vector<Float>* const components, const std::size_t i) {
+    MatrixTypeFor<dimensions, Float> transformation;
+    for(std::size_t j = 0; j != dimensions; ++j) {
+        transformation[dimensions][j] = components[j][i];
+        for(std::size_t k = 0; k != dimensions; ++k)
+            transformation[j][k] = components[dimensions + j*dimensions + k][i]*components[dimensions + dimensions*dimensions + j][i];
+    }
+    shape.setTransformation(transformation);
+}
+
+template<UnsignedInt dimensions> void pack(const Capsule<dimensions>& shape, std::vector<Float>* const components, const std::size_t i) {
+    for(std::size_t j = 0; j != dimensions; ++j) {
+        components[j][i] = shape.a()[j];
+        components[dimensions + j][i] = shape.b()[j];
+    }
+    components[2*dimensions][i] = shape.radius();
+}
+
+template<UnsignedInt dimensions> void unpack(Capsule<dimensions>& shape, const std::vector<Float>* const components, const std::size_t i) {
+    VectorTypeFor<dimensions, Float> a, b;
+    for(std::size_t j = 0; j != dimensions; ++j) {
+        a[j] = components[j][i];
+        b[j] = components[dimensions + j][i];
+    }
+    shape.setA(a);
+    shape.setB(b);
+    shape.setRadius(components[2*dimensions][i]);
+}
+
+/* Collision kernels. Each writes 1 to `hits` for each colliding shape in
+   [begin, end) of the batch and 0 otherwise. */
+
+template<UnsignedInt dimensions> struct PointsSphere {
+    typedef Point<dimensions> BatchType;
+    typedef Sphere<dimensions> ShapeType;
+
+    static void run(const ShapeBatch<BatchType>& batch, const std::size_t begin, const std::size_t end, const ShapeType& sphere, UnsignedByte* const hits) {
+        const Float radiusSquared = Math::pow<2>(sphere.radius());
+        const Float* p[dimensions];
+        for(std::size_t j = 0; j != dimensions; ++j)
+            p[j] = batch.component(j);
+
+        for(std::size_t i = begin; i != end; ++i) {
+            Float distanceSquared = 0.0f;
+            for(std::size_t j = 0; j != dimensions; ++j)
+                distanceSquared += Math::pow<2>(p[j][i] - sphere.position()[j]);
+            hits[i - begin] = distanceSquared < radiusSquared;
+        }
+    }
+};
+
+template<UnsignedInt dimensions> struct SpheresPoint {
+    typedef Sphere<dimensions> BatchType;
+    typedef Point<dimensions> ShapeType;
+
+    static void run(const ShapeBatch<BatchType>& batch, const std::size_t begin, const std::size_t end, const ShapeType& point, UnsignedByte* const hits) {
+        const Float* p[dimensions];
+        for(std::size_t j = 0; j != dimensions; ++j)
+            p[j] = batch.component(j);
+        const Float* const r = batch.component(dimensions);
+
+        for(std::size_t i = begin; i != end; ++i) {
+            Float distanceSquared = 0.0f;
+            for(std::size_t j = 0; j != dimensions; ++j)
+                distanceSquared += Math::pow<2>(p[j][i] - point.position()[j]);
+            hits[i - begin] = distanceSquared < r[i]*r[i];
+        }
+    }
+};
+
+template<UnsignedInt dimensions> struct SpheresSphere {
+    typedef Sphere<dimensions> BatchType;
+    typedef Sphere<dimensions> ShapeType;
+
+    static void run(const ShapeBatch<BatchType>& batch, const std::size_t begin, const std::size_t end, const ShapeType& sphere, UnsignedByte* const hits) {
+        const Float* p[dimensions];
+        for(std::size_t j = 0; j != dimensions; ++j)
+            p[j] = batch.component(j);
+        const Float* const r = batch.component(dimensions);
+
+        for(std::size_t i = begin; i != end; ++i) {
+            Float distanceSquared = 0.0f;
+            for(std::size_t j = 0; j != dimensions; ++j)
+                distanceSquared += Math::pow<2>(p[j][i] - sphere.position()[j]);
+            hits[i - begin] = distanceSquared < Math::pow<2>(r[i] + sphere.radius());
+        }
+    }
+};
+
+template<UnsignedInt dimensions> struct AxisAlignedBoxesSphere {
+    typedef AxisAlignedBox<dimensions> BatchType;
+    typedef Sphere<dimensions> ShapeType;
+
+    static void run(const ShapeBatch<BatchType>& batch, const std::size_t begin, const std::size_t end, const ShapeType& sphere, UnsignedByte* const hits) {
+        const Float radiusSquared = Math::pow<2>(sphere.radius());
+        const Float* min[dimensions];
+        const Float* max[dimensions];
+        for(std::size_t j = 0; j != dimensions; ++j) {
+            min[j] = batch.component(j);
+            max[j] = batch.component(dimensions + j);
+        }
+
+        /* Distance of the sphere center from the box */
+        for(std::size_t i = begin; i != end; ++i) {
+            Float distanceSquared = 0.0f;
+            for(std::size_t j = 0; j != dimensions; ++j) {
+                const Float c = sphere.position()[j];
+                distanceSquared += Math::pow<2>(Math::max(Math::max(min[j][i] - c, c - max[j][i]), 0.0f));
+            }
+            hits[i - begin] = distanceSquared < radiusSquared;
+        }
+    }
+};
+
+template<UnsignedInt dimensions> struct BoxesSphere {
+    typedef Box<dimensions> BatchType;
+    typedef Sphere<dimensions> ShapeType;
+
+    static void run(const ShapeBatch<BatchType>& batch, const std::size_t begin, const std::size_t end, const ShapeType& sphere, UnsignedByte* const hits) {
+        const Float radiusSquared = Math::pow<2>(sphere.radius());
+        const Float* center[dimensions];
+        const Float* axes[dimensions*dimensions];
+        const Float* extent[dimensions];
+        for(std::size_t j = 0; j != dimensions; ++j) {
+            center[j] = batch.component(j);
+            extent[j] = batch.component(dimensions + dimensions*dimensions + j);
+        }
+        for(std::size_t j = 0; j != dimensions*dimensions; ++j)
+            axes[j] = batch.component(dimensions + j);
+
+        /* Project the sphere center relative to box center onto box axes,
+           the distance along each axis is what's outside of the extent */
+        for(std::size_t i = begin; i != end; ++i) {
+            Float d[dimensions];
+            for(std::size_t j = 0; j != dimensions; ++j)
+                d[j] = sphere.position()[j] - center[j][i];
+
+            Float distanceSquared = 0.0f;
+            for(std::size_t j = 0; j != dimensions; ++j) {
+                Float projected = 0.0f;
+                for(std::size_t k = 0; k != dimensions; ++k)
+                    projected += d[k]*axes[j*dimensions + k][i];
+                distanceSquared += Math::pow<2>(Math::max(Math::abs(projected) - extent[j][i], 0.0f));
+            }
+            hits[i - begin] = distanceSquared < radiusSquared;
+        }
+    }
+};
+
+template<UnsignedInt dimensions> struct CapsulesSphere {
+    typedef Capsule<dimensions> BatchType;
+    typedef Sphere<dimensions> ShapeType;
+
+    static void run(const ShapeBatch<BatchType>& batch, const std::size_t begin, const std::size_t end, const ShapeType& sphere, UnsignedByte* const hits) {
+        const Float* a[dimensions];
+        const Float* b[dimensions];
+        for(std::size_t j = 0; j != dimensions; ++j) {
+            a[j] = batch.component(j);
+            b[j] = batch.component(dimensions + j);
+        }
+        const Float* const r = batch.component(2*dimensions);
+
+        /* Distance of the sphere center from the closest point on the
+           capsule segment */
+        for(std::size_t i = begin; i != end; ++i) {
+            Float ab[dimensions], ac[dimensions];
+            Float abDot = 0.0f, acAbDot = 0.0f;
+            for(std::size_t j = 0; j != dimensions; ++j) {
+                ab[j] = b[j][i] - a[j][i];
+                ac[j] = sphere.position()[j] - a[j][i];
+                abDot += ab[j]*ab[j];
+                acAbDot += ac[j]*ab[j];
+            }
+
+            const Float t = Math::clamp(acAbDot/Math::max(abDot, Math::TypeTraits<Float>::epsilon()), 0.0f, 1.0f);
+            Float distanceSquared = 0.0f;
+            for(std::size_t j = 0; j != dimensions; ++j)
+                distanceSquared += Math::pow<2>(ac[j] - t*ab[j]);
+            hits[i - begin] = distanceSquared < Math::pow<2>(r[i] + sphere.radius());
+        }
+    }
+};
+
+template<class Kernel> void collidesMask(const ShapeBatch<typename Kernel::BatchType>& batch, const typename Kernel::ShapeType& shape, const Containers::ArrayView<UnsignedByte> mask) {
+    CORRADE_ASSERT(mask.size() >= (batch.size() + 7)/8,
+        "Shapes::collides(): expected mask of at least" << (batch.size() + 7)/8 << "bytes but got" << mask.size(), );
+
+    UnsignedByte hits[BlockSize];
+    for(std::size_t begin = 0; begin < batch.size(); begin += BlockSize) {
+        const std::size_t end = Math::min(begin + BlockSize, batch.size());
+        Kernel::run(batch, begin, end, shape, hits);
+
+        for(std::size_t i = 0; i < end - begin; i += 8) {
+            UnsignedByte byte = 0;
+            for(std::size_t j = 0; j != 8 && i + j != end - begin; ++j)
+                byte |= hits[i + j] << j;
+            mask[(begin + i)/8] = byte;
+        }
+    }
+}
+
+template<class Kernel> void collidingPairsImplementation(const ShapeBatch<typename Kernel::BatchType>& a, const ShapeBatch<typename Kernel::ShapeType>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) {
+    UnsignedByte hits[BlockSize];
+    for(std::size_t j = 0; j != b.size(); ++j) {
+        const typename Kernel::ShapeType shape = b[j];
+        for(std::size_t begin = 0; begin < a.size(); begin += BlockSize) {
+            const std::size_t end = Math::min(begin + BlockSize, a.size());
+            Kernel::run(a, begin, end, shape, hits);
+
+            for(std::size_t i = 0; i != end - begin; ++i)
+                if(hits[i]) out.emplace_back(begin + i, j);
+        }
+    }
+}
+
+}
+
+template<class T> void ShapeBatch<T>::reserve(const std::size_t capacity) {
+    for(std::vector<Float>& component: _components)
+        component.reserve(capacity);
+}
+
+template<class T> ShapeBatch<T>& ShapeBatch<T>::add(const T& shape) {
+    /* Grow only if the memory isn't there from previous use already */
+    if(_components[0].size() == _size)
+        for(std::vector<Float>& component: _components)
+            component.emplace_back();
+
+    pack(shape, _components, _size++);
+    return *this;
+}
+
+template<class T> void ShapeBatch<T>::set(const std::size_t i, const T& shape) {
+    CORRADE_ASSERT(i < _size, "Shapes::ShapeBatch::set(): index" << i << "out of range for" << _size << "shapes", );
+    pack(shape, _components, i);
+}
+
+template<class T> T ShapeBatch<T>::operator[](const std::size_t i) const {
+    CORRADE_ASSERT(i < _size, "Shapes::ShapeBatch::operator[](): index" << i << "out of range for" << _size << "shapes", {});
+    T shape;
+    unpack(shape, _components, i);
+    return shape;
+}
+
+template<class T> const Float* ShapeBatch<T>::component(const std::size_t i) const {
+    CORRADE_ASSERT(i < ComponentCount, "Shapes::ShapeBatch::component(): index" << i << "out of range for" << ComponentCount << "components", nullptr);
+    return _components[i].data();
+}
+
+template<UnsignedInt dimensions> void collides(const ShapeBatch<Point<dimensions>>& a, const Sphere<dimensions>& sphere, const Containers::ArrayView<UnsignedByte> mask) {
+    collidesMask<PointsSphere<dimensions>>(a, sphere, mask);
+}
+
+template<UnsignedInt dimensions> void collides(const ShapeBatch<Sphere<dimensions>>& a, const Point<dimensions>& point, const Containers::ArrayView<UnsignedByte> mask) {
+    collidesMask<SpheresPoint<dimensions>>(a, point, mask);
+}
+
+template<UnsignedInt dimensions> void collides(const ShapeBatch<Sphere<dimensions>>& a, const Sphere<dimensions>& sphere, const Containers::ArrayView<UnsignedByte> mask) {
+    collidesMask<SpheresSphere<dimensions>>(a, sphere, mask);
+}
+
+template<UnsignedInt dimensions> void collides(const ShapeBatch<AxisAlignedBox<dimensions>>& a, const Sphere<dimensions>& sphere, const Containers::ArrayView<UnsignedByte> mask) {
+    collidesMask<AxisAlignedBoxesSphere<dimensions>>(a, sphere, mask);
+}
+
+template<UnsignedInt dimensions> void collides(const ShapeBatch<Box<dimensions>>& a, const Sphere<dimensions>& sphere, const Containers::ArrayView<UnsignedByte> mask) {
+    collidesMask<BoxesSphere<dimensions>>(a, sphere, mask);
+}
+
+template<UnsignedInt dimensions> void collides(const ShapeBatch<Capsule<dimensions>>& a, const Sphere<dimensions>& sphere, const Containers::ArrayView<UnsignedByte> mask) {
+    collidesMask<CapsulesSphere<dimensions>>(a, sphere, mask);
+}
+
+template<UnsignedInt dimensions> void collidingPairs(const ShapeBatch<Point<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) {
+    collidingPairsImplementation<PointsSphere<dimensions>>(a, b, out);
+}
+
+template<UnsignedInt dimensions> void collidingPairs(const ShapeBatch<Sphere<dimensions>>& a, const ShapeBatch<Point<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) {
+    collidingPairsImplementation<SpheresPoint<dimensions>>(a, b, out);
+}
+
+template<UnsignedInt dimensions> void collidingPairs(const ShapeBatch<Sphere<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) {
+    collidingPairsImplementation<SpheresSphere<dimensions>>(a, b, out);
+}
+
+template<UnsignedInt dimensions> void collidingPairs(const ShapeBatch<AxisAlignedBox<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) {
+    collidingPairsImplementation<AxisAlignedBoxesSphere<dimensions>>(a, b, out);
+}
+
+template<UnsignedInt dimensions> void collidingPairs(const ShapeBatch<Box<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) {
+    collidingPairsImplementation<BoxesSphere<dimensions>>(a, b, out);
+}
+
+template<UnsignedInt dimensions> void collidingPairs(const ShapeBatch<Capsule<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) {
+    collidingPairsImplementation<CapsulesSphere<dimensions>>(a, b, out);
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<Point2D>;
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<Point3D>;
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<Sphere2D>;
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<Sphere3D>;
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<AxisAlignedBox2D>;
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<AxisAlignedBox3D>;
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<Box2D>;
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<Box3D>;
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<Capsule2D>;
+template class MAGNUM_SHAPES_EXPORT ShapeBatch<Capsule3D>;
+
+#define _c(dimensions) \
+    template MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Point<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>); \
+    template MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Sphere<dimensions>>&, const Point<dimensions>&, Containers::ArrayView<UnsignedByte>); \
+    template MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Sphere<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>); \
+    template MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<AxisAlignedBox<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>); \
+    template MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Box<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>); \
+    template MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Capsule<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>); \
+    template MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Point<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&); \
+    template MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Sphere<dimensions>>&, const ShapeBatch<Point<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&); \
+    template MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Sphere<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&); \
+    template MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<AxisAlignedBox<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&); \
+    template MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Box<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&); \
+    template MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Capsule<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&);
+_c(2)
+_c(3)
+#undef _c
+#endif
+
+}}
@@ -0,0 +1,301 @@
+#ifndef Magnum_Shapes_ShapeBatch_h
+#define Magnum_Shapes_ShapeBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::ShapeBatch, typedef @ref Magnum::Shapes::PointBatch2D, @ref Magnum::Shapes::PointBatch3D, @ref Magnum::Shapes::SphereBatch2D, @ref Magnum::Shapes::SphereBatch3D, @ref Magnum::Shapes::AxisAlignedBoxBatch2D, @ref Magnum::Shapes::AxisAlignedBoxBatch3D, @ref Magnum::Shapes::BoxBatch2D, @ref Magnum::Shapes::BoxBatch3D, @ref Magnum::Shapes::CapsuleBatch2D, @ref Magnum::Shapes::CapsuleBatch3D, function @ref Magnum::Shapes::collides(), @ref Magnum::Shapes::collidingPairs()
+ */
+
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+namespace Implementation {
+    template<class> struct ShapeBatchTraits;
+
+    template<UnsignedInt dimensions> struct ShapeBatchTraits<Point<dimensions>> {
+        /* position */
+        enum: std::size_t { ComponentCount = dimensions };
+    };
+    template<UnsignedInt dimensions> struct ShapeBatchTraits<Sphere<dimensions>> {
+        /* position, radius */
+        enum: std::size_t { ComponentCount = dimensions + 1 };
+    };
+    template<UnsignedInt dimensions> struct ShapeBatchTraits<AxisAlignedBox<dimensions>> {
+        /* min, max */
+        enum: std::size_t { ComponentCount = dimensions*2 };
+    };
+    template<UnsignedInt dimensions> struct ShapeBatchTraits<Box<dimensions>> {
+        /* center, normalized axes, half extents along the axes */
+        enum: std::size_t { ComponentCount = dimensions + dimensions*dimensions + dimensions };
+    };
+    template<UnsignedInt dimensions> struct ShapeBatchTraits<Capsule<dimensions>> {
+        /* a, b, radius */
+        enum: std::size_t { ComponentCount = dimensions*2 + 1 };
+    };
+}
+
+/**
+@brief Batch of shapes
+
+Stores many shapes of the same type in a structure-of-arrays layout, i.e.
+each scalar component of the shapes (such as X coordinate of sphere center or
+sphere radius) in a separate contiguous array. This allows the batch
+collision functions such as @ref collides(const ShapeBatch<Point<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>)
+to process many shapes at once using SIMD instructions, instead of testing
+each shape separately through @ref AbstractShape::collides() or the `%`
+operator. Example:
+@code
+Shapes::PointBatch3D projectiles;
+for(const Vector3& position: projectilePositions)
+    projectiles.add(Shapes::Point3D{position});
+
+Containers::Array<UnsignedByte> hits{Containers::ValueInit, (projectiles.size() + 7)/8};
+Shapes::collides(projectiles, Shapes::Sphere3D{target, 0.5f}, hits);
+@endcode
+
+Clearing the batch keeps the allocated memory, so it can be cheaply refilled
+every frame.
+
+Supported shape types are @ref Point, @ref Sphere, @ref AxisAlignedBox,
+@ref Box and @ref Capsule. The box is stored as center, axes and half extents,
+so its transformation is expected to have no skew.
+@see @ref PointBatch2D, @ref PointBatch3D, @ref SphereBatch2D,
+    @ref SphereBatch3D, @ref AxisAlignedBoxBatch2D, @ref AxisAlignedBoxBatch3D,
+    @ref BoxBatch2D, @ref BoxBatch3D, @ref CapsuleBatch2D,
+    @ref CapsuleBatch3D
+*/
+template<class T> class MAGNUM_SHAPES_EXPORT ShapeBatch {
+    public:
+        enum: UnsignedInt {
+            Dimensions = T::Dimensions  /**< Dimension count */
+        };
+
+        enum: std::size_t {
+            /** Count of scalar components of each shape */
+            ComponentCount = Implementation::ShapeBatchTraits<T>::ComponentCount
+        };
+
+        /** @brief Constructor */
+        explicit ShapeBatch(): _size{} {}
+
+        /** @brief Count of shapes in the batch */
+        std::size_t size() const { return _size; }
+
+        /** @brief Whether the batch is empty */
+        bool isEmpty() const { return !_size; }
+
+        /** @brief Reserve memory for given count of shapes */
+        void reserve(std::size_t capacity);
+
+        /**
+         * @brief Clear the batch
+         *
+         * The allocated memory is kept for later reuse.
+         */
+        void clear() { _size = 0; }
+
+        /**
+         * @brief Add shape to the batch
+         * @return Reference to self (for method chaining)
+         */
+        ShapeBatch<T>& add(const T& shape);
+
+        /**
+         * @brief Replace shape at given position
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        void set(std::size_t i, const T& shape);
+
+        /**
+         * @brief Shape at given position
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        T operator[](std::size_t i) const;
+
+        /**
+         * @brief Data of given component
+         *
+         * Contiguous array of @ref size() values. Expects that @p i is less
+         * than @ref ComponentCount.
+         */
+        const Float* component(std::size_t i) const;
+
+    private:
+        std::vector<Float> _components[ComponentCount];
+        std::size_t _size;
+};
+
+/** @brief Batch of two-dimensional points */
+typedef ShapeBatch<Point2D> PointBatch2D;
+
+/** @brief Batch of three-dimensional points */
+typedef ShapeBatch<Point3D> PointBatch3D;
+
+/** @brief Batch of two-dimensional spheres */
+typedef ShapeBatch<Sphere2D> SphereBatch2D;
+
+/** @brief Batch of three-dimensional spheres */
+typedef ShapeBatch<Sphere3D> SphereBatch3D;
+
+/** @brief Batch of two-dimensional axis-aligned boxes */
+typedef ShapeBatch<AxisAlignedBox2D> AxisAlignedBoxBatch2D;
+
+/** @brief Batch of three-dimensional axis-aligned boxes */
+typedef ShapeBatch<AxisAlignedBox3D> AxisAlignedBoxBatch3D;
+
+/** @brief Batch of two-dimensional boxes */
+typedef ShapeBatch<Box2D> BoxBatch2D;
+
+/** @brief Batch of three-dimensional boxes */
+typedef ShapeBatch<Box3D> BoxBatch3D;
+
+/** @brief Batch of two-dimensional capsules */
+typedef ShapeBatch<Capsule2D> CapsuleBatch2D;
+
+/** @brief Batch of three-dimensional capsules */
+typedef ShapeBatch<Capsule3D> CapsuleBatch3D;
+
+/**
+@brief Collision of points with a sphere
+
+Sets bit `i` of @p mask if point `i` collides with @p sphere, with the same
+semantics as @ref Sphere::operator%(const Point<dimensions>&) const. Bits
+are ordered from the least significant one, so point `i` corresponds to
+`(mask[i/8] >> (i%8)) & 1`, the same layout as in @ref Math::BoolVector.
+Unused bits in the last byte are set to zero. Expects that @p mask has at
+least `(a.size() + 7)/8` bytes.
+@see @ref collidingPairs()
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Point<dimensions>>& a, const Sphere<dimensions>& sphere, Containers::ArrayView<UnsignedByte> mask);
+
+/**
+@brief Collision of spheres with a point
+
+Same as @ref collides(const ShapeBatch<Point<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>),
+but testing each sphere in the batch against given point.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Sphere<dimensions>>& a, const Point<dimensions>& point, Containers::ArrayView<UnsignedByte> mask);
+
+/**
+@brief Collision of spheres with a sphere
+
+Same as @ref collides(const ShapeBatch<Point<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>),
+but testing each sphere in the batch against given sphere, with the same
+semantics as @ref Sphere::operator%(const Sphere<dimensions>&) const.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Sphere<dimensions>>& a, const Sphere<dimensions>& sphere, Containers::ArrayView<UnsignedByte> mask);
+
+/**
+@brief Collision of axis-aligned boxes with a sphere
+
+Same as @ref collides(const ShapeBatch<Point<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>),
+but testing each box in the batch against given sphere. The box and sphere
+collide if distance of the sphere center from the box is less than sphere
+radius.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<AxisAlignedBox<dimensions>>& a, const Sphere<dimensions>& sphere, Containers::ArrayView<UnsignedByte> mask);
+
+/**
+@brief Collision of boxes with a sphere
+
+Same as @ref collides(const ShapeBatch<AxisAlignedBox<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>),
+but for oriented boxes.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Box<dimensions>>& a, const Sphere<dimensions>& sphere, Containers::ArrayView<UnsignedByte> mask);
+
+/**
+@brief Collision of capsules with a sphere
+
+Same as @ref collides(const ShapeBatch<Point<dimensions>>&, const Sphere<dimensions>&, Containers::ArrayView<UnsignedByte>),
+but testing each capsule in the batch against given sphere, with the same
+semantics as @ref Capsule::operator%(const Sphere<dimensions>&) const.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const ShapeBatch<Capsule<dimensions>>& a, const Sphere<dimensions>& sphere, Containers::ArrayView<UnsignedByte> mask);
+
+/**
+@brief Colliding pairs of points and spheres
+
+Tests all points against all spheres and appends index pairs of colliding
+shapes to @p out, the first index being into @p a and the second into @p b.
+The pairs are ordered by the second index first. The @p out vector isn't
+cleared, so it can be reused between calls without reallocating. Apart from
+growing @p out the function doesn't allocate.
+@see @ref collides(), @ref ShapeGroup::collidingPairs()
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Point<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out);
+
+/**
+@brief Colliding pairs of spheres and points
+
+See @ref collidingPairs(const ShapeBatch<Point<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&)
+for more information.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Sphere<dimensions>>& a, const ShapeBatch<Point<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out);
+
+/**
+@brief Colliding pairs of spheres and spheres
+
+See @ref collidingPairs(const ShapeBatch<Point<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&)
+for more information.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Sphere<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out);
+
+/**
+@brief Colliding pairs of axis-aligned boxes and spheres
+
+See @ref collidingPairs(const ShapeBatch<Point<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&)
+for more information.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<AxisAlignedBox<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out);
+
+/**
+@brief Colliding pairs of boxes and spheres
+
+See @ref collidingPairs(const ShapeBatch<Point<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&)
+for more information.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Box<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out);
+
+/**
+@brief Colliding pairs of capsules and spheres
+
+See @ref collidingPairs(const ShapeBatch<Point<dimensions>>&, const ShapeBatch<Sphere<dimensions>>&, std::vector<std::pair<UnsignedInt, UnsignedInt>>&)
+for more information.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collidingPairs(const ShapeBatch<Capsule<dimensions>>& a, const ShapeBatch<Sphere<dimensions>>& b, std::vector<std::pair<UnsignedInt, UnsignedInt>>& out);
+
+}}
+
+#endif
@@ -25,33 +25,609 @@
 
 #include "ShapeGroup.h"
 
+#include <algorithm>
+#include <limits>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Shapes/AbstractShape.h"
+#include "Magnum/Shapes/Implementation/ShapeBounds.h"
 
 namespace Magnum { namespace Shapes {
 
-template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
-    /* Clean all objects */
-    if(!this->isEmpty()) {
-        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
-        objects.reserve(this->size());
-        for(std::size_t i = 0; i != this->size(); ++i)
-            objects.push_back((*this)[i].object());
+namespace {
+    /* Shapes spanning more grid cells than this are tested against everything
+       instead of being inserted into the grid */
+    constexpr UnsignedInt MaxGridCellsPerShape = 64;
+
+    /* Cell coordinates outside of this range are treated the same as shapes
+       spanning too many cells to avoid integer overflow */
+    constexpr Float MaxGridCellCoordinate = 1.0e9f;
+
+    template<UnsignedInt dimensions> UnsignedInt gridCellHash(const Math::Vector<dimensions, Int>& cell) {
+        constexpr UnsignedInt primes[]{73856093u, 19349663u, 83492791u};
+        UnsignedInt hash = 0;
+        for(std::size_t i = 0; i != dimensions; ++i)
+            hash ^= UnsignedInt(cell[i])*primes[i];
+        return hash;
+    }
+}
+
+template<UnsignedInt dimensions> struct ShapeGroup<dimensions>::ContactCache {
+    struct CachedContact {
+        UnsignedInt a, b;
+        Collision<dimensions> collision;
+    };
+
+    void sort(const std::vector<RangeTypeFor<dimensions, Float>>& bounds);
+    void resort(const std::vector<RangeTypeFor<dimensions, Float>>& bounds);
+
+    /* Contacts from the last update, sorted by shape indices, and shapes at
+       these indices. The shapes are used only to report ended contacts of
+       shapes that were removed from the group and thus might not exist
+       anymore. */
+    std::vector<CachedContact> contacts, nextContacts;
+    std::vector<AbstractShape<dimensions>*> shapes;
+
+    /* Bounded shapes sorted by interval start along the sweep axis, position
+       of each shape in the sweep (or ~0 for unbounded shapes), list of
+       unbounded shapes and upper limit for interval length along the axis */
+    std::size_t axis{};
+    std::vector<std::pair<Float, UnsignedInt>> sweep;
+    std::vector<UnsignedInt> rank;
+    std::vector<UnsignedInt> unbounded;
+    Float maxExtent{};
+
+    /* Scratch storage reused between calls */
+    std::vector<UnsignedInt> moved;
+    std::vector<bool> movedMask;
+    std::vector<UnsignedInt> remap;
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> tests;
+    std::vector<CachedContact> hits;
+};
+
+namespace {
+    template<UnsignedInt dimensions> bool boundsFinite(const RangeTypeFor<dimensions, Float>& bounds) {
+        return (Math::abs(bounds.min()) < VectorTypeFor<dimensions, Float>{Constants::inf()}).all() &&
+               (Math::abs(bounds.max()) < VectorTypeFor<dimensions, Float>{Constants::inf()}).all();
+    }
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::ContactCache::sort(const std::vector<RangeTypeFor<dimensions, Float>>& bounds) {
+    /* Pick the axis the same way as in sweepAndPrune() */
+    VectorTypeFor<dimensions, Float> sum, sumSquared;
+    std::size_t count = 0;
+    for(const RangeTypeFor<dimensions, Float>& b: bounds) {
+        if(!boundsFinite<dimensions>(b)) continue;
+        const VectorTypeFor<dimensions, Float> center = b.center();
+        sum += center;
+        sumSquared += center*center;
+        ++count;
+    }
+    axis = 0;
+    if(count) {
+        const VectorTypeFor<dimensions, Float> variance = sumSquared/Float(count) - Math::pow<2>(sum/Float(count));
+        for(std::size_t i = 1; i != dimensions; ++i)
+            if(variance[i] > variance[axis]) axis = i;
+    }
+
+    sweep.clear();
+    unbounded.clear();
+    maxExtent = 0.0f;
+    for(UnsignedInt i = 0; i != bounds.size(); ++i) {
+        if(!boundsFinite<dimensions>(bounds[i])) {
+            unbounded.push_back(i);
+            continue;
+        }
 
-        SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+        sweep.emplace_back(bounds[i].min()[axis], i);
+        maxExtent = Math::max(maxExtent, bounds[i].size()[axis]);
     }
+    std::sort(sweep.begin(), sweep.end());
+
+    rank.assign(bounds.size(), ~UnsignedInt{});
+    for(UnsignedInt i = 0; i != sweep.size(); ++i)
+        rank[sweep[i].second] = i;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::ContactCache::resort(const std::vector<RangeTypeFor<dimensions, Float>>& bounds) {
+    /* Update interval starts of the moved shapes. If any shape became
+       unbounded or bounded, the sweep has to be built from scratch. The
+       maximal extent is only ever enlarged here, it's a conservative limit
+       for how far back to look when querying the sweep. */
+    for(const UnsignedInt i: moved) {
+        const bool finite = boundsFinite<dimensions>(bounds[i]);
+        if(finite != (rank[i] != ~UnsignedInt{})) return sort(bounds);
+        if(!finite) continue;
+
+        sweep[rank[i]].first = bounds[i].min()[axis];
+        maxExtent = Math::max(maxExtent, bounds[i].size()[axis]);
+    }
+
+    /* The sweep is almost sorted if only a few shapes moved, in which case
+       insertion sort is the fastest */
+    if(moved.size() > sweep.size()/8)
+        std::sort(sweep.begin(), sweep.end());
+    else for(std::size_t i = 1; i < sweep.size(); ++i) {
+        const std::pair<Float, UnsignedInt> value = sweep[i];
+        std::size_t j = i;
+        for(; j && value < sweep[j - 1]; --j) sweep[j] = sweep[j - 1];
+        sweep[j] = value;
+    }
+
+    for(UnsignedInt i = 0; i != sweep.size(); ++i)
+        rank[sweep[i].second] = i;
+}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>::ShapeGroup(): dirty(true), _broadPhase{BroadPhase::SweepAndPrune}, _gridCellSize{1.0f}, _chunkSize{1024}, _cleanChunkCount{}, _cleanScene{}, _contactCache{new ContactCache}, _contactTestCount{} {}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>::~ShapeGroup() = default;
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
+    cleanObjects();
+    updateBounds();
 
     dirty = false;
 }
 
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::cleanObjects() {
+    if(this->isEmpty()) return;
+
+    _objects.clear();
+    _objects.reserve(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i)
+        _objects.push_back((*this)[i].object());
+
+    SceneGraph::AbstractObject<dimensions, Float>::setClean(_objects);
+}
+
+template<UnsignedInt dimensions> std::size_t ShapeGroup<dimensions>::beginClean() {
+    _cleanChunkCount = 0;
+    _cleanScene = nullptr;
+
+    _objects.clear();
+    _objects.reserve(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        SceneGraph::AbstractObject<dimensions, Float>& object = (*this)[i].object();
+        if(!_cleanScene && object.isDirty()) _cleanScene = object.scene();
+        _objects.push_back(object);
+    }
+
+    /* The chunks are executed on the scene, nothing to do if nothing is
+       dirty. The bounds are updated on next setClean() call, when all shapes
+       are transformed already. */
+    if(_cleanScene) _cleanChunkCount = SceneGraph::AbstractObject<dimensions, Float>::beginClean(_objects);
+
+    return _cleanChunkCount;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::cleanChunk(const std::size_t chunk) {
+    CORRADE_ASSERT(chunk < _cleanChunkCount,
+        "Shapes::ShapeGroup::cleanChunk(): index" << chunk << "out of range for" << _cleanChunkCount << "chunks", );
+    _cleanScene->cleanChunk(chunk);
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::updateBounds() {
+    /* Update bounds for the broad phase, shapes without finite bounds get
+       infinite ones so they overlap with everything */
+    _bounds.resize(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i)
+        if(!Implementation::shapeBounds(Implementation::getAbstractShape((*this)[i]), _bounds[i]))
+            _bounds[i] = {VectorTypeFor<dimensions, Float>{-Constants::inf()}, VectorTypeFor<dimensions, Float>{Constants::inf()}};
+}
+
+template<UnsignedInt dimensions> ShapeGroup<dimensions>& ShapeGroup<dimensions>::setGridCellSize(const Float size) {
+    CORRADE_ASSERT(size > 0.0f,
+        "Shapes::ShapeGroup::setGridCellSize(): expected positive cell size, got" << size, *this);
+    _gridCellSize = size;
+    return *this;
+}
+
 template<UnsignedInt dimensions> AbstractShape<dimensions>* ShapeGroup<dimensions>::firstCollision(const AbstractShape<dimensions>& shape) {
     setClean();
+
+    RangeTypeFor<dimensions, Float> bounds;
+    const bool bounded = Implementation::shapeBounds(Implementation::getAbstractShape(shape), bounds);
     for(std::size_t i = 0; i != this->size(); ++i)
-        if(&(*this)[i] != &shape && (*this)[i].collides(shape))
+        if(&(*this)[i] != &shape && (!bounded || Implementation::boundsOverlap<dimensions>(_bounds[i], bounds)) && (*this)[i].collides(shape))
             return &(*this)[i];
 
     return nullptr;
 }
 
+template<UnsignedInt dimensions> ShapeGroup<dimensions>& ShapeGroup<dimensions>::setChunkSize(const std::size_t size) {
+    CORRADE_ASSERT(size, "Shapes::ShapeGroup::setChunkSize(): chunk size can't be zero", *this);
+    _chunkSize = size;
+    return *this;
+}
+
+template<UnsignedInt dimensions> const std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>& ShapeGroup<dimensions>::collidingPairs() {
+    findCandidates();
+
+    _pairs.clear();
+    testPairs(0, _candidates.size(), _pairs);
+    return _pairs;
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::allCollisions() -> const std::vector<std::tuple<AbstractShape<dimensions>*, AbstractShape<dimensions>*, Collision<dimensions>>>& {
+    findCandidates();
+
+    _collisions.clear();
+    testCollisions(0, _candidates.size(), _collisions);
+    return _collisions;
+}
+
+template<UnsignedInt dimensions> std::size_t ShapeGroup<dimensions>::beginCollidingPairs() {
+    findCandidates();
+
+    /* Keep the per-chunk vectors around so their memory gets reused */
+    const std::size_t chunkCount = collisionChunkCount();
+    if(_chunkPairs.size() < chunkCount) _chunkPairs.resize(chunkCount);
+    for(std::size_t i = 0; i != chunkCount; ++i) _chunkPairs[i].clear();
+
+    return chunkCount;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::collidingPairsChunk(const std::size_t chunk) {
+    CORRADE_ASSERT(chunk < collisionChunkCount(),
+        "Shapes::ShapeGroup::collidingPairsChunk(): index" << chunk << "out of range for" << collisionChunkCount() << "chunks", );
+    testPairs(chunk*_chunkSize, std::min(_candidates.size(), (chunk + 1)*_chunkSize), _chunkPairs[chunk]);
+}
+
+template<UnsignedInt dimensions> const std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>& ShapeGroup<dimensions>::endCollidingPairs() {
+    /* Chunks are contiguous ranges of the sorted candidates, so concatenating
+       them in order gives the same output as the serial version */
+    _pairs.clear();
+    for(std::size_t i = 0, chunkCount = collisionChunkCount(); i != chunkCount; ++i)
+        _pairs.insert(_pairs.end(), _chunkPairs[i].begin(), _chunkPairs[i].end());
+    return _pairs;
+}
+
+template<UnsignedInt dimensions> std::size_t ShapeGroup<dimensions>::beginAllCollisions() {
+    findCandidates();
+
+    const std::size_t chunkCount = collisionChunkCount();
+    if(_chunkCollisions.size() < chunkCount) _chunkCollisions.resize(chunkCount);
+    for(std::size_t i = 0; i != chunkCount; ++i) _chunkCollisions[i].clear();
+
+    return chunkCount;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::allCollisionsChunk(const std::size_t chunk) {
+    CORRADE_ASSERT(chunk < collisionChunkCount(),
+        "Shapes::ShapeGroup::allCollisionsChunk(): index" << chunk << "out of range for" << collisionChunkCount() << "chunks", );
+    testCollisions(chunk*_chunkSize, std::min(_candidates.size(), (chunk + 1)*_chunkSize), _chunkCollisions[chunk]);
+}
+
+template<UnsignedInt dimensions> auto ShapeGroup<dimensions>::endAllCollisions() -> const std::vector<std::tuple<AbstractShape<dimensions>*, AbstractShape<dimensions>*, Collision<dimensions>>>& {
+    _collisions.clear();
+    for(std::size_t i = 0, chunkCount = collisionChunkCount(); i != chunkCount; ++i)
+        _collisions.insert(_collisions.end(), _chunkCollisions[i].begin(), _chunkCollisions[i].end());
+    return _collisions;
+}
+
+template<UnsignedInt dimensions> const std::vector<Contact<dimensions>>& ShapeGroup<dimensions>::updateContacts() {
+    cleanObjects();
+    dirty = false;
+
+    ContactCache& cache = *_contactCache;
+    const UnsignedInt count = this->size();
+
+    /* Find shapes that moved since the last update. If shapes were added to
+       or removed from the group, their indices changed and all shapes have to
+       be tested again. */
+    bool rebuild = cache.rank.size() != count;
+    for(UnsignedInt i = 0; i != count && !rebuild; ++i) {
+        const AbstractShape<dimensions>& shape = (*this)[i];
+        if(shape._contactGroup != this || shape._contactIndex != i)
+            rebuild = true;
+    }
+
+    _contacts.clear();
+    cache.moved.clear();
+    cache.movedMask.assign(count, rebuild);
+    if(rebuild) {
+        /* Map cached contacts to new shape indices. Contacts of shapes that
+           are no longer in the group ended, they're reported first so a new
+           shape at the same address can't begin a contact before an ended
+           one with the same address is reported. */
+        cache.remap.assign(cache.rank.size(), ~UnsignedInt{});
+        for(UnsignedInt i = 0; i != count; ++i) {
+            const AbstractShape<dimensions>& shape = (*this)[i];
+            if(shape._contactGroup == this && shape._contactIndex < cache.remap.size())
+                cache.remap[shape._contactIndex] = i;
+        }
+
+        std::size_t out = 0;
+        for(typename ContactCache::CachedContact& contact: cache.contacts) {
+            const UnsignedInt a = cache.remap[contact.a];
+            const UnsignedInt b = cache.remap[contact.b];
+            if(a == ~UnsignedInt{} || b == ~UnsignedInt{}) {
+                _contacts.emplace_back(*cache.shapes[contact.a], *cache.shapes[contact.b], ContactState::End, contact.collision);
+                continue;
+            }
+
+            if(a < b) cache.contacts[out++] = {a, b, contact.collision};
+            else cache.contacts[out++] = {b, a, contact.collision.flipped()};
+        }
+        cache.contacts.resize(out);
+        std::sort(cache.contacts.begin(), cache.contacts.end(), [](const typename ContactCache::CachedContact& a, const typename ContactCache::CachedContact& b) {
+            return std::make_pair(a.a, a.b) < std::make_pair(b.a, b.b);
+        });
+
+        _bounds.resize(count);
+        cache.shapes.resize(count);
+        for(UnsignedInt i = 0; i != count; ++i) {
+            AbstractShape<dimensions>& shape = (*this)[i];
+            cache.shapes[i] = &shape;
+            shape._contactGroup = this;
+            shape._contactIndex = i;
+            shape._contactMoved = false;
+            cache.moved.push_back(i);
+        }
+    } else for(UnsignedInt i = 0; i != count; ++i) {
+        AbstractShape<dimensions>& shape = (*this)[i];
+        if(!shape._contactMoved) continue;
+        shape._contactMoved = false;
+        cache.moved.push_back(i);
+        cache.movedMask[i] = true;
+    }
+
+    /* Update bounds of the moved shapes and the sweep */
+    for(const UnsignedInt i: cache.moved)
+        if(!Implementation::shapeBounds(Implementation::getAbstractShape((*this)[i]), _bounds[i]))
+            _bounds[i] = {VectorTypeFor<dimensions, Float>{-Constants::inf()}, VectorTypeFor<dimensions, Float>{Constants::inf()}};
+    if(rebuild) cache.sort(_bounds);
+    else if(!cache.moved.empty()) cache.resort(_bounds);
+
+    /* Find pairs with overlapping bounds involving the moved shapes. Pairs of
+       two moved shapes are added only from the one with lower index. */
+    cache.tests.clear();
+    for(const UnsignedInt i: cache.moved) {
+        const RangeTypeFor<dimensions, Float>& bounds = _bounds[i];
+        auto test = [&](const UnsignedInt j) {
+            if(j == i || (cache.movedMask[j] && j < i) || !Implementation::boundsOverlap<dimensions>(bounds, _bounds[j])) return;
+            cache.tests.emplace_back(std::min(i, j), std::max(i, j));
+        };
+
+        /* Unbounded shapes are tested against everything */
+        if(cache.rank[i] == ~UnsignedInt{}) {
+            for(UnsignedInt j = 0; j != count; ++j) test(j);
+            continue;
+        }
+
+        /* Intervals overlapping this one along the axis start after the
+           start of this one minus maximal interval length and before its
+           end */
+        const Float min = bounds.min()[cache.axis] - cache.maxExtent;
+        const Float max = bounds.max()[cache.axis];
+        for(std::size_t j = cache.rank[i] + 1; j < cache.sweep.size() && cache.sweep[j].first <= max; ++j)
+            test(cache.sweep[j].second);
+        for(std::size_t j = cache.rank[i]; j && cache.sweep[j - 1].first >= min; --j)
+            test(cache.sweep[j - 1].second);
+        for(const UnsignedInt j: cache.unbounded) test(j);
+    }
+    std::sort(cache.tests.begin(), cache.tests.end());
+    _contactTestCount = cache.tests.size();
+
+    cache.hits.clear();
+    for(const std::pair<UnsignedInt, UnsignedInt>& t: cache.tests) {
+        AbstractShape<dimensions>& a = (*this)[t.first];
+        AbstractShape<dimensions>& b = (*this)[t.second];
+        if(a.collides(b)) cache.hits.push_back({t.first, t.second, a.collision(b)});
+    }
+
+    /* Merge the new hits with the cached contacts. Contacts of shapes that
+       didn't move persist, contacts of moved shapes which are not among the
+       hits ended. */
+    cache.nextContacts.clear();
+    auto it = cache.contacts.begin();
+    auto hit = cache.hits.begin();
+    while(it != cache.contacts.end() || hit != cache.hits.end()) {
+        const bool takeHit = it == cache.contacts.end() || (hit != cache.hits.end() && std::make_pair(hit->a, hit->b) <= std::make_pair(it->a, it->b));
+        const bool takeContact = it != cache.contacts.end() && (hit == cache.hits.end() || std::make_pair(it->a, it->b) <= std::make_pair(hit->a, hit->b));
+
+        if(takeHit) {
+            cache.nextContacts.push_back(*hit);
+            _contacts.emplace_back((*this)[hit->a], (*this)[hit->b], takeContact ? ContactState::Persist : ContactState::Begin, hit->collision);
+        } else if(cache.movedMask[it->a] || cache.movedMask[it->b]) {
+            _contacts.emplace_back((*this)[it->a], (*this)[it->b], ContactState::End, it->collision);
+        } else {
+            cache.nextContacts.push_back(*it);
+            _contacts.emplace_back((*this)[it->a], (*this)[it->b], ContactState::Persist, it->collision);
+        }
+
+        if(takeHit) ++hit;
+        if(takeContact) ++it;
+    }
+    std::swap(cache.contacts, cache.nextContacts);
+
+    return _contacts;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::testPairs(const std::size_t begin, const std::size_t end, std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>& out) {
+    for(std::size_t i = begin; i != end; ++i) {
+        AbstractShape<dimensions>& a = (*this)[_candidates[i].first];
+        AbstractShape<dimensions>& b = (*this)[_candidates[i].second];
+        if(a.collides(b)) out.emplace_back(&a, &b);
+    }
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::testCollisions(const std::size_t begin, const std::size_t end, std::vector<std::tuple<AbstractShape<dimensions>*, AbstractShape<dimensions>*, Collision<dimensions>>>& out) {
+    for(std::size_t i = begin; i != end; ++i) {
+        AbstractShape<dimensions>& a = (*this)[_candidates[i].first];
+        AbstractShape<dimensions>& b = (*this)[_candidates[i].second];
+        if(a.collides(b)) out.emplace_back(&a, &b, a.collision(b));
+    }
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::findCandidates() {
+    setClean();
+
+    _candidates.clear();
+    switch(_broadPhase) {
+        case BroadPhase::None:
+            for(UnsignedInt i = 0; i != _bounds.size(); ++i)
+                for(UnsignedInt j = i + 1; j != _bounds.size(); ++j)
+                    _candidates.emplace_back(i, j);
+            return;
+
+        case BroadPhase::SweepAndPrune:
+            sweepAndPrune();
+            break;
+
+        case BroadPhase::HashGrid:
+            hashGrid();
+            break;
+    }
+
+    /* Sort the candidates so the output doesn't depend on the broad phase
+       and remove duplicates */
+    std::sort(_candidates.begin(), _candidates.end());
+    _candidates.erase(std::unique(_candidates.begin(), _candidates.end()), _candidates.end());
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::sweepAndPrune() {
+    /* Pick axis along which the (finite) shape centers are spread the most to
+       minimize count of overlapping intervals */
+    VectorTypeFor<dimensions, Float> sum, sumSquared;
+    std::size_t count = 0;
+    for(const RangeTypeFor<dimensions, Float>& bounds: _bounds) {
+        const VectorTypeFor<dimensions, Float> center = bounds.center();
+        if(!(Math::abs(center) < VectorTypeFor<dimensions, Float>{Constants::inf()}).all()) continue;
+        sum += center;
+        sumSquared += center*center;
+        ++count;
+    }
+    std::size_t axis = 0;
+    if(count) {
+        const VectorTypeFor<dimensions, Float> variance = sumSquared/Float(count) - Math::pow<2>(sum/Float(count));
+        for(std::size_t i = 1; i != dimensions; ++i)
+            if(variance[i] > variance[axis]) axis = i;
+    }
+
+    /* Sort interval starts along the axis, make a sorted copy of the bounds
+       so the sweep below goes through memory linearly */
+    _sweep.clear();
+    _sweep.reserve(_bounds.size());
+    for(UnsignedInt i = 0; i != _bounds.size(); ++i)
+        _sweep.emplace_back(_bounds[i].min()[axis], i);
+    std::sort(_sweep.begin(), _sweep.end());
+    _sweepBounds.resize(_sweep.size());
+    for(std::size_t i = 0; i != _sweep.size(); ++i)
+        _sweepBounds[i] = _bounds[_sweep[i].second];
+
+    /* Test each interval against the following ones until they start after
+       its end */
+    for(std::size_t i = 0; i != _sweep.size(); ++i) {
+        const Float max = _sweepBounds[i].max()[axis];
+        for(std::size_t j = i + 1; j != _sweep.size() && _sweep[j].first <= max; ++j) {
+            if(!Implementation::boundsOverlap<dimensions>(_sweepBounds[i], _sweepBounds[j])) continue;
+            const UnsignedInt a = _sweep[i].second;
+            const UnsignedInt b = _sweep[j].second;
+            _candidates.emplace_back(std::min(a, b), std::max(a, b));
+        }
+    }
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::hashGrid() {
+    /* Insert each shape into all cells it touches */
+    _cells.clear();
+    _large.clear();
+    for(UnsignedInt i = 0; i != _bounds.size(); ++i) {
+        const VectorTypeFor<dimensions, Float> min = Math::floor(_bounds[i].min()/_gridCellSize);
+        const VectorTypeFor<dimensions, Float> max = Math::floor(_bounds[i].max()/_gridCellSize);
+        if(!(Math::abs(min) < VectorTypeFor<dimensions, Float>{MaxGridCellCoordinate}).all() ||
+           !(Math::abs(max) < VectorTypeFor<dimensions, Float>{MaxGridCellCoordinate}).all()) {
+            _large.push_back(i);
+            continue;
+        }
+
+        const Math::Vector<dimensions, Int> cellMin{min};
+        const Math::Vector<dimensions, Int> cellCount = Math::Vector<dimensions, Int>{max} - cellMin + Math::Vector<dimensions, Int>{1};
+
+        /* Check each axis separately before multiplying, the product of
+           all axes could overflow for huge shapes */
+        UnsignedInt cellTotal = 1;
+        for(std::size_t j = 0; j != dimensions && cellTotal <= MaxGridCellsPerShape; ++j) {
+            if(UnsignedInt(cellCount[j]) > MaxGridCellsPerShape)
+                cellTotal = MaxGridCellsPerShape + 1;
+            else cellTotal *= cellCount[j];
+        }
+        if(cellTotal > MaxGridCellsPerShape) {
+            _large.push_back(i);
+            continue;
+        }
+
+        for(Int c = 0; c != Int(cellTotal); ++c) {
+            Math::Vector<dimensions, Int> cell = cellMin;
+            for(Int j = 0, offset = c; j != Int(dimensions); ++j) {
+                cell[j] += offset % cellCount[j];
+                offset /= cellCount[j];
+            }
+            _cells.emplace_back(gridCellHash<dimensions>(cell), i);
+        }
+    }
+
+    /* Group shapes by cell, test all shapes sharing a cell with each other.
+       Two overlapping shapes can share more than one cell, report them only
+       in the cell containing the minimal corner of their intersection. Hash
+       collisions of distinct cells only produce extra candidates which get
+       filtered out by the bounds check or the deduplication afterwards. */
+    std::sort(_cells.begin(), _cells.end());
+    for(std::size_t begin = 0, end; begin != _cells.size(); begin = end) {
+        const UnsignedInt hash = _cells[begin].first;
+        end = begin + 1;
+        while(end != _cells.size() && _cells[end].first == hash) ++end;
+
+        for(std::size_t i = begin; i != end; ++i)
+            for(std::size_t j = i + 1; j != end; ++j) {
+                const UnsignedInt a = _cells[i].second;
+                const UnsignedInt b = _cells[j].second;
+                if(a == b || !Implementation::boundsOverlap<dimensions>(_bounds[a], _bounds[b])) continue;
+
+                const Math::Vector<dimensions, Int> cell{Math::floor(Math::max(_bounds[a].min(), _bounds[b].min())/_gridCellSize)};
+                if(gridCellHash<dimensions>(cell) == hash)
+                    _candidates.emplace_back(std::min(a, b), std::max(a, b));
+            }
+    }
+
+    /* Large and unbounded shapes are tested against everything */
+    for(const UnsignedInt a: _large)
+        for(UnsignedInt b = 0; b != _bounds.size(); ++b)
+            if(a != b && Implementation::boundsOverlap<dimensions>(_bounds[a], _bounds[b]))
+                _candidates.emplace_back(std::min(a, b), std::max(a, b));
+}
+
+Debug& operator<<(Debug& debug, const BroadPhase value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case BroadPhase::value: return debug << "Shapes::BroadPhase::" #value;
+        _c(None)
+        _c(SweepAndPrune)
+        _c(HashGrid)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Shapes::BroadPhase(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const ContactState value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case ContactState::value: return debug << "Shapes::ContactState::" #value;
+        _c(Begin)
+        _c(Persist)
+        _c(End)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Shapes::ContactState(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<2>;
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<3>;
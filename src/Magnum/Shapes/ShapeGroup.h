@@ -26,21 +26,160 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shapes::ShapeGroup, typedef @ref Magnum::Shapes::ShapeGroup2D, @ref Magnum::Shapes::ShapeGroup3D
+ * @brief Class @ref Magnum::Shapes::ShapeGroup, typedef @ref Magnum::Shapes::ShapeGroup2D, @ref Magnum::Shapes::ShapeGroup3D, enum @ref Magnum::Shapes::BroadPhase
  */
 
+#include <functional>
+#include <memory>
+#include <tuple>
 #include <vector>
 
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/Shapes/AbstractShape.h"
+#include "Magnum/Shapes/Collision.h"
+#include "Magnum/Shapes/Contact.h"
 #include "Magnum/Shapes/visibility.h"
 
 namespace Magnum { namespace Shapes {
 
+/**
+@brief Broad phase algorithm
+
+Used by @ref ShapeGroup::collidingPairs() and @ref ShapeGroup::allCollisions()
+to find candidate pairs before doing the exact collision test.
+@see @ref ShapeGroup::setBroadPhase()
+*/
+enum class BroadPhase: UnsignedByte {
+    /**
+     * No broad phase, every pair of shapes in the group is tested. Fastest
+     * for just a handful of shapes.
+     */
+    None,
+
+    /**
+     * Sweep and prune. Shape bounds are sorted along the axis with largest
+     * spread of shape centers and only shapes with overlapping intervals are
+     * tested. Works well for most scenes without any tuning.
+     */
+    SweepAndPrune,
+
+    /**
+     * Uniform hash grid. Each shape is inserted into all grid cells its
+     * bounds touch and only shapes sharing a cell are tested. Works best for
+     * many similarly-sized shapes in densely populated scenes, needs the cell
+     * size set to roughly the size of a typical shape using
+     * @ref ShapeGroup::setGridCellSize().
+     */
+    HashGrid
+};
+
+/** @debugoperatorenum{Magnum::Shapes::BroadPhase} */
+MAGNUM_SHAPES_EXPORT Debug& operator<<(Debug& debug, BroadPhase value);
+
 /**
 @brief Group of shapes
 
 See @ref Shape for more information. See @ref shapes for brief introduction.
+
+@anchor Shapes-ShapeGroup-all-pairs
+## All-pairs queries
+
+Collisions of all shapes in the group with each other can be queried using
+@ref collidingPairs() or @ref allCollisions(). Instead of testing every pair
+of shapes, axis-aligned bounds of all shapes are computed on @ref setClean()
+and a broad phase selected by @ref setBroadPhase() filters out pairs that
+can't collide. Shapes without finite bounds (lines, planes, cylinders,
+inverted spheres and compositions) are tested against all other shapes. The
+returned pairs are ordered by position of the shapes in the group, so the
+output is the same regardless of the broad phase used. The group keeps the
+intermediate data and the output between calls, so repeated queries don't
+allocate once the buffers reach their final size.
+@code
+Shapes::ShapeGroup3D shapes;
+shapes.setBroadPhase(Shapes::BroadPhase::HashGrid)
+    .setGridCellSize(2.0f);
+
+// ...
+
+for(const auto& pair: shapes.collidingPairs()) {
+    // handle collision of pair.first and pair.second
+}
+@endcode
+
+@anchor Shapes-ShapeGroup-parallel
+## Parallel collision detection
+
+Both the transformation updates and the exact collision tests can be split
+into chunks and executed on multiple threads. Similarly to
+@ref SceneGraph::Scene::beginClean() the group doesn't create any threads, the
+chunks are executed by the application, see @ref scenegraph-parallel for the
+`runChunks()` helper used below. @ref beginClean()
+computes absolute transformations of all dirty objects and splits updating
+the shapes into chunks, which are then executed using @ref cleanChunk().
+@ref beginCollidingPairs() then computes shape bounds, runs the broad phase
+and splits the candidate pairs into chunks of @ref chunkSize() pairs, which
+are tested using @ref collidingPairsChunk(). Finally,
+@ref endCollidingPairs() merges the results of all chunks:
+@code
+runChunks(threadCount, shapes.beginClean(), [&](std::size_t chunk) {
+    shapes.cleanChunk(chunk);
+});
+runChunks(threadCount, shapes.beginCollidingPairs(), [&](std::size_t chunk) {
+    shapes.collidingPairsChunk(chunk);
+});
+for(const auto& pair: shapes.endCollidingPairs()) {
+    // handle collision of pair.first and pair.second
+}
+@endcode
+
+Each chunk processes a contiguous range of the sorted candidate pairs and the
+chunk results are concatenated in order, so the output is exactly the same as
+from @ref collidingPairs(), regardless of how many threads were used or in
+which order the chunks were executed. @ref beginAllCollisions(),
+@ref allCollisionsChunk() and @ref endAllCollisions() are the parallel
+equivalents of @ref allCollisions(). All chunks have to be executed before
+calling the corresponding `end*()` function and the shapes and objects can't
+be modified until then. The broad phase itself is always done on the calling
+thread. Cleaning in parallel requires all shapes in the group to be part of
+the same scene.
+
+@anchor Shapes-ShapeGroup-contacts
+## Tracking contacts between updates
+
+In most simulations only a small fraction of shapes moves between two
+updates. Instead of recomputing all collisions from scratch each time,
+@ref updateContacts() keeps the colliding pairs and their collision data from
+the previous call and tests only pairs in which at least one of the shapes
+moved. For each colliding pair it then reports whether the contact began in
+this update, persisted from the previous one, or ended:
+@code
+for(const Shapes::Contact3D& contact: shapes.updateContacts()) {
+    switch(contact.state()) {
+        case Shapes::ContactState::Begin:
+            // play a sound...
+            break;
+        case Shapes::ContactState::Persist:
+            // resolve the penetration using contact.collision()...
+            break;
+        case Shapes::ContactState::End:
+            break;
+    }
+}
+@endcode
+
+A shape is considered moved if its object was marked dirty or the shape was
+changed since the last update. Bounds and candidate pairs are found only for
+the moved shapes using a sweep along an axis that's kept sorted between
+updates, so the cost of the update is proportional to the amount of motion
+and count of contacts rather than to the count of all shapes. Adding or
+removing shapes to the group causes all shapes to be tested again on the next
+update. Contacts of shapes that were removed from the group are reported as
+@ref ContactState::End at the beginning of the list in the next update. As
+the removed shape might not exist anymore, it shouldn't be accessed through
+the contact, only its address can be used to identify the pair.
+
 @see @ref scenegraph, @ref ShapeGroup2D, @ref ShapeGroup3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public SceneGraph::FeatureGroup<dimensions, AbstractShape<dimensions>, Float> {
@@ -52,7 +191,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          *
          * Marks the group as dirty.
          */
-        explicit ShapeGroup(): dirty(true) {}
+        explicit ShapeGroup();
+
+        ~ShapeGroup();
 
         /**
          * @brief Whether the group is dirty
@@ -74,21 +215,250 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          * @brief Set the group and all bodies as clean
          *
          * This function is called before computing any collisions to ensure
-         * all objects are cleaned.
+         * all objects are cleaned. Also updates bounds of all shapes used for
+         * the broad phase.
          */
         void setClean();
 
+        /**
+         * @brief Begin cleaning the group in parallel
+         * @return Count of chunks to execute with @ref cleanChunk()
+         *
+         * Computes absolute transformations of all dirty objects in the
+         * group, updating the shapes is deferred to @ref cleanChunk(). The
+         * bounds are updated in the next call to @ref setClean() or any
+         * collision query. Expects that all dirty objects are part of the
+         * same scene. See @ref Shapes-ShapeGroup-parallel "class documentation"
+         * for more information.
+         * @see @ref SceneGraph::Scene::beginClean()
+         */
+        std::size_t beginClean();
+
+        /**
+         * @brief Count of clean chunks to execute
+         *
+         * Count of chunks to execute after last call to @ref beginClean().
+         */
+        std::size_t cleanChunkCount() const { return _cleanChunkCount; }
+
+        /**
+         * @brief Execute chunk of the parallel clean
+         *
+         * Can be called from any thread, each chunk should be executed only
+         * once after each @ref beginClean(). Expects that @p chunk is less
+         * than @ref cleanChunkCount().
+         */
+        void cleanChunk(std::size_t chunk);
+
+        /** @brief Broad phase algorithm */
+        BroadPhase broadPhase() const { return _broadPhase; }
+
+        /**
+         * @brief Set broad phase algorithm
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref BroadPhase::SweepAndPrune. See
+         * @ref Shapes-ShapeGroup-all-pairs "class documentation" for more
+         * information.
+         */
+        ShapeGroup<dimensions>& setBroadPhase(BroadPhase broadPhase) {
+            _broadPhase = broadPhase;
+            return *this;
+        }
+
+        /** @brief Hash grid cell size */
+        Float gridCellSize() const { return _gridCellSize; }
+
+        /**
+         * @brief Set hash grid cell size
+         * @return Reference to self (for method chaining)
+         *
+         * Used only by @ref BroadPhase::HashGrid. Shapes spanning too many
+         * cells are tested against all other shapes instead of being inserted
+         * into the grid. Expects that the size is positive, default is `1.0f`.
+         */
+        ShapeGroup<dimensions>& setGridCellSize(Float size);
+
+        /**
+         * @brief Chunk size for parallel collision detection
+         *
+         * Default is `1024`.
+         * @see @ref beginCollidingPairs(), @ref beginAllCollisions()
+         */
+        std::size_t chunkSize() const { return _chunkSize; }
+
+        /**
+         * @brief Set chunk size for parallel collision detection
+         * @return Reference to self (for method chaining)
+         *
+         * Count of candidate pairs tested in one call to
+         * @ref collidingPairsChunk() or @ref allCollisionsChunk(). Smaller
+         * chunks allow for better load balancing at the cost of higher
+         * scheduling overhead. Expects that the size is not zero.
+         */
+        ShapeGroup<dimensions>& setChunkSize(std::size_t size);
+
         /**
          * @brief First collision of given shape with other shapes in the group
          *
          * Returns first shape colliding with given one. If there aren't any
          * collisions, returns `nullptr`. Calls @ref setClean() before the
-         * operation.
+         * operation. Shapes with bounds not overlapping bounds of given shape
+         * are skipped without doing the exact collision test.
          */
         AbstractShape<dimensions>* firstCollision(const AbstractShape<dimensions>& shape);
 
+        /**
+         * @brief All colliding pairs of shapes in the group
+         *
+         * Calls @ref setClean(), finds candidate pairs using the broad phase
+         * and returns pairs for which @ref AbstractShape::collides() returns
+         * `true`. In each pair the first shape is the one earlier in the group
+         * and the pairs are sorted. The returned reference is valid until the
+         * next call to this function. See
+         * @ref Shapes-ShapeGroup-all-pairs "class documentation" for more
+         * information.
+         * @see @ref allCollisions()
+         */
+        const std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>& collidingPairs();
+
+        /**
+         * @brief All collisions of shapes in the group
+         *
+         * Same as @ref collidingPairs(), but additionally returns result of
+         * @ref AbstractShape::collision() for each colliding pair. The
+         * collision data are empty for shape pairs which don't have detailed
+         * collision implemented. The returned reference is valid until the
+         * next call to this function.
+         */
+        const std::vector<std::tuple<AbstractShape<dimensions>*, AbstractShape<dimensions>*, Collision<dimensions>>>& allCollisions();
+
+        /**
+         * @brief Begin parallel query for all colliding pairs
+         * @return Count of chunks to execute with @ref collidingPairsChunk()
+         *
+         * Calls @ref setClean(), finds candidate pairs using the broad phase
+         * and splits them into chunks of @ref chunkSize() pairs. See
+         * @ref Shapes-ShapeGroup-parallel "class documentation" for more
+         * information.
+         * @see @ref collidingPairs()
+         */
+        std::size_t beginCollidingPairs();
+
+        /**
+         * @brief Count of collision chunks to execute
+         *
+         * Count of chunks to execute after last call to
+         * @ref beginCollidingPairs() or @ref beginAllCollisions().
+         */
+        std::size_t collisionChunkCount() const {
+            return (_candidates.size() + _chunkSize - 1)/_chunkSize;
+        }
+
+        /**
+         * @brief Execute chunk of the parallel colliding pairs query
+         *
+         * Can be called from any thread, each chunk should be executed only
+         * once after each @ref beginCollidingPairs(). Expects that @p chunk
+         * is less than @ref collisionChunkCount().
+         */
+        void collidingPairsChunk(std::size_t chunk);
+
+        /**
+         * @brief End parallel query for all colliding pairs
+         *
+         * Merges results of all chunks executed with
+         * @ref collidingPairsChunk(). The output is the same as from
+         * @ref collidingPairs(). The returned reference is valid until the
+         * next call to this function or to @ref collidingPairs().
+         */
+        const std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>& endCollidingPairs();
+
+        /**
+         * @brief Begin parallel query for all collisions
+         * @return Count of chunks to execute with @ref allCollisionsChunk()
+         *
+         * Same as @ref beginCollidingPairs(), but for @ref allCollisions().
+         */
+        std::size_t beginAllCollisions();
+
+        /**
+         * @brief Execute chunk of the parallel all collisions query
+         *
+         * Can be called from any thread, each chunk should be executed only
+         * once after each @ref beginAllCollisions(). Expects that @p chunk is
+         * less than @ref collisionChunkCount().
+         */
+        void allCollisionsChunk(std::size_t chunk);
+
+        /**
+         * @brief End parallel query for all collisions
+         *
+         * Merges results of all chunks executed with
+         * @ref allCollisionsChunk(). The output is the same as from
+         * @ref allCollisions(). The returned reference is valid until the
+         * next call to this function or to @ref allCollisions().
+         */
+        const std::vector<std::tuple<AbstractShape<dimensions>*, AbstractShape<dimensions>*, Collision<dimensions>>>& endAllCollisions();
+
+        /**
+         * @brief Update contacts between shapes in the group
+         *
+         * Cleans all objects, tests pairs involving shapes that moved since
+         * the last call and returns all contacts, ordered by position of the
+         * shapes in the group. Contacts of pairs in which neither shape
+         * moved are reported as @ref ContactState::Persist with the collision
+         * data from the previous update. Ended contacts of shapes removed from
+         * the group since the last call are reported first. The returned
+         * reference is valid until the next call to this function. See
+         * @ref Shapes-ShapeGroup-contacts "class documentation" for more
+         * information.
+         * @see @ref contactTestCount()
+         */
+        const std::vector<Contact<dimensions>>& updateContacts();
+
+        /**
+         * @brief Count of shape pairs tested in last contact update
+         *
+         * Count of exact collision tests done in the last call to
+         * @ref updateContacts().
+         */
+        std::size_t contactTestCount() const { return _contactTestCount; }
+
     private:
+        struct ContactCache;
+
+        void MAGNUM_SHAPES_LOCAL cleanObjects();
+        void MAGNUM_SHAPES_LOCAL updateBounds();
+        void MAGNUM_SHAPES_LOCAL testPairs(std::size_t begin, std::size_t end, std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>& out);
+        void MAGNUM_SHAPES_LOCAL testCollisions(std::size_t begin, std::size_t end, std::vector<std::tuple<AbstractShape<dimensions>*, AbstractShape<dimensions>*, Collision<dimensions>>>& out);
+        void MAGNUM_SHAPES_LOCAL findCandidates();
+        void MAGNUM_SHAPES_LOCAL sweepAndPrune();
+        void MAGNUM_SHAPES_LOCAL hashGrid();
+
         bool dirty;
+        BroadPhase _broadPhase;
+        Float _gridCellSize;
+        std::size_t _chunkSize;
+        std::size_t _cleanChunkCount;
+        SceneGraph::AbstractObject<dimensions, Float>* _cleanScene;
+
+        /* Scratch storage reused between calls */
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> _objects;
+        std::vector<RangeTypeFor<dimensions, Float>> _bounds;
+        std::vector<std::pair<Float, UnsignedInt>> _sweep;
+        std::vector<RangeTypeFor<dimensions, Float>> _sweepBounds;
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> _cells;
+        std::vector<UnsignedInt> _large;
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> _candidates;
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> _pairs;
+        std::vector<std::tuple<AbstractShape<dimensions>*, AbstractShape<dimensions>*, Collision<dimensions>>> _collisions;
+        std::vector<std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>> _chunkPairs;
+        std::vector<std::vector<std::tuple<AbstractShape<dimensions>*, AbstractShape<dimensions>*, Collision<dimensions>>>> _chunkCollisions;
+
+        std::unique_ptr<ContactCache> _contactCache;
+        std::vector<Contact<dimensions>> _contacts;
+        std::size_t _contactTestCount;
 };
 
 /**
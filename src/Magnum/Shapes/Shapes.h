@@ -46,6 +46,8 @@ template<UnsignedInt> class Box;
 typedef Box<2> Box2D;
 typedef Box<3> Box3D;
 
+enum class BroadPhase: UnsignedByte;
+
 template<UnsignedInt> class Capsule;
 typedef Capsule<2> Capsule2D;
 typedef Capsule<3> Capsule3D;
@@ -58,6 +60,12 @@ template<UnsignedInt> class Composition;
 typedef Composition<2> Composition2D;
 typedef Composition<3> Composition3D;
 
+template<UnsignedInt> class Contact;
+typedef Contact<2> Contact2D;
+typedef Contact<3> Contact3D;
+
+enum class ContactState: UnsignedByte;
+
 template<UnsignedInt> class Cylinder;
 typedef Cylinder<2> Cylinder2D;
 typedef Cylinder<3> Cylinder3D;
@@ -89,6 +97,21 @@ class Plane;
 template<UnsignedInt> class Point;
 typedef Point<2> Point2D;
 typedef Point<3> Point3D;
+
+template<class> class ShapeBatch;
+typedef ShapeBatch<Point2D> PointBatch2D;
+typedef ShapeBatch<Point3D> PointBatch3D;
+typedef ShapeBatch<Sphere2D> SphereBatch2D;
+typedef ShapeBatch<Sphere3D> SphereBatch3D;
+typedef ShapeBatch<AxisAlignedBox2D> AxisAlignedBoxBatch2D;
+typedef ShapeBatch<AxisAlignedBox3D> AxisAlignedBoxBatch3D;
+typedef ShapeBatch<Box2D> BoxBatch2D;
+typedef ShapeBatch<Box3D> BoxBatch3D;
+typedef ShapeBatch<Capsule2D> CapsuleBatch2D;
+typedef ShapeBatch<Capsule3D> CapsuleBatch3D;
+
+class TriangleMesh;
+class TriangleMeshData;
 #endif
 
 }}
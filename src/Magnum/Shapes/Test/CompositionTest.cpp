@@ -27,7 +27,12 @@
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Shapes/Point.h"
 #include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
 #include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
 #include "Magnum/Shapes/Sphere.h"
 
 #include "ShapeTestBase.h"
@@ -47,6 +52,10 @@ struct CompositionTest: TestSuite::Tester {
     void copy();
     void move();
     void transformed();
+    void transformedAllTypes();
+
+    void benchmarkCopyTransformed();
+    void benchmarkCollides();
 };
 
 CompositionTest::CompositionTest() {
@@ -59,7 +68,11 @@ CompositionTest::CompositionTest() {
 
               &CompositionTest::copy,
               &CompositionTest::move,
-              &CompositionTest::transformed});
+              &CompositionTest::transformed,
+              &CompositionTest::transformedAllTypes});
+
+    addBenchmarks({&CompositionTest::benchmarkCopyTransformed,
+                   &CompositionTest::benchmarkCollides}, 10);
 }
 
 void CompositionTest::negated() {
@@ -183,6 +196,77 @@ void CompositionTest::transformed() {
     CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox2D>(2).max(), Vector2(2.0f, -6.5f));
 }
 
+void CompositionTest::transformedAllTypes() {
+    const Shapes::Composition3D a =
+        (Shapes::Point3D{{1.0f, 0.0f, 0.0f}} ||
+         Shapes::Line3D{{0.0f, 1.0f, 0.0f}, {0.0f, 2.0f, 0.0f}} ||
+         Shapes::LineSegment3D{{0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 2.0f}} ||
+         Shapes::Sphere3D{{1.0f, 1.0f, 0.0f}, 0.5f}) &&
+        (Shapes::InvertedSphere3D{{0.0f, 1.0f, 1.0f}, 0.25f} ||
+         Shapes::Cylinder3D{{1.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 2.0f}, 0.5f} ||
+         Shapes::Capsule3D{{1.0f, 1.0f, 1.0f}, {2.0f, 1.0f, 1.0f}, 0.5f} ||
+         Shapes::AxisAlignedBox3D{{-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}}) &&
+        (Shapes::Box3D{Matrix4::translation({0.0f, -1.0f, 0.0f})} ||
+         !Shapes::Plane{{0.0f, 0.0f, -1.0f}, Vector3::zAxis()});
+
+    /* Copy, the copy is then overwritten by the transformation */
+    const Shapes::Composition3D b = a.transformed(Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_COMPARE(b.size(), 10);
+    CORRADE_COMPARE(b.type(0), Composition3D::Type::Point);
+    CORRADE_COMPARE(b.type(9), Composition3D::Type::Plane);
+
+    CORRADE_COMPARE(b.get<Shapes::Point3D>(0).position(), (Vector3{11.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(b.get<Shapes::Line3D>(1).a(), (Vector3{10.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(b.get<Shapes::LineSegment3D>(2).b(), (Vector3{10.0f, 0.0f, 2.0f}));
+    CORRADE_COMPARE(b.get<Shapes::Sphere3D>(3).position(), (Vector3{11.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(b.get<Shapes::InvertedSphere3D>(4).radius(), 0.25f);
+    CORRADE_COMPARE(b.get<Shapes::Cylinder3D>(5).a(), (Vector3{11.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(b.get<Shapes::Capsule3D>(6).b(), (Vector3{12.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(b.get<Shapes::AxisAlignedBox3D>(7).min(), (Vector3{9.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(b.get<Shapes::Box3D>(8).transformation(), Matrix4::translation({10.0f, -1.0f, 0.0f}));
+    CORRADE_COMPARE(b.get<Shapes::Plane>(9).position(), (Vector3{10.0f, 0.0f, -1.0f}));
+
+    /* The original is untouched */
+    CORRADE_COMPARE(a.get<Shapes::Box3D>(8).transformation(), Matrix4::translation({0.0f, -1.0f, 0.0f}));
+    CORRADE_COMPARE(a.get<Shapes::Plane>(9).position(), (Vector3{0.0f, 0.0f, -1.0f}));
+
+    /* Collision goes through the stored types */
+    VERIFY_COLLIDES(b, Shapes::Point3D({11.0f, 1.0f, 0.0f}));
+    VERIFY_NOT_COLLIDES(b, Shapes::Point3D({1.0f, 1.0f, 0.0f}));
+}
+
+namespace {
+    /* Ragdoll-like hitbox set: spheres around bones */
+    Shapes::Composition3D hitboxes() {
+        Shapes::Composition3D c = Shapes::Sphere3D{{0.0f, 1.7f, 0.0f}, 0.15f} ||
+            Shapes::Capsule3D{{0.0f, 1.0f, 0.0f}, {0.0f, 1.5f, 0.0f}, 0.1f};
+        for(Int i = 1; i != 15; ++i)
+            c = std::move(c) || Shapes::Capsule3D{{0.1f*i, 1.0f, 0.0f}, {0.1f*i, 1.5f, 0.0f}, 0.1f};
+        return c;
+    }
+}
+
+void CompositionTest::benchmarkCopyTransformed() {
+    const Shapes::Composition3D a = hitboxes();
+    Shapes::Composition3D b;
+
+    CORRADE_BENCHMARK(1000)
+        b = a.transformed(Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    CORRADE_COMPARE(b.size(), 16);
+}
+
+void CompositionTest::benchmarkCollides() {
+    const Shapes::Composition3D a = hitboxes();
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1000)
+        for(Int i = 0; i != 15; ++i)
+            count += a % Shapes::Sphere3D{{0.1f*i, 1.2f, 0.0f}, 0.05f};
+
+    CORRADE_COMPARE(count, 15*1000);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shapes::Test::CompositionTest)
@@ -0,0 +1,467 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/ShapeBatch.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/shapeImplementation.h"
+#include "Magnum/Shapes/Implementation/CollisionDispatch.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct ShapeBatchTest: TestSuite::Tester {
+    explicit ShapeBatchTest();
+
+    void construct();
+    void addSet();
+    void clear();
+    void box();
+
+    void pointsSphere();
+    void spheresPoint();
+    void spheresSphere();
+    void axisAlignedBoxesSphere();
+    void boxesSphere();
+    void capsulesSphere();
+    void maskUnusedBits();
+
+    void collidingPairs();
+    void collidingPairsAppend();
+
+    void benchmarkBatch();
+    void benchmarkOperator();
+    void benchmarkAbstract();
+};
+
+ShapeBatchTest::ShapeBatchTest() {
+    addTests({&ShapeBatchTest::construct,
+              &ShapeBatchTest::addSet,
+              &ShapeBatchTest::clear,
+              &ShapeBatchTest::box,
+
+              &ShapeBatchTest::pointsSphere,
+              &ShapeBatchTest::spheresPoint,
+              &ShapeBatchTest::spheresSphere,
+              &ShapeBatchTest::axisAlignedBoxesSphere,
+              &ShapeBatchTest::boxesSphere,
+              &ShapeBatchTest::capsulesSphere,
+              &ShapeBatchTest::maskUnusedBits,
+
+              &ShapeBatchTest::collidingPairs,
+              &ShapeBatchTest::collidingPairsAppend});
+
+    addBenchmarks({&ShapeBatchTest::benchmarkBatch,
+                   &ShapeBatchTest::benchmarkOperator,
+                   &ShapeBatchTest::benchmarkAbstract}, 10);
+}
+
+namespace {
+    /* Not a multiple of the internal block size nor of 8 */
+    constexpr std::size_t Count = 1003;
+
+    bool bit(const Containers::Array<UnsignedByte>& mask, std::size_t i) {
+        return (mask[i/8] >> (i%8)) & 1;
+    }
+
+    Vector3 randomVector(std::mt19937& rng, Float size) {
+        std::uniform_real_distribution<Float> d{-size, size};
+        const Float x = d(rng), y = d(rng), z = d(rng);
+        return {x, y, z};
+    }
+
+    /* Reference implementation of the box/sphere test, independent of how
+       the box is stored in the batch */
+    bool boxSphere(const Vector3& center, Rad rotation, const Vector3& extent, const Sphere3D& sphere) {
+        const Vector3 local = Matrix4::rotationY(-rotation).transformVector(sphere.position() - center);
+        const Vector3 closest = Math::clamp(local, -extent, extent);
+        return (local - closest).dot() < Math::pow<2>(sphere.radius());
+    }
+}
+
+void ShapeBatchTest::construct() {
+    SphereBatch3D a;
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(SphereBatch3D::Dimensions, 3);
+    CORRADE_COMPARE(SphereBatch3D::ComponentCount, 4);
+    CORRADE_COMPARE(PointBatch2D::ComponentCount, 2);
+    CORRADE_COMPARE(AxisAlignedBoxBatch3D::ComponentCount, 6);
+    CORRADE_COMPARE(BoxBatch2D::ComponentCount, 8);
+    CORRADE_COMPARE(BoxBatch3D::ComponentCount, 15);
+    CORRADE_COMPARE(CapsuleBatch3D::ComponentCount, 7);
+}
+
+void ShapeBatchTest::addSet() {
+    SphereBatch3D a;
+    a.add({{1.0f, 2.0f, 3.0f}, 0.5f})
+     .add({{4.0f, 5.0f, 6.0f}, 1.5f});
+    CORRADE_VERIFY(!a.isEmpty());
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(a[1].position(), (Vector3{4.0f, 5.0f, 6.0f}));
+    CORRADE_COMPARE(a[1].radius(), 1.5f);
+
+    /* Structure-of-arrays layout */
+    CORRADE_COMPARE(a.component(0)[0], 1.0f);
+    CORRADE_COMPARE(a.component(0)[1], 4.0f);
+    CORRADE_COMPARE(a.component(2)[1], 6.0f);
+    CORRADE_COMPARE(a.component(3)[0], 0.5f);
+
+    a.set(0, {{-1.0f, 0.0f, 1.0f}, 2.0f});
+    CORRADE_COMPARE(a[0].position(), (Vector3{-1.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(a[0].radius(), 2.0f);
+    CORRADE_COMPARE(a[1].radius(), 1.5f);
+
+    CapsuleBatch2D b;
+    b.add({{1.0f, 2.0f}, {3.0f, 4.0f}, 0.25f});
+    CORRADE_COMPARE(b[0].a(), (Vector2{1.0f, 2.0f}));
+    CORRADE_COMPARE(b[0].b(), (Vector2{3.0f, 4.0f}));
+    CORRADE_COMPARE(b[0].radius(), 0.25f);
+
+    AxisAlignedBoxBatch2D c;
+    c.add({{-1.0f, -2.0f}, {3.0f, 4.0f}});
+    CORRADE_COMPARE(c[0].min(), (Vector2{-1.0f, -2.0f}));
+    CORRADE_COMPARE(c[0].max(), (Vector2{3.0f, 4.0f}));
+}
+
+void ShapeBatchTest::clear() {
+    PointBatch2D a;
+    a.add(Point2D{{1.0f, 2.0f}})
+     .add(Point2D{{3.0f, 4.0f}});
+    const Float* data = a.component(0);
+
+    a.clear();
+    CORRADE_VERIFY(a.isEmpty());
+
+    /* The memory is reused */
+    a.add(Point2D{{5.0f, 6.0f}});
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(a.component(0), data);
+    CORRADE_COMPARE(a[0].position(), (Vector2{5.0f, 6.0f}));
+}
+
+void ShapeBatchTest::box() {
+    const Matrix4 transformation = Matrix4::translation({1.0f, 2.0f, 3.0f})*
+        Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling({2.0f, 0.5f, 3.0f});
+
+    BoxBatch3D a;
+    a.add(Box3D{transformation});
+
+    /* Center */
+    CORRADE_COMPARE(a.component(0)[0], 1.0f);
+    CORRADE_COMPARE(a.component(2)[0], 3.0f);
+    /* Normalized Y axis */
+    CORRADE_COMPARE(Vector3(a.component(6)[0], a.component(7)[0], a.component(8)[0]), Matrix4::rotationZ(Deg(30.0f)).up());
+    /* Half extents */
+    CORRADE_COMPARE(Vector3(a.component(12)[0], a.component(13)[0], a.component(14)[0]), (Vector3{2.0f, 0.5f, 3.0f}));
+
+    CORRADE_COMPARE(a[0].transformation(), transformation);
+}
+
+void ShapeBatchTest::pointsSphere() {
+    std::mt19937 rng;
+    PointBatch3D a;
+    for(std::size_t i = 0; i != Count; ++i)
+        a.add(Point3D{randomVector(rng, 2.0f)});
+
+    const Sphere3D sphere{{0.5f, -0.25f, 0.0f}, 1.5f};
+    Containers::Array<UnsignedByte> mask{Containers::ValueInit, (Count + 7)/8};
+    collides(a, sphere, mask);
+
+    std::size_t hits = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_COMPARE(bit(mask, i), sphere % a[i]);
+        hits += bit(mask, i);
+    }
+
+    /* Verify the test isn't trivial */
+    CORRADE_VERIFY(hits > Count/10);
+    CORRADE_VERIFY(hits < Count*9/10);
+}
+
+void ShapeBatchTest::spheresPoint() {
+    std::mt19937 rng;
+    std::uniform_real_distribution<Float> radius{0.1f, 1.5f};
+    SphereBatch2D a;
+    for(std::size_t i = 0; i != Count; ++i)
+        a.add({randomVector(rng, 2.0f).xy(), radius(rng)});
+
+    const Point2D point{{0.25f, 0.5f}};
+    Containers::Array<UnsignedByte> mask{Containers::ValueInit, (Count + 7)/8};
+    collides(a, point, mask);
+
+    std::size_t hits = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_COMPARE(bit(mask, i), a[i] % point);
+        hits += bit(mask, i);
+    }
+
+    CORRADE_VERIFY(hits > Count/10);
+    CORRADE_VERIFY(hits < Count*9/10);
+}
+
+void ShapeBatchTest::spheresSphere() {
+    std::mt19937 rng;
+    std::uniform_real_distribution<Float> radius{0.1f, 0.5f};
+    SphereBatch3D a;
+    for(std::size_t i = 0; i != Count; ++i)
+        a.add({randomVector(rng, 2.0f), radius(rng)});
+
+    const Sphere3D sphere{{-0.5f, 0.0f, 0.25f}, 1.0f};
+    Containers::Array<UnsignedByte> mask{Containers::ValueInit, (Count + 7)/8};
+    collides(a, sphere, mask);
+
+    std::size_t hits = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_COMPARE(bit(mask, i), a[i] % sphere);
+        hits += bit(mask, i);
+    }
+
+    CORRADE_VERIFY(hits > Count/10);
+    CORRADE_VERIFY(hits < Count*9/10);
+}
+
+void ShapeBatchTest::axisAlignedBoxesSphere() {
+    std::mt19937 rng;
+    AxisAlignedBoxBatch3D a;
+    for(std::size_t i = 0; i != Count; ++i) {
+        const Vector3 min = randomVector(rng, 2.0f);
+        a.add({min, min + Math::abs(randomVector(rng, 0.5f))});
+    }
+
+    const Sphere3D sphere{{0.5f, -0.25f, 0.0f}, 1.0f};
+    Containers::Array<UnsignedByte> mask{Containers::ValueInit, (Count + 7)/8};
+    collides(a, sphere, mask);
+
+    std::size_t hits = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        const AxisAlignedBox3D box = a[i];
+        const Vector3 closest = Math::clamp(sphere.position(), box.min(), box.max());
+        CORRADE_COMPARE(bit(mask, i), (sphere.position() - closest).dot() < Math::pow<2>(sphere.radius()));
+        hits += bit(mask, i);
+    }
+
+    CORRADE_VERIFY(hits > Count/10);
+    CORRADE_VERIFY(hits < Count*9/10);
+
+    /* Sphere center inside the box */
+    AxisAlignedBoxBatch3D b;
+    b.add({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+    collides(b, Sphere3D{{}, 0.1f}, mask);
+    CORRADE_VERIFY(bit(mask, 0));
+}
+
+void ShapeBatchTest::boxesSphere() {
+    std::mt19937 rng;
+    std::uniform_real_distribution<Float> angle{0.0f, 6.28f};
+    std::vector<std::tuple<Vector3, Rad, Vector3>> boxes;
+    BoxBatch3D a;
+    for(std::size_t i = 0; i != Count; ++i) {
+        const Vector3 center = randomVector(rng, 2.0f);
+        const Rad rotation{angle(rng)};
+        const Vector3 extent = Math::abs(randomVector(rng, 0.5f));
+        boxes.emplace_back(center, rotation, extent);
+        a.add(Box3D{Matrix4::translation(center)*Matrix4::rotationY(rotation)*Matrix4::scaling(extent)});
+    }
+
+    const Sphere3D sphere{{0.5f, -0.25f, 0.0f}, 1.0f};
+    Containers::Array<UnsignedByte> mask{Containers::ValueInit, (Count + 7)/8};
+    collides(a, sphere, mask);
+
+    std::size_t hits = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_COMPARE(bit(mask, i), boxSphere(std::get<0>(boxes[i]), std::get<1>(boxes[i]), std::get<2>(boxes[i]), sphere));
+        hits += bit(mask, i);
+    }
+
+    CORRADE_VERIFY(hits > Count/10);
+    CORRADE_VERIFY(hits < Count*9/10);
+}
+
+void ShapeBatchTest::capsulesSphere() {
+    std::mt19937 rng;
+    std::uniform_real_distribution<Float> radius{0.1f, 0.5f};
+    CapsuleBatch3D a;
+    for(std::size_t i = 0; i != Count; ++i) {
+        const Vector3 p = randomVector(rng, 2.0f);
+        a.add({p, p + randomVector(rng, 1.0f), radius(rng)});
+    }
+
+    /* Degenerate capsule is treated as a sphere. Capsule::operator%()
+       divides by zero in that case, so it's not used as a reference. */
+    a.set(7, {{0.5f, 0.0f, 0.0f}, {0.5f, 0.0f, 0.0f}, 0.5f});
+
+    const Sphere3D sphere{{0.5f, -0.25f, 0.0f}, 0.75f};
+    Containers::Array<UnsignedByte> mask{Containers::ValueInit, (Count + 7)/8};
+    collides(a, sphere, mask);
+
+    std::size_t hits = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        if(i != 7) CORRADE_COMPARE(bit(mask, i), a[i] % sphere);
+        hits += bit(mask, i);
+    }
+
+    CORRADE_VERIFY(bit(mask, 7));
+    CORRADE_VERIFY(hits > Count/10);
+    CORRADE_VERIFY(hits < Count*9/10);
+}
+
+void ShapeBatchTest::maskUnusedBits() {
+    PointBatch2D a;
+    for(std::size_t i = 0; i != 11; ++i)
+        a.add(Point2D{});
+
+    Containers::Array<UnsignedByte> mask{3};
+    for(UnsignedByte& i: mask) i = 0xff;
+    collides(a, Sphere2D{{}, 1.0f}, mask);
+
+    CORRADE_COMPARE(mask[0], 0xff);
+    CORRADE_COMPARE(mask[1], 0x07);
+    /* Bytes past the batch are not touched */
+    CORRADE_COMPARE(mask[2], 0xff);
+}
+
+void ShapeBatchTest::collidingPairs() {
+    PointBatch2D a;
+    a.add(Point2D{{0.0f, 0.0f}})
+     .add(Point2D{{5.0f, 0.0f}})
+     .add(Point2D{{1.0f, 0.0f}});
+
+    SphereBatch2D b;
+    b.add({{1.0f, 0.0f}, 1.5f})
+     .add({{10.0f, 0.0f}, 1.0f})
+     .add({{5.0f, 0.5f}, 1.0f});
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> pairs;
+    Shapes::collidingPairs(a, b, pairs);
+    CORRADE_COMPARE(pairs, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {0, 0}, {2, 0}, {1, 2}}));
+
+    /* Against the per-pair test */
+    std::mt19937 rng;
+    std::uniform_real_distribution<Float> radius{0.1f, 0.5f};
+    CapsuleBatch3D c;
+    SphereBatch3D d;
+    for(std::size_t i = 0; i != 300; ++i) {
+        const Vector3 p = randomVector(rng, 2.0f);
+        c.add({p, p + randomVector(rng, 1.0f), radius(rng)});
+    }
+    for(std::size_t i = 0; i != 20; ++i)
+        d.add({randomVector(rng, 2.0f), radius(rng)});
+
+    pairs.clear();
+    Shapes::collidingPairs(c, d, pairs);
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> expected;
+    for(std::size_t j = 0; j != d.size(); ++j)
+        for(std::size_t i = 0; i != c.size(); ++i)
+            if(c[i] % d[j]) expected.emplace_back(i, j);
+    CORRADE_VERIFY(!expected.empty());
+    CORRADE_COMPARE(pairs, expected);
+}
+
+void ShapeBatchTest::collidingPairsAppend() {
+    SphereBatch3D a;
+    a.add({{}, 1.0f});
+    SphereBatch3D b;
+    b.add({{0.5f, 0.0f, 0.0f}, 1.0f});
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> pairs{{7, 8}};
+    Shapes::collidingPairs(a, b, pairs);
+    CORRADE_COMPARE(pairs, (std::vector<std::pair<UnsignedInt, UnsignedInt>>{
+        {7, 8}, {0, 0}}));
+}
+
+namespace {
+    constexpr std::size_t BenchmarkCount = 100000;
+
+    PointBatch3D benchmarkPoints() {
+        std::mt19937 rng;
+        PointBatch3D points;
+        points.reserve(BenchmarkCount);
+        for(std::size_t i = 0; i != BenchmarkCount; ++i)
+            points.add(Point3D{randomVector(rng, 2.0f)});
+        return points;
+    }
+
+    const Sphere3D BenchmarkSphere{{0.5f, -0.25f, 0.0f}, 1.5f};
+}
+
+void ShapeBatchTest::benchmarkBatch() {
+    const PointBatch3D points = benchmarkPoints();
+    Containers::Array<UnsignedByte> mask{Containers::ValueInit, (points.size() + 7)/8};
+
+    CORRADE_BENCHMARK(10)
+        collides(points, BenchmarkSphere, mask);
+
+    std::size_t hits = 0;
+    for(std::size_t i = 0; i != points.size(); ++i)
+        hits += bit(mask, i);
+    CORRADE_VERIFY(hits);
+}
+
+void ShapeBatchTest::benchmarkOperator() {
+    const PointBatch3D batch = benchmarkPoints();
+    std::vector<Point3D> points;
+    for(std::size_t i = 0; i != batch.size(); ++i)
+        points.push_back(batch[i]);
+    std::vector<bool> hits(points.size());
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != points.size(); ++i)
+            hits[i] = BenchmarkSphere % points[i];
+
+    CORRADE_VERIFY(std::find(hits.begin(), hits.end(), true) != hits.end());
+}
+
+void ShapeBatchTest::benchmarkAbstract() {
+    const PointBatch3D batch = benchmarkPoints();
+    std::vector<Implementation::Shape<Point3D>> points;
+    for(std::size_t i = 0; i != batch.size(); ++i)
+        points.emplace_back(batch[i]);
+    const Implementation::Shape<Sphere3D> sphere{BenchmarkSphere};
+    std::vector<bool> hits(points.size());
+
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != points.size(); ++i)
+            hits[i] = Implementation::collides(points[i], sphere);
+
+    CORRADE_VERIFY(std::find(hits.begin(), hits.end(), true) != hits.end());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::ShapeBatchTest)
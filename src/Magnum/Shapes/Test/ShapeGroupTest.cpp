@@ -0,0 +1,727 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Line.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Shape.h"
+#include "Magnum/Shapes/ShapeGroup.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct ShapeGroupTest: TestSuite::Tester {
+    explicit ShapeGroupTest();
+
+    void firstCollisionBounds();
+    void collidingPairs();
+    void collidingPairsUnbounded();
+    void collidingPairsLarge();
+    void collidingPairsHuge();
+    void collidingPairsRandom();
+    void collidingPairsReuse();
+    void allCollisions();
+
+    void parallelClean();
+    void parallelCleanNothingDirty();
+    void parallelCollidingPairs();
+    void parallelAllCollisions();
+
+    void contacts();
+    void contactsUnbounded();
+    void contactsMembership();
+    void contactsRandom();
+
+    void debugBroadPhase();
+    void debugContactState();
+
+    template<BroadPhase broadPhase> void benchmark();
+    void benchmarkSerial();
+    template<std::size_t threadCount> void benchmarkParallel();
+    void benchmarkContacts();
+    void benchmarkContactsAllCollisions();
+
+    private:
+        template<class F> void benchmarkContactsImplementation(F update);
+};
+
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+namespace {
+    constexpr BroadPhase BroadPhases[]{BroadPhase::None, BroadPhase::SweepAndPrune, BroadPhase::HashGrid};
+
+    /* Random spheres in a cube, each object having one shape */
+    void populate(Scene3D& scene, ShapeGroup3D& shapes, std::size_t count, Float size, Float radius) {
+        std::mt19937 rng;
+        std::uniform_real_distribution<Float> position{-size, size};
+        for(std::size_t i = 0; i != count; ++i) {
+            auto o = new Object3D{&scene};
+            o->translate({position(rng), position(rng), position(rng)});
+            new Shape<Sphere3D>{*o, {{}, radius}, &shapes};
+        }
+    }
+
+    template<UnsignedInt dimensions> std::vector<std::pair<std::size_t, std::size_t>> indices(const ShapeGroup<dimensions>& shapes, const std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>>& pairs) {
+        std::vector<std::pair<std::size_t, std::size_t>> out;
+        for(const auto& pair: pairs) {
+            std::size_t a = 0, b = 0;
+            for(std::size_t i = 0; i != shapes.size(); ++i) {
+                if(&shapes[i] == pair.first) a = i;
+                if(&shapes[i] == pair.second) b = i;
+            }
+            out.emplace_back(a, b);
+        }
+        return out;
+    }
+
+    /* Contacts as shape indices and states */
+    template<UnsignedInt dimensions> std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>> contactIndices(const ShapeGroup<dimensions>& shapes, const std::vector<Contact<dimensions>>& contacts) {
+        std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>> out;
+        for(const Contact<dimensions>& contact: contacts) {
+            out.emplace_back(indices(shapes, {{&contact.a(), &contact.b()}})[0], contact.state());
+        }
+        return out;
+    }
+
+    /* Executes the chunks on given count of threads */
+    template<class F> void runChunks(std::size_t threadCount, std::size_t chunkCount, F chunkFunction) {
+        std::vector<std::thread> threads(threadCount - 1);
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]() {
+            for(std::size_t chunk; (chunk = next++) < chunkCount; )
+                chunkFunction(chunk);
+        };
+        for(std::thread& thread: threads) thread = std::thread{worker};
+        worker();
+        for(std::thread& thread: threads) thread.join();
+    }
+}
+
+ShapeGroupTest::ShapeGroupTest() {
+    addTests({&ShapeGroupTest::firstCollisionBounds,
+              &ShapeGroupTest::collidingPairs,
+              &ShapeGroupTest::collidingPairsUnbounded,
+              &ShapeGroupTest::collidingPairsLarge,
+              &ShapeGroupTest::collidingPairsHuge,
+              &ShapeGroupTest::collidingPairsRandom,
+              &ShapeGroupTest::collidingPairsReuse,
+              &ShapeGroupTest::allCollisions,
+
+              &ShapeGroupTest::parallelClean,
+              &ShapeGroupTest::parallelCleanNothingDirty,
+              &ShapeGroupTest::parallelCollidingPairs,
+              &ShapeGroupTest::parallelAllCollisions,
+
+              &ShapeGroupTest::contacts,
+              &ShapeGroupTest::contactsUnbounded,
+              &ShapeGroupTest::contactsMembership,
+              &ShapeGroupTest::contactsRandom,
+
+              &ShapeGroupTest::debugBroadPhase,
+              &ShapeGroupTest::debugContactState});
+
+    addBenchmarks<ShapeGroupTest>({&ShapeGroupTest::benchmark<BroadPhase::None>,
+                                   &ShapeGroupTest::benchmark<BroadPhase::SweepAndPrune>,
+                                   &ShapeGroupTest::benchmark<BroadPhase::HashGrid>}, 3);
+
+    addBenchmarks<ShapeGroupTest>({&ShapeGroupTest::benchmarkSerial,
+                                   &ShapeGroupTest::benchmarkParallel<1>,
+                                   &ShapeGroupTest::benchmarkParallel<2>,
+                                   &ShapeGroupTest::benchmarkParallel<4>,
+                                   &ShapeGroupTest::benchmarkParallel<8>}, 3);
+
+    addBenchmarks({&ShapeGroupTest::benchmarkContacts,
+                   &ShapeGroupTest::benchmarkContactsAllCollisions}, 3);
+}
+
+void ShapeGroupTest::firstCollisionBounds() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    Object2D a(&scene);
+    Shape<Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+
+    /* Bounds of the point don't overlap the sphere */
+    Object2D b(&scene);
+    Shape<Point2D> bShape(b, {{3.0f, 0.0f}}, &shapes);
+
+    /* Line has no bounds and thus is always tested */
+    Object2D c(&scene);
+    Shape<Line2D> cShape(c, {{5.0f, -1.0f}, {5.0f, 1.0f}}, &shapes);
+
+    CORRADE_VERIFY(!shapes.firstCollision(aShape));
+    CORRADE_VERIFY(!shapes.firstCollision(bShape));
+
+    c.translate(Vector2::xAxis(-4.5f));
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == &cShape);
+    CORRADE_VERIFY(shapes.firstCollision(cShape) == &aShape);
+
+    b.translate(Vector2::xAxis(-2.5f));
+    CORRADE_VERIFY(shapes.firstCollision(aShape) == &bShape);
+}
+
+void ShapeGroupTest::collidingPairs() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* 0 and 1 collide, 2 is alone, 3 collides with 1 and 4 */
+    Object2D o0(&scene), o1(&scene), o2(&scene), o3(&scene), o4(&scene);
+    Shape<Sphere2D> s0(o0, {{0.0f, 0.0f}, 1.0f}, &shapes);
+    Shape<Sphere2D> s1(o1, {{1.5f, 0.0f}, 1.0f}, &shapes);
+    Shape<Sphere2D> s2(o2, {{10.0f, 10.0f}, 1.0f}, &shapes);
+    Shape<Sphere2D> s3(o3, {{3.0f, 0.5f}, 1.0f}, &shapes);
+    Shape<Point2D> s4(o4, {{3.5f, 1.0f}}, &shapes);
+
+    for(BroadPhase broadPhase: BroadPhases) {
+        shapes.setBroadPhase(broadPhase);
+        CORRADE_COMPARE(shapes.broadPhase(), broadPhase);
+        CORRADE_COMPARE(indices(shapes, shapes.collidingPairs()), (std::vector<std::pair<std::size_t, std::size_t>>{
+            {0, 1}, {1, 3}, {3, 4}}));
+    }
+
+    /* Moving an object is picked up */
+    o2.translate({-8.5f, -10.0f});
+    for(BroadPhase broadPhase: BroadPhases) {
+        shapes.setBroadPhase(broadPhase);
+        CORRADE_COMPARE(indices(shapes, shapes.collidingPairs()), (std::vector<std::pair<std::size_t, std::size_t>>{
+            {0, 1}, {0, 2}, {1, 2}, {1, 3}, {2, 3}, {3, 4}}));
+    }
+}
+
+void ShapeGroupTest::collidingPairsUnbounded() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D o0(&scene), o1(&scene), o2(&scene), o3(&scene);
+    Shape<Sphere3D> s0(o0, {{0.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Shape<Line3D> s1(o1, {{-1.0f, 0.5f, 0.0f}, {1.0f, 0.5f, 0.0f}}, &shapes);
+    Shape<Sphere3D> s2(o2, {{100.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Shape<Sphere3D> s3(o3, {{0.0f, 100.0f, 0.0f}, 1.0f}, &shapes);
+
+    for(BroadPhase broadPhase: BroadPhases) {
+        shapes.setBroadPhase(broadPhase);
+        CORRADE_COMPARE(indices(shapes, shapes.collidingPairs()), (std::vector<std::pair<std::size_t, std::size_t>>{
+            {0, 1}, {1, 2}}));
+    }
+}
+
+void ShapeGroupTest::collidingPairsLarge() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+    shapes.setBroadPhase(BroadPhase::HashGrid)
+        .setGridCellSize(0.5f);
+    CORRADE_COMPARE(shapes.gridCellSize(), 0.5f);
+
+    /* The big sphere spans far more cells than a shape can be inserted into */
+    Object2D o0(&scene), o1(&scene), o2(&scene), o3(&scene);
+    Shape<Point2D> s0(o0, {{-19.5f, 0.0f}}, &shapes);
+    Shape<Sphere2D> s1(o1, {{}, 20.0f}, &shapes);
+    Shape<Point2D> s2(o2, {{30.0f, 0.0f}}, &shapes);
+    Shape<Sphere2D> s3(o3, {{19.5f, 0.0f}, 0.25f}, &shapes);
+
+    CORRADE_COMPARE(indices(shapes, shapes.collidingPairs()), (std::vector<std::pair<std::size_t, std::size_t>>{
+        {0, 1}, {1, 3}}));
+}
+
+void ShapeGroupTest::collidingPairsHuge() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    shapes.setGridCellSize(1.0f);
+
+    /* The box spans 65536x1x65536 cells, the cell count overflows 32 bits */
+    Object3D o0(&scene), o1(&scene);
+    Shape<AxisAlignedBox3D> s0(o0, {{}, {65535.5f, 0.5f, 65535.5f}}, &shapes);
+    Shape<Point3D> s1(o1, {{100.0f, 0.25f, 100.0f}}, &shapes);
+
+    for(BroadPhase broadPhase: BroadPhases) {
+        shapes.setBroadPhase(broadPhase);
+        CORRADE_COMPARE(indices(shapes, shapes.collidingPairs()), (std::vector<std::pair<std::size_t, std::size_t>>{
+            {0, 1}}));
+    }
+}
+
+void ShapeGroupTest::collidingPairsRandom() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    populate(scene, shapes, 500, 10.0f, 0.75f);
+
+    shapes.setBroadPhase(BroadPhase::None);
+    const std::vector<std::pair<AbstractShape3D*, AbstractShape3D*>> expected = shapes.collidingPairs();
+    CORRADE_VERIFY(!expected.empty());
+
+    shapes.setBroadPhase(BroadPhase::SweepAndPrune);
+    CORRADE_VERIFY(shapes.collidingPairs() == expected);
+
+    /* Cell size both smaller and larger than the shapes */
+    shapes.setBroadPhase(BroadPhase::HashGrid);
+    for(Float cellSize: {0.3f, 1.5f, 4.0f}) {
+        shapes.setGridCellSize(cellSize);
+        CORRADE_VERIFY(shapes.collidingPairs() == expected);
+    }
+}
+
+void ShapeGroupTest::collidingPairsReuse() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    populate(scene, shapes, 200, 5.0f, 0.75f);
+
+    for(BroadPhase broadPhase: BroadPhases) {
+        shapes.setBroadPhase(broadPhase);
+        const auto& pairs = shapes.collidingPairs();
+        const std::size_t size = pairs.size();
+        const void* data = pairs.data();
+
+        /* Same output into the same memory */
+        CORRADE_VERIFY(&shapes.collidingPairs() == &pairs);
+        CORRADE_COMPARE(pairs.size(), size);
+        CORRADE_VERIFY(pairs.data() == data);
+    }
+}
+
+void ShapeGroupTest::allCollisions() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D o0(&scene), o1(&scene), o2(&scene);
+    Shape<Sphere3D> s0(o0, {{}, 1.0f}, &shapes);
+    Shape<Sphere3D> s1(o1, {{1.5f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    /* Line-sphere has only the boolean test implemented */
+    Shape<Line3D> s2(o2, {{-0.5f, 0.5f, -1.0f}, {-0.5f, 0.5f, 1.0f}}, &shapes);
+
+    const auto& collisions = shapes.allCollisions();
+    CORRADE_COMPARE(collisions.size(), 2);
+
+    CORRADE_VERIFY(std::get<0>(collisions[0]) == &s0);
+    CORRADE_VERIFY(std::get<1>(collisions[0]) == &s1);
+    CORRADE_VERIFY(std::get<2>(collisions[0]));
+    CORRADE_COMPARE(std::get<2>(collisions[0]).separationDistance(), 0.5f);
+
+    CORRADE_VERIFY(std::get<0>(collisions[1]) == &s0);
+    CORRADE_VERIFY(std::get<1>(collisions[1]) == &s2);
+    CORRADE_VERIFY(!std::get<2>(collisions[1]));
+}
+
+void ShapeGroupTest::parallelClean() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene), b(&scene);
+    Shape<Sphere3D> aShape(a, {{}, 1.0f}, &shapes);
+    Shape<Point3D> bShape(b, {{}}, &shapes);
+    shapes.setClean();
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    a.translate(Vector3::xAxis(5.0f));
+    b.translate(Vector3::xAxis(5.5f));
+    CORRADE_VERIFY(shapes.isDirty());
+
+    /* The objects are clean, but the shapes are not transformed yet */
+    CORRADE_COMPARE(shapes.beginClean(), 1);
+    CORRADE_COMPARE(shapes.cleanChunkCount(), 1);
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(aShape.transformedShape().position(), Vector3{});
+
+    shapes.cleanChunk(0);
+    CORRADE_COMPARE(aShape.transformedShape().position(), Vector3::xAxis(5.0f));
+    CORRADE_COMPARE(bShape.transformedShape().position(), Vector3::xAxis(5.5f));
+
+    /* The bounds are updated on the next query */
+    CORRADE_COMPARE(shapes.collidingPairs().size(), 1);
+    CORRADE_VERIFY(!shapes.isDirty());
+}
+
+void ShapeGroupTest::parallelCleanNothingDirty() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    CORRADE_COMPARE(shapes.beginClean(), 0);
+
+    Object3D a(&scene);
+    Shape<Sphere3D> aShape(a, {{}, 1.0f}, &shapes);
+    shapes.setClean();
+    CORRADE_COMPARE(shapes.beginClean(), 0);
+    CORRADE_COMPARE(shapes.cleanChunkCount(), 0);
+}
+
+void ShapeGroupTest::parallelCollidingPairs() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    populate(scene, shapes, 500, 10.0f, 0.75f);
+    shapes.setChunkSize(7);
+    CORRADE_COMPARE(shapes.chunkSize(), 7);
+
+    for(BroadPhase broadPhase: BroadPhases) {
+        shapes.setBroadPhase(broadPhase);
+        const std::vector<std::pair<AbstractShape3D*, AbstractShape3D*>> expected = shapes.collidingPairs();
+        CORRADE_VERIFY(!expected.empty());
+
+        /* Executing the chunks in reverse order gives the same result */
+        const std::size_t chunkCount = shapes.beginCollidingPairs();
+        CORRADE_VERIFY(chunkCount > 1);
+        CORRADE_COMPARE(chunkCount, shapes.collisionChunkCount());
+        for(std::size_t i = chunkCount; i != 0; --i)
+            shapes.collidingPairsChunk(i - 1);
+        CORRADE_VERIFY(shapes.endCollidingPairs() == expected);
+
+        /* Same with threads */
+        runChunks(4, shapes.beginCollidingPairs(), [&](std::size_t chunk) {
+            shapes.collidingPairsChunk(chunk);
+        });
+        CORRADE_VERIFY(shapes.endCollidingPairs() == expected);
+    }
+
+    /* Cleaning in parallel gives the same result as cleaning serially */
+    scene.setDirty();
+    runChunks(4, shapes.beginClean(), [&](std::size_t chunk) {
+        shapes.cleanChunk(chunk);
+    });
+    shapes.beginCollidingPairs();
+    for(std::size_t i = 0; i != shapes.collisionChunkCount(); ++i)
+        shapes.collidingPairsChunk(i);
+    const std::vector<std::pair<AbstractShape3D*, AbstractShape3D*>> parallel = shapes.endCollidingPairs();
+    CORRADE_VERIFY(parallel == shapes.collidingPairs());
+}
+
+void ShapeGroupTest::parallelAllCollisions() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    populate(scene, shapes, 300, 8.0f, 0.75f);
+    shapes.setChunkSize(5);
+
+    const std::vector<std::tuple<AbstractShape3D*, AbstractShape3D*, Collision3D>> expected = shapes.allCollisions();
+    CORRADE_VERIFY(!expected.empty());
+
+    runChunks(4, shapes.beginAllCollisions(), [&](std::size_t chunk) {
+        shapes.allCollisionsChunk(chunk);
+    });
+    const auto& collisions = shapes.endAllCollisions();
+    CORRADE_COMPARE(collisions.size(), expected.size());
+    for(std::size_t i = 0; i != collisions.size(); ++i) {
+        CORRADE_VERIFY(std::get<0>(collisions[i]) == std::get<0>(expected[i]));
+        CORRADE_VERIFY(std::get<1>(collisions[i]) == std::get<1>(expected[i]));
+        CORRADE_COMPARE(std::get<2>(collisions[i]).separationDistance(), std::get<2>(expected[i]).separationDistance());
+    }
+}
+
+void ShapeGroupTest::contacts() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    /* 0 and 1 collide, 2 is alone */
+    Object2D o0(&scene), o1(&scene), o2(&scene);
+    Shape<Sphere2D> s0(o0, {{0.0f, 0.0f}, 1.0f}, &shapes);
+    Shape<Sphere2D> s1(o1, {{1.5f, 0.0f}, 1.0f}, &shapes);
+    Shape<Sphere2D> s2(o2, {{10.0f, 0.0f}, 1.0f}, &shapes);
+
+    /* First update tests everything */
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::Begin}}));
+    CORRADE_COMPARE(shapes.updateContacts()[0].collision().separationDistance(), 0.5f);
+
+    /* Nothing moved, nothing tested, the contact persists with the same
+       data */
+    const auto& contacts = shapes.updateContacts();
+    CORRADE_COMPARE(shapes.contactTestCount(), 0);
+    CORRADE_COMPARE(contactIndices(shapes, contacts), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::Persist}}));
+    CORRADE_COMPARE(contacts[0].collision().separationDistance(), 0.5f);
+
+    /* Moving 2 next to 1 begins a new contact, only pairs with 2 are
+       tested */
+    o2.translate({-7.0f, 0.0f});
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::Persist},
+        {{1, 2}, ContactState::Begin}}));
+    CORRADE_COMPARE(shapes.contactTestCount(), 1);
+
+    /* Moving 0 away ends its contact, the last collision data are kept */
+    o0.translate({-5.0f, 0.0f});
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::End},
+        {{1, 2}, ContactState::Persist}}));
+    CORRADE_COMPARE(shapes.updateContacts()[0].collision().separationDistance(), 0.5f);
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{1, 2}, ContactState::Persist}}));
+
+    /* Changing the shape itself is picked up as well */
+    s2.setShape({{10.0f, 0.0f}, 0.1f});
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{1, 2}, ContactState::End}}));
+    CORRADE_VERIFY(shapes.updateContacts().empty());
+}
+
+void ShapeGroupTest::contactsUnbounded() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D o0(&scene), o1(&scene), o2(&scene);
+    Shape<Sphere3D> s0(o0, {{0.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Shape<Line3D> s1(o1, {{-1.0f, 0.5f, 0.0f}, {1.0f, 0.5f, 0.0f}}, &shapes);
+    Shape<Sphere3D> s2(o2, {{100.0f, 10.0f, 0.0f}, 1.0f}, &shapes);
+
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::Begin}}));
+
+    /* Moving the line tests it against everything */
+    o1.translate({0.0f, 9.5f, 0.0f});
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::End},
+        {{1, 2}, ContactState::Begin}}));
+    CORRADE_COMPARE(shapes.contactTestCount(), 2);
+
+    /* Moving a bounded shape tests it against the line */
+    o0.translate({0.0f, 10.0f, 0.0f});
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::Begin},
+        {{1, 2}, ContactState::Persist}}));
+    CORRADE_COMPARE(shapes.contactTestCount(), 1);
+}
+
+void ShapeGroupTest::contactsMembership() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    auto o0 = new Object2D{&scene};
+    auto o1 = new Object2D{&scene};
+    auto o2 = new Object2D{&scene};
+    auto s0 = new Shape<Sphere2D>{*o0, {{0.0f, 0.0f}, 1.0f}, &shapes};
+    auto s1 = new Shape<Sphere2D>{*o1, {{1.5f, 0.0f}, 1.0f}, &shapes};
+    new Shape<Sphere2D>{*o2, {{3.0f, 0.0f}, 1.0f}, &shapes};
+
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::Begin},
+        {{1, 2}, ContactState::Begin}}));
+
+    /* Contact of the removed shape ends and is reported first, the remaining
+       contact keeps persisting even though the shapes got different
+       indices */
+    delete o0;
+    {
+        const auto& contacts = shapes.updateContacts();
+        CORRADE_COMPARE(contacts.size(), 2);
+        CORRADE_VERIFY(&contacts[0].a() == s0);
+        CORRADE_VERIFY(&contacts[0].b() == s1);
+        CORRADE_COMPARE(contacts[0].state(), ContactState::End);
+        CORRADE_COMPARE(contacts[0].collision().separationDistance(), 0.5f);
+        CORRADE_COMPARE(contactIndices(shapes, {contacts[1]}), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+            {{0, 1}, ContactState::Persist}}));
+    }
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::Persist}}));
+
+    /* Added shape begins a new contact */
+    auto o3 = new Object2D{&scene};
+    new Shape<Point2D>{*o3, {{1.5f, 0.5f}}, &shapes};
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::Persist},
+        {{0, 2}, ContactState::Begin}}));
+    CORRADE_COMPARE(contactIndices(shapes, shapes.updateContacts()), (std::vector<std::pair<std::pair<std::size_t, std::size_t>, ContactState>>{
+        {{0, 1}, ContactState::Persist},
+        {{0, 2}, ContactState::Persist}}));
+    CORRADE_COMPARE(shapes.contactTestCount(), 0);
+
+    /* Removing a shape from the group without deleting it ends its contacts
+       as well */
+    shapes.remove(*s1);
+    {
+        const auto& contacts = shapes.updateContacts();
+        CORRADE_COMPARE(contacts.size(), 2);
+        CORRADE_VERIFY(&contacts[0].a() == s1);
+        CORRADE_COMPARE(contacts[0].state(), ContactState::End);
+        CORRADE_VERIFY(&contacts[1].a() == s1);
+        CORRADE_COMPARE(contacts[1].state(), ContactState::End);
+    }
+}
+
+void ShapeGroupTest::contactsRandom() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    populate(scene, shapes, 500, 10.0f, 0.75f);
+
+    std::vector<std::pair<AbstractShape3D*, AbstractShape3D*>> previous;
+    std::mt19937 rng;
+    std::uniform_int_distribution<std::size_t> index{0, shapes.size() - 1};
+    std::uniform_real_distribution<Float> offset{-1.0f, 1.0f};
+    for(std::size_t frame = 0; frame != 20; ++frame) {
+        /* Move a few shapes, every tenth frame move one really far so it
+           gets out of the sorted order */
+        for(std::size_t i = 0; i != 25; ++i)
+            shapes[index(rng)].object().setDirty();
+        for(std::size_t i = 0; i != 25; ++i) {
+            auto& object = static_cast<Object3D&>(shapes[index(rng)].object());
+            object.translate({offset(rng), offset(rng), offset(rng)});
+        }
+        if(frame % 10 == 5)
+            static_cast<Object3D&>(shapes[index(rng)].object()).translate({-15.0f, 0.0f, 0.0f});
+
+        std::vector<std::pair<AbstractShape3D*, AbstractShape3D*>> current, ended;
+        for(const Contact3D& contact: shapes.updateContacts()) {
+            if(contact.state() == ContactState::End)
+                ended.emplace_back(&contact.a(), &contact.b());
+            else current.emplace_back(&contact.a(), &contact.b());
+        }
+        CORRADE_COMPARE_AS(shapes.contactTestCount(), shapes.size(), TestSuite::Compare::Less);
+
+        /* Active contacts are the same as all collisions */
+        const auto& expected = shapes.allCollisions();
+        CORRADE_COMPARE(current.size(), expected.size());
+        for(std::size_t i = 0; i != std::min(current.size(), expected.size()); ++i) {
+            CORRADE_VERIFY(current[i].first == std::get<0>(expected[i]));
+            CORRADE_VERIFY(current[i].second == std::get<1>(expected[i]));
+        }
+
+        /* Ended contacts are the ones from previous frame that are not
+           active anymore */
+        std::vector<std::pair<AbstractShape3D*, AbstractShape3D*>> expectedEnded;
+        std::set_difference(previous.begin(), previous.end(), current.begin(), current.end(), std::back_inserter(expectedEnded), [&](const std::pair<AbstractShape3D*, AbstractShape3D*>& a, const std::pair<AbstractShape3D*, AbstractShape3D*>& b) {
+            return indices(shapes, {a})[0] < indices(shapes, {b})[0];
+        });
+        CORRADE_VERIFY(ended == expectedEnded);
+
+        previous = std::move(current);
+    }
+}
+
+void ShapeGroupTest::debugBroadPhase() {
+    std::ostringstream out;
+    Debug(&out) << BroadPhase::HashGrid << BroadPhase(0xde);
+    CORRADE_COMPARE(out.str(), "Shapes::BroadPhase::HashGrid Shapes::BroadPhase(0xde)\n");
+}
+
+void ShapeGroupTest::debugContactState() {
+    std::ostringstream out;
+    Debug(&out) << ContactState::Persist << ContactState(0xde);
+    CORRADE_COMPARE(out.str(), "Shapes::ContactState::Persist Shapes::ContactState(0xde)\n");
+}
+
+template<BroadPhase broadPhase> void ShapeGroupTest::benchmark() {
+    /* 20k spheres, on average a few neighbors each */
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    shapes.setBroadPhase(broadPhase)
+        .setGridCellSize(2.0f);
+    populate(scene, shapes, 20000, 20.0f, 1.0f);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1)
+        count += shapes.collidingPairs().size();
+
+    CORRADE_VERIFY(count);
+}
+
+void ShapeGroupTest::benchmarkSerial() {
+    /* 20k moving spheres, each frame all of them need to be transformed
+       again */
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    shapes.setBroadPhase(BroadPhase::HashGrid)
+        .setGridCellSize(2.0f);
+    populate(scene, shapes, 20000, 20.0f, 1.0f);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        scene.setDirty();
+        count += shapes.collidingPairs().size();
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+template<std::size_t threadCount> void ShapeGroupTest::benchmarkParallel() {
+    setTestCaseName(std::string{"benchmarkParallel<"} + std::to_string(threadCount) + ">");
+
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    shapes.setBroadPhase(BroadPhase::HashGrid)
+        .setGridCellSize(2.0f);
+    populate(scene, shapes, 20000, 20.0f, 1.0f);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        scene.setDirty();
+        runChunks(threadCount, shapes.beginClean(), [&](std::size_t chunk) {
+            shapes.cleanChunk(chunk);
+        });
+        runChunks(threadCount, shapes.beginCollidingPairs(), [&](std::size_t chunk) {
+            shapes.collidingPairsChunk(chunk);
+        });
+        count += shapes.endCollidingPairs().size();
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+template<class F> void ShapeGroupTest::benchmarkContactsImplementation(F update) {
+    /* 20k spheres, 5% of them moving a bit each frame */
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    populate(scene, shapes, 20000, 20.0f, 1.0f);
+
+    std::mt19937 rng;
+    std::uniform_int_distribution<std::size_t> index{0, shapes.size() - 1};
+    std::uniform_real_distribution<Float> offset{-0.1f, 0.1f};
+    update(shapes);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != shapes.size()/20; ++i)
+            static_cast<Object3D&>(shapes[index(rng)].object()).translate({offset(rng), offset(rng), offset(rng)});
+        count += update(shapes);
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+void ShapeGroupTest::benchmarkContacts() {
+    benchmarkContactsImplementation([](ShapeGroup3D& shapes) {
+        return shapes.updateContacts().size();
+    });
+}
+
+void ShapeGroupTest::benchmarkContactsAllCollisions() {
+    benchmarkContactsImplementation([](ShapeGroup3D& shapes) {
+        return shapes.allCollisions().size();
+    });
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::ShapeGroupTest)
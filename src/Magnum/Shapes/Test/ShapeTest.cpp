@@ -23,16 +23,24 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Shapes/Capsule.h"
 #include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Plane.h"
 #include "Magnum/Shapes/Point.h"
 #include "Magnum/Shapes/Shape.h"
 #include "Magnum/Shapes/ShapeGroup.h"
 #include "Magnum/Shapes/Sphere.h"
+#include "Magnum/SceneGraph/DualComplexTransformation.h"
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/RigidMatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TranslationTransformation.h"
 
 namespace Magnum { namespace Shapes { namespace Test {
 
@@ -44,6 +52,13 @@ struct ShapeTest: TestSuite::Tester {
     void collision();
     void firstCollision();
     void shapeGroup();
+
+    void lazyTransformation();
+    void rigidTransformation();
+    void rigidTransformationDetection();
+
+    void benchmarkCleanOnly();
+    template<class Transformation> void benchmarkTransform();
 };
 
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
@@ -56,7 +71,15 @@ ShapeTest::ShapeTest() {
               &ShapeTest::collides,
               &ShapeTest::collision,
               &ShapeTest::firstCollision,
-              &ShapeTest::shapeGroup});
+              &ShapeTest::shapeGroup,
+
+              &ShapeTest::lazyTransformation,
+              &ShapeTest::rigidTransformation,
+              &ShapeTest::rigidTransformationDetection});
+
+    addBenchmarks<ShapeTest>({&ShapeTest::benchmarkCleanOnly,
+                              &ShapeTest::benchmarkTransform<SceneGraph::MatrixTransformation3D>,
+                              &ShapeTest::benchmarkTransform<SceneGraph::RigidMatrixTransformation3D>}, 3);
 }
 
 void ShapeTest::clean() {
@@ -219,9 +242,146 @@ void ShapeTest::shapeGroup() {
     const auto& point = shape->transformedShape().get<Shapes::Point2D>(1);
     a.translate(Vector2::xAxis(5.0f));
     a.setClean();
+    CORRADE_COMPARE(shape->transformedShape().size(), 2);
     CORRADE_COMPARE(point.position(), Vector2(5.25f, -1.0f));
 }
 
+void ShapeTest::lazyTransformation() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{1.0f, -2.0f, 3.0f}, 1.5f}, &shapes);
+    a.scale(Vector3(2.0f));
+
+    /* Cleaning the object only saves the transformation */
+    a.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+
+    /* Transformed on first access */
+    CORRADE_COMPARE(aShape.transformedShape().position(), Vector3(2.0f, -4.0f, 6.0f));
+    CORRADE_COMPARE(aShape.transformedShape().radius(), 3.0f);
+
+    /* Cleaned multiple times before the access, only the last transformation
+       is used */
+    a.translate(Vector3::xAxis(1.0f));
+    a.setClean();
+    a.translate(Vector3::xAxis(1.0f));
+    a.setClean();
+    CORRADE_COMPARE(aShape.transformedShape().position(), Vector3(4.0f, -4.0f, 6.0f));
+
+    /* Collision tests transform the shape as well */
+    Object3D b(&scene);
+    Shape<Shapes::Point3D> bShape(b, {{0.0f, -4.0f, 6.0f}}, &shapes);
+    b.translate(Vector3::xAxis(2.0f));
+    a.translate(Vector3::xAxis(-2.0f));
+    shapes.setClean();
+    CORRADE_VERIFY(aShape.collides(bShape));
+    CORRADE_COMPARE(bShape.transformedShape().position(), Vector3(2.0f, -4.0f, 6.0f));
+
+    /* Setting a new shape is transformed with the current transformation */
+    aShape.setShape({{1.0f, 0.0f, 0.0f}, 0.5f});
+    CORRADE_COMPARE(aShape.transformedShape().position(), Vector3(2.0f, 0.0f, 0.0f));
+    CORRADE_COMPARE(aShape.transformedShape().radius(), 1.0f);
+}
+
+void ShapeTest::rigidTransformation() {
+    typedef SceneGraph::Scene<SceneGraph::RigidMatrixTransformation3D> RigidScene3D;
+    typedef SceneGraph::Object<SceneGraph::RigidMatrixTransformation3D> RigidObject3D;
+
+    RigidScene3D scene;
+    RigidObject3D a(&scene);
+    a.rotateY(Deg(90.0f))
+     .translate({1.0f, 2.0f, 3.0f});
+
+    const Shapes::Sphere3D sphere{{1.0f, 0.0f, 0.0f}, 0.5f};
+    const Shapes::Capsule3D capsule{{}, {0.0f, 0.0f, 1.0f}, 0.25f};
+    const Shapes::Plane plane{{1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}};
+    Shape<Shapes::Sphere3D> sphereShape(a, sphere);
+    Shape<Shapes::Capsule3D> capsuleShape(a, capsule);
+    Shape<Shapes::Plane> planeShape(a, plane);
+    a.setClean();
+
+    /* The rigid path should give the same result as the general one */
+    const Matrix4 transformation = a.absoluteTransformationMatrix();
+    CORRADE_COMPARE(sphereShape.transformedShape().position(), sphere.transformed(transformation).position());
+    CORRADE_COMPARE(sphereShape.transformedShape().radius(), 0.5f);
+    CORRADE_COMPARE(capsuleShape.transformedShape().a(), capsule.transformed(transformation).a());
+    CORRADE_COMPARE(capsuleShape.transformedShape().b(), capsule.transformed(transformation).b());
+    CORRADE_COMPARE(capsuleShape.transformedShape().radius(), 0.25f);
+    CORRADE_COMPARE(planeShape.transformedShape().position(), plane.transformed(transformation).position());
+    CORRADE_COMPARE(planeShape.transformedShape().normal(), plane.transformed(transformation).normal());
+}
+
+void ShapeTest::rigidTransformationDetection() {
+    {
+        Scene3D scene;
+        Object3D a(&scene);
+        CORRADE_VERIFY(!Implementation::isRigidTransformation(a));
+    } {
+        Scene2D scene;
+        Object2D a(&scene);
+        CORRADE_VERIFY(!Implementation::isRigidTransformation(a));
+    } {
+        SceneGraph::Scene<SceneGraph::RigidMatrixTransformation3D> scene;
+        SceneGraph::Object<SceneGraph::RigidMatrixTransformation3D> a(&scene);
+        CORRADE_VERIFY(Implementation::isRigidTransformation(a));
+    } {
+        SceneGraph::Scene<SceneGraph::DualQuaternionTransformation> scene;
+        SceneGraph::Object<SceneGraph::DualQuaternionTransformation> a(&scene);
+        CORRADE_VERIFY(Implementation::isRigidTransformation(a));
+    } {
+        SceneGraph::Scene<SceneGraph::DualComplexTransformation> scene;
+        SceneGraph::Object<SceneGraph::DualComplexTransformation> a(&scene);
+        CORRADE_VERIFY(Implementation::isRigidTransformation(a));
+    } {
+        SceneGraph::Scene<SceneGraph::TranslationTransformation2D> scene;
+        SceneGraph::Object<SceneGraph::TranslationTransformation2D> a(&scene);
+        CORRADE_VERIFY(Implementation::isRigidTransformation(a));
+    }
+}
+
+void ShapeTest::benchmarkCleanOnly() {
+    /* Objects are cleaned e.g. for rendering, but the shapes are not queried
+       for collisions */
+    Scene3D scene;
+    std::vector<std::unique_ptr<Object3D>> objects;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        objects.emplace_back(new Object3D{&scene});
+        new Shape<Shapes::Capsule3D>(*objects.back(), {{}, {0.0f, 1.0f, 0.0f}, 0.5f});
+    }
+
+    CORRADE_BENCHMARK(10) {
+        for(std::unique_ptr<Object3D>& object: objects) {
+            object->translate(Vector3::xAxis(0.01f));
+            object->setClean();
+        }
+    }
+}
+
+template<class Transformation> void ShapeTest::benchmarkTransform() {
+    setTestCaseName(std::string{"benchmarkTransform<"} + (std::is_same<Transformation, SceneGraph::MatrixTransformation3D>::value ? "MatrixTransformation3D" : "RigidMatrixTransformation3D") + ">");
+
+    SceneGraph::Scene<Transformation> scene;
+    std::vector<std::unique_ptr<SceneGraph::Object<Transformation>>> objects;
+    std::vector<Shape<Shapes::Capsule3D>*> shapes;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        objects.emplace_back(new SceneGraph::Object<Transformation>{&scene});
+        objects.back()->rotateY(Deg(Float(i)));
+        shapes.push_back(new Shape<Shapes::Capsule3D>(*objects.back(), {{}, {0.0f, 1.0f, 0.0f}, 0.5f}));
+    }
+
+    Float radius = 0.0f;
+    CORRADE_BENCHMARK(10) {
+        for(std::unique_ptr<SceneGraph::Object<Transformation>>& object: objects)
+            object->translate(Vector3::xAxis(0.01f));
+        for(Shape<Shapes::Capsule3D>* shape: shapes)
+            radius += shape->transformedShape().radius();
+    }
+
+    CORRADE_COMPARE(radius, 5000.0f);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shapes::Test::ShapeTest)
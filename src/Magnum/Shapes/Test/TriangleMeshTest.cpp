@@ -0,0 +1,385 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Shape.h"
+#include "Magnum/Shapes/ShapeGroup.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/TriangleMesh.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+#include "ShapeTestBase.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct TriangleMeshTest: TestSuite::Tester {
+    explicit TriangleMeshTest();
+
+    void construct();
+    void constructDefault();
+    void transformed();
+    void collisionPoint();
+    void collisionPointEdge();
+    void collisionLine();
+    void collisionLineSegment();
+    void collisionSphere();
+    void collisionSphereDetailed();
+    void collisionCapsule();
+    void collisionRandom();
+    void composition();
+    void shapeGroup();
+
+    template<std::size_t size> void benchmarkSphere();
+};
+
+TriangleMeshTest::TriangleMeshTest() {
+    addTests({&TriangleMeshTest::construct,
+              &TriangleMeshTest::constructDefault,
+              &TriangleMeshTest::transformed,
+              &TriangleMeshTest::collisionPoint,
+              &TriangleMeshTest::collisionPointEdge,
+              &TriangleMeshTest::collisionLine,
+              &TriangleMeshTest::collisionLineSegment,
+              &TriangleMeshTest::collisionSphere,
+              &TriangleMeshTest::collisionSphereDetailed,
+              &TriangleMeshTest::collisionCapsule,
+              &TriangleMeshTest::collisionRandom,
+              &TriangleMeshTest::composition,
+              &TriangleMeshTest::shapeGroup});
+
+    addBenchmarks<TriangleMeshTest>({&TriangleMeshTest::benchmarkSphere<16>,
+                                     &TriangleMeshTest::benchmarkSphere<64>,
+                                     &TriangleMeshTest::benchmarkSphere<256>}, 3);
+}
+
+namespace {
+    /* Cube from -1 to 1 */
+    const std::vector<Vector3> CubePositions{
+        {-1.0f, -1.0f, -1.0f}, { 1.0f, -1.0f, -1.0f},
+        {-1.0f,  1.0f, -1.0f}, { 1.0f,  1.0f, -1.0f},
+        {-1.0f, -1.0f,  1.0f}, { 1.0f, -1.0f,  1.0f},
+        {-1.0f,  1.0f,  1.0f}, { 1.0f,  1.0f,  1.0f}};
+    const std::vector<UnsignedInt> CubeIndices{
+        0, 2, 1, 1, 2, 3,   /* -Z */
+        4, 5, 6, 5, 7, 6,   /* +Z */
+        0, 1, 4, 1, 5, 4,   /* -Y */
+        2, 6, 3, 3, 6, 7,   /* +Y */
+        0, 4, 2, 2, 4, 6,   /* -X */
+        1, 3, 5, 3, 7, 5};  /* +X */
+
+    /* Height field in the XZ plane with given count of cells on a side */
+    void terrain(std::size_t size, std::vector<Vector3>& positions, std::vector<UnsignedInt>& indices) {
+        for(std::size_t z = 0; z != size + 1; ++z)
+            for(std::size_t x = 0; x != size + 1; ++x)
+                positions.push_back({Float(x), 0.5f*std::sin(Float(x)*0.3f)*std::cos(Float(z)*0.2f), Float(z)});
+        for(UnsignedInt z = 0; z != size; ++z)
+            for(UnsignedInt x = 0; x != size; ++x) {
+                const UnsignedInt i = z*(size + 1) + x;
+                indices.insert(indices.end(), {i, i + UnsignedInt(size) + 1, i + 1,
+                                               i + 1, i + UnsignedInt(size) + 1, i + UnsignedInt(size) + 2});
+            }
+    }
+}
+
+void TriangleMeshTest::construct() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    CORRADE_COMPARE(data.triangleCount(), 12);
+    CORRADE_COMPARE(data.bounds(), (Range3D{Vector3{-1.0f}, Vector3{1.0f}}));
+
+    /* 12 triangles split in halves until there's at most 4 in a leaf --
+       1 + 2 + 4 nodes */
+    CORRADE_COMPARE(data.nodeCount(), 7);
+
+    std::vector<Vector3> positions;
+    std::vector<UnsignedInt> indices;
+    terrain(64, positions, indices);
+    const TriangleMeshData large{positions, indices};
+    CORRADE_COMPARE(large.triangleCount(), 64*64*2);
+    CORRADE_COMPARE_AS(large.nodeCount(), large.triangleCount(), TestSuite::Compare::Less);
+}
+
+void TriangleMeshTest::constructDefault() {
+    const TriangleMeshData data;
+    CORRADE_COMPARE(data.triangleCount(), 0);
+    CORRADE_COMPARE(data.nodeCount(), 0);
+    CORRADE_COMPARE(data.bounds(), Range3D{});
+
+    const TriangleMesh mesh;
+    CORRADE_VERIFY(!mesh.data());
+    CORRADE_VERIFY(!(mesh % Sphere3D{{}, 1.0f}));
+    CORRADE_VERIFY(!(mesh/Sphere3D{{}, 1.0f}));
+
+    /* Mesh with empty data doesn't collide either */
+    const TriangleMesh empty{data};
+    CORRADE_VERIFY(empty.data() == &data);
+    CORRADE_VERIFY(!(empty % Sphere3D{{}, 1.0f}));
+    CORRADE_VERIFY(!(empty % Point3D{{}}));
+}
+
+void TriangleMeshTest::transformed() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    const TriangleMesh mesh{data, Matrix4::translation({1.0f, 2.0f, 3.0f})};
+
+    /* The data are shared, only the transformation changes */
+    const TriangleMesh transformed = mesh.transformed(Matrix4::scaling(Vector3{2.0f}));
+    CORRADE_VERIFY(transformed.data() == &data);
+    CORRADE_COMPARE(transformed.transformation(), Matrix4::scaling(Vector3{2.0f})*Matrix4::translation({1.0f, 2.0f, 3.0f}));
+
+    /* The cube spans from [0, 2, 4] to [4, 6, 8] after the transformation */
+    VERIFY_COLLIDES(transformed, Sphere3D({4.5f, 4.0f, 6.0f}, 0.75f));
+    VERIFY_NOT_COLLIDES(transformed, Sphere3D({4.5f, 4.0f, 6.0f}, 0.25f));
+    VERIFY_NOT_COLLIDES(mesh, Sphere3D({4.5f, 4.0f, 6.0f}, 0.75f));
+}
+
+void TriangleMeshTest::collisionPoint() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    const TriangleMesh mesh{data, Matrix4::translation(Vector3::xAxis(10.0f))*Matrix4::rotationY(Deg(30.0f))};
+
+    VERIFY_COLLIDES(mesh, Point3D({10.0f, 0.0f, 0.0f}));
+    VERIFY_COLLIDES(mesh, Point3D({10.9f, 0.5f, 0.0f}));
+    VERIFY_NOT_COLLIDES(mesh, Point3D({11.5f, 0.0f, 0.0f}));
+    VERIFY_NOT_COLLIDES(mesh, Point3D({0.0f, 0.0f, 0.0f}));
+}
+
+void TriangleMeshTest::collisionPointEdge() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    const TriangleMesh mesh{data};
+
+    /* Points from which the ray used for the inside test goes through a face
+       diagonal, an edge or a vertex shared by more triangles. Each crossing
+       should be counted only once. */
+    const Vector3 direction = Vector3{0.4784f, 0.6142f, 0.6274f}.normalized();
+
+    /* Leaving the cube through them */
+    VERIFY_COLLIDES(mesh, Point3D(Vector3{0.0f, 0.0f, 1.0f} - direction*0.25f));
+    VERIFY_COLLIDES(mesh, Point3D(Vector3{1.0f, 1.0f, 0.0f} - direction*0.25f));
+    VERIFY_COLLIDES(mesh, Point3D(Vector3{1.0f, 1.0f, 1.0f} - direction*0.25f));
+
+    /* Entering the cube through them */
+    VERIFY_NOT_COLLIDES(mesh, Point3D(Vector3{0.0f, 0.0f, -1.0f} - direction*0.25f));
+    VERIFY_NOT_COLLIDES(mesh, Point3D(Vector3{-1.0f, -1.0f, 0.0f} - direction*0.25f));
+    VERIFY_NOT_COLLIDES(mesh, Point3D(Vector3{-1.0f, -1.0f, -1.0f} - direction*0.25f));
+}
+
+void TriangleMeshTest::collisionLine() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    const TriangleMesh mesh{data};
+
+    /* Going through, passing the mesh with both points outside */
+    VERIFY_COLLIDES(mesh, Line3D({5.0f, 0.5f, 0.0f}, {6.0f, 0.5f, 0.0f}));
+    VERIFY_COLLIDES(mesh, Line3D({-5.0f, -5.0f, -5.0f}, {-4.0f, -4.0f, -4.0f}));
+    VERIFY_NOT_COLLIDES(mesh, Line3D({5.0f, 1.5f, 0.0f}, {6.0f, 1.5f, 0.0f}));
+}
+
+void TriangleMeshTest::collisionLineSegment() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    const TriangleMesh mesh{data};
+
+    VERIFY_COLLIDES(mesh, LineSegment3D({5.0f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.0f}));
+    VERIFY_NOT_COLLIDES(mesh, LineSegment3D({5.0f, 0.5f, 0.0f}, {6.0f, 0.5f, 0.0f}));
+
+    /* Completely inside doesn't touch the surface */
+    VERIFY_NOT_COLLIDES(mesh, LineSegment3D({-0.5f, 0.5f, 0.0f}, {0.5f, 0.5f, 0.0f}));
+}
+
+void TriangleMeshTest::collisionSphere() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    const TriangleMesh mesh{data};
+
+    /* Face, edge, corner */
+    VERIFY_COLLIDES(mesh, Sphere3D({1.5f, 0.2f, 0.3f}, 0.75f));
+    VERIFY_NOT_COLLIDES(mesh, Sphere3D({1.5f, 0.2f, 0.3f}, 0.25f));
+    VERIFY_COLLIDES(mesh, Sphere3D({1.5f, 1.5f, 0.0f}, 0.75f));
+    VERIFY_NOT_COLLIDES(mesh, Sphere3D({1.5f, 1.5f, 0.0f}, 0.7f));
+    VERIFY_COLLIDES(mesh, Sphere3D({1.5f, 1.5f, 1.5f}, 0.9f));
+    VERIFY_NOT_COLLIDES(mesh, Sphere3D({1.5f, 1.5f, 1.5f}, 0.85f));
+
+    /* Only the surface is tested */
+    VERIFY_NOT_COLLIDES(mesh, Sphere3D({}, 0.5f));
+    VERIFY_COLLIDES(mesh, Sphere3D({}, 1.5f));
+}
+
+void TriangleMeshTest::collisionSphereDetailed() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    const TriangleMesh mesh{data, Matrix4::scaling(Vector3{2.0f})};
+
+    /* Sphere intersecting the +X face of the cube, which is at x = 2 */
+    const Sphere3D sphere{{2.5f, 0.5f, 0.0f}, 1.0f};
+    const Collision3D collision = mesh/sphere;
+    CORRADE_VERIFY(collision);
+    CORRADE_COMPARE(collision.position(), (Vector3{1.5f, 0.5f, 0.0f}));
+    CORRADE_COMPARE(collision.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(collision.separationDistance(), 0.5f);
+
+    /* Flipped */
+    CORRADE_COMPARE((sphere/mesh).separationNormal(), Vector3::xAxis());
+
+    /* Center on the surface, moving the mesh behind the face */
+    const Collision3D onSurface = mesh/Sphere3D{{2.0f, 0.5f, 0.0f}, 1.0f};
+    CORRADE_COMPARE(onSurface.separationNormal(), -Vector3::xAxis());
+    CORRADE_COMPARE(onSurface.separationDistance(), 1.0f);
+
+    /* No collision */
+    CORRADE_VERIFY(!(mesh/Sphere3D{{3.5f, 0.5f, 0.0f}, 1.0f}));
+}
+
+void TriangleMeshTest::collisionCapsule() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    const TriangleMesh mesh{data};
+
+    /* Passing through with both ends far away */
+    VERIFY_COLLIDES(mesh, Capsule3D({-5.0f, 0.0f, 0.0f}, {5.0f, 0.0f, 0.0f}, 0.1f));
+
+    /* Parallel with an edge */
+    VERIFY_COLLIDES(mesh, Capsule3D({-5.0f, 1.5f, 1.5f}, {5.0f, 1.5f, 1.5f}, 0.75f));
+    VERIFY_NOT_COLLIDES(mesh, Capsule3D({-5.0f, 1.5f, 1.5f}, {5.0f, 1.5f, 1.5f}, 0.65f));
+
+    /* End close to a face */
+    VERIFY_COLLIDES(mesh, Capsule3D({0.0f, 1.5f, 0.0f}, {0.0f, 5.0f, 0.0f}, 0.75f));
+    VERIFY_NOT_COLLIDES(mesh, Capsule3D({0.0f, 1.5f, 0.0f}, {0.0f, 5.0f, 0.0f}, 0.25f));
+}
+
+void TriangleMeshTest::collisionRandom() {
+    /* Random triangle soup, compare the hierarchy against testing each
+       triangle separately */
+    std::mt19937 rng;
+    std::uniform_real_distribution<Float> position{-10.0f, 10.0f};
+    std::uniform_real_distribution<Float> offset{-1.0f, 1.0f};
+    std::vector<Vector3> positions;
+    std::vector<UnsignedInt> indices;
+    std::vector<TriangleMeshData> triangles;
+    for(UnsignedInt i = 0; i != 300; ++i) {
+        const Vector3 center{position(rng), position(rng), position(rng)};
+        std::vector<Vector3> triangle;
+        for(std::size_t j = 0; j != 3; ++j)
+            triangle.push_back(center + Vector3{offset(rng), offset(rng), offset(rng)});
+        positions.insert(positions.end(), triangle.begin(), triangle.end());
+        indices.insert(indices.end(), {i*3, i*3 + 1, i*3 + 2});
+        triangles.emplace_back(triangle, std::vector<UnsignedInt>{0, 1, 2});
+    }
+    const TriangleMeshData data{positions, indices};
+
+    std::size_t collisions = 0;
+    for(std::size_t i = 0; i != 200; ++i) {
+        const Sphere3D sphere{{position(rng), position(rng), position(rng)}, 1.0f};
+        const Capsule3D capsule{sphere.position(), sphere.position() + Vector3{offset(rng), offset(rng), offset(rng)}*3.0f, 0.5f};
+        const LineSegment3D segment{capsule.a(), capsule.b()};
+
+        bool sphereExpected = false, capsuleExpected = false, segmentExpected = false;
+        for(const TriangleMeshData& triangle: triangles) {
+            sphereExpected = sphereExpected || TriangleMesh{triangle} % sphere;
+            capsuleExpected = capsuleExpected || TriangleMesh{triangle} % capsule;
+            segmentExpected = segmentExpected || TriangleMesh{triangle} % segment;
+        }
+
+        CORRADE_COMPARE(TriangleMesh{data} % sphere, sphereExpected);
+        CORRADE_COMPARE(TriangleMesh{data} % capsule, capsuleExpected);
+        CORRADE_COMPARE(TriangleMesh{data} % segment, segmentExpected);
+        if(sphereExpected) ++collisions;
+    }
+
+    /* Verify that the test actually tests something */
+    CORRADE_COMPARE_AS(collisions, 10, TestSuite::Compare::Greater);
+}
+
+void TriangleMeshTest::composition() {
+    const TriangleMeshData data{CubePositions, CubeIndices};
+    const Composition3D composition = TriangleMesh{data} && !Sphere3D{{}, 1.2f};
+    CORRADE_COMPARE(composition.type(0), Composition3D::Type::TriangleMesh);
+
+    /* Touching the cube corner but not the sphere */
+    VERIFY_COLLIDES(composition, Sphere3D({1.5f, 1.5f, 1.5f}, 0.9f));
+    VERIFY_NOT_COLLIDES(composition, Sphere3D({1.5f, 0.0f, 0.0f}, 0.9f));
+
+    const Composition3D transformed = composition.transformed(Matrix4::translation(Vector3::xAxis(10.0f)));
+    CORRADE_COMPARE(transformed.get<TriangleMesh>(0).transformation(), Matrix4::translation(Vector3::xAxis(10.0f)));
+    VERIFY_COLLIDES(transformed, Sphere3D({11.5f, 1.5f, 1.5f}, 0.9f));
+}
+
+void TriangleMeshTest::shapeGroup() {
+    typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+    typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+    const TriangleMeshData data{CubePositions, CubeIndices};
+
+    Scene3D scene;
+    ShapeGroup3D shapes;
+    Object3D level{&scene}, a{&scene}, b{&scene};
+    level.scale(Vector3{2.0f});
+    Shape<TriangleMesh> mesh{level, {data}, &shapes};
+    Shape<Sphere3D> sphere{a, {{2.5f, 0.0f, 0.0f}, 1.0f}, &shapes};
+    Shape<Sphere3D> far{b, {{10.0f, 0.0f, 0.0f}, 1.0f}, &shapes};
+
+    const auto& collisions = shapes.allCollisions();
+    CORRADE_COMPARE(collisions.size(), 1);
+    CORRADE_VERIFY(std::get<0>(collisions[0]) == &mesh);
+    CORRADE_VERIFY(std::get<1>(collisions[0]) == &sphere);
+    CORRADE_COMPARE(std::get<2>(collisions[0]).separationDistance(), 0.5f);
+
+    /* The bounds of the mesh are transformed as well */
+    b.translate(Vector3::xAxis(-12.5f));
+    CORRADE_COMPARE(shapes.collidingPairs().size(), 2);
+    CORRADE_VERIFY(shapes.firstCollision(far) == &mesh);
+}
+
+template<std::size_t size> void TriangleMeshTest::benchmarkSphere() {
+    setTestCaseName(std::string{"benchmarkSphere<"} + std::to_string(size) + ">");
+
+    /* Spheres close to the terrain surface, so the queries need to go down
+       to the leaves */
+    std::vector<Vector3> positions;
+    std::vector<UnsignedInt> indices;
+    terrain(size, positions, indices);
+    const TriangleMeshData data{positions, indices};
+    const TriangleMesh mesh{data};
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<Float> position{0.0f, Float(size)};
+    std::vector<Sphere3D> spheres;
+    for(std::size_t i = 0; i != 10000; ++i)
+        spheres.push_back({{position(rng), 0.5f, position(rng)}, 0.25f});
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Sphere3D& sphere: spheres)
+            if(mesh % sphere) ++count;
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::TriangleMeshTest)
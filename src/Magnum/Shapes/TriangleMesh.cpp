@@ -0,0 +1,480 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TriangleMesh.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes {
+
+namespace {
+    /* Max triangle count in a leaf node */
+    constexpr UnsignedInt LeafSize = 4;
+
+    /* Enough for any tree built by median splits of 32-bit triangle counts */
+    constexpr std::size_t MaxDepth = 64;
+
+    /* Directions of the ray used for inside test, chosen to not be parallel
+       with axis-aligned geometry. The next one is used if the ray goes
+       through an edge or a vertex. */
+    constexpr std::size_t InsideTestDirectionCount = 4;
+    const Vector3 InsideTestDirections[InsideTestDirectionCount]{
+        { 0.4784f,  0.6142f,  0.6274f},
+        {-0.6142f,  0.6274f,  0.4784f},
+        { 0.6274f, -0.4784f,  0.6142f},
+        {-0.4784f, -0.6274f, -0.6142f}};
+
+    Float boxPointDistanceSquared(const Range3D& box, const Vector3& point) {
+        return (Math::max(box.min() - point, Vector3{0.0f}) + Math::max(point - box.max(), Vector3{0.0f})).dot();
+    }
+
+    /* Ray/box slab test for parameter range of the ray */
+    bool boxLine(const Range3D& box, const Vector3& origin, const Vector3& inverseDirection, Float min, Float max) {
+        const Vector3 a = (box.min() - origin)*inverseDirection;
+        const Vector3 b = (box.max() - origin)*inverseDirection;
+        const Vector3 near = Math::min(a, b);
+        const Vector3 far = Math::max(a, b);
+        for(std::size_t i = 0; i != 3; ++i) {
+            /* NaN if the ray is parallel with the slab and starts on its
+               boundary, treat as overlap */
+            if(near[i] == near[i]) min = Math::max(min, near[i]);
+            if(far[i] == far[i]) max = Math::min(max, far[i]);
+        }
+        return min <= max;
+    }
+
+    /* Moller-Trumbore ray/triangle test for parameter range of the ray */
+    bool lineTriangle(const Vector3& origin, const Vector3& direction, const Vector3* triangle, Float min, Float max) {
+        const Vector3 e1 = triangle[1] - triangle[0];
+        const Vector3 e2 = triangle[2] - triangle[0];
+        const Vector3 p = Math::cross(direction, e2);
+        const Float determinant = Math::dot(e1, p);
+        if(determinant == 0.0f) return false;
+
+        const Float inverseDeterminant = 1.0f/determinant;
+        const Vector3 s = origin - triangle[0];
+        const Float u = Math::dot(s, p)*inverseDeterminant;
+        if(u < 0.0f || u > 1.0f) return false;
+
+        const Vector3 q = Math::cross(s, e1);
+        const Float v = Math::dot(direction, q)*inverseDeterminant;
+        if(v < 0.0f || u + v > 1.0f) return false;
+
+        const Float t = Math::dot(e2, q)*inverseDeterminant;
+        return t >= min && t <= max;
+    }
+
+    /* Ray/triangle crossing for the inside test. Returns 1 if the ray from
+       the origin crosses the triangle, 0 if not and -1 if it's too close to
+       an edge or a vertex to tell, because then it might be counted once for
+       each triangle sharing it. The same if the ray lies in the triangle
+       plane. */
+    Int rayTriangleCrossing(const Vector3& origin, const Vector3& direction, const Vector3* triangle) {
+        constexpr Float epsilon = Math::TypeTraits<Float>::epsilon();
+        const Vector3 e1 = triangle[1] - triangle[0];
+        const Vector3 e2 = triangle[2] - triangle[0];
+        const Vector3 s = origin - triangle[0];
+        const Vector3 p = Math::cross(direction, e2);
+        const Float determinant = Math::dot(e1, p);
+
+        /* Parallel with the plane, ambiguous only if lying in it. The
+           determinant is the direction projected on the triangle normal. */
+        const Vector3 normal = Math::cross(e1, e2);
+        const Float normalLength = normal.length();
+        if(Math::abs(determinant) <= epsilon*normalLength) {
+            const Float size = Math::max(e1.length(), e2.length());
+            return Math::abs(Math::dot(s, normal)) <= epsilon*size*normalLength ? -1 : 0;
+        }
+
+        const Float inverseDeterminant = 1.0f/determinant;
+        const Float u = Math::dot(s, p)*inverseDeterminant;
+        const Vector3 q = Math::cross(s, e1);
+        const Float v = Math::dot(direction, q)*inverseDeterminant;
+        if(u < -epsilon || v < -epsilon || u + v > 1.0f + epsilon || Math::dot(e2, q)*inverseDeterminant < 0.0f)
+            return 0;
+        return u <= epsilon || v <= epsilon || u + v >= 1.0f - epsilon ? -1 : 1;
+    }
+
+    /* Closest point on triangle, Ericson: Real-Time Collision Detection,
+       section 5.1.5 */
+    Vector3 closestPointTriangle(const Vector3& point, const Vector3* triangle) {
+        const Vector3& a = triangle[0];
+        const Vector3& b = triangle[1];
+        const Vector3& c = triangle[2];
+        const Vector3 ab = b - a;
+        const Vector3 ac = c - a;
+
+        const Vector3 ap = point - a;
+        const Float d1 = Math::dot(ab, ap);
+        const Float d2 = Math::dot(ac, ap);
+        if(d1 <= 0.0f && d2 <= 0.0f) return a;
+
+        const Vector3 bp = point - b;
+        const Float d3 = Math::dot(ab, bp);
+        const Float d4 = Math::dot(ac, bp);
+        if(d3 >= 0.0f && d4 <= d3) return b;
+
+        const Float vc = d1*d4 - d3*d2;
+        if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+            return a + ab*(d1/(d1 - d3));
+
+        const Vector3 cp = point - c;
+        const Float d5 = Math::dot(ab, cp);
+        const Float d6 = Math::dot(ac, cp);
+        if(d6 >= 0.0f && d5 <= d6) return c;
+
+        const Float vb = d5*d2 - d1*d6;
+        if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+            return a + ac*(d2/(d2 - d6));
+
+        const Float va = d3*d6 - d5*d4;
+        if(va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+            return b + (c - b)*((d4 - d3)/((d4 - d3) + (d5 - d6)));
+
+        /* Inside the face. The sum is zero only for degenerate triangles,
+           which are handled by the edge cases above. */
+        const Float denominator = 1.0f/(va + vb + vc);
+        return a + ab*(vb*denominator) + ac*(vc*denominator);
+    }
+
+    /* Squared distance of two line segments, Ericson: Real-Time Collision
+       Detection, section 5.1.9 */
+    Float lineSegmentLineSegmentSquared(const Vector3& p1, const Vector3& q1, const Vector3& p2, const Vector3& q2) {
+        const Vector3 d1 = q1 - p1;
+        const Vector3 d2 = q2 - p2;
+        const Vector3 r = p1 - p2;
+        const Float a = d1.dot();
+        const Float e = d2.dot();
+        const Float f = Math::dot(d2, r);
+
+        Float s, t;
+        if(a == 0.0f && e == 0.0f) return r.dot();
+        if(a == 0.0f) {
+            s = 0.0f;
+            t = Math::clamp(f/e, 0.0f, 1.0f);
+        } else {
+            const Float c = Math::dot(d1, r);
+            if(e == 0.0f) {
+                t = 0.0f;
+                s = Math::clamp(-c/a, 0.0f, 1.0f);
+            } else {
+                const Float b = Math::dot(d1, d2);
+                const Float denominator = a*e - b*b;
+                s = denominator != 0.0f ? Math::clamp((b*f - c*e)/denominator, 0.0f, 1.0f) : 0.0f;
+                t = (b*s + f)/e;
+                if(t < 0.0f) {
+                    t = 0.0f;
+                    s = Math::clamp(-c/a, 0.0f, 1.0f);
+                } else if(t > 1.0f) {
+                    t = 1.0f;
+                    s = Math::clamp((b - c)/a, 0.0f, 1.0f);
+                }
+            }
+        }
+
+        return (p1 + d1*s - p2 - d2*t).dot();
+    }
+
+    Float lineSegmentTriangleSquared(const Vector3& a, const Vector3& b, const Vector3* triangle) {
+        if(lineTriangle(a, b - a, triangle, 0.0f, 1.0f)) return 0.0f;
+
+        return Math::min({
+            (closestPointTriangle(a, triangle) - a).dot(),
+            (closestPointTriangle(b, triangle) - b).dot(),
+            lineSegmentLineSegmentSquared(a, b, triangle[0], triangle[1]),
+            lineSegmentLineSegmentSquared(a, b, triangle[1], triangle[2]),
+            lineSegmentLineSegmentSquared(a, b, triangle[2], triangle[0])});
+    }
+
+    /* Calls triangleTest on triangles in all leaf nodes for which nodeTest
+       returns true, until triangleTest returns true */
+    template<class Node, class NodeTest, class TriangleTest> bool traverse(const Containers::Array<Node>& nodes, const Containers::Array<Vector3>& positions, NodeTest nodeTest, TriangleTest triangleTest) {
+        if(nodes.empty()) return false;
+
+        UnsignedInt stack[MaxDepth];
+        std::size_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while(stackSize) {
+            const Node& node = nodes[stack[--stackSize]];
+            if(!nodeTest(node.bounds)) continue;
+
+            if(node.count) {
+                for(UnsignedInt i = node.offset; i != node.offset + node.count; ++i)
+                    if(triangleTest(positions + i*3)) return true;
+                continue;
+            }
+
+            CORRADE_INTERNAL_ASSERT(stackSize + 2 <= MaxDepth);
+            stack[stackSize++] = node.offset;
+            stack[stackSize++] = UnsignedInt(&node - nodes.data()) + 1;
+        }
+
+        return false;
+    }
+}
+
+TriangleMeshData::TriangleMeshData() noexcept = default;
+
+TriangleMeshData::TriangleMeshData(const std::vector<Vector3>& positions, const std::vector<UnsignedInt>& indices) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "Shapes::TriangleMeshData: index count" << indices.size() << "is not divisible by three", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "Shapes::TriangleMeshData: index" << index << "out of bounds for" << positions.size() << "vertices", );
+    #endif
+
+    const UnsignedInt triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* Triangle bounds and centroids */
+    std::vector<Range3D> triangleBounds(triangleCount);
+    std::vector<Vector3> centers(triangleCount);
+    std::vector<UnsignedInt> order(triangleCount);
+    for(UnsignedInt i = 0; i != triangleCount; ++i) {
+        const Vector3& a = positions[indices[i*3]];
+        const Vector3& b = positions[indices[i*3 + 1]];
+        const Vector3& c = positions[indices[i*3 + 2]];
+        triangleBounds[i] = {Math::min(Math::min(a, b), c), Math::max(Math::max(a, b), c)};
+        centers[i] = (a + b + c)/3.0f;
+        order[i] = i;
+    }
+
+    /* Build the hierarchy top-down, splitting each node in the median of its
+       longest axis. The tree is stored depth-first, with the left child
+       directly after its parent, so the right child gets its index only after
+       the whole left subtree is done. */
+    std::vector<Node> nodes;
+    nodes.reserve(2*(triangleCount/LeafSize + 1));
+    struct Pending { UnsignedInt rightOf, begin, end; };
+    std::vector<Pending> pending{{~UnsignedInt{}, 0, triangleCount}};
+    while(!pending.empty()) {
+        const Pending range = pending.back();
+        pending.pop_back();
+
+        const UnsignedInt node = nodes.size();
+        if(range.rightOf != ~UnsignedInt{}) nodes[range.rightOf].offset = node;
+
+        Range3D bounds = triangleBounds[order[range.begin]];
+        Range3D centerBounds{centers[order[range.begin]], centers[order[range.begin]]};
+        for(UnsignedInt i = range.begin + 1; i != range.end; ++i) {
+            bounds = {Math::min(bounds.min(), triangleBounds[order[i]].min()),
+                      Math::max(bounds.max(), triangleBounds[order[i]].max())};
+            centerBounds = {Math::min(centerBounds.min(), centers[order[i]]),
+                            Math::max(centerBounds.max(), centers[order[i]])};
+        }
+
+        if(range.end - range.begin <= LeafSize) {
+            nodes.push_back({bounds, range.begin, range.end - range.begin});
+            continue;
+        }
+
+        nodes.push_back({bounds, 0, 0});
+
+        const Vector3 size = centerBounds.size();
+        const std::size_t axis = size.x() >= size.y() && size.x() >= size.z() ? 0 : (size.y() >= size.z() ? 1 : 2);
+        const UnsignedInt middle = range.begin + (range.end - range.begin)/2;
+        std::nth_element(order.begin() + range.begin, order.begin() + middle, order.begin() + range.end, [&](UnsignedInt a, UnsignedInt b) {
+            return centers[a][axis] < centers[b][axis];
+        });
+
+        /* The left half is processed next */
+        pending.push_back({node, middle, range.end});
+        pending.push_back({~UnsignedInt{}, range.begin, middle});
+    }
+
+    _nodes = Containers::Array<Node>{nodes.size()};
+    std::copy(nodes.begin(), nodes.end(), _nodes.begin());
+
+    _positions = Containers::Array<Vector3>{std::size_t(triangleCount)*3};
+    for(UnsignedInt i = 0; i != triangleCount; ++i)
+        for(UnsignedInt j = 0; j != 3; ++j)
+            _positions[i*3 + j] = positions[indices[order[i]*3 + j]];
+}
+
+TriangleMeshData::TriangleMeshData(TriangleMeshData&&) noexcept = default;
+
+TriangleMeshData::~TriangleMeshData() = default;
+
+TriangleMeshData& TriangleMeshData::operator=(TriangleMeshData&&) noexcept = default;
+
+Range3D TriangleMeshData::bounds() const {
+    return _nodes.empty() ? Range3D{} : _nodes[0].bounds;
+}
+
+TriangleMesh TriangleMesh::transformed(const Matrix4& matrix) const {
+    TriangleMesh out{*this};
+    out._transformation = matrix*_transformation;
+    return out;
+}
+
+Matrix4 TriangleMesh::invertedTransformation(Float& scaling) const {
+    /* Cheaper than a general inverse, also checks for uniform scaling */
+    scaling = _transformation.uniformScaling();
+    const Matrix3x3 rotationScaling = _transformation.rotationScaling().transposed()/Math::pow<2>(scaling);
+    return Matrix4::from(rotationScaling, -(rotationScaling*_transformation.translation()));
+}
+
+bool TriangleMesh::operator%(const Point3D& other) const {
+    if(!_data) return false;
+
+    /* Count crossings of a ray going from the point, odd count means the
+       point is inside. If the ray goes through an edge or a vertex, try
+       another direction. If all of them do, the mesh is likely degenerate
+       and the last direction counts such crossings as well. */
+    Float scaling;
+    const Vector3 origin = invertedTransformation(scaling).transformPoint(other.position());
+    for(std::size_t i = 0; i != InsideTestDirectionCount; ++i) {
+        const Vector3& direction = InsideTestDirections[i];
+        const Vector3 inverseDirection = 1.0f/direction;
+        const bool last = i + 1 == InsideTestDirectionCount;
+        std::size_t crossings = 0;
+        const bool ambiguous = traverse(_data->_nodes, _data->_positions, [&](const Range3D& bounds) {
+            return boxLine(bounds, origin, inverseDirection, 0.0f, Constants::inf());
+        }, [&](const Vector3* triangle) {
+            const Int crossing = rayTriangleCrossing(origin, direction, triangle);
+            if(crossing < 0 && !last) return true;
+            if(crossing) ++crossings;
+            return false;
+        });
+        if(!ambiguous) return crossings % 2;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+bool TriangleMesh::operator%(const Line3D& other) const {
+    if(!_data) return false;
+
+    Float scaling;
+    const Matrix4 inverted = invertedTransformation(scaling);
+    const Vector3 a = inverted.transformPoint(other.a());
+    const Vector3 direction = inverted.transformPoint(other.b()) - a;
+    const Vector3 inverseDirection = 1.0f/direction;
+    return traverse(_data->_nodes, _data->_positions, [&](const Range3D& bounds) {
+        return boxLine(bounds, a, inverseDirection, -Constants::inf(), Constants::inf());
+    }, [&](const Vector3* triangle) {
+        return lineTriangle(a, direction, triangle, -Constants::inf(), Constants::inf());
+    });
+}
+
+bool TriangleMesh::operator%(const LineSegment3D& other) const {
+    if(!_data) return false;
+
+    Float scaling;
+    const Matrix4 inverted = invertedTransformation(scaling);
+    const Vector3 a = inverted.transformPoint(other.a());
+    const Vector3 direction = inverted.transformPoint(other.b()) - a;
+    const Vector3 inverseDirection = 1.0f/direction;
+    return traverse(_data->_nodes, _data->_positions, [&](const Range3D& bounds) {
+        return boxLine(bounds, a, inverseDirection, 0.0f, 1.0f);
+    }, [&](const Vector3* triangle) {
+        return lineTriangle(a, direction, triangle, 0.0f, 1.0f);
+    });
+}
+
+bool TriangleMesh::operator%(const Sphere3D& other) const {
+    if(!_data) return false;
+
+    Float scaling;
+    const Vector3 center = invertedTransformation(scaling).transformPoint(other.position());
+    const Float radiusSquared = Math::pow<2>(other.radius()/scaling);
+    return traverse(_data->_nodes, _data->_positions, [&](const Range3D& bounds) {
+        return boxPointDistanceSquared(bounds, center) < radiusSquared;
+    }, [&](const Vector3* triangle) {
+        return (closestPointTriangle(center, triangle) - center).dot() < radiusSquared;
+    });
+}
+
+Collision3D TriangleMesh::operator/(const Sphere3D& other) const {
+    if(!_data) return {};
+
+    /* Find the closest point, shrinking the search radius with each found
+       point */
+    Float scaling;
+    const Vector3 center = invertedTransformation(scaling).transformPoint(other.position());
+    const Float radius = other.radius()/scaling;
+    Float distanceSquared = Math::pow<2>(radius);
+    const Vector3* closestTriangle = nullptr;
+    Vector3 closest;
+    traverse(_data->_nodes, _data->_positions, [&](const Range3D& bounds) {
+        return boxPointDistanceSquared(bounds, center) < distanceSquared;
+    }, [&](const Vector3* triangle) {
+        const Vector3 point = closestPointTriangle(center, triangle);
+        const Float d = (point - center).dot();
+        if(d < distanceSquared) {
+            distanceSquared = d;
+            closestTriangle = triangle;
+            closest = point;
+        }
+        return false;
+    });
+
+    /* No collision occured */
+    if(!closestTriangle) return {};
+
+    /* Separating normal in mesh space. If the center is on the surface, move
+       the mesh behind the triangle. If can't decide on direction, just move
+       up. */
+    const Float distance = Math::sqrt(distanceSquared);
+    Vector3 separatingNormal;
+    if(!Math::TypeTraits<Float>::equals(distanceSquared, 0.0f))
+        separatingNormal = (closest - center)/distance;
+    else {
+        const Vector3 normal = Math::cross(closestTriangle[1] - closestTriangle[0], closestTriangle[2] - closestTriangle[0]);
+        separatingNormal = Math::TypeTraits<Float>::equals(normal.dot(), 0.0f) ?
+            Vector3::yAxis() : -normal.normalized();
+    }
+
+    /* Collision position is on the sphere surface */
+    const Vector3 normal = _transformation.rotationScaling()*separatingNormal/scaling;
+    return Collision3D(other.position() + normal*other.radius(), normal, (radius - distance)*scaling);
+}
+
+bool TriangleMesh::operator%(const Capsule3D& other) const {
+    if(!_data) return false;
+
+    Float scaling;
+    const Matrix4 inverted = invertedTransformation(scaling);
+    const Vector3 a = inverted.transformPoint(other.a());
+    const Vector3 b = inverted.transformPoint(other.b());
+    const Float radius = other.radius()/scaling;
+    const Float radiusSquared = Math::pow<2>(radius);
+    const Range3D capsuleBounds{Math::min(a, b) - Vector3{radius}, Math::max(a, b) + Vector3{radius}};
+    return traverse(_data->_nodes, _data->_positions, [&](const Range3D& bounds) {
+        return (bounds.min() <= capsuleBounds.max()).all() && (capsuleBounds.min() <= bounds.max()).all();
+    }, [&](const Vector3* triangle) {
+        return lineSegmentTriangleSquared(a, b, triangle) < radiusSquared;
+    });
+}
+
+}}
@@ -0,0 +1,240 @@
+#ifndef Magnum_Shapes_TriangleMesh_h
+#define Magnum_Shapes_TriangleMesh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::TriangleMesh, @ref Magnum::Shapes::TriangleMeshData
+ */
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shapes/Collision.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Triangle mesh data for collision detection
+
+Stores triangles of a mesh in a bounding volume hierarchy, which is built
+once in the constructor. The data are then referenced by one or more
+@ref TriangleMesh shapes. The hierarchy is a binary tree of axis-aligned
+bounding boxes, created by splitting the triangles in a median of the longest
+axis, so collision queries need to test only a logarithmic portion of the
+triangles.
+@see @ref TriangleMesh
+*/
+class MAGNUM_SHAPES_EXPORT TriangleMeshData {
+    friend TriangleMesh;
+
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates mesh data with no triangles.
+         */
+        explicit TriangleMeshData() noexcept;
+
+        /**
+         * @brief Constructor
+         * @param positions     Vertex positions
+         * @param indices       Vertex indices, three for each triangle
+         *
+         * Expects that the index count is divisible by three and all indices
+         * are in range for @p positions. The data are copied, so the passed
+         * arrays don't need to be kept around.
+         */
+        explicit TriangleMeshData(const std::vector<Vector3>& positions, const std::vector<UnsignedInt>& indices);
+
+        /** @brief Copying is not allowed */
+        TriangleMeshData(const TriangleMeshData&) = delete;
+
+        /**
+         * @brief Move constructor
+         *
+         * @ref TriangleMesh shapes referencing the moved-from instance are
+         * not updated.
+         */
+        TriangleMeshData(TriangleMeshData&&) noexcept;
+
+        ~TriangleMeshData();
+
+        /** @brief Copying is not allowed */
+        TriangleMeshData& operator=(const TriangleMeshData&) = delete;
+
+        /** @brief Move assignment */
+        TriangleMeshData& operator=(TriangleMeshData&&) noexcept;
+
+        /** @brief Triangle count */
+        std::size_t triangleCount() const { return _positions.size()/3; }
+
+        /** @brief Count of nodes in the bounding volume hierarchy */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /**
+         * @brief Bounds of all triangles
+         *
+         * Zero range at origin if there are no triangles.
+         */
+        Range3D bounds() const;
+
+    private:
+        /* Inner nodes have zero count, the left child right after them and
+           the right child at given offset. Leaf nodes reference given count
+           of triangles starting at given offset. */
+        struct Node {
+            Range3D bounds;
+            UnsignedInt offset, count;
+        };
+
+        Containers::Array<Node> _nodes;
+
+        /* Three positions for each triangle, ordered by leaf nodes */
+        Containers::Array<Vector3> _positions;
+};
+
+/**
+@brief Triangle mesh (3D only)
+
+References triangles stored in @ref TriangleMeshData, together with a
+transformation. The data aren't copied, they need to be kept in scope for the
+whole lifetime of the shape and all its copies. Transforming the shape only
+changes the transformation, the collision queries are then done by
+transforming the other shape into space of the mesh data. Similarly to
+@ref Plane and @ref Sphere the mesh expects uniform scaling.
+
+The mesh is useful for static level geometry, which can't be easily
+approximated with simple shapes:
+@code
+Shapes::TriangleMeshData levelData{positions, indices};
+new Shapes::Shape<Shapes::TriangleMesh>{level, Shapes::TriangleMesh{levelData}, &shapes};
+@endcode
+
+Collisions with spheres, capsules, lines and line segments are detected
+against the surface of the mesh, so for example a sphere completely inside a
+closed mesh doesn't collide with it. Collision with a point, on the other
+hand, is detected if the point is inside the mesh, which is expected to be
+closed in this case. See @ref shapes for brief introduction.
+*/
+class MAGNUM_SHAPES_EXPORT TriangleMesh {
+    public:
+        enum: UnsignedInt {
+            Dimensions = 3 /**< Dimension count */
+        };
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates mesh without any data, which doesn't collide with anything.
+         */
+        /*implicit*/ TriangleMesh(): _data{} {}
+
+        /**
+         * @brief Constructor
+         * @param data              Triangle data
+         * @param transformation    Transformation of the data
+         */
+        /*implicit*/ TriangleMesh(const TriangleMeshData& data, const Matrix4& transformation = Matrix4{}): _data{&data}, _transformation{transformation} {}
+
+        /** @brief Transformed shape */
+        TriangleMesh transformed(const Matrix4& matrix) const;
+
+        /**
+         * @brief Triangle data
+         *
+         * `nullptr` for default-constructed shape.
+         */
+        const TriangleMeshData* data() const { return _data; }
+
+        /** @brief Transformation of the data */
+        Matrix4 transformation() const { return _transformation; }
+
+        /** @brief Set transformation of the data */
+        void setTransformation(const Matrix4& transformation) {
+            _transformation = transformation;
+        }
+
+        /**
+         * @brief Collision occurence with point
+         *
+         * Whether the point is inside the mesh, expecting the mesh to be
+         * closed.
+         */
+        bool operator%(const Point3D& other) const;
+
+        /** @brief Collision occurence with line */
+        bool operator%(const Line3D& other) const;
+
+        /** @brief Collision occurence with line segment */
+        bool operator%(const LineSegment3D& other) const;
+
+        /** @brief Collision occurence with sphere */
+        bool operator%(const Sphere3D& other) const;
+
+        /**
+         * @brief Collision with sphere
+         *
+         * The contact position is on the sphere surface, separation normal
+         * points from the sphere center to the closest point on the mesh.
+         */
+        Collision3D operator/(const Sphere3D& other) const;
+
+        /** @brief Collision occurence with capsule */
+        bool operator%(const Capsule3D& other) const;
+
+    private:
+        Matrix4 MAGNUM_SHAPES_LOCAL invertedTransformation(Float& scaling) const;
+
+        const TriangleMeshData* _data;
+        Matrix4 _transformation;
+};
+
+/** @collisionoccurenceoperator{Point,TriangleMesh} */
+inline bool operator%(const Point3D& a, const TriangleMesh& b) { return b % a; }
+
+/** @collisionoccurenceoperator{Line,TriangleMesh} */
+inline bool operator%(const Line3D& a, const TriangleMesh& b) { return b % a; }
+
+/** @collisionoccurenceoperator{LineSegment,TriangleMesh} */
+inline bool operator%(const LineSegment3D& a, const TriangleMesh& b) { return b % a; }
+
+/** @collisionoccurenceoperator{Sphere,TriangleMesh} */
+inline bool operator%(const Sphere3D& a, const TriangleMesh& b) { return b % a; }
+
+/** @collisionoperator{Sphere,TriangleMesh} */
+inline Collision3D operator/(const Sphere3D& a, const TriangleMesh& b) { return (b/a).flipped(); }
+
+/** @collisionoccurenceoperator{Capsule,TriangleMesh} */
+inline bool operator%(const Capsule3D& a, const TriangleMesh& b) { return b % a; }
+
+}}
+
+#endif
@@ -64,6 +64,7 @@ Debug& operator<<(Debug& debug, ShapeDimensionTraits<3>::Type value) {
         _val(AxisAlignedBox)
         _val(Box)
         _val(Plane)
+        _val(TriangleMesh)
         _val(Composition)
         #undef _val
         /* LCOV_EXCL_STOP */
@@ -25,6 +25,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstddef>
 #include <utility>
 #include <Corrade/Utility/Assert.h>
 
@@ -44,7 +45,9 @@ namespace Magnum { namespace Shapes { namespace Implementation {
     3.  Add TypeOf struct specialization (either for both 2D/3D or for only one
         of them)
     4.  Add the enum value to (documentation-only) enum in Composition
-    5.  Update doc/shapes.dox with new type
+    5.  Add the type to dispatch() in Composition.cpp, if it's larger than
+        the largest shape, enlarge ShapeSize below
+    6.  Update doc/shapes.dox with new type
 
     Adding new collision detection implementation:
 
@@ -52,7 +55,8 @@ namespace Magnum { namespace Shapes { namespace Implementation {
         2D/3D pair
 */
 
-/* Shape type for given dimension count */
+/* Shape type for given dimension count and size of the largest shape wrapper
+   for Composition::Slot, checked in Composition::copyShapes() */
 
 template<UnsignedInt> struct ShapeDimensionTraits;
 
@@ -69,6 +73,9 @@ template<> struct ShapeDimensionTraits<2> {
         Box = 19,
         Composition = 23
     };
+
+    /* Box with its transformation matrix */
+    enum: std::size_t { ShapeSize = sizeof(void*) + 3*3*sizeof(Float) };
 };
 
 template<> struct ShapeDimensionTraits<3> {
@@ -83,8 +90,12 @@ template<> struct ShapeDimensionTraits<3> {
         AxisAlignedBox = 17,
         Box = 19,
         Plane = 23,
-        Composition = 29
+        TriangleMesh = 29,
+        Composition = 31
     };
+
+    /* Triangle mesh with its data pointer and transformation matrix */
+    enum: std::size_t { ShapeSize = 2*sizeof(void*) + 4*4*sizeof(Float) };
 };
 
 MAGNUM_SHAPES_EXPORT Debug& operator<<(Debug& debug, ShapeDimensionTraits<2>::Type value);
@@ -144,6 +155,11 @@ template<> struct TypeOf<Shapes::Plane> {
         return ShapeDimensionTraits<3>::Type::Plane;
     }
 };
+template<> struct TypeOf<Shapes::TriangleMesh> {
+    constexpr static ShapeDimensionTraits<3>::Type type() {
+        return ShapeDimensionTraits<3>::Type::TriangleMesh;
+    }
+};
 template<UnsignedInt dimensions> struct TypeOf<Shapes::Composition<dimensions>> {
     constexpr static typename ShapeDimensionTraits<dimensions>::Type type() {
         return ShapeDimensionTraits<dimensions>::Type::Composition;
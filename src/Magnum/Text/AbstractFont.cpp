@@ -30,7 +30,7 @@
 #include <Corrade/Utility/Unicode.h>
 
 #include "Magnum/Math/Functions.h"
-#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
 
 namespace Magnum { namespace Text {
 
@@ -163,6 +163,13 @@ std::unique_ptr<AbstractLayouter> AbstractFont::layout(const GlyphCache& cache,
     return doLayout(cache, size, text);
 }
 
+std::unique_ptr<AbstractLayouter> AbstractFont::layout(DynamicGlyphCache& cache, const Float size, const std::string& text) {
+    CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layout(): no font opened", nullptr);
+
+    cache.fill(*this, text);
+    return doLayout(cache, size, text);
+}
+
 AbstractLayouter::AbstractLayouter(UnsignedInt glyphCount): _glyphCount(glyphCount) {}
 
 AbstractLayouter::~AbstractLayouter() {}
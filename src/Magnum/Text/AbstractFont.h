@@ -52,7 +52,9 @@ namespace for available font plugins.
 
 First step is to open the font using @ref openData(), @ref openSingleData() or
 @ref openFile(). Next step is to prerender all the glyphs which will be used in
-text rendering later, see @ref GlyphCache for more information. See
+text rendering later, see @ref GlyphCache for more information. Alternatively
+the glyphs can be rendered on demand during layout using
+@ref DynamicGlyphCache. See
 @ref Renderer for information about text rendering.
 
 ## Subclassing
@@ -242,6 +244,14 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         std::unique_ptr<AbstractLayouter> layout(const GlyphCache& cache, Float size, const std::string& text);
 
+        /**
+         * @brief Layout the text, adding missing glyphs to the cache
+         *
+         * Calls @ref DynamicGlyphCache::fill() with @p text and then lays it
+         * out the same way as @ref layout(const GlyphCache&, Float, const std::string&).
+         */
+        std::unique_ptr<AbstractLayouter> layout(DynamicGlyphCache& cache, Float size, const std::string& text);
+
     protected:
         /**
          * @brief Font metrics
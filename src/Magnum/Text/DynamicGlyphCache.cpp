@@ -0,0 +1,236 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DynamicGlyphCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <unordered_set>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+
+namespace Magnum { namespace Text {
+
+DynamicGlyphCache::DynamicGlyphCache(const Vector2i& size, const Vector2i& padding): GlyphCache{size, size, padding}, _packer{size, TextureTools::AtlasPacker::Algorithm::MaxRectsBestShortSideFit, padding},
+    /* Matching the internal format chosen in GlyphCache */
+    #if !(defined(MAGNUM_TARGET_GLES) && defined(MAGNUM_TARGET_GLES2))
+    _format{PixelFormat::Red},
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    _format{Context::current().isExtensionSupported<Extensions::GL::EXT::texture_rg>() ?
+        PixelFormat::Red : PixelFormat::Luminance},
+    #else
+    _format{PixelFormat::Luminance},
+    #endif
+    _frame{}, _evictedGlyphCount{}, _data{Containers::ValueInit, std::size_t(size.product())} {}
+
+DynamicGlyphCache::~DynamicGlyphCache() = default;
+
+void DynamicGlyphCache::fill(AbstractFont& font, const std::string& text) {
+    /* Mark present glyphs as used, collect characters of the missing ones */
+    std::u32string missing;
+    std::unordered_set<UnsignedInt> missingGlyphs;
+    for(const char32_t character: Utility::Unicode::utf32(text)) {
+        const UnsignedInt glyph = font.glyphId(character);
+        auto found = _glyphs.find(glyph);
+        if(found != _glyphs.end()) found->second.lastUsed = _frame;
+        else if(missingGlyphs.insert(glyph).second) missing += character;
+    }
+
+    if(missing.empty()) return;
+
+    /* Forget space reserved outside of fill() so the font can't overwrite
+       glyphs stored there */
+    releaseReserved();
+    font.fillGlyphCache(*this, Utility::Unicode::utf8(missing));
+    releaseReserved();
+}
+
+void DynamicGlyphCache::releaseReserved() {
+    /* Make space that was reserved but not used available again */
+    for(const std::pair<Range2Di, bool>& reserved: _reserved)
+        if(!reserved.second) _packer.remove(reserved.first);
+    _reserved.clear();
+}
+
+std::vector<Range2Di> DynamicGlyphCache::reserve(const std::vector<Vector2i>& sizes) {
+    /* Eviction candidates, least recently used last. Glyph 0 is the fallback
+       for everything else, so it's never evicted. Built only when needed. */
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> candidates;
+    bool candidatesBuilt = false;
+
+    std::vector<Range2Di> out;
+    out.reserve(sizes.size());
+    std::size_t failed = 0;
+    for(const Vector2i& size: sizes) {
+        std::pair<bool, Range2Di> added;
+        while(!(added = _packer.add(size)).first) {
+            if(!candidatesBuilt) {
+                for(const auto& glyph: _glyphs)
+                    if(glyph.first && glyph.second.lastUsed != _frame)
+                        candidates.emplace_back(glyph.second.lastUsed, glyph.first);
+                std::sort(candidates.begin(), candidates.end(), std::greater<std::pair<UnsignedInt, UnsignedInt>>{});
+                candidatesBuilt = true;
+            }
+
+            if(candidates.empty()) break;
+
+            const UnsignedInt glyph = candidates.back().second;
+            candidates.pop_back();
+            auto found = _glyphs.find(glyph);
+            _packer.remove(found->second.rectangle);
+            clear(found->second.rectangle.padded(padding()));
+            _glyphs.erase(found);
+            erase(glyph);
+            ++_evictedGlyphCount;
+        }
+
+        /* Nothing left to evict, give the glyph an empty range so the font
+           doesn't write anything */
+        if(!added.first) {
+            ++failed;
+            out.emplace_back();
+            continue;
+        }
+
+        /* Clear whatever a font might have written to space that was
+           reserved but not used, including the padding */
+        clear(added.second.padded(padding()));
+        _reserved.emplace_back(added.second, false);
+        out.push_back(added.second);
+    }
+
+    if(failed) Error() << "Text::DynamicGlyphCache::reserve(): cache of size" << textureSize() << "is too small to fit all glyphs used in a single frame," << failed << "glyphs not added";
+
+    return out;
+}
+
+void DynamicGlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) {
+    /* The space is not just reserved anymore. If it wasn't reserved at all
+       and is empty, it's a glyph that didn't fit. */
+    auto reserved = std::find_if(_reserved.begin(), _reserved.end(), [&rectangle](const std::pair<Range2Di, bool>& r) {
+        return !r.second && r.first == rectangle;
+    });
+    if(reserved != _reserved.end()) reserved->second = true;
+    else if(rectangle == Range2Di{}) return;
+
+    /* Inserting a glyph again, free the previous space */
+    auto found = _glyphs.find(glyph);
+    if(found != _glyphs.end()) {
+        _packer.remove(found->second.rectangle);
+        clear(found->second.rectangle.padded(padding()));
+        _glyphs.erase(found);
+        erase(glyph);
+    }
+
+    _glyphs.insert({glyph, Glyph{rectangle, _frame}});
+    GlyphCache::insert(glyph, position, rectangle);
+}
+
+void DynamicGlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT(image.format() == _format && image.type() == PixelType::UnsignedByte,
+        "Text::DynamicGlyphCache::setImage(): expected" << _format << "and" << PixelType::UnsignedByte << "but got" << image.format() << "and" << image.type(), );
+
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::tie(dataOffset, dataSize, std::ignore) = image.dataProperties();
+    const char* const pixels = image.data() + dataOffset.sum();
+
+    /* Copy only the parts overlapping space reserved in current fill(),
+       including the padding, everything else in the image is expected to be
+       stale. The padding of neighboring glyphs doesn't overlap, so this
+       doesn't touch any other glyph. */
+    const Range2Di imageRange{Math::max(offset, Vector2i{}), Math::min(offset + image.size(), textureSize())};
+    for(const std::pair<Range2Di, bool>& reserved: _reserved) {
+        const Range2Di padded = reserved.first.padded(padding());
+        const Range2Di range{Math::max(imageRange.min(), padded.min()), Math::min(imageRange.max(), padded.max())};
+        if(!(range.size() > Vector2i{}).all()) continue;
+
+        for(Int y = range.min().y(); y != range.max().y(); ++y)
+            std::memcpy(_data + y*textureSize().x() + range.min().x(),
+                pixels + (y - offset.y())*dataSize.x() + range.min().x() - offset.x(),
+                range.size().x());
+
+        _dirty.push_back(range);
+    }
+}
+
+void DynamicGlyphCache::clear(Range2Di range) {
+    range = {Math::max(range.min(), Vector2i{}), Math::min(range.max(), textureSize())};
+    if(!(range.size() > Vector2i{}).all()) return;
+
+    for(Int y = range.min().y(); y != range.max().y(); ++y)
+        std::memset(_data + y*textureSize().x() + range.min().x(), 0, range.size().x());
+
+    _dirty.push_back(range);
+}
+
+void DynamicGlyphCache::flush() {
+    ++_frame;
+
+    /* Merge regions if the union doesn't contain more unchanged pixels than
+       the smaller of them. Neighboring glyphs packed together usually end up
+       as a single region. */
+    for(bool merged = true; merged; ) {
+        merged = false;
+        for(std::size_t i = 0; i < _dirty.size(); ++i) {
+            for(std::size_t j = i + 1; j < _dirty.size(); ) {
+                const Int a = _dirty[i].size().product();
+                const Int b = _dirty[j].size().product();
+                const Range2Di joined = Math::join(_dirty[i], _dirty[j]);
+                if(joined.size().product() - a - b > Math::min(a, b)) {
+                    ++j;
+                    continue;
+                }
+
+                _dirty[i] = joined;
+                _dirty.erase(_dirty.begin() + j);
+                merged = true;
+            }
+        }
+    }
+
+    /* Upload each region with one call */
+    std::vector<char> data;
+    for(const Range2Di& range: _dirty) {
+        data.resize(range.size().product());
+        for(Int y = range.min().y(); y != range.max().y(); ++y)
+            std::memcpy(data.data() + (y - range.min().y())*range.size().x(),
+                _data + y*textureSize().x() + range.min().x(),
+                range.size().x());
+
+        texture().setSubImage(0, range.min(), ImageView2D{
+            PixelStorage{}.setAlignment(1), _format, PixelType::UnsignedByte,
+            range.size(), Containers::ArrayView<const char>{data.data(), data.size()}});
+    }
+
+    _dirty.clear();
+}
+
+}}
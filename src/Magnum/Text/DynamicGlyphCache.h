@@ -0,0 +1,235 @@
+#ifndef Magnum_Text_DynamicGlyphCache_h
+#define Magnum_Text_DynamicGlyphCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::DynamicGlyphCache
+ */
+
+#include <string>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/TextureTools/AtlasPacker.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Glyph cache filled on demand
+
+Unlike @ref GlyphCache, which is filled once with a known character set, this
+cache adds glyphs lazily as the text is laid out and evicts glyphs that were
+not used for the longest time when the texture is full. Useful for scripts
+with large character sets, such as CJK, where rendering all glyphs upfront is
+not feasible. The internal texture format is red channel only, same as with
+@ref GlyphCache::GlyphCache(const Vector2i&, const Vector2i&).
+
+## Usage
+
+Create the cache and pass it to @ref Renderer or @ref AbstractFont::layout().
+Glyphs that are not in the cache yet are rendered by the font and packed into
+the texture using @ref TextureTools::AtlasPacker. The texture updates are
+collected and uploaded at once in @ref flush(), which should be called once
+per frame before drawing the text and which also starts a new frame for the
+eviction bookkeeping.
+@code
+Text::AbstractFont* font;
+Text::DynamicGlyphCache cache{Vector2i{1024}};
+Text::Renderer2D renderer{*font, cache, 16.0f};
+renderer.reserve(256, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+
+// every frame
+renderer.render(text);
+cache.flush();
+// draw the renderer mesh...
+@endcode
+
+For text rendered through @ref Renderer2D::render() "static Renderer::render()"
+functions, call @ref fill() with the text first. The font needs to support
+rendering of arbitrary glyphs using @ref AbstractFont::fillGlyphCache(), fonts
+with @ref AbstractFont::Feature::PreparedGlyphCache can't be used.
+
+@anchor Text-DynamicGlyphCache-eviction
+## Eviction
+
+All glyphs of the text passed to @ref fill() are marked as used in current
+frame. When a new glyph doesn't fit into the texture, glyphs that were not
+used for the longest time are evicted until it fits. Glyphs used in the
+current frame are never evicted, because already laid out text may reference
+them. If all glyphs needed in a single frame don't fit into the texture, the
+remaining ones are not added and fall back to glyph `0`.
+
+Laid out text that is kept for multiple frames without being rendered again
+references glyphs that can be evicted in later frames. To prevent that, pass
+the text to @ref fill() every frame, which is cheap for glyphs that are
+already in the cache.
+
+@anchor Text-DynamicGlyphCache-uploads
+## Texture uploads
+
+The texture keeps glyphs from previous calls to @ref fill(), so font plugins
+can't simply upload a whole new texture image. Only parts of images passed to
+@ref setImage() that overlap space returned from @ref reserve() during the
+current @ref fill() (including the padding) are used, everything else in the
+image is ignored. A plugin can thus either upload each glyph separately or
+render all new glyphs into a single image of @ref textureSize() and upload it
+with one call to @ref setImage() at zero offset.
+
+The used parts are copied into a CPU-side copy of the texture and only the
+affected regions are remembered. The regions are merged into larger ones if
+it doesn't add too much unchanged area and each is then uploaded with a
+single call in @ref flush(). Space of evicted glyphs is cleared together with
+its padding.
+*/
+class MAGNUM_TEXT_EXPORT DynamicGlyphCache: public GlyphCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Glyph cache texture size
+         * @param padding   Padding around every glyph
+         *
+         * Sets internal texture format to red channel only, see
+         * @ref GlyphCache::GlyphCache(const Vector2i&, const Vector2i&) for
+         * more information.
+         */
+        explicit DynamicGlyphCache(const Vector2i& size, const Vector2i& padding = {});
+
+        ~DynamicGlyphCache();
+
+        /**
+         * @brief Current frame
+         *
+         * Incremented by each @ref flush(), initially `0`.
+         */
+        UnsignedInt frame() const { return _frame; }
+
+        /**
+         * @brief Count of evicted glyphs
+         *
+         * Total count of glyphs evicted since the cache was created. A
+         * steadily growing value means the texture is too small for the text
+         * being rendered.
+         */
+        std::size_t evictedGlyphCount() const { return _evictedGlyphCount; }
+
+        /**
+         * @brief Count of regions waiting for upload
+         *
+         * The regions are not merged yet.
+         * @see @ref flush()
+         */
+        std::size_t dirtyRegionCount() const { return _dirty.size(); }
+
+        /**
+         * @brief Fill cache with glyphs of given text
+         * @param font      Font
+         * @param text      UTF-8 text
+         *
+         * Glyphs already present in the cache are marked as used in the
+         * current frame, the missing ones are rendered with
+         * @ref AbstractFont::fillGlyphCache(). Called implicitly from
+         * @ref AbstractFont::layout(DynamicGlyphCache&, Float, const std::string&)
+         * and @ref AbstractRenderer::render(const std::string&) if the
+         * renderer was created with this cache. See
+         * @ref Text-DynamicGlyphCache-eviction "class documentation" for more
+         * information.
+         */
+        void fill(AbstractFont& font, const std::string& text);
+
+        /**
+         * @brief Upload changed regions and start a new frame
+         *
+         * Should be called once per frame, after all text is laid out and
+         * before it's drawn. See
+         * @ref Text-DynamicGlyphCache-uploads "class documentation" for more
+         * information.
+         */
+        void flush();
+
+        /**
+         * @brief Reserve space for glyphs
+         *
+         * Unlike @ref GlyphCache::reserve(), this can be called on a non-empty
+         * cache. Evicts least recently used glyphs if there isn't enough
+         * space. Glyphs that don't fit even after evicting all glyphs not
+         * used in the current frame get an empty range at the origin, which
+         * @ref insert() ignores, and a message is printed to error output.
+         * Returned ranges are never outside of the texture. Space that is
+         * reserved but not used by any inserted glyph is made available
+         * again at the end of @ref fill().
+         */
+        std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes) override;
+
+        /**
+         * @brief Insert glyph to cache
+         *
+         * Unlike @ref GlyphCache::insert(), an already present glyph can be
+         * inserted again, its previous space is then made available for
+         * other glyphs. The glyph is marked as used in the current frame.
+         */
+        void insert(UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) override;
+
+        /**
+         * @brief Set cache image
+         *
+         * Copies parts of the image that overlap space reserved during the
+         * current @ref fill() into the CPU-side copy of the texture, the rest
+         * of the image is ignored. The texture itself is updated in
+         * @ref flush(). Expects @ref PixelType::UnsignedByte and the same
+         * @ref PixelFormat as the texture internal format, i.e.
+         * @ref PixelFormat::Red or @ref PixelFormat::Luminance on OpenGL ES
+         * 2.0 without @extension{EXT,texture_rg}. See
+         * @ref Text-DynamicGlyphCache-uploads "class documentation" for more
+         * information.
+         */
+        void setImage(const Vector2i& offset, const ImageView2D& image) override;
+
+    private:
+        struct Glyph {
+            Range2Di rectangle;
+            UnsignedInt lastUsed;
+        };
+
+        void MAGNUM_TEXT_LOCAL releaseReserved();
+        void MAGNUM_TEXT_LOCAL clear(Range2Di range);
+
+        TextureTools::AtlasPacker _packer;
+        PixelFormat _format;
+        UnsignedInt _frame;
+        std::size_t _evictedGlyphCount;
+        std::unordered_map<UnsignedInt, Glyph> _glyphs;
+        /* Space reserved in current fill(), second is true if a glyph was
+           inserted there */
+        std::vector<std::pair<Range2Di, bool>> _reserved;
+        std::vector<Range2Di> _dirty;
+        Containers::Array<char> _data;
+};
+
+}}
+
+#endif
@@ -92,6 +92,11 @@ void GlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const
     else CORRADE_INTERNAL_ASSERT_OUTPUT(glyphs.insert({glyph, glyphData}).second);
 }
 
+void GlyphCache::erase(const UnsignedInt glyph) {
+    if(glyph == 0) glyphs[0] = {};
+    else glyphs.erase(glyph);
+}
+
 void GlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
     /** @todo some internalformat/format checking also here (if querying internal format is not slow) */
     _texture.setSubImage(0, offset, image);
@@ -55,7 +55,9 @@ font->createGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
                               "0123456789?!:;,. ");
 @endcode
 
-See @ref Renderer for information about text rendering.
+See @ref Renderer for information about text rendering. If the character
+set is not known upfront or is too large to be rendered at once, use
+@ref DynamicGlyphCache instead.
 @todo Some way for Font to negotiate or check internal texture format
 @todo Default glyph 0 with rect 0 0 0 0 will result in negative dimensions when
     nonzero padding is removed
@@ -160,7 +162,7 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          *      glyphs.
          * @see @ref padding()
          */
-        std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
+        virtual std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
 
         /**
          * @brief Insert glyph to cache
@@ -177,7 +179,7 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          * See also @ref setImage() to upload glyph image.
          * @see @ref padding()
          */
-        void insert(UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle);
+        virtual void insert(UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle);
 
         /**
          * @brief Set cache image
@@ -187,6 +189,16 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          */
         virtual void setImage(const Vector2i& offset, const ImageView2D& image);
 
+    protected:
+        /**
+         * @brief Remove glyph from cache
+         *
+         * Used by subclasses that manage the texture space on their own. If
+         * @p glyph is `0`, the "Not Found" glyph is reset to zero position
+         * and zero region.
+         */
+        void erase(UnsignedInt glyph);
+
     private:
         void MAGNUM_LOCAL initialize(TextureFormat internalFormat, const Vector2i& size);
 
@@ -31,6 +31,7 @@
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
 
 namespace Magnum { namespace Text {
 
@@ -302,7 +303,7 @@ void AbstractRenderer::bufferUnmapImplementationDefault(Buffer& buffer)
     #endif
 }
 
-AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
+AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray}, _dynamicCache{}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::map_buffer_range);
     #elif defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
@@ -339,6 +340,10 @@ template<UnsignedInt dimensions> Renderer<dimensions>::Renderer(AbstractFont& fo
             typename Shaders::AbstractVector<dimensions>::TextureCoordinates());
 }
 
+template<UnsignedInt dimensions> Renderer<dimensions>::Renderer(AbstractFont& font, DynamicGlyphCache& cache, const Float size, const Alignment alignment): Renderer{font, static_cast<const GlyphCache&>(cache), size, alignment} {
+    _dynamicCache = &cache;
+}
+
 void AbstractRenderer::reserve(const uint32_t glyphCount, const BufferUsage vertexBufferUsage, const BufferUsage indexBufferUsage) {
     _capacity = glyphCount;
 
@@ -373,6 +378,9 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const BufferUsage vert
 }
 
 void AbstractRenderer::render(const std::string& text) {
+    /* Add missing glyphs */
+    if(_dynamicCache) _dynamicCache->fill(font, text);
+
     /* Render vertex data */
     std::vector<Vertex> vertexData;
     _rectangle = {};
@@ -104,7 +104,9 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          * filled with @ref reserve(). Rectangle spanning the rendered text is
          * available through @ref rectangle().
          *
-         * Initially no text is rendered.
+         * Initially no text is rendered. If the renderer was created with
+         * @ref DynamicGlyphCache, glyphs missing in the cache are added
+         * first.
          * @attention The capacity must be large enough to contain all glyphs,
          *      see @ref reserve() for more information.
          */
@@ -124,6 +126,7 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         #ifdef CORRADE_TARGET_EMSCRIPTEN
         Containers::Array<UnsignedByte> _vertexBufferData, _indexBufferData;
         #endif
+        DynamicGlyphCache* _dynamicCache;
 
     private:
         AbstractFont& font;
@@ -266,6 +269,14 @@ template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT Renderer: public Abstr
         explicit Renderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
         Renderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
 
+        /**
+         * @brief Construct with a dynamic glyph cache
+         *
+         * Same as above, but each @ref render(const std::string&) call first
+         * adds glyphs missing in @p cache using @ref DynamicGlyphCache::fill().
+         */
+        explicit Renderer(AbstractFont& font, DynamicGlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+
         using AbstractRenderer::render;
 };
 
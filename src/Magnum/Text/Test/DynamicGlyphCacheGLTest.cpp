@@ -0,0 +1,406 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/DynamicGlyphCache.h"
+#include "Magnum/Text/Renderer.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct DynamicGlyphCacheGLTest: OpenGLTester {
+    explicit DynamicGlyphCacheGLTest();
+
+    void construct();
+    void fill();
+    void flush();
+    void evict();
+    void evictCurrentFrame();
+    void evictClear();
+    void reserveTooLarge();
+    void setImageWholeTexture();
+    void layout();
+    void renderer();
+};
+
+DynamicGlyphCacheGLTest::DynamicGlyphCacheGLTest() {
+    addTests({&DynamicGlyphCacheGLTest::construct,
+              &DynamicGlyphCacheGLTest::fill,
+              &DynamicGlyphCacheGLTest::flush,
+              &DynamicGlyphCacheGLTest::evict,
+              &DynamicGlyphCacheGLTest::evictCurrentFrame,
+              &DynamicGlyphCacheGLTest::evictClear,
+              &DynamicGlyphCacheGLTest::reserveTooLarge,
+              &DynamicGlyphCacheGLTest::setImageWholeTexture,
+              &DynamicGlyphCacheGLTest::layout,
+              &DynamicGlyphCacheGLTest::renderer});
+}
+
+namespace {
+
+PixelFormat glyphFormat() {
+    #if !(defined(MAGNUM_TARGET_GLES) && defined(MAGNUM_TARGET_GLES2))
+    return PixelFormat::Red;
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    return Context::current().isExtensionSupported<Extensions::GL::EXT::texture_rg>() ?
+        PixelFormat::Red : PixelFormat::Luminance;
+    #else
+    return PixelFormat::Luminance;
+    #endif
+}
+
+class TestLayouter: public AbstractLayouter {
+    public:
+        explicit TestLayouter(std::vector<Range2D> textureCoordinates): AbstractLayouter(textureCoordinates.size()), _textureCoordinates{std::move(textureCoordinates)} {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(Range2D{{}, {1.0f, 2.0f}}, _textureCoordinates[i], Vector2::xAxis(1.0f));
+        }
+
+        std::vector<Range2D> _textureCoordinates;
+};
+
+/* Glyph ID is the character for lowercase letters, glyph image is filled
+   with the glyph ID. Either each glyph is uploaded separately or all of them
+   are rendered into a single image of the texture size. */
+class TestFont: public AbstractFont {
+    public:
+        std::vector<std::string> filled;
+        Vector2i glyphSize{8, 16};
+        bool singleImage = false;
+
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t character) override {
+            return character >= U'a' && character <= U'z' ? UnsignedInt(character) : 0;
+        }
+
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+        void doFillGlyphCache(GlyphCache& cache, const std::u32string& characters) override {
+            filled.push_back(Utility::Unicode::utf8(characters));
+
+            const std::vector<Range2Di> ranges = cache.reserve(std::vector<Vector2i>(characters.size(), glyphSize));
+            std::vector<char> image(singleImage ? cache.textureSize().product() : 0);
+            for(std::size_t i = 0; i != characters.size(); ++i) {
+                const UnsignedInt glyph = doGlyphId(characters[i]);
+                if(singleImage) {
+                    for(Int y = ranges[i].min().y(); y != ranges[i].max().y(); ++y)
+                        for(Int x = ranges[i].min().x(); x != ranges[i].max().x(); ++x)
+                            image[y*cache.textureSize().x() + x] = char(glyph);
+                } else {
+                    const std::vector<char> data(ranges[i].size().product(), char(glyph));
+                    cache.setImage(ranges[i].min(), ImageView2D{PixelStorage{}.setAlignment(1),
+                        glyphFormat(), PixelType::UnsignedByte, ranges[i].size(),
+                        Containers::ArrayView<const char>{data.data(), data.size()}});
+                }
+                cache.insert(glyph, {1, 2}, ranges[i]);
+            }
+
+            if(singleImage) cache.setImage({}, ImageView2D{PixelStorage{}.setAlignment(1),
+                glyphFormat(), PixelType::UnsignedByte, cache.textureSize(),
+                Containers::ArrayView<const char>{image.data(), image.size()}});
+        }
+
+        std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache& cache, Float, const std::string& text) override {
+            std::vector<Range2D> textureCoordinates;
+            for(const char32_t character: Utility::Unicode::utf32(text)) {
+                const Range2Di rectangle = cache[doGlyphId(character)].second;
+                textureCoordinates.push_back(Range2D{rectangle}.scaled(1.0f/Vector2{cache.textureSize()}));
+            }
+            return std::unique_ptr<AbstractLayouter>(new TestLayouter{std::move(textureCoordinates)});
+        }
+};
+
+bool contains(const GlyphCache& cache, UnsignedInt glyph) {
+    for(const auto& g: cache) if(g.first == glyph) return true;
+    return false;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+/* Every pixel inside a glyph has the glyph ID, everything else is zero */
+bool verifyTexture(DynamicGlyphCache& cache) {
+    Image2D image = cache.texture().image(0, {PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte});
+    const Vector2i size = cache.textureSize();
+    std::vector<char> expected(size.product());
+    for(const auto& glyph: cache) {
+        const Range2Di& rectangle = glyph.second.second;
+        for(Int y = rectangle.min().y(); y != rectangle.max().y(); ++y)
+            for(Int x = rectangle.min().x(); x != rectangle.max().x(); ++x)
+                expected[y*size.x() + x] = char(glyph.first);
+    }
+
+    return std::equal(expected.begin(), expected.end(), image.data<char>());
+}
+#endif
+
+}
+
+void DynamicGlyphCacheGLTest::construct() {
+    DynamicGlyphCache cache{{64, 32}};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(cache.textureSize(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+    CORRADE_COMPARE(cache.frame(), 0);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+    CORRADE_COMPARE(cache.dirtyRegionCount(), 0);
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(cache.texture().imageSize(0), (Vector2i{64, 32}));
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::fill() {
+    TestFont font;
+    DynamicGlyphCache cache{{32, 32}};
+
+    /* Only unique glyphs are rendered */
+    cache.fill(font, "abca");
+    CORRADE_COMPARE(font.filled, (std::vector<std::string>{"abc"}));
+    CORRADE_COMPARE(cache.glyphCount(), 4);
+    CORRADE_COMPARE(cache['a'].first, (Vector2i{1, 2}));
+    CORRADE_COMPARE(cache['a'].second.size(), (Vector2i{8, 16}));
+    CORRADE_VERIFY(cache['a'].second != cache['b'].second);
+    CORRADE_VERIFY(cache.dirtyRegionCount() > 0);
+
+    /* Only missing glyphs are rendered */
+    cache.fill(font, "bcd");
+    CORRADE_COMPARE(font.filled, (std::vector<std::string>{"abc", "d"}));
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+
+    /* Nothing is missing */
+    cache.fill(font, "dab");
+    CORRADE_COMPARE(font.filled.size(), 2);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void DynamicGlyphCacheGLTest::flush() {
+    TestFont font;
+    DynamicGlyphCache cache{{32, 32}};
+
+    cache.fill(font, "abcd");
+    cache.flush();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.frame(), 1);
+    CORRADE_COMPARE(cache.dirtyRegionCount(), 0);
+
+    cache.fill(font, "efgh");
+    cache.flush();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.frame(), 2);
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_VERIFY(verifyTexture(cache));
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::evict() {
+    TestFont font;
+    /* Space for eight glyphs */
+    DynamicGlyphCache cache{{32, 32}};
+
+    cache.fill(font, "abcdefgh");
+    cache.flush();
+    cache.fill(font, "abcd");
+    cache.flush();
+    CORRADE_COMPARE(cache.glyphCount(), 9);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+
+    /* Two of the glyphs not used in the last frame are evicted */
+    cache.fill(font, "ij");
+    CORRADE_COMPARE(font.filled.back(), "ij");
+    CORRADE_COMPARE(cache.glyphCount(), 9);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 2);
+    for(const char glyph: std::string{"abcdij"})
+        CORRADE_VERIFY(contains(cache, glyph));
+    std::size_t remaining = 0;
+    for(const char glyph: std::string{"efgh"})
+        if(contains(cache, glyph)) ++remaining;
+    CORRADE_COMPARE(remaining, 2);
+
+    cache.flush();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_VERIFY(verifyTexture(cache));
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::evictCurrentFrame() {
+    TestFont font;
+    DynamicGlyphCache cache{{32, 32}};
+
+    /* Glyphs used in the current frame are not evicted */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        cache.fill(font, "abcdefghij");
+    }
+    CORRADE_COMPARE(out.str(), "Text::DynamicGlyphCache::reserve(): cache of size Vector(32, 32) is too small to fit all glyphs used in a single frame, 2 glyphs not added\n");
+    CORRADE_COMPARE(cache.glyphCount(), 9);
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 0);
+    CORRADE_VERIFY(!contains(cache, 'i'));
+    CORRADE_VERIFY(!contains(cache, 'j'));
+
+    cache.flush();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_VERIFY(verifyTexture(cache));
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::evictClear() {
+    TestFont font;
+    DynamicGlyphCache cache{{16, 16}};
+
+    font.glyphSize = {16, 16};
+    cache.fill(font, "a");
+    cache.flush();
+
+    /* The smaller glyph is put where the large one was, the rest of its
+       space is cleared */
+    font.glyphSize = {8, 8};
+    cache.fill(font, "b");
+    CORRADE_COMPARE(cache.evictedGlyphCount(), 1);
+    CORRADE_COMPARE(cache['b'].second, (Range2Di{{}, {8, 8}}));
+    cache.flush();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_VERIFY(verifyTexture(cache));
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::reserveTooLarge() {
+    DynamicGlyphCache cache{{16, 16}, {1, 1}};
+
+    /* The glyph that doesn't fit gets an empty range instead of one outside
+       of the texture */
+    std::ostringstream out;
+    std::vector<Range2Di> ranges;
+    {
+        Error redirectError{&out};
+        ranges = cache.reserve({{8, 8}, {16, 16}});
+    }
+    CORRADE_COMPARE(out.str(), "Text::DynamicGlyphCache::reserve(): cache of size Vector(16, 16) is too small to fit all glyphs used in a single frame, 1 glyphs not added\n");
+    CORRADE_COMPARE(ranges.size(), 2);
+    CORRADE_COMPARE(ranges[0].size(), (Vector2i{8, 8}));
+    CORRADE_COMPARE(ranges[1], Range2Di{});
+
+    /* Inserting the glyph that didn't fit does nothing */
+    cache.insert('a', {}, ranges[0]);
+    cache.insert('b', {}, ranges[1]);
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+    CORRADE_VERIFY(contains(cache, 'a'));
+    CORRADE_VERIFY(!contains(cache, 'b'));
+}
+
+void DynamicGlyphCacheGLTest::setImageWholeTexture() {
+    TestFont font;
+    font.singleImage = true;
+    DynamicGlyphCache cache{{32, 32}};
+
+    /* Each fill uploads the whole texture, glyphs added in previous fills
+       are not overwritten */
+    cache.fill(font, "ab");
+    cache.flush();
+    cache.fill(font, "cd");
+    cache.flush();
+    cache.fill(font, "e");
+    CORRADE_COMPARE(font.filled, (std::vector<std::string>{"ab", "cd", "e"}));
+    CORRADE_COMPARE(cache.glyphCount(), 6);
+    cache.flush();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_VERIFY(verifyTexture(cache));
+    #endif
+}
+
+void DynamicGlyphCacheGLTest::layout() {
+    TestFont font;
+    DynamicGlyphCache cache{{32, 32}};
+
+    /* Missing glyphs are added before the layout */
+    std::unique_ptr<AbstractLayouter> layouter = font.layout(cache, 1.0f, "abc");
+    CORRADE_COMPARE(font.filled, (std::vector<std::string>{"abc"}));
+    CORRADE_COMPARE(cache.glyphCount(), 4);
+    CORRADE_COMPARE(layouter->glyphCount(), 3);
+
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    CORRADE_COMPARE(layouter->renderGlyph(1, cursorPosition, rectangle).second,
+        Range2D{cache['b'].second}.scaled(Vector2{1.0f/32.0f}));
+}
+
+void DynamicGlyphCacheGLTest::renderer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_EMSCRIPTEN)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::OES::mapbuffer>()
+       #ifdef CORRADE_TARGET_NACL
+       && !Context::current().isExtensionSupported<Extensions::GL::CHROMIUM::map_sub>()
+       #endif
+    ) {
+        CORRADE_SKIP("No required extension is supported");
+    }
+    #endif
+
+    TestFont font;
+    DynamicGlyphCache cache{{32, 32}};
+    Renderer2D renderer{font, cache, 1.0f};
+    renderer.reserve(4, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Missing glyphs are added on every render */
+    renderer.render("ab");
+    CORRADE_COMPARE(font.filled, (std::vector<std::string>{"ab"}));
+    renderer.render("abcd");
+    CORRADE_COMPARE(font.filled, (std::vector<std::string>{"ab", "cd"}));
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::DynamicGlyphCacheGLTest)
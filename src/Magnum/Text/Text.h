@@ -39,6 +39,7 @@ class AbstractFont;
 class AbstractFontConverter;
 class AbstractLayouter;
 class DistanceFieldGlyphCache;
+class DynamicGlyphCache;
 class GlyphCache;
 
 enum class Alignment: UnsignedByte;
@@ -25,37 +25,38 @@
 
 #include "Atlas.h"
 
-#include "Magnum/Math/Functions.h"
-#include "Magnum/Math/Range.h"
+#include <algorithm>
+#include <numeric>
+
+#include "Magnum/TextureTools/AtlasPacker.h"
 
 namespace Magnum { namespace TextureTools {
 
 std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
     if(sizes.empty()) return {};
 
-    /* Size of largest texture */
-    Vector2i maxSize;
-    for(const Vector2i& size: sizes)
-        maxSize = Math::max(maxSize, size);
-
-    std::vector<Range2Di> atlas;
-
-    /* Columns and rows */
-    const Vector2i paddedSize = maxSize+2*padding;
-    const Vector2i gridSize = atlasSize/paddedSize;
-    if(std::size_t(gridSize.product()) < sizes.size()) {
-        Error() << "TextureTools::atlas(): requested atlas size" << atlasSize
-                << "is too small to fit" << sizes.size() << paddedSize
-                << "textures. Generated atlas will be empty.";
-        return atlas;
+    /* Add the largest textures first, smaller ones then fill the gaps */
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+        const Int maxA = sizes[a].max(), maxB = sizes[b].max();
+        return maxA > maxB || (maxA == maxB && sizes[a].min() > sizes[b].min());
+    });
+
+    AtlasPacker packer{atlasSize, AtlasPacker::Algorithm::MaxRectsBestShortSideFit, padding};
+    std::vector<Range2Di> atlas(sizes.size());
+    for(std::size_t i: order) {
+        const std::pair<bool, Range2Di> added = packer.add(sizes[i]);
+        if(!added.first) {
+            Error() << "TextureTools::atlas(): requested atlas size" << atlasSize
+                    << "is too small to fit" << sizes.size() << "textures with padding"
+                    << padding << Debug::nospace << ". Generated atlas will be empty.";
+            return {};
+        }
+
+        atlas[i] = added.second;
     }
 
-    /** @todo actual magic implementation, not this joke */
-
-    atlas.reserve(sizes.size());
-    for(std::size_t i = 0; i != sizes.size(); ++i)
-        atlas.push_back(Range2Di::fromSize(Vector2i(i%gridSize.x(), i/gridSize.x())*paddedSize+padding, sizes[i]));
-
     return atlas;
 }
 
@@ -49,6 +49,11 @@ into required size, empty vector is returned.
 Padding is added twice to each size and the atlas is laid out so the padding
 don't overlap. Returned sizes are the same as original sizes, i.e. without the
 padding.
+
+The textures are sorted from largest to smallest and placed using
+@ref AtlasPacker::Algorithm::MaxRectsBestShortSideFit, without rotation. Use
+@ref AtlasPacker directly if you need to add textures incrementally, allow
+rotation or use a different algorithm.
 */
 std::vector<Range2Di> MAGNUM_TEXTURETOOLS_EXPORT atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding = Vector2i());
 
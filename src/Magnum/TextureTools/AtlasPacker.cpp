@@ -0,0 +1,306 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AtlasPacker.h"
+
+#include <algorithm>
+#include <limits>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace TextureTools {
+
+AtlasPacker::AtlasPacker(const Vector2i& size, const Algorithm algorithm, const Vector2i& padding): _size{size}, _padding{padding}, _algorithm{algorithm}, _rotationAllowed{false} {
+    clear();
+}
+
+Float AtlasPacker::occupancy() const {
+    const Long area = Long(_size.x())*Long(_size.y());
+    return area ? Float(Double(_usedArea)/Double(area)) : 0.0f;
+}
+
+void AtlasPacker::clear() {
+    _count = 0;
+    _usedArea = 0;
+    _skyline.clear();
+    _free.clear();
+    if(_algorithm == Algorithm::SkylineBottomLeft)
+        _skyline.push_back({0, 0, _size.x()});
+    else
+        _free.push_back({{}, _size});
+}
+
+std::pair<bool, Range2Di> AtlasPacker::add(const Vector2i& size) {
+    /* Both sides padded, atlas edges included. The padding is in atlas
+       space, so it's not rotated together with the rectangle. */
+    const Vector2i sizes[]{size + 2*_padding, size.flipped() + 2*_padding};
+    const std::size_t sizeCount = _rotationAllowed && sizes[0] != sizes[1] ? 2 : 1;
+
+    Vector2i position;
+    std::size_t chosen;
+    if(!(_algorithm == Algorithm::SkylineBottomLeft ?
+        addSkyline({sizes, sizeCount}, position, chosen) :
+        addMaxRects({sizes, sizeCount}, position, chosen))) return {false, {}};
+
+    const bool rotated = chosen == 1;
+    ++_count;
+    _usedArea += Long(sizes[chosen].x())*Long(sizes[chosen].y());
+    return {true, Range2Di::fromSize(position + _padding, rotated ? size.flipped() : size)};
+}
+
+void AtlasPacker::remove(const Range2Di& range) {
+    CORRADE_ASSERT(_algorithm == Algorithm::MaxRectsBestShortSideFit,
+        "TextureTools::AtlasPacker::remove(): not supported with" << _algorithm, );
+    CORRADE_ASSERT(_count, "TextureTools::AtlasPacker::remove(): no rectangles to remove", );
+
+    const Range2Di padded{range.min() - _padding, range.max() + _padding};
+    --_count;
+    _usedArea -= Long(padded.size().x())*Long(padded.size().y());
+
+    /* If nothing is left, reset to the initial state to undo any
+       fragmentation */
+    if(!_count) {
+        _free.assign(1, {{}, _size});
+        return;
+    }
+
+    /* Zero-area rectangles don't occupy any space */
+    if(!padded.size().x() || !padded.size().y()) return;
+
+    /* Add the freed range together with its unions with neighboring free
+       space, first grown horizontally and then vertically and vice versa */
+    const std::size_t freeCount = _free.size();
+    const Range2Di horizontal = growMaxRects(padded, false);
+    const Range2Di vertical = growMaxRects(padded, true);
+    for(const Range2Di& added: {padded, horizontal, growMaxRects(horizontal, true), vertical, growMaxRects(vertical, false)})
+        _free.push_back(added);
+
+    /* Unlike in addMaxRects(), the new rectangles can contain the existing
+       ones, so everything needs to be checked */
+    auto contains = [](const Range2Di& a, const Range2Di& b) {
+        return (a.min() <= b.min()).all() && (a.max() >= b.max()).all();
+    };
+    for(std::size_t i = 0; i != _free.size(); ++i) {
+        for(std::size_t j = Math::max(freeCount, i + 1); j < _free.size(); ++j) {
+            if(_free[i].size().isZero() || _free[j].size().isZero()) continue;
+            if(contains(_free[i], _free[j])) _free[j] = {};
+            else if(contains(_free[j], _free[i])) _free[i] = {};
+        }
+    }
+
+    _free.erase(std::remove_if(_free.begin(), _free.end(), [](const Range2Di& r) {
+        return r.size().x() <= 0 || r.size().y() <= 0;
+    }), _free.end());
+}
+
+Range2Di AtlasPacker::growMaxRects(Range2Di range, const bool vertical) const {
+    /* A free rectangle spanning the whole side of the range and touching or
+       overlapping it can be merged with it into a larger free rectangle */
+    const std::size_t a = vertical ? 1 : 0, b = vertical ? 0 : 1;
+    for(bool grown = true; grown; ) {
+        grown = false;
+        for(const Range2Di& free: _free) {
+            if(free.min()[b] > range.min()[b] || free.max()[b] < range.max()[b] ||
+               free.max()[a] < range.min()[a] || free.min()[a] > range.max()[a])
+                continue;
+            if(free.min()[a] < range.min()[a]) {
+                range.min()[a] = free.min()[a];
+                grown = true;
+            }
+            if(free.max()[a] > range.max()[a]) {
+                range.max()[a] = free.max()[a];
+                grown = true;
+            }
+        }
+    }
+
+    return range;
+}
+
+Int AtlasPacker::skylineFit(const std::size_t i, const Vector2i& size) const {
+    /* Doesn't fit horizontally */
+    const Int x = _skyline[i].x;
+    if(x + size.x() > _size.x()) return -1;
+
+    /* Find the highest node under the rectangle */
+    Int y = _skyline[i].y;
+    Int widthLeft = size.x();
+    for(std::size_t j = i; widthLeft > 0; ++j) {
+        y = Math::max(y, _skyline[j].y);
+        widthLeft -= _skyline[j].width;
+    }
+
+    return y + size.y() > _size.y() ? -1 : y;
+}
+
+bool AtlasPacker::addSkyline(const Containers::ArrayView<const Vector2i> sizes, Vector2i& position, std::size_t& chosen) {
+    Int bestTop = std::numeric_limits<Int>::max();
+    Int bestWidth = std::numeric_limits<Int>::max();
+    std::size_t bestIndex = ~std::size_t{};
+
+    /* Find the node where the top edge of the rectangle would be lowest,
+       preferring narrower nodes on ties to leave less space unused */
+    for(std::size_t i = 0; i != _skyline.size(); ++i) {
+        for(std::size_t j = 0; j != sizes.size(); ++j) {
+            const Int y = skylineFit(i, sizes[j]);
+            if(y == -1) continue;
+
+            const Int top = y + sizes[j].y();
+            if(top < bestTop || (top == bestTop && _skyline[i].width < bestWidth)) {
+                bestTop = top;
+                bestWidth = _skyline[i].width;
+                bestIndex = i;
+                chosen = j;
+                position = {_skyline[i].x, y};
+            }
+        }
+    }
+
+    if(bestIndex == ~std::size_t{}) return false;
+    const Vector2i bestSize = sizes[chosen];
+
+    /* Zero-width rectangles don't change the skyline */
+    if(!bestSize.x()) return true;
+
+    /* Insert a new node and shrink or remove the nodes it covers */
+    _skyline.insert(_skyline.begin() + bestIndex, SkylineNode{position.x(), bestTop, bestSize.x()});
+    const Int right = position.x() + bestSize.x();
+    for(std::size_t i = bestIndex + 1; i < _skyline.size(); ) {
+        SkylineNode& node = _skyline[i];
+        if(node.x >= right) break;
+
+        const Int shrink = right - node.x;
+        if(shrink < node.width) {
+            node.x += shrink;
+            node.width -= shrink;
+            break;
+        }
+
+        _skyline.erase(_skyline.begin() + i);
+    }
+
+    /* Merge neighboring nodes of the same height */
+    for(std::size_t i = 0; i + 1 < _skyline.size(); ) {
+        if(_skyline[i].y == _skyline[i + 1].y) {
+            _skyline[i].width += _skyline[i + 1].width;
+            _skyline.erase(_skyline.begin() + i + 1);
+        } else ++i;
+    }
+
+    return true;
+}
+
+bool AtlasPacker::addMaxRects(const Containers::ArrayView<const Vector2i> sizes, Vector2i& position, std::size_t& chosen) {
+    Int bestShortSide = std::numeric_limits<Int>::max();
+    Int bestLongSide = std::numeric_limits<Int>::max();
+    Vector2i bestSize{-1};
+
+    /* Find the free rectangle where the shorter leftover side is smallest */
+    for(const Range2Di& free: _free) {
+        for(std::size_t j = 0; j != sizes.size(); ++j) {
+            const Vector2i leftover = free.size() - sizes[j];
+            if(leftover.x() < 0 || leftover.y() < 0) continue;
+
+            const Int shortSide = Math::min(leftover.x(), leftover.y());
+            const Int longSide = Math::max(leftover.x(), leftover.y());
+            if(shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+                bestShortSide = shortSide;
+                bestLongSide = longSide;
+                bestSize = sizes[j];
+                chosen = j;
+                position = free.min();
+            }
+        }
+    }
+
+    if(bestSize.x() == -1) return false;
+
+    splitMaxRects(Range2Di::fromSize(position, bestSize));
+    return true;
+}
+
+void AtlasPacker::splitMaxRects(const Range2Di& placed) {
+    /* Split all free rectangles intersecting the placed one into up to four
+       maximal rectangles around it */
+    const std::size_t freeCount = _free.size();
+    for(std::size_t i = 0; i != freeCount; ++i) {
+        const Range2Di free = _free[i];
+        if(placed.min().x() >= free.max().x() || placed.max().x() <= free.min().x() ||
+           placed.min().y() >= free.max().y() || placed.max().y() <= free.min().y())
+            continue;
+
+        if(placed.min().x() > free.min().x())
+            _free.push_back({free.min(), {placed.min().x(), free.max().y()}});
+        if(placed.max().x() < free.max().x())
+            _free.push_back({{placed.max().x(), free.min().y()}, free.max()});
+        if(placed.min().y() > free.min().y())
+            _free.push_back({free.min(), {free.max().x(), placed.min().y()}});
+        if(placed.max().y() < free.max().y())
+            _free.push_back({{free.min().x(), placed.max().y()}, free.max()});
+
+        /* Mark the original as empty, removed below */
+        _free[i] = {};
+    }
+
+    /* Remove the new rectangles that are fully contained in other ones. The
+       new rectangles are inside the ones they were split from, so none of the
+       untouched rectangles can be contained in them. If two rectangles are
+       the same, only the later one is removed. */
+    auto contains = [](const Range2Di& a, const Range2Di& b) {
+        return (a.min() <= b.min()).all() && (a.max() >= b.max()).all();
+    };
+    for(std::size_t i = freeCount; i != _free.size(); ++i) {
+        for(std::size_t j = 0; j != _free.size(); ++j) {
+            if(i == j || _free[j].size().isZero()) continue;
+            if(contains(_free[j], _free[i]) && (j < i || !contains(_free[i], _free[j]))) {
+                _free[i] = {};
+                break;
+            }
+        }
+    }
+
+    /* Remove the split and contained rectangles */
+    _free.erase(std::remove_if(_free.begin(), _free.end(), [](const Range2Di& r) {
+        return r.size().x() <= 0 || r.size().y() <= 0;
+    }), _free.end());
+}
+
+Debug& operator<<(Debug& debug, const AtlasPacker::Algorithm value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case AtlasPacker::Algorithm::value: return debug << "TextureTools::AtlasPacker::Algorithm::" #value;
+        _c(SkylineBottomLeft)
+        _c(MaxRectsBestShortSideFit)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "TextureTools::AtlasPacker::Algorithm(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
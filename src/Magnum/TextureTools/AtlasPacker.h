@@ -0,0 +1,225 @@
+#ifndef Magnum_TextureTools_AtlasPacker_h
+#define Magnum_TextureTools_AtlasPacker_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::AtlasPacker
+ */
+
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Incremental texture atlas packer
+
+Places rectangles of arbitrary sizes into a fixed-size atlas one by one,
+without moving the already placed ones. Useful for atlases that are filled
+dynamically, such as glyph caches. If you have all sizes known upfront, the
+@ref atlas() function packs them in one go, sorting them from largest to
+smallest for tighter fit.
+@code
+TextureTools::AtlasPacker packer{{512, 512}};
+packer.setRotationAllowed(true);
+
+std::pair<bool, Range2Di> glyph = packer.add({12, 18});
+if(!glyph.first) {
+    // atlas is full...
+}
+@endcode
+
+Two algorithms are available, see @ref Algorithm. The
+@ref Algorithm::MaxRectsBestShortSideFit "MaxRects" algorithm gives tighter
+packing, while the @ref Algorithm::SkylineBottomLeft "skyline" algorithm is
+faster and its state has constant size regardless of how fragmented the atlas
+is. Fill ratio of the atlas can be queried using @ref occupancy().
+
+@anchor TextureTools-AtlasPacker-padding
+## Padding
+
+Padding is added to both sides of each rectangle, so the padding of
+neighboring rectangles doesn't overlap, but the padding can overlap atlas
+edges. The returned ranges are without the padding.
+
+@anchor TextureTools-AtlasPacker-rotation
+## Rotation
+
+If rotation is allowed using @ref setRotationAllowed(), the packer can rotate
+a rectangle by 90° if it fits better. The returned range then has the X and Y
+size swapped compared to the requested size and it's up to the user to
+account for that when filling the atlas and generating texture coordinates.
+The padding is always applied in atlas space and is not rotated.
+
+@anchor TextureTools-AtlasPacker-removing
+## Removing rectangles
+
+With the @ref Algorithm::MaxRectsBestShortSideFit "MaxRects" algorithm,
+previously added rectangles can be removed again using @ref remove(), making
+their space available for new rectangles. This allows the atlas to be used
+as a cache with eviction. The freed space is merged with neighboring free
+space where the union is a rectangle, but long-running add/remove cycles can
+still fragment the atlas over time, in which case it's best to @ref clear()
+it and fill it again.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT AtlasPacker {
+    public:
+        /**
+         * @brief Packing algorithm
+         *
+         * @see @ref AtlasPacker()
+         */
+        enum class Algorithm: UnsignedByte {
+            /**
+             * Skyline, bottom-left placement. Keeps only the upper contour
+             * of placed rectangles and puts each new rectangle at a position
+             * where its top edge is lowest. Fast, but the space below the
+             * contour is lost.
+             */
+            SkylineBottomLeft,
+
+            /**
+             * MaxRects, best short side fit. Keeps a list of maximal free
+             * rectangles and puts each new rectangle into the one where the
+             * shorter leftover side is smallest. Slower than skyline, but
+             * gives better fill ratio especially for varying sizes.
+             */
+            MaxRectsBestShortSideFit
+        };
+
+        /**
+         * @brief Constructor
+         * @param size      Atlas size
+         * @param algorithm Packing algorithm
+         * @param padding   Padding around each rectangle
+         */
+        explicit AtlasPacker(const Vector2i& size, Algorithm algorithm = Algorithm::MaxRectsBestShortSideFit, const Vector2i& padding = {});
+
+        /** @brief Atlas size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Packing algorithm */
+        Algorithm algorithm() const { return _algorithm; }
+
+        /** @brief Padding around each rectangle */
+        Vector2i padding() const { return _padding; }
+
+        /**
+         * @brief Whether rotating the rectangles is allowed
+         *
+         * Not allowed by default.
+         */
+        bool isRotationAllowed() const { return _rotationAllowed; }
+
+        /**
+         * @brief Allow or disallow rotating the rectangles
+         * @return Reference to self (for method chaining)
+         *
+         * Affects only rectangles added after this call. See
+         * @ref TextureTools-AtlasPacker-rotation "class documentation" for
+         * more information.
+         */
+        AtlasPacker& setRotationAllowed(bool allowed) {
+            _rotationAllowed = allowed;
+            return *this;
+        }
+
+        /** @brief Count of added rectangles */
+        std::size_t count() const { return _count; }
+
+        /**
+         * @brief Occupancy
+         *
+         * Ratio of the area covered by added rectangles (including their
+         * padding) to the area of the whole atlas, in range @f$ [0, 1] @f$.
+         */
+        Float occupancy() const;
+
+        /**
+         * @brief Add a rectangle
+         * @return Whether the rectangle fit and its range in the atlas,
+         *      without the padding
+         *
+         * If the rectangle doesn't fit, returns `false` and the packer state
+         * is not modified. If rotation is allowed, the returned range may
+         * have the size rotated, see @ref TextureTools-AtlasPacker-rotation "class documentation"
+         * for more information.
+         */
+        std::pair<bool, Range2Di> add(const Vector2i& size);
+
+        /**
+         * @brief Remove a rectangle
+         * @param range     Range returned from @ref add(), without the
+         *      padding
+         *
+         * Makes the space occupied by the rectangle and its padding
+         * available again. Expects that the algorithm is
+         * @ref Algorithm::MaxRectsBestShortSideFit and that the range was
+         * previously returned from @ref add() and not removed yet. See
+         * @ref TextureTools-AtlasPacker-removing "class documentation" for
+         * more information.
+         */
+        void remove(const Range2Di& range);
+
+        /**
+         * @brief Remove all rectangles
+         *
+         * Resets the packer to its initial state, keeping the size,
+         * algorithm, padding and rotation setting.
+         */
+        void clear();
+
+    private:
+        struct SkylineNode {
+            Int x, y, width;
+        };
+
+        bool addSkyline(Containers::ArrayView<const Vector2i> sizes, Vector2i& position, std::size_t& chosen);
+        Int skylineFit(std::size_t i, const Vector2i& size) const;
+        bool addMaxRects(Containers::ArrayView<const Vector2i> sizes, Vector2i& position, std::size_t& chosen);
+        void splitMaxRects(const Range2Di& placed);
+        Range2Di growMaxRects(Range2Di range, bool vertical) const;
+
+        Vector2i _size, _padding;
+        Algorithm _algorithm;
+        bool _rotationAllowed;
+        std::size_t _count;
+        Long _usedArea;
+        std::vector<SkylineNode> _skyline;
+        std::vector<Range2Di> _free;
+};
+
+/** @debugoperatorclassenum{Magnum::TextureTools::AtlasPacker,Magnum::TextureTools::AtlasPacker::Algorithm} */
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, AtlasPacker::Algorithm value);
+
+}}
+
+#endif
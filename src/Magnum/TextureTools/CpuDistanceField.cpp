@@ -0,0 +1,268 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CpuDistanceField.h"
+
+#include <cmath>
+#include <limits>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+    /* Count of input columns processed in one column chunk and count of
+       output rows processed in one row chunk */
+    enum: std::size_t {
+        ColumnChunkSize = 32,
+        RowChunkSize = 16
+    };
+}
+
+struct CpuDistanceField::State {
+    /* Input */
+    const char* pixels;
+    std::size_t stride, pixelSize;
+    Vector2i inputSize;
+
+    /* Input column and row sampled by each output column and row */
+    Vector2i outputSize;
+    Containers::Array<Int> columns, rows;
+
+    /* Squared distances to nearest inside and outside pixel in the same
+       column for each sampled row, clamped to (radius + 1)^2 */
+    Containers::Array<Float> inside, outside;
+
+    Containers::Array<char> output;
+    std::size_t outputStride;
+
+    std::size_t columnChunkCount, rowChunkCount;
+};
+
+CpuDistanceField::CpuDistanceField(const Int radius): _radius{radius} {}
+
+CpuDistanceField::CpuDistanceField(CpuDistanceField&&) noexcept = default;
+
+CpuDistanceField::~CpuDistanceField() = default;
+
+CpuDistanceField& CpuDistanceField::operator=(CpuDistanceField&&) noexcept = default;
+
+Image2D CpuDistanceField::operator()(const ImageView2D& input, const Vector2i& outputSize) {
+    for(std::size_t i = 0, count = begin(input, outputSize); i != count; ++i)
+        columnChunk(i);
+    for(std::size_t i = 0, count = beginRows(); i != count; ++i)
+        rowChunk(i);
+    return end();
+}
+
+std::size_t CpuDistanceField::begin(const ImageView2D& input, const Vector2i& outputSize) {
+    CORRADE_ASSERT(input.type() == PixelType::UnsignedByte,
+        "TextureTools::CpuDistanceField::begin(): expected input with" << PixelType::UnsignedByte << "but got" << input.type(), {});
+    CORRADE_ASSERT(input.size().product() && outputSize.product(),
+        "TextureTools::CpuDistanceField::begin(): expected non-empty input and output size but got" << input.size() << "and" << outputSize, {});
+
+    _state.reset(new State);
+    State& state = *_state;
+
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::tie(dataOffset, dataSize, state.pixelSize) = input.dataProperties();
+    state.pixels = input.data() + dataOffset.sum();
+    state.stride = dataSize.x();
+    state.inputSize = input.size();
+    state.outputSize = outputSize;
+
+    /* Same mapping as in the shader, i.e. truncated float multiplication */
+    const Vector2 scaling = Vector2{input.size()}/Vector2{outputSize};
+    state.columns = Containers::Array<Int>{std::size_t(outputSize.x())};
+    for(Int x = 0; x != outputSize.x(); ++x)
+        state.columns[x] = Math::min(Int(Float(x)*scaling.x()), input.size().x() - 1);
+    state.rows = Containers::Array<Int>{std::size_t(outputSize.y())};
+    for(Int y = 0; y != outputSize.y(); ++y)
+        state.rows[y] = Math::min(Int(Float(y)*scaling.y()), input.size().y() - 1);
+
+    const std::size_t sampledSize = std::size_t(outputSize.y())*input.size().x();
+    state.inside = Containers::Array<Float>{sampledSize};
+    state.outside = Containers::Array<Float>{sampledSize};
+
+    state.columnChunkCount = (input.size().x() + ColumnChunkSize - 1)/ColumnChunkSize;
+    state.rowChunkCount = 0;
+    return state.columnChunkCount;
+}
+
+std::size_t CpuDistanceField::columnChunkCount() const {
+    return _state ? _state->columnChunkCount : 0;
+}
+
+void CpuDistanceField::columnChunk(const std::size_t chunk) {
+    CORRADE_ASSERT(_state && chunk < _state->columnChunkCount,
+        "TextureTools::CpuDistanceField::columnChunk(): chunk" << chunk << "out of range for" << columnChunkCount() << "chunks", );
+    State& state = *_state;
+
+    const Int begin = chunk*ColumnChunkSize;
+    const Int end = Math::min(begin + Int(ColumnChunkSize), state.inputSize.x());
+    const Int width = end - begin;
+    const Int height = state.inputSize.y();
+
+    /* Distances larger than radius + 1 are clamped anyway, so they don't need
+       to be tracked further */
+    const Int far = _radius + 1;
+
+    /* Forward and backward scan, going row by row over all columns in the
+       chunk to access the input in memory order. Distance to nearest inside
+       and outside pixel is computed for each pixel. */
+    Containers::Array<Int> inside{std::size_t(width*height)}, outside{std::size_t(width*height)};
+    Containers::Array<Int> lastInside{Containers::DirectInit, std::size_t(width), -far},
+        lastOutside{Containers::DirectInit, std::size_t(width), -far};
+    for(Int y = 0; y != height; ++y) {
+        const char* const row = state.pixels + y*state.stride + begin*state.pixelSize;
+        for(Int x = 0; x != width; ++x) {
+            if(UnsignedByte(row[x*state.pixelSize]) > 127)
+                lastInside[x] = y;
+            else
+                lastOutside[x] = y;
+
+            inside[y*width + x] = Math::min(y - lastInside[x], far);
+            outside[y*width + x] = Math::min(y - lastOutside[x], far);
+        }
+    }
+
+    Containers::Array<Int> nextInside{Containers::DirectInit, std::size_t(width), height + far},
+        nextOutside{Containers::DirectInit, std::size_t(width), height + far};
+    for(Int y = height - 1; y >= 0; --y) {
+        for(Int x = 0; x != width; ++x) {
+            Int& insideDistance = inside[y*width + x];
+            Int& outsideDistance = outside[y*width + x];
+            if(insideDistance == 0) nextInside[x] = y;
+            if(outsideDistance == 0) nextOutside[x] = y;
+
+            insideDistance = Math::min(insideDistance, nextInside[x] - y);
+            outsideDistance = Math::min(outsideDistance, nextOutside[x] - y);
+        }
+    }
+
+    /* Save squared distances for sampled rows */
+    for(Int i = 0; i != state.outputSize.y(); ++i) {
+        const Int y = state.rows[i];
+        for(Int x = 0; x != width; ++x) {
+            state.inside[i*state.inputSize.x() + begin + x] = Float(Math::pow<2>(inside[y*width + x]));
+            state.outside[i*state.inputSize.x() + begin + x] = Float(Math::pow<2>(outside[y*width + x]));
+        }
+    }
+}
+
+std::size_t CpuDistanceField::beginRows() {
+    CORRADE_ASSERT(_state, "TextureTools::CpuDistanceField::beginRows(): no computation in progress", {});
+    State& state = *_state;
+
+    state.outputStride = (state.outputSize.x() + 3)/4*4;
+    state.output = Containers::Array<char>{Containers::ValueInit, state.outputStride*state.outputSize.y()};
+    state.rowChunkCount = (state.outputSize.y() + RowChunkSize - 1)/RowChunkSize;
+    return state.rowChunkCount;
+}
+
+std::size_t CpuDistanceField::rowChunkCount() const {
+    return _state ? _state->rowChunkCount : 0;
+}
+
+namespace {
+
+/* Lower envelope of parabolas rooted at each pixel with height given by the
+   column distance, evaluated at the sampled columns */
+void distanceTransform(const Float* const f, const Int n, const Containers::ArrayView<const Int> columns, Float* const out, Int* const v, Float* const z) {
+    Int k = 0;
+    v[0] = 0;
+    z[0] = -std::numeric_limits<Float>::infinity();
+    z[1] = +std::numeric_limits<Float>::infinity();
+    for(Int q = 1; q < n; ++q) {
+        /* Intersection of parabolas rooted at q and v[k], written so the
+           values stay small */
+        Float s;
+        while((s = ((f[q] - f[v[k]])/Float(q - v[k]) + Float(q + v[k]))*0.5f) <= z[k])
+            --k;
+
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = +std::numeric_limits<Float>::infinity();
+    }
+
+    k = 0;
+    for(std::size_t i = 0; i != columns.size(); ++i) {
+        const Int q = columns[i];
+        while(z[k + 1] < Float(q)) ++k;
+        out[i] = Float(Math::pow<2>(q - v[k])) + f[v[k]];
+    }
+}
+
+}
+
+void CpuDistanceField::rowChunk(const std::size_t chunk) {
+    CORRADE_ASSERT(_state && chunk < _state->rowChunkCount,
+        "TextureTools::CpuDistanceField::rowChunk(): chunk" << chunk << "out of range for" << rowChunkCount() << "chunks", );
+    State& state = *_state;
+
+    const Int begin = chunk*RowChunkSize;
+    const Int end = Math::min(begin + Int(RowChunkSize), state.outputSize.y());
+    const Int width = state.inputSize.x();
+    const Float limit = Float(Math::pow<2>(_radius + 1));
+    const Float normalization = 1.0f/Float(_radius*2 + 2);
+
+    Containers::Array<Int> v{std::size_t(width)};
+    Containers::Array<Float> z{std::size_t(width + 1)};
+    Containers::Array<Float> inside{std::size_t(state.outputSize.x())}, outside{std::size_t(state.outputSize.x())};
+    for(Int y = begin; y != end; ++y) {
+        distanceTransform(state.inside + y*width, width, state.columns, inside, v, z);
+        distanceTransform(state.outside + y*width, width, state.columns, outside, v, z);
+
+        /* Pixel with zero distance to nearest inside pixel is inside, the
+           distance is then to nearest outside pixel and positive. Normalized
+           from [-radius-1, radius+1] to [0, 1] the same way as in the shader. */
+        char* const row = state.output + y*state.outputStride;
+        for(Int x = 0; x != state.outputSize.x(); ++x) {
+            const Float value = inside[x] == 0.0f ?
+                 std::sqrt(Math::min(outside[x], limit))*normalization + 0.5f :
+                -std::sqrt(Math::min(inside[x], limit))*normalization + 0.5f;
+            row[x] = char(UnsignedByte(Math::clamp(value, 0.0f, 1.0f)*255.0f + 0.5f));
+        }
+    }
+}
+
+Image2D CpuDistanceField::end() {
+    CORRADE_ASSERT(_state, "TextureTools::CpuDistanceField::end(): no computation in progress",
+        (Image2D{PixelFormat::RGBA, PixelType::UnsignedByte}));
+
+    std::unique_ptr<State> state = std::move(_state);
+    return Image2D{
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        PixelFormat::Red,
+        #else
+        PixelFormat::Luminance,
+        #endif
+        PixelType::UnsignedByte, state->outputSize, std::move(state->output)};
+}
+
+}}
@@ -0,0 +1,202 @@
+#ifndef Magnum_TextureTools_CpuDistanceField_h
+#define Magnum_TextureTools_CpuDistanceField_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::CpuDistanceField
+ */
+
+#include <memory>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Signed distance field generation on the CPU
+
+Produces the same output as @ref distanceField(Texture2D&, Texture2D&, const Range2Di&, Int, const Vector2i&),
+but doesn't need an OpenGL context and its cost doesn't depend on the radius.
+@code
+Trade::ImageData2D image = ...;
+
+TextureTools::CpuDistanceField distanceField{24};
+Image2D output = distanceField(image, {256, 256});
+@endcode
+
+The input is expected to be a binary image with the value stored in the first
+(red) channel with @ref PixelType::UnsignedByte. Pixels with value larger
+than `127` are treated as inside, the rest as outside. The output is an image
+of given size with @ref PixelFormat::Red (@ref PixelFormat::Luminance in
+WebGL 1.0 builds) and @ref PixelType::UnsignedByte, with each pixel having
+value computed the same way as in the GPU implementation:
+
+-   The output pixel at position @f$ \boldsymbol{p} @f$ corresponds to input
+    pixel at @f$ \lfloor \boldsymbol{p} \boldsymbol{s} \rfloor @f$, where
+    @f$ \boldsymbol{s} @f$ is input size divided by output size.
+-   Distance @f$ d @f$ of the input pixel to nearest input pixel of opposite
+    value is clamped to `radius + 1`, pixels outside of the input image are
+    not taken into account.
+-   The resulting value is @f$ \pm d / (2 \cdot radius + 2) + 0.5 @f$, with
+    positive sign for inside pixels, stored with 8-bit precision.
+
+## The algorithm
+
+Squared distances to nearest inside and outside pixels are computed using the
+separable exact Euclidean distance transform from *Pedro F. Felzenszwalb,
+Daniel P. Huttenlocher - Distance Transforms of Sampled Functions, Theory of
+Computing, 2012*. It is first done in each input column and then, only for
+input rows that are sampled by the output, along rows using lower envelope of
+parabolas. Both passes are linear in the input size. Input distances are
+clamped to `radius + 1` from the start, which doesn't change the clamped
+result but keeps all values small and thus precise in floating-point.
+
+@anchor TextureTools-CpuDistanceField-parallel
+## Parallel execution
+
+The column and row passes can be split into chunks and executed on multiple
+threads. The class doesn't create any threads, the chunks are executed by the
+application, see @ref scenegraph-parallel for the `runChunks()` helper used
+below. @ref begin() prepares the computation and splits the column pass into
+chunks, which are then executed using @ref columnChunk(). When all column
+chunks are done, @ref beginRows() splits the row pass into chunks, executed
+using @ref rowChunk(). Finally, @ref end() returns the output image:
+@code
+runChunks(threadCount, distanceField.begin(image, {256, 256}), [&](std::size_t chunk) {
+    distanceField.columnChunk(chunk);
+});
+runChunks(threadCount, distanceField.beginRows(), [&](std::size_t chunk) {
+    distanceField.rowChunk(chunk);
+});
+Image2D output = distanceField.end();
+@endcode
+
+Each chunk writes to a disjoint part of the internal state or the output, so
+the result is the same regardless of how many threads were used or in which
+order the chunks were executed. The input image data have to stay in scope
+until all column chunks are executed.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT CpuDistanceField {
+    public:
+        /**
+         * @brief Constructor
+         * @param radius    Max lookup radius in the input image
+         */
+        explicit CpuDistanceField(Int radius);
+
+        /** @brief Copying is not allowed */
+        CpuDistanceField(const CpuDistanceField&) = delete;
+
+        /** @brief Move constructor */
+        CpuDistanceField(CpuDistanceField&&) noexcept;
+
+        ~CpuDistanceField();
+
+        /** @brief Copying is not allowed */
+        CpuDistanceField& operator=(const CpuDistanceField&) = delete;
+
+        /** @brief Move assignment */
+        CpuDistanceField& operator=(CpuDistanceField&&) noexcept;
+
+        /** @brief Max lookup radius */
+        Int radius() const { return _radius; }
+
+        /**
+         * @brief Create signed distance field
+         * @param input         Input image
+         * @param outputSize    Size of the output image
+         *
+         * Executes all chunks on the calling thread. See
+         * @ref TextureTools-CpuDistanceField-parallel "class documentation"
+         * for a parallel alternative.
+         */
+        Image2D operator()(const ImageView2D& input, const Vector2i& outputSize);
+
+        /**
+         * @brief Begin parallel signed distance field creation
+         * @param input         Input image
+         * @param outputSize    Size of the output image
+         * @return Count of chunks to execute with @ref columnChunk()
+         *
+         * Expects that @p input has @ref PixelType::UnsignedByte and that
+         * @p outputSize is not zero if @p input is not empty.
+         */
+        std::size_t begin(const ImageView2D& input, const Vector2i& outputSize);
+
+        /** @brief Count of chunks to execute with @ref columnChunk() */
+        std::size_t columnChunkCount() const;
+
+        /**
+         * @brief Execute column pass chunk
+         *
+         * Can be called from multiple threads concurrently, each chunk only
+         * once after each @ref begin(). Expects that @p chunk is less than
+         * @ref columnChunkCount().
+         */
+        void columnChunk(std::size_t chunk);
+
+        /**
+         * @brief Begin row pass
+         * @return Count of chunks to execute with @ref rowChunk()
+         *
+         * Expects that all chunks from @ref begin() were executed.
+         */
+        std::size_t beginRows();
+
+        /** @brief Count of chunks to execute with @ref rowChunk() */
+        std::size_t rowChunkCount() const;
+
+        /**
+         * @brief Execute row pass chunk
+         *
+         * Can be called from multiple threads concurrently, each chunk only
+         * once after each @ref beginRows(). Expects that @p chunk is less
+         * than @ref rowChunkCount().
+         */
+        void rowChunk(std::size_t chunk);
+
+        /**
+         * @brief End parallel signed distance field creation
+         *
+         * Expects that all chunks from @ref beginRows() were executed.
+         * Returns the output image.
+         */
+        Image2D end();
+
+    private:
+        struct State;
+
+        Int _radius;
+        std::unique_ptr<State> _state;
+};
+
+}}
+
+#endif
@@ -81,6 +81,8 @@ and Special Effects, SIGGRAPH 2007,
 http://www.valvesoftware.com/publications/2007/SIGGRAPH2007_AlphaTestedMagnification.pdf*
 
 @attention This is GPU-only implementation, so it expects active context.
+    See @ref CpuDistanceField for an implementation that gives the same
+    result without OpenGL and whose cost doesn't depend on @p radius.
 
 @note If internal format of @p output texture is not renderable, this function
     prints message to error output and does nothing. In desktop OpenGL and
@@ -0,0 +1,455 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/AtlasPacker.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct AtlasPackerTest: TestSuite::Tester {
+    explicit AtlasPackerTest();
+
+    void construct();
+
+    void skyline();
+    void skylinePadding();
+    void skylineRotation();
+    void maxRects();
+    void maxRectsPadding();
+    void maxRectsRotation();
+    void maxRectsFillGaps();
+    void maxRectsRemove();
+    void maxRectsRemovePadding();
+    void maxRectsRemoveRandom();
+
+    void full();
+    void empty();
+    void clear();
+    template<AtlasPacker::Algorithm algorithm, bool rotation> void random();
+
+    void debugAlgorithm();
+
+    template<AtlasPacker::Algorithm algorithm, bool rotation> void benchmarkPack();
+    template<AtlasPacker::Algorithm algorithm, bool rotation> void benchmarkFillRatio();
+    void benchmarkFillRatioGrid();
+
+    void fillRatioBegin();
+    std::uint64_t fillRatioEnd();
+
+    private:
+        std::vector<Vector2i> _benchmarkSizes;
+        Float _fillRatio;
+};
+
+namespace {
+    const char* algorithmName(AtlasPacker::Algorithm algorithm, bool rotation) {
+        if(algorithm == AtlasPacker::Algorithm::SkylineBottomLeft)
+            return rotation ? "SkylineBottomLeft, rotation" : "SkylineBottomLeft";
+        return rotation ? "MaxRectsBestShortSideFit, rotation" : "MaxRectsBestShortSideFit";
+    }
+
+    /* Mostly glyph-sized rectangles with some larger sprites */
+    std::vector<Vector2i> randomSizes(std::size_t count) {
+        std::minstd_rand rand;
+        std::vector<Vector2i> sizes(count);
+        for(Vector2i& size: sizes) {
+            if(rand() % 5) size = {4 + Int(rand() % 21), 8 + Int(rand() % 25)};
+            else size = {16 + Int(rand() % 113), 16 + Int(rand() % 113)};
+        }
+        return sizes;
+    }
+}
+
+AtlasPackerTest::AtlasPackerTest() {
+    addTests<AtlasPackerTest>({&AtlasPackerTest::construct,
+
+                               &AtlasPackerTest::skyline,
+                               &AtlasPackerTest::skylinePadding,
+                               &AtlasPackerTest::skylineRotation,
+                               &AtlasPackerTest::maxRects,
+                               &AtlasPackerTest::maxRectsPadding,
+                               &AtlasPackerTest::maxRectsRotation,
+                               &AtlasPackerTest::maxRectsFillGaps,
+                               &AtlasPackerTest::maxRectsRemove,
+                               &AtlasPackerTest::maxRectsRemovePadding,
+                               &AtlasPackerTest::maxRectsRemoveRandom,
+
+                               &AtlasPackerTest::full,
+                               &AtlasPackerTest::empty,
+                               &AtlasPackerTest::clear,
+                               &AtlasPackerTest::random<AtlasPacker::Algorithm::SkylineBottomLeft, false>,
+                               &AtlasPackerTest::random<AtlasPacker::Algorithm::SkylineBottomLeft, true>,
+                               &AtlasPackerTest::random<AtlasPacker::Algorithm::MaxRectsBestShortSideFit, false>,
+                               &AtlasPackerTest::random<AtlasPacker::Algorithm::MaxRectsBestShortSideFit, true>,
+
+                               &AtlasPackerTest::debugAlgorithm});
+
+    addBenchmarks<AtlasPackerTest>({&AtlasPackerTest::benchmarkPack<AtlasPacker::Algorithm::SkylineBottomLeft, false>,
+                                    &AtlasPackerTest::benchmarkPack<AtlasPacker::Algorithm::SkylineBottomLeft, true>,
+                                    &AtlasPackerTest::benchmarkPack<AtlasPacker::Algorithm::MaxRectsBestShortSideFit, false>,
+                                    &AtlasPackerTest::benchmarkPack<AtlasPacker::Algorithm::MaxRectsBestShortSideFit, true>}, 5);
+
+    addCustomBenchmarks<AtlasPackerTest>({&AtlasPackerTest::benchmarkFillRatioGrid,
+                                          &AtlasPackerTest::benchmarkFillRatio<AtlasPacker::Algorithm::SkylineBottomLeft, false>,
+                                          &AtlasPackerTest::benchmarkFillRatio<AtlasPacker::Algorithm::SkylineBottomLeft, true>,
+                                          &AtlasPackerTest::benchmarkFillRatio<AtlasPacker::Algorithm::MaxRectsBestShortSideFit, false>,
+                                          &AtlasPackerTest::benchmarkFillRatio<AtlasPacker::Algorithm::MaxRectsBestShortSideFit, true>}, 1,
+        &AtlasPackerTest::fillRatioBegin,
+        &AtlasPackerTest::fillRatioEnd,
+        BenchmarkUnits::Count);
+
+    _benchmarkSizes = randomSizes(2000);
+}
+
+void AtlasPackerTest::construct() {
+    AtlasPacker packer{{64, 32}, AtlasPacker::Algorithm::SkylineBottomLeft, {2, 1}};
+    CORRADE_COMPARE(packer.size(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(packer.algorithm(), AtlasPacker::Algorithm::SkylineBottomLeft);
+    CORRADE_COMPARE(packer.padding(), (Vector2i{2, 1}));
+    CORRADE_VERIFY(!packer.isRotationAllowed());
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.occupancy(), 0.0f);
+
+    /* Default is MaxRects without padding */
+    AtlasPacker packer2{{64, 32}};
+    CORRADE_COMPARE(packer2.algorithm(), AtlasPacker::Algorithm::MaxRectsBestShortSideFit);
+    CORRADE_COMPARE(packer2.padding(), Vector2i{});
+}
+
+void AtlasPackerTest::skyline() {
+    AtlasPacker packer{{64, 64}, AtlasPacker::Algorithm::SkylineBottomLeft};
+
+    CORRADE_COMPARE(packer.add({32, 16}), std::make_pair(true, Range2Di::fromSize({0, 0}, {32, 16})));
+    CORRADE_COMPARE(packer.add({16, 24}), std::make_pair(true, Range2Di::fromSize({32, 0}, {16, 24})));
+    /* Lowest position is on top of the first one, not right of the second */
+    CORRADE_COMPARE(packer.add({32, 16}), std::make_pair(true, Range2Di::fromSize({0, 16}, {32, 16})));
+    CORRADE_COMPARE(packer.add({16, 8}), std::make_pair(true, Range2Di::fromSize({48, 0}, {16, 8})));
+    CORRADE_COMPARE(packer.count(), 4);
+    CORRADE_COMPARE(packer.occupancy(), (32*16*2 + 16*24 + 16*8)/4096.0f);
+}
+
+void AtlasPackerTest::skylinePadding() {
+    AtlasPacker packer{{64, 64}, AtlasPacker::Algorithm::SkylineBottomLeft, {2, 1}};
+
+    CORRADE_COMPARE(packer.add({28, 14}), std::make_pair(true, Range2Di::fromSize({2, 1}, {28, 14})));
+    CORRADE_COMPARE(packer.add({28, 14}), std::make_pair(true, Range2Di::fromSize({34, 1}, {28, 14})));
+    CORRADE_COMPARE(packer.add({60, 14}), std::make_pair(true, Range2Di::fromSize({2, 17}, {60, 14})));
+    CORRADE_COMPARE(packer.occupancy(), 0.5f);
+}
+
+void AtlasPackerTest::skylineRotation() {
+    AtlasPacker packer{{16, 64}, AtlasPacker::Algorithm::SkylineBottomLeft};
+
+    /* Doesn't fit without rotation */
+    CORRADE_VERIFY(!packer.add({64, 16}).first);
+
+    packer.setRotationAllowed(true);
+    CORRADE_VERIFY(packer.isRotationAllowed());
+    CORRADE_COMPARE(packer.add({32, 8}), std::make_pair(true, Range2Di::fromSize({0, 0}, {8, 32})));
+    /* Rotated so the top edge is lower */
+    CORRADE_COMPARE(packer.add({16, 8}), std::make_pair(true, Range2Di::fromSize({8, 0}, {8, 16})));
+    CORRADE_COMPARE(packer.count(), 2);
+}
+
+void AtlasPackerTest::maxRects() {
+    AtlasPacker packer{{64, 64}};
+
+    CORRADE_COMPARE(packer.add({32, 16}), std::make_pair(true, Range2Di::fromSize({0, 0}, {32, 16})));
+    CORRADE_COMPARE(packer.add({32, 32}), std::make_pair(true, Range2Di::fromSize({32, 0}, {32, 32})));
+    /* Exactly fits the space below the first one */
+    CORRADE_COMPARE(packer.add({32, 16}), std::make_pair(true, Range2Di::fromSize({0, 16}, {32, 16})));
+    CORRADE_COMPARE(packer.add({64, 32}), std::make_pair(true, Range2Di::fromSize({0, 32}, {64, 32})));
+    CORRADE_COMPARE(packer.occupancy(), 1.0f);
+    CORRADE_VERIFY(!packer.add({1, 1}).first);
+}
+
+void AtlasPackerTest::maxRectsPadding() {
+    AtlasPacker packer{{64, 64}, AtlasPacker::Algorithm::MaxRectsBestShortSideFit, {2, 1}};
+
+    CORRADE_COMPARE(packer.add({28, 14}), std::make_pair(true, Range2Di::fromSize({2, 1}, {28, 14})));
+    CORRADE_COMPARE(packer.add({28, 14}), std::make_pair(true, Range2Di::fromSize({34, 1}, {28, 14})));
+    CORRADE_COMPARE(packer.add({60, 14}), std::make_pair(true, Range2Di::fromSize({2, 17}, {60, 14})));
+    CORRADE_COMPARE(packer.occupancy(), 0.5f);
+}
+
+void AtlasPackerTest::maxRectsRotation() {
+    AtlasPacker packer{{64, 64}};
+    packer.setRotationAllowed(true);
+
+    CORRADE_COMPARE(packer.add({48, 64}), std::make_pair(true, Range2Di::fromSize({0, 0}, {48, 64})));
+    /* Fits only rotated */
+    CORRADE_COMPARE(packer.add({64, 16}), std::make_pair(true, Range2Di::fromSize({48, 0}, {16, 64})));
+    CORRADE_COMPARE(packer.occupancy(), 1.0f);
+}
+
+void AtlasPackerTest::maxRectsFillGaps() {
+    /* Skyline loses the space under the overhanging rectangle, MaxRects
+       doesn't */
+    AtlasPacker skyline{{64, 32}, AtlasPacker::Algorithm::SkylineBottomLeft};
+    AtlasPacker maxRects{{64, 32}};
+    for(AtlasPacker* packer: {&skyline, &maxRects}) {
+        CORRADE_VERIFY(packer->add({32, 8}).first);
+        CORRADE_VERIFY(packer->add({32, 24}).first);
+        CORRADE_VERIFY(packer->add({64, 8}).first);
+    }
+
+    CORRADE_VERIFY(!skyline.add({32, 16}).first);
+    CORRADE_COMPARE(maxRects.add({32, 16}), std::make_pair(true, Range2Di::fromSize({0, 8}, {32, 16})));
+}
+
+void AtlasPackerTest::maxRectsRemove() {
+    AtlasPacker packer{{64, 64}};
+    const Range2Di a = packer.add({32, 64}).second;
+    const Range2Di b = packer.add({32, 32}).second;
+    const Range2Di c = packer.add({32, 32}).second;
+    CORRADE_COMPARE(a, Range2Di::fromSize({0, 0}, {32, 64}));
+    CORRADE_COMPARE(b, Range2Di::fromSize({32, 0}, {32, 32}));
+    CORRADE_COMPARE(c, Range2Di::fromSize({32, 32}, {32, 32}));
+    CORRADE_VERIFY(!packer.add({1, 1}).first);
+
+    /* The space is reused */
+    packer.remove(b);
+    CORRADE_COMPARE(packer.count(), 2);
+    CORRADE_COMPARE(packer.occupancy(), 0.75f);
+    CORRADE_COMPARE(packer.add({32, 32}), std::make_pair(true, b));
+
+    /* Neighboring free space is merged */
+    packer.remove(b);
+    packer.remove(c);
+    CORRADE_COMPARE(packer.count(), 1);
+    CORRADE_COMPARE(packer.occupancy(), 0.5f);
+    CORRADE_COMPARE(packer.add({32, 64}), std::make_pair(true, Range2Di::fromSize({32, 0}, {32, 64})));
+
+    /* Merged also with space that wasn't occupied before */
+    packer.clear();
+    const Range2Di d = packer.add({64, 16}).second;
+    CORRADE_VERIFY(packer.add({64, 48}).first);
+    packer.remove(d);
+    CORRADE_COMPARE(packer.add({64, 16}), std::make_pair(true, d));
+}
+
+void AtlasPackerTest::maxRectsRemovePadding() {
+    AtlasPacker packer{{64, 32}, AtlasPacker::Algorithm::MaxRectsBestShortSideFit, {2, 1}};
+    const Range2Di a = packer.add({28, 30}).second;
+    CORRADE_VERIFY(packer.add({28, 30}).first);
+    CORRADE_VERIFY(!packer.add({1, 1}).first);
+
+    /* The padding is freed as well */
+    packer.remove(a);
+    CORRADE_COMPARE(packer.occupancy(), 0.5f);
+    CORRADE_COMPARE(packer.add({28, 30}), std::make_pair(true, a));
+}
+
+void AtlasPackerTest::maxRectsRemoveRandom() {
+    const Vector2i padding{1, 2};
+    AtlasPacker packer{{256, 256}, AtlasPacker::Algorithm::MaxRectsBestShortSideFit, padding};
+    packer.setRotationAllowed(true);
+
+    std::minstd_rand rand;
+    const std::vector<Vector2i> sizes = randomSizes(2000);
+    std::vector<Range2Di> added;
+    std::size_t failed = 0;
+    for(const Vector2i& size: sizes) {
+        /* Remove random rectangles until the new one fits, like a cache
+           would do */
+        std::pair<bool, Range2Di> result;
+        while(!(result = packer.add(size)).first && !added.empty()) {
+            const std::size_t i = rand() % added.size();
+            packer.remove(added[i]);
+            added.erase(added.begin() + i);
+        }
+
+        if(result.first) added.push_back(result.second);
+        else ++failed;
+    }
+
+    /* Everything fits after removing enough */
+    CORRADE_COMPARE(failed, 0);
+    CORRADE_COMPARE(packer.count(), added.size());
+
+    /* The padded ranges are inside the atlas and don't overlap */
+    Long area = 0;
+    for(std::size_t i = 0; i != added.size(); ++i) {
+        const Range2Di a{added[i].min() - padding, added[i].max() + padding};
+        CORRADE_VERIFY((a.min() >= Vector2i{}).all());
+        CORRADE_VERIFY((a.max() <= Vector2i{256}).all());
+        area += a.size().product();
+        for(std::size_t j = i + 1; j != added.size(); ++j) {
+            const Range2Di b{added[j].min() - padding, added[j].max() + padding};
+            CORRADE_VERIFY(a.min().x() >= b.max().x() || a.max().x() <= b.min().x() ||
+                           a.min().y() >= b.max().y() || a.max().y() <= b.min().y());
+        }
+    }
+    CORRADE_COMPARE(packer.occupancy(), area/Float(256*256));
+
+    /* Removing everything makes the whole atlas available again */
+    for(const Range2Di& range: added) packer.remove(range);
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.occupancy(), 0.0f);
+    CORRADE_COMPARE(packer.add(Vector2i{256} - 2*padding), std::make_pair(true, Range2Di{padding, Vector2i{256} - padding}));
+}
+
+void AtlasPackerTest::full() {
+    AtlasPacker packer{{32, 32}};
+    CORRADE_VERIFY(packer.add({32, 24}).first);
+
+    /* Failed addition doesn't change anything */
+    CORRADE_VERIFY(!packer.add({16, 16}).first);
+    CORRADE_VERIFY(!packer.add({64, 1}).first);
+    CORRADE_COMPARE(packer.count(), 1);
+    CORRADE_COMPARE(packer.occupancy(), 0.75f);
+
+    CORRADE_COMPARE(packer.add({16, 8}), std::make_pair(true, Range2Di::fromSize({0, 24}, {16, 8})));
+    CORRADE_COMPARE(packer.add({16, 8}), std::make_pair(true, Range2Di::fromSize({16, 24}, {16, 8})));
+    CORRADE_COMPARE(packer.count(), 3);
+}
+
+void AtlasPackerTest::empty() {
+    AtlasPacker packer{{}};
+    CORRADE_VERIFY(!packer.add({1, 1}).first);
+    CORRADE_COMPARE(packer.occupancy(), 0.0f);
+}
+
+void AtlasPackerTest::clear() {
+    AtlasPacker packer{{32, 32}, AtlasPacker::Algorithm::SkylineBottomLeft};
+    packer.setRotationAllowed(true);
+    CORRADE_VERIFY(packer.add({32, 32}).first);
+    CORRADE_VERIFY(!packer.add({1, 1}).first);
+
+    packer.clear();
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.occupancy(), 0.0f);
+    CORRADE_VERIFY(packer.isRotationAllowed());
+    CORRADE_COMPARE(packer.add({32, 32}), std::make_pair(true, Range2Di::fromSize({}, {32, 32})));
+}
+
+template<AtlasPacker::Algorithm algorithm, bool rotation> void AtlasPackerTest::random() {
+    setTestCaseName(std::string{"random<"} + algorithmName(algorithm, rotation) + ">");
+
+    const Vector2i padding{1, 2};
+    AtlasPacker packer{{512, 512}, algorithm, padding};
+    packer.setRotationAllowed(rotation);
+
+    const std::vector<Vector2i> sizes = randomSizes(500);
+    std::vector<Range2Di> padded;
+    Long area = 0;
+    for(const Vector2i& size: sizes) {
+        const std::pair<bool, Range2Di> added = packer.add(size);
+        if(!added.first) continue;
+
+        /* The size is the same or rotated */
+        if(rotation) CORRADE_VERIFY(added.second.size() == size || added.second.size() == size.flipped());
+        else CORRADE_COMPARE(added.second.size(), size);
+
+        padded.push_back({added.second.min() - padding, added.second.max() + padding});
+        area += padded.back().size().product();
+    }
+
+    /* The padded ranges are inside the atlas and don't overlap */
+    for(std::size_t i = 0; i != padded.size(); ++i) {
+        CORRADE_VERIFY((padded[i].min() >= Vector2i{}).all());
+        CORRADE_VERIFY((padded[i].max() <= Vector2i{512}).all());
+        for(std::size_t j = i + 1; j != padded.size(); ++j) {
+            const Range2Di& a = padded[i];
+            const Range2Di& b = padded[j];
+            CORRADE_VERIFY(a.min().x() >= b.max().x() || a.max().x() <= b.min().x() ||
+                           a.min().y() >= b.max().y() || a.max().y() <= b.min().y());
+        }
+    }
+
+    CORRADE_VERIFY(padded.size() > 100);
+    CORRADE_COMPARE(packer.count(), padded.size());
+    CORRADE_COMPARE(packer.occupancy(), area/Float(512*512));
+}
+
+void AtlasPackerTest::debugAlgorithm() {
+    std::ostringstream out;
+
+    Debug{&out} << AtlasPacker::Algorithm::SkylineBottomLeft << AtlasPacker::Algorithm(0xde);
+    CORRADE_COMPARE(out.str(), "TextureTools::AtlasPacker::Algorithm::SkylineBottomLeft TextureTools::AtlasPacker::Algorithm(0xde)\n");
+}
+
+template<AtlasPacker::Algorithm algorithm, bool rotation> void AtlasPackerTest::benchmarkPack() {
+    setTestCaseName(std::string{"benchmarkPack<"} + algorithmName(algorithm, rotation) + ">");
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        AtlasPacker packer{{1024, 1024}, algorithm};
+        packer.setRotationAllowed(rotation);
+        for(const Vector2i& size: _benchmarkSizes)
+            if(packer.add(size).first) ++count;
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+void AtlasPackerTest::fillRatioBegin() {
+    setBenchmarkName("fill ratio (permille)");
+    _fillRatio = 0.0f;
+}
+
+std::uint64_t AtlasPackerTest::fillRatioEnd() {
+    return std::uint64_t(_fillRatio*1000.0f);
+}
+
+template<AtlasPacker::Algorithm algorithm, bool rotation> void AtlasPackerTest::benchmarkFillRatio() {
+    setTestCaseName(std::string{"benchmarkFillRatio<"} + algorithmName(algorithm, rotation) + ">");
+
+    /* Add the rectangles until the atlas is full */
+    CORRADE_BENCHMARK(1) {
+        AtlasPacker packer{{1024, 1024}, algorithm};
+        packer.setRotationAllowed(rotation);
+        for(const Vector2i& size: _benchmarkSizes)
+            if(!packer.add(size).first) break;
+        _fillRatio = packer.occupancy();
+    }
+}
+
+void AtlasPackerTest::benchmarkFillRatioGrid() {
+    /* Uniform grid sized by the largest rectangle, as was done by atlas()
+       before */
+    CORRADE_BENCHMARK(1) {
+        Vector2i maxSize;
+        Long area = 0;
+        std::size_t count = 0;
+        for(const Vector2i& size: _benchmarkSizes) {
+            const Vector2i newMaxSize = Math::max(maxSize, size);
+            if(std::size_t((Vector2i{1024}/newMaxSize).product()) < count + 1) break;
+            maxSize = newMaxSize;
+            area += size.product();
+            ++count;
+        }
+        _fillRatio = area/Float(1024*1024);
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::AtlasPackerTest)
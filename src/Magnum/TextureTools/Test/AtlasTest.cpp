@@ -56,9 +56,9 @@ void AtlasTest::create() {
 
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({0, 0}, {12, 18}),
-        Range2Di::fromSize({32, 0}, {32, 15}),
-        Range2Di::fromSize({0, 25}, {23, 25})}));
+        Range2Di::fromSize({0, 15}, {12, 18}),
+        Range2Di::fromSize({0, 0}, {32, 15}),
+        Range2Di::fromSize({32, 0}, {23, 25})}));
 }
 
 void AtlasTest::createPadding() {
@@ -70,9 +70,9 @@ void AtlasTest::createPadding() {
 
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({2, 1}, {8, 16}),
-        Range2Di::fromSize({34, 1}, {28, 13}),
-        Range2Di::fromSize({2, 26}, {19, 23})}));
+        Range2Di::fromSize({2, 16}, {8, 16}),
+        Range2Di::fromSize({2, 1}, {28, 13}),
+        Range2Di::fromSize({34, 1}, {19, 23})}));
 }
 
 void AtlasTest::createEmpty() {
@@ -87,10 +87,10 @@ void AtlasTest::createTooSmall() {
     std::vector<Range2Di> atlas = TextureTools::atlas({64, 32}, {
         {8, 16},
         {21, 13},
-        {19, 29}
+        {40, 29}
     }, {2, 1});
     CORRADE_VERIFY(atlas.empty());
-    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 Vector(25, 31) textures. Generated atlas will be empty.\n");
+    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 textures with padding Vector(2, 1). Generated atlas will be empty.\n");
 }
 
 }}}
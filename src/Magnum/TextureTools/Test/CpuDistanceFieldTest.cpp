@@ -0,0 +1,279 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/TextureTools/CpuDistanceField.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct CpuDistanceFieldTest: TestSuite::Tester {
+    explicit CpuDistanceFieldTest();
+
+    void construct();
+    void compare();
+    void parallel();
+    void inputFormat();
+    void uniform();
+
+    template<Int radius> void benchmark();
+    template<Int radius> void benchmarkReference();
+
+    private:
+        std::vector<UnsignedByte> _benchmarkInput;
+};
+
+namespace {
+    enum: std::size_t { CompareDataCount = 5 };
+
+    constexpr struct {
+        const char* name;
+        Vector2i inputSize, outputSize;
+        Int radius;
+    } CompareData[CompareDataCount]{
+        {"same size", {64, 64}, {64, 64}, 4},
+        {"downscaled", {128, 96}, {32, 24}, 8},
+        {"non-integer scaling", {100, 70}, {37, 23}, 6},
+        {"upscaled", {32, 32}, {64, 64}, 3},
+        {"large radius", {200, 50}, {50, 50}, 20}
+    };
+
+    ImageView2D view(PixelFormat format, const Vector2i& size, const std::vector<UnsignedByte>& data) {
+        return ImageView2D{format, PixelType::UnsignedByte, size, Containers::ArrayView<const UnsignedByte>{data.data(), data.size()}};
+    }
+
+    /* A filled circle, a rectangle and few random blobs */
+    std::vector<UnsignedByte> generateInput(const Vector2i& size) {
+        std::vector<UnsignedByte> data(size.product());
+        std::minstd_rand rand;
+        std::vector<Vector3i> blobs;
+        for(std::size_t i = 0; i != 6; ++i)
+            blobs.emplace_back(rand() % size.x(), rand() % size.y(), 1 + rand() % 4);
+
+        const Vector2 center = Vector2{size}*0.4f;
+        const Float radius = Float(size.min())*0.25f;
+        for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+            bool inside = (Vector2{Float(x), Float(y)} - center).dot() < radius*radius ||
+                (x > size.x()*3/4 && x < size.x() - 2 && y > size.y()/8 && y < size.y()/2);
+            for(const Vector3i& blob: blobs)
+                if((Vector2i{x, y} - blob.xy()).dot() <= blob.z()*blob.z()) inside = !inside;
+            data[y*size.x() + x] = inside ? 200 : 30;
+        }
+
+        return data;
+    }
+
+    /* Literal translation of the shader, ignoring pixels outside of the image */
+    std::vector<UnsignedByte> reference(const std::vector<UnsignedByte>& input, const Vector2i& inputSize, const Vector2i& outputSize, const Int radius) {
+        std::vector<UnsignedByte> output(outputSize.product());
+        const Vector2 scaling = Vector2{inputSize}/Vector2{outputSize};
+        for(Int y = 0; y != outputSize.y(); ++y) for(Int x = 0; x != outputSize.x(); ++x) {
+            const Vector2i position{Int(Float(x)*scaling.x()), Int(Float(y)*scaling.y())};
+            const bool isInside = input[position.y()*inputSize.x() + position.x()] > 127;
+            auto hasOpposite = [&](const Vector2i& offset) {
+                const Vector2i p = position + offset;
+                if(p.x() < 0 || p.y() < 0 || p.x() >= inputSize.x() || p.y() >= inputSize.y())
+                    return false;
+                return (input[p.y()*inputSize.x() + p.x()] > 127) == !isInside;
+            };
+            auto rotate = [](const Vector2i& v) { return Vector2i{-v.y(), v.x()}; };
+
+            Float minDistanceSquared = Float((radius + 1)*(radius + 1));
+            Int radiusLimit = radius;
+            for(Int i = 1; i <= radiusLimit; ++i) {
+                for(Int j = 0, jmax = i*2; j < jmax; ++j) {
+                    const Vector2i offset{-i + j, i};
+                    if(hasOpposite(offset) || hasOpposite(rotate(offset)) ||
+                       hasOpposite(rotate(rotate(offset))) ||
+                       hasOpposite(rotate(rotate(rotate(offset))))) {
+                        const Float distanceSquared = Float(offset.dot());
+                        if(minDistanceSquared < distanceSquared) continue;
+                        minDistanceSquared = distanceSquared;
+                        radiusLimit = Math::min(radius, Int(std::floor(std::sqrt(distanceSquared))));
+                    }
+                }
+            }
+
+            const Float value = (isInside ? 1.0f : -1.0f)*std::sqrt(minDistanceSquared)/Float(radius*2 + 2) + 0.5f;
+            output[y*outputSize.x() + x] = UnsignedByte(Math::clamp(value, 0.0f, 1.0f)*255.0f + 0.5f);
+        }
+
+        return output;
+    }
+
+    std::vector<UnsignedByte> pixels(const Image2D& image) {
+        std::vector<UnsignedByte> out;
+        const std::size_t stride = (image.size().x() + 3)/4*4;
+        for(Int y = 0; y != image.size().y(); ++y) for(Int x = 0; x != image.size().x(); ++x)
+            out.push_back(UnsignedByte(image.data()[y*stride + x]));
+        return out;
+    }
+
+    /* Copies tightly packed rows to rows aligned to four bytes */
+    std::vector<UnsignedByte> aligned(const std::vector<UnsignedByte>& data, const Vector2i& size) {
+        const std::size_t stride = (size.x() + 3)/4*4;
+        std::vector<UnsignedByte> out(stride*size.y());
+        for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x)
+            out[y*stride + x] = data[y*size.x() + x];
+        return out;
+    }
+}
+
+CpuDistanceFieldTest::CpuDistanceFieldTest() {
+    addTests({&CpuDistanceFieldTest::construct});
+
+    addInstancedTests({&CpuDistanceFieldTest::compare}, CompareDataCount);
+
+    addTests({&CpuDistanceFieldTest::parallel,
+              &CpuDistanceFieldTest::inputFormat,
+              &CpuDistanceFieldTest::uniform});
+
+    addBenchmarks<CpuDistanceFieldTest>({&CpuDistanceFieldTest::benchmark<4>,
+                                         &CpuDistanceFieldTest::benchmark<16>,
+                                         &CpuDistanceFieldTest::benchmark<64>,
+                                         &CpuDistanceFieldTest::benchmarkReference<4>,
+                                         &CpuDistanceFieldTest::benchmarkReference<16>}, 3);
+
+    _benchmarkInput = generateInput({512, 512});
+}
+
+void CpuDistanceFieldTest::construct() {
+    CpuDistanceField distanceField{12};
+    CORRADE_COMPARE(distanceField.radius(), 12);
+    CORRADE_COMPARE(distanceField.columnChunkCount(), 0);
+    CORRADE_COMPARE(distanceField.rowChunkCount(), 0);
+}
+
+void CpuDistanceFieldTest::compare() {
+    const auto& data = CompareData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::vector<UnsignedByte> input = aligned(generateInput(data.inputSize), data.inputSize);
+    const ImageView2D image = view(PixelFormat::Red, data.inputSize, input);
+
+    CpuDistanceField distanceField{data.radius};
+    const Image2D output = distanceField(image, data.outputSize);
+    CORRADE_COMPARE(output.size(), data.outputSize);
+    CORRADE_COMPARE(output.format(), PixelFormat::Red);
+    CORRADE_COMPARE(output.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE_AS(pixels(output),
+        reference(generateInput(data.inputSize), data.inputSize, data.outputSize, data.radius),
+        TestSuite::Compare::Container);
+}
+
+void CpuDistanceFieldTest::parallel() {
+    const Vector2i size{100, 70};
+    const std::vector<UnsignedByte> input = aligned(generateInput(size), size);
+    const ImageView2D image = view(PixelFormat::Red, size, input);
+
+    CpuDistanceField distanceField{6};
+    const std::vector<UnsignedByte> expected = pixels(distanceField(image, {50, 35}));
+
+    /* Execute the chunks in reverse order */
+    const std::size_t columnChunkCount = distanceField.begin(image, {50, 35});
+    CORRADE_COMPARE(columnChunkCount, 4);
+    CORRADE_COMPARE(distanceField.columnChunkCount(), 4);
+    for(std::size_t i = columnChunkCount; i != 0; --i)
+        distanceField.columnChunk(i - 1);
+
+    const std::size_t rowChunkCount = distanceField.beginRows();
+    CORRADE_COMPARE(rowChunkCount, 3);
+    CORRADE_COMPARE(distanceField.rowChunkCount(), 3);
+    for(std::size_t i = rowChunkCount; i != 0; --i)
+        distanceField.rowChunk(i - 1);
+
+    CORRADE_COMPARE_AS(pixels(distanceField.end()), expected,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(distanceField.columnChunkCount(), 0);
+}
+
+void CpuDistanceFieldTest::inputFormat() {
+    /* Only the first channel is taken into account */
+    const Vector2i size{37, 23};
+    const std::vector<UnsignedByte> red = generateInput(size);
+    std::vector<UnsignedByte> rgba(red.size()*4);
+    for(std::size_t i = 0; i != red.size(); ++i) {
+        rgba[i*4 + 0] = red[i];
+        rgba[i*4 + 1] = 255 - red[i];
+        rgba[i*4 + 2] = UnsignedByte(i);
+        rgba[i*4 + 3] = 255;
+    }
+
+    const std::vector<UnsignedByte> redAligned = aligned(red, size);
+    CpuDistanceField distanceField{4};
+    CORRADE_COMPARE_AS(
+        pixels(distanceField(view(PixelFormat::RGBA, size, rgba), {20, 20})),
+        pixels(distanceField(view(PixelFormat::Red, size, redAligned), {20, 20})),
+        TestSuite::Compare::Container);
+}
+
+void CpuDistanceFieldTest::uniform() {
+    /* Nothing opposite found in the radius gives the extreme values */
+    const std::vector<UnsignedByte> inside(16*16, 255), outside(16*16, 0);
+
+    CpuDistanceField distanceField{4};
+    CORRADE_COMPARE_AS(pixels(distanceField(view(PixelFormat::Red, {16, 16}, inside), {8, 8})),
+        std::vector<UnsignedByte>(8*8, 255),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(pixels(distanceField(view(PixelFormat::Red, {16, 16}, outside), {8, 8})),
+        std::vector<UnsignedByte>(8*8, 0),
+        TestSuite::Compare::Container);
+}
+
+template<Int radius> void CpuDistanceFieldTest::benchmark() {
+    setTestCaseName("benchmark<" + std::to_string(radius) + ">");
+
+    const ImageView2D image = view(PixelFormat::Red, {512, 512}, _benchmarkInput);
+    CpuDistanceField distanceField{radius};
+
+    Image2D output{PixelFormat::Red, PixelType::UnsignedByte};
+    CORRADE_BENCHMARK(1) {
+        output = distanceField(image, {128, 128});
+    }
+
+    CORRADE_COMPARE(output.size(), (Vector2i{128, 128}));
+}
+
+template<Int radius> void CpuDistanceFieldTest::benchmarkReference() {
+    setTestCaseName("benchmarkReference<" + std::to_string(radius) + ">");
+
+    std::vector<UnsignedByte> output;
+    CORRADE_BENCHMARK(1) {
+        output = reference(_benchmarkInput, {512, 512}, {128, 128}, radius);
+    }
+
+    CORRADE_COMPARE(output.size(), 128*128);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::CpuDistanceFieldTest)
@@ -23,16 +23,21 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <thread>
+#include <vector>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/PluginManager/Manager.h>
 
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Image.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Renderer.h"
 #include "Magnum/Texture.h"
 #include "Magnum/TextureFormat.h"
+#include "Magnum/TextureTools/CpuDistanceField.h"
 #include "Magnum/TextureTools/DistanceField.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
@@ -71,7 +76,7 @@ namespace Magnum {
 
 @section magnum-distancefieldconverter-usage Usage
 
-    magnum-distancefieldconverter [--magnum-...] [-h|--help] [--importer IMPORTER] [--converter CONVERTER] [--plugin-dir DIR] --output-size "X Y" --radius N [--] input output
+    magnum-distancefieldconverter [--magnum-...] [-h|--help] [--importer IMPORTER] [--converter CONVERTER] [--plugin-dir DIR] [--cpu] [--threads N] --output-size "X Y" --radius N [--] input output
 
 Arguments:
 
@@ -82,6 +87,11 @@ Arguments:
 -   `--converter CONVERTER` -- image converter plugin (default: @ref Trade::AnyImageConverter "AnyImageConverter")
 -   `--plugin-dir DIR` -- base plugin dir (defaults to plugin directory in
     Magnum install location)
+-   `--cpu` -- compute the distance field on the CPU using
+    @ref TextureTools::CpuDistanceField instead of on the GPU, without
+    creating any OpenGL context
+-   `--threads N` -- number of threads used in the CPU mode (default: `0`,
+    which means number of hardware threads)
 -   `--output-size "X Y"` -- size of output image
 -   `--radius N` -- distance field computation radius
 -   `--magnum-...` -- engine-specific options (see @ref Context for details)
@@ -91,7 +101,10 @@ are accepted on input.
 
 The resulting image can be then used with @ref Shaders::DistanceFieldVector
 shader. See also @ref TextureTools::distanceField() for more information about
-the algorithm and parameters.
+the algorithm and parameters. The CPU mode gives the same result, but its cost
+doesn't depend on the radius, which makes it faster for large radii, and it
+can run on machines without a GPU. See @ref TextureTools::CpuDistanceField for
+details.
 
 @section magnum-distancefield-example Example usage
 
@@ -101,6 +114,10 @@ This will open monochrome `logo-src.png` image using any plugin that can open
 PNG files and converts it to 256x256 distance field `logo.png` using any plugin
 that can write PNG files.
 
+    magnum-distancefieldconverter --cpu --threads 4 --output-size "256 256" --radius 24 logo-src.png logo.png
+
+Does the same on the CPU using four threads.
+
 */
 
 namespace TextureTools {
@@ -112,6 +129,9 @@ class DistanceFieldConverter: public Platform::WindowlessApplication {
         int exec() override;
 
     private:
+        Image2D convertCpu(const ImageView2D& image);
+        Image2D convertGpu(const ImageView2D& image);
+
         Utility::Arguments args;
 };
 
@@ -121,13 +141,15 @@ DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments): Plat
         .addOption("importer", "AnyImageImporter").setHelp("importer", "image importer plugin")
         .addOption("converter", "AnyImageConverter").setHelp("converter", "image converter plugin")
         .addOption("plugin-dir", Utility::Directory::join(Utility::Directory::path(Utility::Directory::executableLocation()), MAGNUM_PLUGINS_DIR)).setHelp("plugin-dir", "base plugin dir", "DIR")
+        .addBooleanOption("cpu").setHelp("cpu", "compute the distance field on the CPU")
+        .addOption("threads", "0").setHelp("threads", "number of threads used in the CPU mode, 0 for number of hardware threads", "N")
         .addNamedArgument("output-size").setHelp("output-size", "size of output image", "\"X Y\"")
         .addNamedArgument("radius").setHelp("radius", "distance field computation radius", "N")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setHelp("Converts red channel of an image to distance field representation.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    if(!args.isSet("cpu")) createContext();
 }
 
 int DistanceFieldConverter::exec() {
@@ -150,23 +172,63 @@ int DistanceFieldConverter::exec() {
         return 1;
     }
 
-    /* Decide about internal format */
-    TextureFormat internalFormat;
-    if(image->format() == PixelFormat::Red) internalFormat = TextureFormat::R8;
-    else if(image->format() == PixelFormat::RGB) internalFormat = TextureFormat::RGB8;
-    else if(image->format() == PixelFormat::RGBA) internalFormat = TextureFormat::RGBA8;
-    else {
+    if(image->format() != PixelFormat::Red && image->format() != PixelFormat::RGB && image->format() != PixelFormat::RGBA) {
         Error() << "Unsupported image format" << image->format();
         return 1;
     }
 
+    /* Do it */
+    Debug() << "Converting image of size" << image->size() << "to distance field...";
+    const Image2D result = args.isSet("cpu") ? convertCpu(*image) : convertGpu(*image);
+
+    /* Save image */
+    if(!converter->exportToFile(result, args.value("output"))) {
+        Error() << "Cannot save file" << args.value("output");
+        return 1;
+    }
+
+    return 0;
+}
+
+Image2D DistanceFieldConverter::convertCpu(const ImageView2D& image) {
+    std::size_t threadCount = args.value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+
+    CpuDistanceField distanceField{args.value<Int>("radius")};
+
+    /* Each thread picks next unprocessed chunk until all are done */
+    auto run = [threadCount, &distanceField](std::size_t chunkCount, void(CpuDistanceField::*chunk)(std::size_t)) {
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]() {
+            for(std::size_t i; (i = next++) < chunkCount; )
+                (distanceField.*chunk)(i);
+        };
+
+        std::vector<std::thread> threads(Math::min(threadCount, chunkCount) - 1);
+        for(std::thread& thread: threads) thread = std::thread{worker};
+        worker();
+        for(std::thread& thread: threads) thread.join();
+    };
+
+    run(distanceField.begin(image, args.value<Vector2i>("output-size")), &CpuDistanceField::columnChunk);
+    run(distanceField.beginRows(), &CpuDistanceField::rowChunk);
+    return distanceField.end();
+}
+
+Image2D DistanceFieldConverter::convertGpu(const ImageView2D& image) {
+    /* Decide about internal format */
+    TextureFormat internalFormat;
+    if(image.format() == PixelFormat::Red) internalFormat = TextureFormat::R8;
+    else if(image.format() == PixelFormat::RGB) internalFormat = TextureFormat::RGB8;
+    else internalFormat = TextureFormat::RGBA8;
+
     /* Input texture */
     Texture2D input;
     input.setMinificationFilter(Sampler::Filter::Linear)
         .setMagnificationFilter(Sampler::Filter::Linear)
         .setWrapping(Sampler::Wrapping::ClampToEdge)
-        .setStorage(1, internalFormat, image->size())
-        .setSubImage(0, {}, *image);
+        .setStorage(1, internalFormat, image.size())
+        .setSubImage(0, {}, image);
 
     /* Output texture */
     Texture2D output;
@@ -174,19 +236,11 @@ int DistanceFieldConverter::exec() {
 
     CORRADE_INTERNAL_ASSERT(Renderer::error() == Renderer::Error::NoError);
 
-    /* Do it */
-    Debug() << "Converting image of size" << image->size() << "to distance field...";
-    TextureTools::distanceField(input, output, {{}, args.value<Vector2i>("output-size")}, args.value<Int>("radius"), image->size());
+    TextureTools::distanceField(input, output, {{}, args.value<Vector2i>("output-size")}, args.value<Int>("radius"), image.size());
 
-    /* Save image */
     Image2D result(PixelFormat::Red, PixelType::UnsignedByte);
     output.image(0, result);
-    if(!converter->exportToFile(result, args.value("output"))) {
-        Error() << "Cannot save file" << args.value("output");
-        return 1;
-    }
-
-    return 0;
+    return result;
 }
 
 }}